@@ -0,0 +1,274 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <stdio.h>
+#include <stdlib.h> // calloc
+#include <string>
+#ifdef _MSC_VER	//windows version for hostname and login
+#include "getoptwin.h"
+
+#else
+#include <unistd.h> // gethostname, getlogin_r
+
+#include <getopt.h>
+#endif
+#include <filesystem>
+
+
+#include <GigaMesh/printbuildinfo.h>
+#include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/logging/Logging.h>
+
+using namespace std;
+
+bool ambientOcclusion(
+                const filesystem::path&   rFileName,
+                const filesystem::path&   rFileSuffix,
+                const unsigned int        rNumberOfDirections,
+                const double              rZTolerance,
+                const bool                rWriteBinary,
+                const bool                rReplaceFiles
+) {
+	if( rFileName.extension().wstring().size() != 4 ) {
+		cerr << "[GigaMesh] ERROR: File extension '" << rFileName.extension().string() << "' is faulty!" << endl;
+		return( false );
+	}
+
+	// Add parameters to output prefix
+	std::filesystem::path fileNameOut = rFileName.stem();
+	fileNameOut += rFileSuffix;
+
+	// Check: Input file exists?
+	if( !std::filesystem::exists( rFileName ) ) {
+		cerr << "[GigaMesh] Error: File '" << rFileName << "' not found!" << endl;
+		return( false );
+	}
+
+	// Output file for 3D data including the ambient occlusion as function value.
+	std::filesystem::path fileNameOut3D( fileNameOut );
+	fileNameOut3D += ".ply";
+	if( std::filesystem::exists( fileNameOut3D ) ) {
+		if( !rReplaceFiles ) {
+			cerr << "[GigaMesh] File '" << fileNameOut3D << "' already exists!" << endl;
+			return( false );
+		}
+		cout << "[GigaMesh] Warning: File '" << fileNameOut3D << "' will be replaced!" << endl;
+	}
+
+	// All parameters OK => infos to stdout -----------------------------------------------------------------------------------
+	cout << "[GigaMesh] File IN:         " << rFileName << endl;
+	cout << "[GigaMesh] File OUT/Prefix: " << fileNameOut << endl;
+	cout << "[GigaMesh] Directions:      " << rNumberOfDirections << endl;
+	cout << "[GigaMesh] Tolerance:       " << rZTolerance << endl;
+
+	// Prepare data structures
+	//--------------------------------------------------------------------------
+	bool readSucess;
+	Mesh someMesh( rFileName, readSucess );
+	if( !readSucess ) {
+		cerr << "[GigaMesh] Error: Could not open file '" << rFileName << "'!" << endl;
+		return( false );
+	}
+
+	time_t     rawtime;
+	struct tm* timeinfo;
+	time( &rawtime );
+	timeinfo = localtime( &rawtime );
+	cout << "[GigaMesh] Start date/time is: " << asctime( timeinfo );// << endl;
+	if( !someMesh.funcVertAmbientOcclusionRayCast( rNumberOfDirections, rZTolerance ) ) {
+		cerr << "[GigaMesh] Error: Ambient occlusion of '" << rFileName << "' failed!" << endl;
+		return( false );
+	}
+	someMesh.setFlagExport( MeshIO::EXPORT_BINARY, rWriteBinary );
+	if( !someMesh.writeFile( fileNameOut3D ) ) {
+		cerr << "[GigaMesh] Error: Could not write file '" << fileNameOut3D << "'!" << endl;
+		return( false );
+	}
+	time( &rawtime );
+	timeinfo = localtime( &rawtime );
+	cout << "[GigaMesh] End date/time is: " << asctime( timeinfo );// << endl;
+
+	return( true );
+}
+
+//! Help i.e. usage of paramters.
+void printHelp( const char* rExecName ) {
+	std::cout << "Usage: " << rExecName << " [options] (<file>)" << std::endl;
+	std::cout << "GigaMesh Software Framework AMBIENT OCCLUSION" << std::endl << std::endl;
+	std::cout << "Computes the ambient occlusion per vertex by ray casting i.e. without graphics card." << std::endl;
+	std::cout << "The values are stored as function values, which are written as quality field of the PLY. ";
+	std::cout << "They are in the same range as computed by the GUI: about <directions>/4 for an unoccluded vertex.";
+	std::cout << std::endl << std::endl;
+	std::cout << "Options:" << endl;
+	std::cout << "  -h, --help                              Displays this help." << std::endl;
+	std::cout << "  -v, --version                           Displays version information." << std::endl << std::endl;
+	std::cout << "  -n, --directions <int>                  Number of light directions on the sphere." << std::endl;
+	std::cout << "                                          Default: 1000" << std::endl;
+	std::cout << "  -t, --tolerance <float>                 Occluders closer than this distance are ignored." << std::endl;
+	std::cout << "                                          Relative to the diameter of the bounding box. Default: 0.0" << std::endl;
+	std::cout << "  -b, --binary                            Write the file binary." << std::endl;
+	std::cout << "  -s, --output-suffix <string>            Write the file using the given <string> as suffix for its name." << std::endl;
+	std::cout << "                                          Default suffix is '_AO'." << std::endl;
+	std::cout << "  -k, --overwrite-existing                Overwrite exisitng files, which is not done by default" << std::endl;
+	std::cout << "                                          to prevent accidental data loss." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for testing and debugging:" << std::endl;
+	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
+	             "                                          Higher numbers increases verbosity.\n"
+	             "                                          (Default: 1)" << std::endl;
+}
+
+//! Main routine for loading a mesh and storing it with the ambient occlusion as function value
+//==============================================================================================================================================================
+int main( int argc, char *argv[] ) {
+
+	LOG::initLogging();
+
+	// Default string parameter
+	std::filesystem::path optFileSuffix = "_AO";
+
+	// Default parameters
+	unsigned int optNumberOfDirections = 1000;
+	double       optZTolerance         = 0.0;
+
+	// Default flags
+	bool optReplaceFiles = false;
+	bool optWriteBinary  = false;
+
+	// PARSE command line options
+	//--------------------------------------------------------------------------
+	// https://www.gnu.org/software/libc/manual/html_node/Getopt-Long-Option-Example.html#Getopt-Long-Option-Example
+	static struct option longOptions[] = {
+		{ "directions",                   required_argument, nullptr, 'n' },
+		{ "tolerance",                    required_argument, nullptr, 't' },
+		{ "output-suffix",                required_argument, nullptr, 's' },
+		{ "binary",                       no_argument,       nullptr, 'b' },
+		{ "overwrite-existing",           no_argument,       nullptr, 'k' },
+		{ "version",                      no_argument,       nullptr, 'v' },
+		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "log-level",                    required_argument, nullptr,  0  },
+		{ nullptr, 0, nullptr, 0 }
+	};
+
+	int character = 0;
+	int optionIndex = 0;
+
+	while( ( character = getopt_long_only( argc, argv, ":n:t:s:bkvh",
+	         longOptions, &optionIndex ) ) != -1 ) {
+		switch(character) {
+			case 0:
+				if(std::string(longOptions[optionIndex].name) == "log-level")
+				{
+					unsigned int arg = optarg[0] - '0';
+					if(arg <= 5)
+					{
+						LOG::setLogLevel(static_cast<LOG::LogLevel>(arg));
+					}
+					else
+					{
+						std::cerr << "[GigaMesh] WARNING: Log level is out of range [0-4]!" << std::endl;
+					}
+				}
+				break;
+
+			case 'n': // number of directions
+				try {
+					optNumberOfDirections = std::stoul( optarg );
+				} catch( ... ) {
+					std::cerr << "[GigaMesh] ERROR: Bad number of directions '" << optarg << "'!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+				break;
+
+			case 't': // tolerance
+				try {
+					optZTolerance = std::stod( optarg );
+				} catch( ... ) {
+					std::cerr << "[GigaMesh] ERROR: Bad tolerance '" << optarg << "'!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+				break;
+
+			case 's': // optional file suffix
+				optFileSuffix = std::string( optarg );
+				break;
+
+			case 'b': // write binray file
+				optWriteBinary = true;
+				break;
+
+			case 'k': // replaces output files
+				std::cout << "[GigaMesh] Warning: files might be replaced!" << std::endl;
+				optReplaceFiles = true;
+				break;
+
+			case 'v':
+				std::cout << "GigaMesh Software Framework AMBIENT OCCLUSION " << VERSION_PACKAGE << endl;
+				std::cout << "Multi-threading with " << getParallelThreadCount() << " threads." << endl;
+				std::exit( EXIT_SUCCESS );
+				break;
+
+			case 'h':
+				printHelp( argv[0] );
+				std::exit( EXIT_SUCCESS );
+				break;
+
+			default: // Unknown option given
+				std::cerr << "[GigaMesh] ERROR: Unknown option '" << character << "'!" << std::endl;
+				std::cerr << "[GigaMesh]        See -h or --help for available options." << std::endl;
+				std::exit( EXIT_FAILURE );
+		}
+	}
+
+	// No files given i.e. wrong arguments
+	if( argc-optind <= 0 ) {
+		std::cerr << "[GigaMesh] ERROR: No files given!" << std::endl << std::endl;
+		printHelp( argv[0] );
+		std::exit( EXIT_FAILURE );
+	}
+
+	// SHOW Build information
+	printBuildInfo();
+
+	// Process given files
+	unsigned long filesProcessed = 0;
+	for( int nonOptionArgumentCount = optind;
+	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
+
+		std::filesystem::path nonOptionArgumentString ( argv[nonOptionArgumentCount] );
+
+		if( !nonOptionArgumentString.empty() ) {
+			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
+
+			if( !ambientOcclusion( nonOptionArgumentString, optFileSuffix, optNumberOfDirections,
+			                       optZTolerance, optWriteBinary, optReplaceFiles ) ) {
+				std::cerr << "[GigaMesh] ERROR: ambientOcclusion failed!" << std::endl;
+				std::exit( EXIT_FAILURE );
+			}
+			filesProcessed++;
+		}
+	}
+
+	std::cout << "[GigaMesh] Processed files: " << filesProcessed << std::endl;
+	exit( EXIT_SUCCESS );
+}
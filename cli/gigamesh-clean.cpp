@@ -61,7 +61,8 @@ bool cleanupGigaMeshData(
                 bool            removeOnlyFlag = false,
                 bool            keepLargestComponent = false,
                 bool            skipLargestHole = false,
-                unsigned long   maxNumberVertices = 3000
+                unsigned long   maxNumberVertices = 3000,
+                double          weldTolerance = -1.0
 ) {
 	// Check file extension for input file
 	if( !fileNameIn.has_extension() ) {
@@ -141,6 +142,17 @@ bool cleanupGigaMeshData(
 	auto oldVertexNr = someMesh.getVertexNr();
 	auto oldFaceNr = someMesh.getFaceNr();
 
+	// Weld duplicated vertices e.g. of STL exports, which would be treated as borders otherwise.
+	//----------------------------------------------------------
+	if( weldTolerance >= 0.0 ) {
+		uint64_t mergedNr = 0;
+		if( !someMesh.weldVertices( weldTolerance, VertexWelding::ATTRIBUTES_FIRST, mergedNr ) ) {
+			std::cerr << "[GigaMesh] ERROR: Welding of vertices failed!" << std::endl;
+			return( false );
+		}
+		std::cout << "[GigaMesh] WELD: " << mergedNr << " Vertices merged." << std::endl;
+	}
+
 	// Keep ONLY the largest connected component.
 	//----------------------------------------------------------
 	if( !keepLargestComponent ) {
@@ -245,6 +257,8 @@ void printHelp( const char* rExecName ) {
 	std::cout << "                                          The default for SIZE is 3000. Set 0 (zero) to attempted all holes to be filled." << std::endl;
 	std::cout << "                                          Has no effect, when -r is used." << std::endl;
 	std::cout << "  -n, --no-border-erosion                 Do not apply border erosion i.e. keep dangling faces along the border." << std::endl;
+	std::cout << "  -w, --weld-vertices TOLERANCE           Merge vertices closer than TOLERANCE before cleaning. Set 0 (zero) to merge" << std::endl;
+	std::cout << "                                          only vertices with identical coordinates e.g. of STL files. Disabled by default." << std::endl;
 	std::cout << std::endl;
 	std::cout << "Options to (pre)set the embedded Meta-data:" << std::endl;
 	std::cout << "  -m, --set-material-when-empty STRING    Set the material to STRING, when empty." << std::endl;
@@ -279,6 +293,7 @@ int main( int argc, char* argv[] ) {
 
 	// Default float parameter
 	double percentArea = 0.1;
+	double weldTolerance = -1.0;
 
 	// Default flags
 	bool replaceFiles = false;
@@ -301,6 +316,7 @@ int main( int argc, char* argv[] ) {
 		{ "skip-largest-hole",            no_argument,       nullptr, 's' },
 		{ "skip-holes-larger",            required_argument, nullptr, 'g' },
 		{ "no-border-erosion",            no_argument,       nullptr, 'n' },
+		{ "weld-vertices",                required_argument, nullptr, 'w' },
 		{ "set-material-when-empty",      required_argument, nullptr, 'm' },
 		{ "set-id-when-empty",            no_argument,       nullptr, 'i' },
 		{ "set-id-remove-trailing-chars", required_argument, nullptr, 'j' },
@@ -314,7 +330,7 @@ int main( int argc, char* argv[] ) {
 	int character = 0;
 	int optionIndex = 0;
 
-	while( ( character = getopt_long_only( argc, argv, ":krp:lsg:nm:ij:ovh",
+	while( ( character = getopt_long_only( argc, argv, ":krp:lsg:nw:m:ij:ovh",
 	         longOptions, &optionIndex ) ) != -1 ) {
 		switch(character) {
 			case 0:
@@ -367,6 +383,10 @@ int main( int argc, char* argv[] ) {
 				skipHolesLargerThan = std::stoul( optarg );
 				break;
 
+			case 'w':
+				weldTolerance = std::atof( optarg );
+				break;
+
 			case 'm':
 				materialWhenEmpty = std::string( optarg );
 				materialWhenEmptySet = true;
@@ -432,7 +452,7 @@ int main( int argc, char* argv[] ) {
 			                          removeTrailingChars, enforceIdMaterial, percentArea, applyBorderErosion,
 			                          replaceFiles, removeOnlyFlag,
 			                          keepLargestComponent, skipLargestHole,
-			                          skipHolesLargerThan ) ) {
+			                          skipHolesLargerThan, weldTolerance ) ) {
 				std::cerr << "[GigaMesh] ERROR: cleanupGigaMeshData failed!" << std::endl;
 				std::exit( EXIT_FAILURE );
 			}
@@ -0,0 +1,323 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <stdio.h>
+#include <stdlib.h> // calloc
+#include <string>
+#ifdef _MSC_VER	//windows version for hostname and login
+#include "getoptwin.h"
+
+#else
+#include <unistd.h> // gethostname, getlogin_r
+
+#include <getopt.h>
+#endif
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+
+#include <GigaMesh/printbuildinfo.h>
+#include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/logging/Logging.h>
+
+using namespace std;
+
+bool decimate(
+                const filesystem::path&   rFileName,
+                const filesystem::path&   rFileSuffix,
+                const uint64_t            rTargetFaceNr,
+                const double              rTargetRatio,
+                const double              rMaxError,
+                const bool                rWriteMapping,
+                const bool                rWriteBinary,
+                const bool                rReplaceFiles
+) {
+	if( rFileName.extension().wstring().size() != 4 ) {
+		cerr << "[GigaMesh] ERROR: File extension '" << rFileName.extension().string() << "' is faulty!" << endl;
+		return( false );
+	}
+
+	// Add parameters to output prefix
+	std::filesystem::path fileNameOut = rFileName.stem();
+	fileNameOut += rFileSuffix;
+
+	// Check: Input file exists?
+	if( !std::filesystem::exists( rFileName ) ) {
+		cerr << "[GigaMesh] Error: File '" << rFileName << "' not found!" << endl;
+		return( false );
+	}
+
+	// Output files for the simplified mesh and the index of its vertex for each original vertex.
+	std::filesystem::path fileNameOut3D( fileNameOut );
+	fileNameOut3D += ".ply";
+	std::filesystem::path fileNameOutMapping( fileNameOut );
+	fileNameOutMapping += "_mapping.txt";
+	for( const auto& fileNameCheck : { fileNameOut3D, fileNameOutMapping } ) {
+		if( ( fileNameCheck == fileNameOutMapping ) && !rWriteMapping ) {
+			continue;
+		}
+		if( std::filesystem::exists( fileNameCheck ) ) {
+			if( !rReplaceFiles ) {
+				cerr << "[GigaMesh] File '" << fileNameCheck << "' already exists!" << endl;
+				return( false );
+			}
+			cout << "[GigaMesh] Warning: File '" << fileNameCheck << "' will be replaced!" << endl;
+		}
+	}
+
+	// Prepare data structures
+	//--------------------------------------------------------------------------
+	bool readSucess;
+	Mesh someMesh( rFileName, readSucess );
+	if( !readSucess ) {
+		cerr << "[GigaMesh] Error: Could not open file '" << rFileName << "'!" << endl;
+		return( false );
+	}
+	const uint64_t targetFaceNr = ( rTargetFaceNr > 0 ) ? rTargetFaceNr :
+	                              static_cast<uint64_t>( rTargetRatio * static_cast<double>( someMesh.getFaceNr() ) );
+
+	// All parameters OK => infos to stdout -----------------------------------------------------------------------------------
+	cout << "[GigaMesh] File IN:         " << rFileName << endl;
+	cout << "[GigaMesh] File OUT/Prefix: " << fileNameOut << endl;
+	cout << "[GigaMesh] Target faces:    " << targetFaceNr << endl;
+	cout << "[GigaMesh] Maximum error:   " << rMaxError << endl;
+
+	time_t     rawtime;
+	struct tm* timeinfo;
+	time( &rawtime );
+	timeinfo = localtime( &rawtime );
+	cout << "[GigaMesh] Start date/time is: " << asctime( timeinfo );// << endl;
+	std::vector<sVertexProperties> vertexProps;
+	std::vector<sFaceProperties>   faceProps;
+	std::vector<uint64_t>          fineToCoarse;
+	if( !someMesh.decimateQuadricError( targetFaceNr, rMaxError, vertexProps, faceProps, fineToCoarse ) ) {
+		cerr << "[GigaMesh] Error: Decimation of '" << rFileName << "' failed!" << endl;
+		return( false );
+	}
+	Mesh coarseMesh( vertexProps, faceProps );
+	coarseMesh.setFlagExport( MeshIO::EXPORT_BINARY, rWriteBinary );
+	if( !coarseMesh.writeFile( fileNameOut3D ) ) {
+		cerr << "[GigaMesh] Error: Could not write file '" << fileNameOut3D << "'!" << endl;
+		return( false );
+	}
+	if( rWriteMapping ) {
+		std::ofstream mappingFile( fileNameOutMapping );
+		if( !mappingFile.is_open() ) {
+			cerr << "[GigaMesh] Error: Could not write file '" << fileNameOutMapping << "'!" << endl;
+			return( false );
+		}
+		mappingFile << "# Index of the vertex of " << fileNameOut3D.filename() << " for each vertex of " << rFileName.filename() << "\n";
+		for( const uint64_t coarseIdx : fineToCoarse ) {
+			mappingFile << coarseIdx << "\n";
+		}
+	}
+	time( &rawtime );
+	timeinfo = localtime( &rawtime );
+	cout << "[GigaMesh] End date/time is: " << asctime( timeinfo );// << endl;
+
+	return( true );
+}
+
+//! Help i.e. usage of paramters.
+void printHelp( const char* rExecName ) {
+	std::cout << "Usage: " << rExecName << " [options] (<file>)" << std::endl;
+	std::cout << "GigaMesh Software Framework DECIMATE" << std::endl << std::endl;
+	std::cout << "Simplifies meshes by edge collapses using quadric error metrics. Borders and the borders ";
+	std::cout << "between labels are preserved. The remaining vertices keep their properties e.g. function values.";
+	std::cout << std::endl << std::endl;
+	std::cout << "Options:" << endl;
+	std::cout << "  -h, --help                              Displays this help." << std::endl;
+	std::cout << "  -v, --version                           Displays version information." << std::endl << std::endl;
+	std::cout << "  -f, --faces <int>                       Number of faces to reach. Overrides --ratio." << std::endl;
+	std::cout << "  -r, --ratio <float>                     Number of faces to reach relative to the input." << std::endl;
+	std::cout << "                                          Default: 0.1" << std::endl;
+	std::cout << "  -e, --max-error <float>                 Maximum error of a single collapse i.e. weighted sum of" << std::endl;
+	std::cout << "                                          squared distances. Default: unlimited" << std::endl;
+	std::cout << "  -m, --mapping                           Write the index of the remaining vertex for each input" << std::endl;
+	std::cout << "                                          vertex to a text file, e.g. to transfer results back." << std::endl;
+	std::cout << "  -b, --binary                            Write the file binary." << std::endl;
+	std::cout << "  -s, --output-suffix <string>            Write the file using the given <string> as suffix for its name." << std::endl;
+	std::cout << "                                          Default suffix is '_QEM'." << std::endl;
+	std::cout << "  -k, --overwrite-existing                Overwrite exisitng files, which is not done by default" << std::endl;
+	std::cout << "                                          to prevent accidental data loss." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options for testing and debugging:" << std::endl;
+	std::cout << "    , --log-level [0-4]                   Sets the log level of this application.\n"
+	             "                                          Higher numbers increases verbosity.\n"
+	             "                                          (Default: 1)" << std::endl;
+}
+
+//! Main routine for loading a mesh and storing its simplification
+//==============================================================================================================================================================
+int main( int argc, char *argv[] ) {
+
+	LOG::initLogging();
+
+	// Default string parameter
+	std::filesystem::path optFileSuffix = "_QEM";
+
+	// Default parameters
+	uint64_t optTargetFaceNr = 0;
+	double   optTargetRatio  = 0.1;
+	double   optMaxError     = std::numeric_limits<double>::infinity();
+
+	// Default flags
+	bool optWriteMapping = false;
+	bool optReplaceFiles = false;
+	bool optWriteBinary  = false;
+
+	// PARSE command line options
+	//--------------------------------------------------------------------------
+	// https://www.gnu.org/software/libc/manual/html_node/Getopt-Long-Option-Example.html#Getopt-Long-Option-Example
+	static struct option longOptions[] = {
+		{ "faces",                        required_argument, nullptr, 'f' },
+		{ "ratio",                        required_argument, nullptr, 'r' },
+		{ "max-error",                    required_argument, nullptr, 'e' },
+		{ "mapping",                      no_argument,       nullptr, 'm' },
+		{ "output-suffix",                required_argument, nullptr, 's' },
+		{ "binary",                       no_argument,       nullptr, 'b' },
+		{ "overwrite-existing",           no_argument,       nullptr, 'k' },
+		{ "version",                      no_argument,       nullptr, 'v' },
+		{ "help",                         no_argument,       nullptr, 'h' },
+		{ "log-level",                    required_argument, nullptr,  0  },
+		{ nullptr, 0, nullptr, 0 }
+	};
+
+	int character = 0;
+	int optionIndex = 0;
+
+	while( ( character = getopt_long_only( argc, argv, ":f:r:e:ms:bkvh",
+	         longOptions, &optionIndex ) ) != -1 ) {
+		switch(character) {
+			case 0:
+				if(std::string(longOptions[optionIndex].name) == "log-level")
+				{
+					unsigned int arg = optarg[0] - '0';
+					if(arg <= 5)
+					{
+						LOG::setLogLevel(static_cast<LOG::LogLevel>(arg));
+					}
+					else
+					{
+						std::cerr << "[GigaMesh] WARNING: Log level is out of range [0-4]!" << std::endl;
+					}
+				}
+				break;
+
+			case 'f': // number of faces
+				try {
+					optTargetFaceNr = std::stoull( optarg );
+				} catch( ... ) {
+					std::cerr << "[GigaMesh] ERROR: Bad number of faces '" << optarg << "'!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+				break;
+
+			case 'r': // ratio of faces
+				try {
+					optTargetRatio = std::stod( optarg );
+				} catch( ... ) {
+					optTargetRatio = -1.0;
+				}
+				if( !( optTargetRatio >= 0.0 ) || ( optTargetRatio > 1.0 ) ) {
+					std::cerr << "[GigaMesh] ERROR: Bad ratio '" << optarg << "'!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+				break;
+
+			case 'e': // maximum error
+				try {
+					optMaxError = std::stod( optarg );
+				} catch( ... ) {
+					std::cerr << "[GigaMesh] ERROR: Bad maximum error '" << optarg << "'!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+				break;
+
+			case 'm': // write mapping
+				optWriteMapping = true;
+				break;
+
+			case 's': // optional file suffix
+				optFileSuffix = std::string( optarg );
+				break;
+
+			case 'b': // write binray file
+				optWriteBinary = true;
+				break;
+
+			case 'k': // replaces output files
+				std::cout << "[GigaMesh] Warning: files might be replaced!" << std::endl;
+				optReplaceFiles = true;
+				break;
+
+			case 'v':
+				std::cout << "GigaMesh Software Framework DECIMATE " << VERSION_PACKAGE << endl;
+				std::cout << "Multi-threading with " << std::thread::hardware_concurrency() << " threads." << endl;
+				std::exit( EXIT_SUCCESS );
+				break;
+
+			case 'h':
+				printHelp( argv[0] );
+				std::exit( EXIT_SUCCESS );
+				break;
+
+			default: // Unknown option given
+				std::cerr << "[GigaMesh] ERROR: Unknown option '" << character << "'!" << std::endl;
+				std::cerr << "[GigaMesh]        See -h or --help for available options." << std::endl;
+				std::exit( EXIT_FAILURE );
+		}
+	}
+
+	// No files given i.e. wrong arguments
+	if( argc-optind <= 0 ) {
+		std::cerr << "[GigaMesh] ERROR: No files given!" << std::endl << std::endl;
+		printHelp( argv[0] );
+		std::exit( EXIT_FAILURE );
+	}
+
+	// SHOW Build information
+	printBuildInfo();
+
+	// Process given files
+	unsigned long filesProcessed = 0;
+	for( int nonOptionArgumentCount = optind;
+	     nonOptionArgumentCount < argc; nonOptionArgumentCount++ ) {
+
+		std::filesystem::path nonOptionArgumentString ( argv[nonOptionArgumentCount] );
+
+		if( !nonOptionArgumentString.empty() ) {
+			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
+
+			if( !decimate( nonOptionArgumentString, optFileSuffix, optTargetFaceNr, optTargetRatio,
+			               optMaxError, optWriteMapping, optWriteBinary, optReplaceFiles ) ) {
+				std::cerr << "[GigaMesh] ERROR: decimate failed!" << std::endl;
+				std::exit( EXIT_FAILURE );
+			}
+			filesProcessed++;
+		}
+	}
+
+	std::cout << "[GigaMesh] Processed files: " << filesProcessed << std::endl;
+	exit( EXIT_SUCCESS );
+}
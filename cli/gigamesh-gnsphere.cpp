@@ -159,23 +159,22 @@ bool convertMeshData(
         //prepare normal data
         bool sphereCoordinates = true;
 
-        std::list<sVertexProperties> vertexProps;
+        // Contiguous xyz-triplets for the parallel binning.
+        std::vector<double> normalsXYZ;
 
-        auto fAddNormal = [&vertexProps](const Vector3D& normal) -> void {
+        auto fAddNormal = [&normalsXYZ](const Vector3D& normal) -> void {
             if( std::isnan(normal.getX()) || std::isnan(normal.getY()) || std::isnan(normal.getZ()) )
             {
                 return;
             }
-            sVertexProperties prop;
-            prop.mNormalX = normal.getX();
-            prop.mNormalY = normal.getY();
-            prop.mNormalZ = normal.getZ();
-
-            vertexProps.emplace_back(prop);
+            normalsXYZ.push_back(normal.getX());
+            normalsXYZ.push_back(normal.getY());
+            normalsXYZ.push_back(normal.getZ());
         };
         if(rFaceNormals)
         {
             auto faceCount = someMesh.getFaceNr();
+            normalsXYZ.reserve( faceCount * 3 );
 
             for( uint64_t faceIdx = 0; faceIdx < faceCount; ++faceIdx)
             {
@@ -187,6 +186,7 @@ bool convertMeshData(
         else
         {
             auto vertCount = someMesh.getVertexNr();
+            normalsXYZ.reserve( vertCount * 3 );
 
             for( uint64_t vertIdx=0; vertIdx<vertCount; vertIdx++ ) {
                 Vertex* currVertex = someMesh.getVertexPos( vertIdx );
@@ -203,7 +203,7 @@ bool convertMeshData(
         time( &rawtime );
         timeinfo = localtime( &rawtime );
         cout << "[GigaMesh] Start date/time is: " << asctime( timeinfo );// << endl;
-        someMesh.writeIcoNormalSphereData(fileNameOutCSV, vertexProps , rSubdivisionLevel, sphereCoordinates);
+        someMesh.writeIcoNormalSphereData(fileNameOutCSV, normalsXYZ, rSubdivisionLevel, sphereCoordinates);
         timeinfo = localtime( &rawtime );
         cout << "[GigaMesh] End date/time is: " << asctime( timeinfo );// << endl;
         if(rCleanMesh == true){
@@ -77,6 +77,41 @@ bool infoGigaMeshData(
 	return( true );
 }
 
+//! Fast mode: only the file is read and the information is determined
+//! from the primitives without establishing the mesh structure.
+//! See MeshInfoData::fetchPrimitiveProperties
+bool infoGigaMeshDataFast(
+                const std::filesystem::path&   rFileNameIn,    //!< Input - filename.
+                MeshInfoData&                  rFileInfos,     //!< Output - data properties.
+                bool                           rAbsolutePath   //!< Option: display absolute path or stem only.
+) {
+	// Check: Input file exists
+	if( !std::filesystem::exists( rFileNameIn) ) {
+		std::wcerr << "[GigaMesh] ERROR: File '" << rFileNameIn.wstring() << "' not found!" << std::endl;
+		return( false );
+	}
+
+	MeshIO meshFile;
+	std::vector<sVertexProperties> vertexProps;
+	std::vector<sFaceProperties>   faceProps;
+	if( !meshFile.readFile( rFileNameIn, vertexProps, faceProps ) ) {
+		std::wcerr << "[GigaMesh] ERROR: Could not open file '" << rFileNameIn.wstring() << "'!" << std::endl;
+		return( false );
+	}
+
+	rFileInfos.reset();
+	if( rAbsolutePath ) {
+		rFileInfos.mStrings[MeshInfoData::FILENAME]       = meshFile.getFullName().string();
+	} else {
+		rFileInfos.mStrings[MeshInfoData::FILENAME]       = meshFile.getBaseName().string();
+	}
+	rFileInfos.mStrings[MeshInfoData::MODEL_ID]           = meshFile.getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_ID );
+	rFileInfos.mStrings[MeshInfoData::MODEL_MATERIAL]     = meshFile.getModelMetaDataRef().getModelMetaString( ModelMetaData::META_MODEL_MATERIAL );
+	rFileInfos.mStrings[MeshInfoData::MODEL_WEBREFERENCE] = meshFile.getModelMetaDataRef().getModelMetaString( ModelMetaData::META_REFERENCE_WEB );
+
+	return( rFileInfos.fetchPrimitiveProperties( vertexProps, faceProps ) );
+}
+
 //! Help i.e. usage of paramters.
 void printHelp( const char* rExecName ) {
 	std::cout << "Usage: " << rExecName << " [options] (<file>)" << std::endl;
@@ -93,6 +128,9 @@ void printHelp( const char* rExecName ) {
 	std::cout << "  -t, --write-sidecar-file-html           Write mesh information in HTML as side car file." << std::endl;
 	std::cout << "  -a, --write-sidecar-files               Write all the above side car files." << std::endl;
     std::cout << "  -q, --quick                             Suppress detection of self-intersections (computationally intensive)." << std::endl;
+	std::cout << "  -f, --fast                              Fast mode: count primitives, bounding box, area and volume without" << std::endl;
+	std::cout << "                                          establishing the mesh structure. Properties requiring the adjacency" << std::endl;
+	std::cout << "                                          e.g. borders, manifoldness and connected components are not determined." << std::endl;
 	//! \todo integrate '-k' option for '-j/l/x/t/a' and NOT for '-o'
 //	std::cout << "  -k, --overwrite-existing                Overwrite exisitng files, which is not done by default" << std::endl;
 //	std::cout << "                                          to prevent accidental data loss." << std::endl;
@@ -126,6 +164,7 @@ int main( int argc, char* argv[] ) {
 	bool optSideCarJSON  = false;
 	bool optSideCarTTL   = false;
     bool optSuppressSelfIntersection = false;
+	bool optFast         = false;
 
 	// PARSE command line options
 	//--------------------------------------------------------------------------
@@ -140,6 +179,7 @@ int main( int argc, char* argv[] ) {
 		{ "write-sidecar-files",          no_argument,       nullptr, 'a' },
 		{ "overwrite-existing",           no_argument,       nullptr, 'k' },
         { "quick",                        no_argument,       nullptr, 'q' },
+		{ "fast",                         no_argument,       nullptr, 'f' },
 		{ "version",                      no_argument,       nullptr, 'v' },
 		{ "help",                         no_argument,       nullptr, 'h' },
 		{ "log-level",                    required_argument, nullptr,  0  },
@@ -149,7 +189,7 @@ int main( int argc, char* argv[] ) {
 	int character = 0;
 	int optionIndex = 0;
 
-    while( ( character = getopt_long_only( argc, argv, ":o:stkqxjlavh",
+    while( ( character = getopt_long_only( argc, argv, ":o:stkqfxjlavh",
 	         longOptions, &optionIndex ) ) != -1 ) {
 
         switch(character) {
@@ -200,6 +240,10 @@ int main( int argc, char* argv[] ) {
                 optSuppressSelfIntersection = true;
                 break;
 
+			case 'f':
+				optFast = true;
+				break;
+
 			case 'a':
 				optSideCarHTML = true;
 				optSideCarTTL  = true;
@@ -253,7 +297,12 @@ int main( int argc, char* argv[] ) {
 			std::cout << "[GigaMesh] Processing file " << nonOptionArgumentString << "..." << std::endl;
 
 			MeshInfoData fileInfoSingle;
-			if( !infoGigaMeshData( nonOptionArgumentString,
+			if( optFast ) {
+				if( !infoGigaMeshDataFast( nonOptionArgumentString, fileInfoSingle, optAbsolutePath ) ) {
+					std::cerr << "[GigaMesh] ERROR: infoGigaMeshDataFast failed!" << std::endl;
+					std::exit( EXIT_FAILURE );
+				}
+			} else if( !infoGigaMeshData( nonOptionArgumentString,
                                    fileInfoSingle,
                                    optSuppressSelfIntersection,
                                    optAbsolutePath
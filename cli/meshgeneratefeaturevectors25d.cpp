@@ -394,6 +394,9 @@ bool generateFeatureVectors(
 	// Pre-compute sparse filte:
 	voxelFilter2DElements* sparseFilters;
 	generateVoxelFilters2D( multiscaleRadiiSize, multiscaleRadii, xyzDim, &sparseFilters );
+	// ... merged for a single pass over all scales:
+	voxelFilter2DMultiscale multiscaleFilter;
+	const bool multiscaleFilterValid = generateVoxelFilters2DMultiscale( sparseFilters, multiscaleRadiiSize, xyzDim, &multiscaleFilter );
 
 	sMeshDataStruct* setMeshData = new sMeshDataStruct[availableConcurrentThreads];
 	for( size_t t = 0; t < availableConcurrentThreads; t++ )
@@ -405,12 +408,14 @@ bool generateFeatureVectors(
 		setMeshData[t].multiscaleRadiiSize    = multiscaleRadiiSize;
 		setMeshData[t].multiscaleRadii        = multiscaleRadii;
 		setMeshData[t].sparseFilters          = &sparseFilters;
+		setMeshData[t].multiscaleFilter       = multiscaleFilterValid ? &multiscaleFilter : nullptr;
 		setMeshData[t].mPatchNormal           = &patchNormalsToAssign;
 		setMeshData[t].descriptVolume         = descriptVolume;
 		setMeshData[t].descriptSurface        = descriptSurface;
 	}
 
 	compFeatureVectorsMain( setMeshData, availableConcurrentThreads );
+	freeVoxelFilters2DMultiscale( &multiscaleFilter );
 
 	delete[] setMeshData;
 
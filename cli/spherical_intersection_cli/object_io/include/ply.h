@@ -36,6 +36,18 @@ Object_Information load_ply(const std::string &path);
 void save_ply(const std::string &path,
 	      const Object_Information &object_information,
 	      const std::vector<double> &qualities, const Format format);
+
+//! @brief Saves a mesh with a quality and a feature vector per vertex.
+//!
+//! The feature vectors are written as property list uint8 float
+//! feature_vector, which is read by GigaMesh.
+//! @param features feature_count values per vertex, stored consecutively.
+//! @param feature_count length of the feature vectors - at most 255.
+void save_ply(const std::string &path,
+	      const Object_Information &object_information,
+	      const std::vector<double> &qualities,
+	      const std::vector<double> &features,
+	      const std::size_t feature_count, const Format format);
 } // namespace ply
 } // namespace object_io
 
@@ -490,7 +490,7 @@ Object_Information ply::load_ply(const std::string &path) {
 
 namespace {
 void write_header(std::ofstream &file, Format format, std::size_t vertex_count,
-		  std::size_t face_count) {
+		  std::size_t face_count, std::size_t feature_count) {
 	file << "ply\n";
 	file << "format ";
 	switch (format) {
@@ -519,6 +519,10 @@ void write_header(std::ofstream &file, Format format, std::size_t vertex_count,
 	     << "\n";
 	file << "property float quality"
 	     << "\n";
+	if (feature_count > 0) {
+		file << "property list uint8 float feature_vector"
+		     << "\n";
+	}
 	file << "element face " << face_count << "\n";
 	file << "property list uint32 uint32 vertex_indices"
 	     << "\n";
@@ -527,6 +531,8 @@ void write_header(std::ofstream &file, Format format, std::size_t vertex_count,
 
 void write_body_ascii(const std::vector<Vertex_Location> &vertex_locations,
 		      const std::vector<double> &qualities,
+		      const std::vector<double> &features,
+		      std::size_t feature_count,
 		      const std::vector<Triangle_Indices> &triangle_indices,
 		      std::ofstream &file) {
 	for (std::size_t vertex_index = 0;
@@ -534,7 +540,17 @@ void write_body_ascii(const std::vector<Vertex_Location> &vertex_locations,
 		const auto &location = vertex_locations[vertex_index];
 		auto quality = qualities[vertex_index];
 		file << location[0] << " " << location[1] << " " << location[2]
-		     << " " << quality << "\n";
+		     << " " << quality;
+		if (feature_count > 0) {
+			file << " " << feature_count;
+			for (std::size_t feature_index = 0;
+			     feature_index < feature_count; feature_index++) {
+				file << " "
+				     << features[vertex_index * feature_count +
+						 feature_index];
+			}
+		}
+		file << "\n";
 	}
 	for (std::size_t triangle_index = 0;
 	     triangle_index < triangle_indices.size(); triangle_index++) {
@@ -552,6 +568,8 @@ void append_as_binary(const T &value, std::ofstream &file, Endian endian) {
 
 void write_body_binary(const std::vector<Vertex_Location> &vertex_locations,
 		       const std::vector<double> &qualities,
+		       const std::vector<double> &features,
+		       std::size_t feature_count,
 		       const std::vector<Triangle_Indices> &triangle_indices,
 		       std::ofstream &file, Endian endian) {
 	for (std::size_t vertex_index = 0;
@@ -562,6 +580,17 @@ void write_body_binary(const std::vector<Vertex_Location> &vertex_locations,
 		append_as_binary<float>(location[1], file, endian);
 		append_as_binary<float>(location[2], file, endian);
 		append_as_binary<float>(quality, file, endian);
+		if (feature_count > 0) {
+			append_as_binary<std::uint8_t>(feature_count, file,
+						       endian);
+			for (std::size_t feature_index = 0;
+			     feature_index < feature_count; feature_index++) {
+				append_as_binary<float>(
+				    features[vertex_index * feature_count +
+					     feature_index],
+				    file, endian);
+			}
+		}
 	}
 	for (std::size_t triangle_index = 0;
 	     triangle_index < triangle_indices.size(); triangle_index++) {
@@ -577,6 +606,17 @@ void write_body_binary(const std::vector<Vertex_Location> &vertex_locations,
 void ply::save_ply(const std::string &path,
 		   const Object_Information &object_information,
 		   const std::vector<double> &qualities, Format format) {
+	save_ply(path, object_information, qualities, {}, 0, format);
+}
+
+void ply::save_ply(const std::string &path,
+		   const Object_Information &object_information,
+		   const std::vector<double> &qualities,
+		   const std::vector<double> &features,
+		   const std::size_t feature_count, Format format) {
+	if (feature_count > std::numeric_limits<std::uint8_t>::max()) {
+		throw std::invalid_argument("Feature vector too long.");
+	}
 	std::ofstream file{path};
 	if (file.fail()) {
 		std::cout << "File \"" + path + "\" not found." << std::endl;
@@ -587,18 +627,20 @@ void ply::save_ply(const std::string &path,
 	auto &triangle_indices = object_information.second;
 
 	write_header(file, format, vertex_locations.size(),
-		     triangle_indices.size());
+		     triangle_indices.size(), feature_count);
 
 	switch (format) {
 	case ascii:
-		return write_body_ascii(vertex_locations, qualities,
-					triangle_indices, file);
+		return write_body_ascii(vertex_locations, qualities, features,
+					feature_count, triangle_indices, file);
 	case binary_little_endian:
-		return write_body_binary(vertex_locations, qualities,
-					 triangle_indices, file, little);
+		return write_body_binary(vertex_locations, qualities, features,
+					 feature_count, triangle_indices, file,
+					 little);
 	case binary_big_endian:
-		return write_body_binary(vertex_locations, qualities,
-					 triangle_indices, file, big);
+		return write_body_binary(vertex_locations, qualities, features,
+					 feature_count, triangle_indices, file,
+					 big);
 	default:
 		throw std::invalid_argument("Unknown format.");
 	}
@@ -20,15 +20,18 @@
 // along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
 #include <chrono>
+#include <csignal>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <memory>
 #include <sstream>
 #include <string>
-#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -41,6 +44,7 @@
 #include <spherical_intersection/graph.h>
 #include <spherical_intersection/mesh_spherical.h>
 #include "timer.h"
+#include "worker_pool.h"
 
 namespace {
 bool help_is_requested = false;
@@ -55,6 +59,9 @@ bool input_format_is_set = false;
 double radius = 0.0;
 bool radius_is_set = false;
 
+std::vector<double> radii;
+bool radii_is_set = false;
+
 std::function<double(spherical_intersection::Graph &)> algorithm;
 bool algorithm_is_set = false;
 
@@ -67,6 +74,42 @@ bool thread_count_is_set = false;
 std::size_t max_thread_load;
 bool max_thread_load_is_set = false;
 
+//! @brief Number of vertices fetched at once by a worker. Small enough to
+//! balance vertices of very different cost, large enough to keep
+//! neighbouring vertices on one thread.
+constexpr std::size_t vertex_chunk_size = 16;
+
+//! @brief Set by SIGINT to stop the computation.
+volatile std::sig_atomic_t interrupt_signal = 0;
+
+void handle_interrupt(int) { interrupt_signal = 1; }
+
+//! @brief Converts a comma separated list of radii.
+//! @param radii_string the list.
+//! @return The radii in ascending order without duplicates.
+std::vector<double> parse_radii(const std::string &radii_string) {
+	std::vector<double> parsed_radii;
+	std::stringstream ss(radii_string);
+	std::string radius_string;
+	while (std::getline(ss, radius_string, ',')) {
+		double parsed_radius = 0.0;
+		std::stringstream radius_ss(radius_string);
+		if (!(radius_ss >> parsed_radius) || parsed_radius <= 0.0) {
+			throw std::invalid_argument("Invalid radius given.");
+		}
+		parsed_radii.push_back(parsed_radius);
+	}
+	if (parsed_radii.empty() ||
+	    parsed_radii.size() > std::numeric_limits<std::uint8_t>::max()) {
+		throw std::invalid_argument("Invalid number of radii given.");
+	}
+	std::sort(parsed_radii.begin(), parsed_radii.end());
+	parsed_radii.erase(
+	    std::unique(parsed_radii.begin(), parsed_radii.end()),
+	    parsed_radii.end());
+	return parsed_radii;
+}
+
 void set_parser_up(Input_Parser &input_parser) {
 	input_parser.add_flag(help_is_requested, "-help", "Displays help.");
 
@@ -94,6 +137,15 @@ void set_parser_up(Input_Parser &input_parser) {
 	input_parser.add_value(radius, "-radius", "Sets the sphere radius.",
 			       &radius_is_set);
 
+	input_parser.add_value(
+	    radii, "-radii",
+	    "Sets several sphere radii separated by commas e.g. 0.5,1,2. All "
+	    "radii are evaluated in a single pass and written as feature "
+	    "vectors in ascending order of the radii. Replaces -radius.",
+	    &radii_is_set,
+	    std::function<std::vector<double>(const std::string &)>(
+		parse_radii));
+
 	std::function<std::function<double(spherical_intersection::Graph &)>(
 	    const std::string &string)>
 	    algorithm_conversion = [](const std::string &algorithm_name)
@@ -136,8 +188,8 @@ void set_parser_up(Input_Parser &input_parser) {
 
 	input_parser.add_value(
 	    max_thread_load, "-max_load",
-	    "Sets the maximum number of values to be calculated in each thread "
-	    "without notification.",
+	    "Sets the number of values to be calculated per thread between "
+	    "two progress notifications.",
 	    &max_thread_load_is_set);
 }
 
@@ -153,7 +205,7 @@ bool arguments_are_valid() {
 			  << std::endl;
 		result = false;
 	}
-	if (!radius_is_set) {
+	if (!radius_is_set && !radii_is_set) {
 		std::cout << "Error: No radius given. Use -help for help."
 			  << std::endl;
 		result = false;
@@ -183,60 +235,64 @@ bool arguments_are_valid() {
 	return result;
 }
 
+//! @brief Computes the values of the given algorithm for all vertices and
+//! all given radii.
+//! @param radii the radii in ascending order.
+//! @return radii.size() values per vertex, stored consecutively in the order
+//! of the radii.
 std::vector<double> compute_all_values(
-    const spherical_intersection::Mesh &mesh, double radius,
+    const spherical_intersection::Mesh &mesh,
+    const std::vector<double> &radii,
     std::function<double(spherical_intersection::Graph &graph)> algorithm,
     std::size_t thread_count) {
 	const auto &vertices = mesh.get_vertices();
 	std::size_t vertex_count = vertices.size();
-	std::vector<double> values(vertex_count);
-	auto set_range = [&vertices, &values, &algorithm, &radius](
-			     std::size_t start_index, std::size_t amount) {
-		for (std::size_t index = start_index;
-		     index < start_index + amount; index++) {
+	std::size_t radius_count = radii.size();
+	std::vector<double> values(vertex_count * radius_count);
+	worker_pool::Worker_Pool pool(thread_count);
+	std::vector<spherical_intersection::Graph> graphs(
+	    pool.get_thread_count());
+	auto set_range = [&vertices, &values, &algorithm, &radii, &graphs,
+			  radius_count](std::size_t begin, std::size_t end,
+					std::size_t worker_index) {
+		// one graph per worker, whose memory is reused for all its
+		// vertices. The spheres of a vertex are processed from the
+		// largest to the smallest, so the smaller ones are built
+		// within the neighbourhood just visited for the largest
+		// i.e. from cache and without growing the graph.
+		spherical_intersection::Graph &graph = graphs[worker_index];
+		for (std::size_t index = begin; index < end; index++) {
 			const auto &vertex = vertices[index];
-			spherical_intersection::math3d::Sphere sphere{
-			    vertex.get_location(), radius};
-			spherical_intersection::Graph graph{vertices[index],
-							    sphere};
-			values[index] = algorithm(graph);
+			for (std::size_t radius_index = radius_count;
+			     radius_index-- > 0;) {
+				spherical_intersection::math3d::Sphere sphere{
+				    vertex.get_location(), radii[radius_index]};
+				graph.assign(vertex, sphere);
+				values[index * radius_count + radius_index] =
+				    algorithm(graph);
+			}
 		}
 	};
 
-	std::size_t current_start_index = 0;
-	std::size_t load_per_thread = max_thread_load;
+	std::size_t notification_load = thread_count * max_thread_load;
+	std::size_t next_notification = notification_load;
 	std::cout << std::endl;
-	while (thread_count * load_per_thread <
-	       vertex_count - current_start_index) {
-		std::vector<std::thread> threads;
-		for (std::size_t thread_idx = 0; thread_idx < thread_count;
-		     thread_idx++) {
-			threads.emplace_back(set_range, current_start_index,
-					     load_per_thread);
-			current_start_index += load_per_thread;
-		}
-		for (auto &thread : threads) {
-			thread.join();
-		}
-		std::cout << (100.0 * current_start_index) / vertex_count << "%"
-			  << std::endl;
-	}
-
-	std::vector<std::thread> threads;
-	load_per_thread = (vertex_count - current_start_index) / thread_count;
-	std::size_t load_for_last_thread =
-	    ((vertex_count - current_start_index) / thread_count) +
-	    ((vertex_count - current_start_index) % thread_count);
-	for (std::size_t thread_idx = 0; thread_idx < thread_count - 1;
-	     thread_idx++) {
-		threads.emplace_back(set_range, current_start_index,
-				     load_per_thread);
-		current_start_index += load_per_thread;
-	}
-	threads.emplace_back(set_range, current_start_index,
-			     load_for_last_thread);
-	for (auto &thread : threads) {
-		thread.join();
+	bool is_complete = pool.run(
+	    vertex_count, vertex_chunk_size, set_range,
+	    [vertex_count, notification_load,
+	     &next_notification](std::size_t done_count) {
+		    if (notification_load > 0 &&
+			done_count >= next_notification) {
+			    std::cout << (100.0 * done_count) / vertex_count
+				      << "%" << std::endl;
+			    next_notification =
+				(done_count / notification_load + 1) *
+				notification_load;
+		    }
+		    return interrupt_signal == 0;
+	    });
+	if (!is_complete) {
+		return values;
 	}
 	std::cout << "100%" << std::endl;
 	return values;
@@ -278,27 +334,50 @@ int main(int argc, char *argv[]) {
 		    vertex_location[0], vertex_location[1],
 		    vertex_location[2]});
 	}
-	for (const auto &triangle_indices : object_information.second) {
-		const auto &vertices = mesh.get_vertices();
-		mesh.add_triangle(vertices[triangle_indices[0]],
-				  vertices[triangle_indices[1]],
-				  vertices[triangle_indices[2]]);
-	}
+	mesh.add_triangles(object_information.second);
 	std::cout << "Done!" << std::endl;
 
+	if (!radii_is_set) {
+		radii = {radius};
+	}
+
 	std::cout << "Computing values... " << std::flush;
+	std::signal(SIGINT, handle_interrupt);
 	timer::Timer::start("computation");
-	auto values = compute_all_values(mesh, radius, algorithm, thread_count);
+	auto values = compute_all_values(mesh, radii, algorithm, thread_count);
 	timer::Timer::stop("computation");
+	std::signal(SIGINT, SIG_DFL);
+	if (interrupt_signal != 0) {
+		std::cout << "Interrupted!" << std::endl;
+		return 1;
+	}
 	std::cout << "Done!" << std::endl;
 
 	std::cout << "Computation speed: "
-		  << values.size() / timer::Timer::get("computation")
-		  << " vertices per second" << std::endl;
+		  << mesh.get_vertices().size() /
+			 timer::Timer::get("computation")
+		  << " vertices per second";
+	if (radii.size() > 1) {
+		std::cout << " for " << radii.size() << " radii";
+	}
+	std::cout << std::endl;
 
 	std::cout << "Exporting values... " << std::flush;
-	object_io::ply::save_ply(output_path, object_information, values,
-				 object_io::ply::Format::binary_little_endian);
+	if (radii.size() == 1) {
+		object_io::ply::save_ply(
+		    output_path, object_information, values,
+		    object_io::ply::Format::binary_little_endian);
+	} else {
+		// quality is the value of the smallest radius.
+		std::vector<double> qualities(mesh.get_vertices().size());
+		for (std::size_t index = 0; index < qualities.size(); index++) {
+			qualities[index] = values[index * radii.size()];
+		}
+		object_io::ply::save_ply(
+		    output_path, object_information, qualities, values,
+		    radii.size(),
+		    object_io::ply::Format::binary_little_endian);
+	}
 	std::cout << "Done!" << std::endl;
 
 	return 0;
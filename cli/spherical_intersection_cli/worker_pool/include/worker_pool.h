@@ -0,0 +1,99 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace worker_pool {
+//! @brief A fixed set of threads processing index ranges.
+//!
+//! The threads are created once and wait between the jobs. A job is the
+//! range [0, count), which is split into chunks. The threads fetch the
+//! chunks via an atomic cursor, so a slow chunk only delays the thread
+//! working on it instead of all threads.
+class Worker_Pool {
+      public:
+	//! @brief Processes the elements [begin, end). worker_index is within
+	//! [0, get_thread_count()) and can be used to address per-thread data.
+	using Task = std::function<void(std::size_t begin, std::size_t end,
+					std::size_t worker_index)>;
+	//! @brief Receives the number of finished elements. Returning false
+	//! cancels the job.
+	using Progress_Callback = std::function<bool(std::size_t done_count)>;
+
+      private:
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable job_available;
+	std::condition_variable job_done;
+
+	const Task *task = nullptr;
+	std::size_t count = 0;
+	std::size_t chunk_size = 1;
+	std::uint64_t generation = 0;
+	std::size_t active_workers = 0;
+	bool is_stopping = false;
+	std::exception_ptr error;
+
+	std::atomic<std::size_t> next_chunk{0};
+	std::atomic<std::size_t> done_count{0};
+	std::atomic<bool> is_cancelled{false};
+
+	void work(std::size_t worker_index);
+
+      public:
+	//! @brief Starts thread_count threads (at least one).
+	explicit Worker_Pool(std::size_t thread_count);
+	~Worker_Pool();
+	Worker_Pool(const Worker_Pool &) = delete;
+	Worker_Pool &operator=(const Worker_Pool &) = delete;
+
+	std::size_t get_thread_count() const;
+
+	//! @brief Applies the task to all chunks of [0, count) and blocks until
+	//! all of them are done or the job was cancelled. The progress callback
+	//! is called from the calling thread once per progress_interval.
+	//! Exceptions thrown by the task cancel the job and are rethrown.
+	//! @return false, if the job was cancelled. In this case an unknown
+	//! subset of the chunks was processed.
+	bool run(std::size_t count, std::size_t chunk_size, const Task &task,
+		 const Progress_Callback &progress = nullptr,
+		 std::chrono::milliseconds progress_interval =
+		     std::chrono::milliseconds(100));
+
+	//! @brief Lets the threads stop after their current chunk. May be
+	//! called from any thread while run is active.
+	void cancel();
+};
+} // namespace worker_pool
+
+#endif
@@ -0,0 +1,128 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "worker_pool.h"
+
+#include <algorithm>
+
+using namespace worker_pool;
+
+Worker_Pool::Worker_Pool(std::size_t thread_count) {
+	thread_count = std::max<std::size_t>(thread_count, 1);
+	threads.reserve(thread_count);
+	for (std::size_t worker_index = 0; worker_index < thread_count;
+	     worker_index++) {
+		threads.emplace_back(&Worker_Pool::work, this, worker_index);
+	}
+}
+
+Worker_Pool::~Worker_Pool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_stopping = true;
+	}
+	job_available.notify_all();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
+
+std::size_t Worker_Pool::get_thread_count() const { return threads.size(); }
+
+void Worker_Pool::work(std::size_t worker_index) {
+	std::uint64_t finished_generation = 0;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		job_available.wait(lock, [this, finished_generation] {
+			return is_stopping || generation != finished_generation;
+		});
+		if (is_stopping) {
+			return;
+		}
+		finished_generation = generation;
+		lock.unlock();
+
+		try {
+			while (!is_cancelled.load(std::memory_order_relaxed)) {
+				std::size_t begin = next_chunk.fetch_add(
+				    1, std::memory_order_relaxed) *
+						    chunk_size;
+				if (begin >= count) {
+					break;
+				}
+				std::size_t end =
+				    std::min(begin + chunk_size, count);
+				(*task)(begin, end, worker_index);
+				done_count.fetch_add(end - begin,
+						     std::memory_order_relaxed);
+			}
+		} catch (...) {
+			is_cancelled = true;
+			std::lock_guard<std::mutex> error_lock(mutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+
+		lock.lock();
+		if (--active_workers == 0) {
+			job_done.notify_all();
+		}
+	}
+}
+
+bool Worker_Pool::run(std::size_t count, std::size_t chunk_size,
+		      const Task &task, const Progress_Callback &progress,
+		      std::chrono::milliseconds progress_interval) {
+	std::unique_lock<std::mutex> lock(mutex);
+	this->task = &task;
+	this->count = count;
+	this->chunk_size = std::max<std::size_t>(chunk_size, 1);
+	next_chunk = 0;
+	done_count = 0;
+	is_cancelled = false;
+	error = nullptr;
+	active_workers = threads.size();
+	generation++;
+	job_available.notify_all();
+
+	while (!job_done.wait_for(lock, progress_interval,
+				  [this] { return active_workers == 0; })) {
+		if (progress) {
+			// the callback may take a while e.g. for output.
+			lock.unlock();
+			if (!progress(done_count.load())) {
+				cancel();
+			}
+			lock.lock();
+		}
+	}
+	this->task = nullptr;
+	if (error) {
+		std::exception_ptr job_error = error;
+		error = nullptr;
+		std::rethrow_exception(job_error);
+	}
+	return !is_cancelled;
+}
+
+void Worker_Pool::cancel() { is_cancelled = true; }
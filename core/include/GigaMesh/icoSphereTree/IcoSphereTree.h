@@ -26,6 +26,7 @@
 #include <vector>
 #include <memory>
 #include <array>
+#include <cstdint>
 #include <unordered_set>
 
 struct IcoSphereTreeFaceNode
@@ -43,6 +44,8 @@ class IcoSphereTree
 		[[nodiscard]] std::vector<float> getVertices() const;
 
 		size_t getNearestVertexIndexAt(const Vector3D& position) const;
+		//same result as getNearestVertexIndexAt, but without ray casting. Directions exactly along a vertex always yield this vertex.
+		size_t getNearestVertexIndexDirect(const Vector3D& direction) const;
 
 		//returns true if ray intersects icosphere. If true, the index of the nearest vertex is stored in 'index'
 		//last parameter toggles, if vertices "behind" the ray should also be considered
@@ -57,18 +60,40 @@ class IcoSphereTree
 		bool isSelected(size_t index) const;
 
 		void incData(size_t index, double value = 1.0);
+		//bins count normals given as xyz-triplets weighted by their length - not-a-number is skipped
+		void incDataFromNormals(const float* normalsXYZ, size_t count);
+		void incDataFromNormals(const double* normalsXYZ, size_t count);
 		double getMaxData() const;
 
 		std::vector<double>* getVertexDataP() { return &mVertexData;}
 
 	private:
 		void subdivide(unsigned int subdivisions = 1);
+		void buildFlatFaces();
+		void buildDirectionLookup();
+		size_t getRootFaceIndex(const double* direction) const;
+		size_t getChildFaceIndex(const double* direction, size_t faceIdx, size_t level) const;
+		size_t getLookupCellIndex(const double* direction) const;
+		template<typename T>
+		void incDataFromNormalsT(const T* normalsXYZ, size_t count);
 
 		std::array<IcoSphereTreeFaceNode, 20> mRootFaces;
 		std::vector<Vector3D> mVertices;
 		std::vector<double> mVertexData;	//function-value associated to this bucket => num normals in this bucket
 		std::unordered_set<size_t> mSelectedVertices;
 
+		//faces of all levels in breadth-first order as vertex index triplets. The four children of face i
+		//of a level start at mFlatLevelOffsets[level+1] + 4 * (i - mFlatLevelOffsets[level]).
+		std::vector<uint32_t> mFlatFaceVertices;
+		std::vector<size_t> mFlatLevelOffsets;
+		std::vector<double> mFlatVertexCoords; //xyz-triplets of mVertices
+
+		//cube map of directions with mLookupResolution^2 cells per side. Each cell holds the deepest face of mFlatFaceVertices
+		//containing the whole cell, so that the search for the leaf can start there. UINT32_MAX, when the cell spans several root faces.
+		static constexpr unsigned int mLookupResolution = 64;
+		std::vector<uint32_t> mLookupFaces;
+		std::vector<uint8_t> mLookupLevels;
+
 		double mMaxData = 0;
 };
 
@@ -0,0 +1,176 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AFFINETRANSFORM_H
+#define AFFINETRANSFORM_H
+
+#include <cstdint>
+
+#include <GigaMesh/mesh/matrix4d.h>
+
+//!
+//! \brief Affine transformation as 3x4 matrix for batches of coordinates. (Layer 0)
+//!
+//! Compact form of a Matrix4D without the projective row. The coefficients
+//! are kept in a plain array of the template type, so that the loops over
+//! contiguous blocks of coordinates (float or double) can be vectorized by
+//! the compiler. Coordinates are given as interleaved arrays with a stride
+//! of 3 (xyz) or 4 (xyzw as used by Matrix4D::applyTo) - the homogeneous
+//! coordinate is not touched.
+//!
+//! The result is identical to Vector3D * Matrix4D for points (w=1) and
+//! directions (w=0), when the last row of the Matrix4D is ( 0 0 0 1 ).
+//!
+//! Layer 0
+//!
+
+template<typename tReal>
+class AffineTransform3x4 {
+	public:
+		//! Identity.
+		AffineTransform3x4() {
+			for( unsigned int i=0; i<12; i++ ) {
+				mCoeff[i] = ( i%5 == 0 ) ? 1 : 0;
+			}
+		}
+
+		//! Takes the upper 3x4 part of the given matrix - see Matrix4D::applyTo.
+		explicit AffineTransform3x4( const Matrix4D& rMat ) {
+			for( int row=0; row<3; row++ ) {
+				mCoeff[row*4]   = static_cast<tReal>( rMat.getX( row ) );
+				mCoeff[row*4+1] = static_cast<tReal>( rMat.getY( row ) );
+				mCoeff[row*4+2] = static_cast<tReal>( rMat.getZ( row ) );
+				mCoeff[row*4+3] = static_cast<tReal>( rMat.getH( row ) );
+			}
+		}
+
+		//! Transposed inverse of the linear part scaled by its determinant i.e. the cofactor
+		//! matrix without translation. Maps cross products of transformed edges:
+		//! ( A u ) x ( A v ) = cof( A ) ( u x v ) - so unnormalized face normals
+		//! can be transformed without recomputation and without division.
+		AffineTransform3x4 getCofactor() const {
+			const tReal* m = mCoeff;
+			AffineTransform3x4 cof;
+			cof.mCoeff[0]  = m[5]*m[10] - m[6]*m[9];
+			cof.mCoeff[1]  = m[6]*m[8]  - m[4]*m[10];
+			cof.mCoeff[2]  = m[4]*m[9]  - m[5]*m[8];
+			cof.mCoeff[4]  = m[2]*m[9]  - m[1]*m[10];
+			cof.mCoeff[5]  = m[0]*m[10] - m[2]*m[8];
+			cof.mCoeff[6]  = m[1]*m[8]  - m[0]*m[9];
+			cof.mCoeff[8]  = m[1]*m[6]  - m[2]*m[5];
+			cof.mCoeff[9]  = m[2]*m[4]  - m[0]*m[6];
+			cof.mCoeff[10] = m[0]*m[5]  - m[1]*m[4];
+			cof.mCoeff[3]  = 0;
+			cof.mCoeff[7]  = 0;
+			cof.mCoeff[11] = 0;
+			return( cof );
+		}
+
+		//! Transforms a single point in place.
+		inline void applyToPoint( tReal* rXYZ ) const {
+			const tReal vecX = rXYZ[0];
+			const tReal vecY = rXYZ[1];
+			const tReal vecZ = rXYZ[2];
+			rXYZ[0] = mCoeff[0]*vecX + mCoeff[1]*vecY + mCoeff[2]*vecZ  + mCoeff[3];
+			rXYZ[1] = mCoeff[4]*vecX + mCoeff[5]*vecY + mCoeff[6]*vecZ  + mCoeff[7];
+			rXYZ[2] = mCoeff[8]*vecX + mCoeff[9]*vecY + mCoeff[10]*vecZ + mCoeff[11];
+		}
+
+		//! Transforms a single direction in place i.e. without translation.
+		inline void applyToDirection( tReal* rXYZ ) const {
+			const tReal vecX = rXYZ[0];
+			const tReal vecY = rXYZ[1];
+			const tReal vecZ = rXYZ[2];
+			rXYZ[0] = mCoeff[0]*vecX + mCoeff[1]*vecY + mCoeff[2]*vecZ;
+			rXYZ[1] = mCoeff[4]*vecX + mCoeff[5]*vecY + mCoeff[6]*vecZ;
+			rXYZ[2] = mCoeff[8]*vecX + mCoeff[9]*vecY + mCoeff[10]*vecZ;
+		}
+
+		//! Transforms rCount points in place.
+		void applyToPoints( tReal* rCoords, const uint64_t rCount, const unsigned int rStride=3 ) const {
+			// Coefficients in locals to assure the compiler that they are not aliased by rCoords.
+			const tReal m0 = mCoeff[0], m1 = mCoeff[1], m2  = mCoeff[2],  m3  = mCoeff[3];
+			const tReal m4 = mCoeff[4], m5 = mCoeff[5], m6  = mCoeff[6],  m7  = mCoeff[7];
+			const tReal m8 = mCoeff[8], m9 = mCoeff[9], m10 = mCoeff[10], m11 = mCoeff[11];
+			for( uint64_t i=0; i<rCount; i++ ) {
+				tReal* xyz = rCoords + i*rStride;
+				const tReal vecX = xyz[0];
+				const tReal vecY = xyz[1];
+				const tReal vecZ = xyz[2];
+				xyz[0] = m0*vecX + m1*vecY + m2*vecZ  + m3;
+				xyz[1] = m4*vecX + m5*vecY + m6*vecZ  + m7;
+				xyz[2] = m8*vecX + m9*vecY + m10*vecZ + m11;
+			}
+		}
+
+		//! Transforms rCount points in place and extends the given bounding box
+		//! by the transformed points. Not-a-number is ignored for the bounding box.
+		void applyToPoints( tReal* rCoords, const uint64_t rCount, const unsigned int rStride,
+		                    tReal* rMinXYZ, tReal* rMaxXYZ ) const {
+			tReal minX = rMinXYZ[0], minY = rMinXYZ[1], minZ = rMinXYZ[2];
+			tReal maxX = rMaxXYZ[0], maxY = rMaxXYZ[1], maxZ = rMaxXYZ[2];
+			const tReal m0 = mCoeff[0], m1 = mCoeff[1], m2  = mCoeff[2],  m3  = mCoeff[3];
+			const tReal m4 = mCoeff[4], m5 = mCoeff[5], m6  = mCoeff[6],  m7  = mCoeff[7];
+			const tReal m8 = mCoeff[8], m9 = mCoeff[9], m10 = mCoeff[10], m11 = mCoeff[11];
+			for( uint64_t i=0; i<rCount; i++ ) {
+				tReal* xyz = rCoords + i*rStride;
+				const tReal vecX = xyz[0];
+				const tReal vecY = xyz[1];
+				const tReal vecZ = xyz[2];
+				const tReal newX = m0*vecX + m1*vecY + m2*vecZ  + m3;
+				const tReal newY = m4*vecX + m5*vecY + m6*vecZ  + m7;
+				const tReal newZ = m8*vecX + m9*vecY + m10*vecZ + m11;
+				xyz[0] = newX;
+				xyz[1] = newY;
+				xyz[2] = newZ;
+				// Comparison as in Mesh::estBoundingBox - false for not-a-number.
+				minX = ( newX < minX ) ? newX : minX;
+				minY = ( newY < minY ) ? newY : minY;
+				minZ = ( newZ < minZ ) ? newZ : minZ;
+				maxX = ( newX > maxX ) ? newX : maxX;
+				maxY = ( newY > maxY ) ? newY : maxY;
+				maxZ = ( newZ > maxZ ) ? newZ : maxZ;
+			}
+			rMinXYZ[0] = minX; rMinXYZ[1] = minY; rMinXYZ[2] = minZ;
+			rMaxXYZ[0] = maxX; rMaxXYZ[1] = maxY; rMaxXYZ[2] = maxZ;
+		}
+
+		//! Transforms rCount directions in place i.e. without translation.
+		void applyToDirections( tReal* rCoords, const uint64_t rCount, const unsigned int rStride=3 ) const {
+			const tReal m0 = mCoeff[0], m1 = mCoeff[1], m2  = mCoeff[2];
+			const tReal m4 = mCoeff[4], m5 = mCoeff[5], m6  = mCoeff[6];
+			const tReal m8 = mCoeff[8], m9 = mCoeff[9], m10 = mCoeff[10];
+			for( uint64_t i=0; i<rCount; i++ ) {
+				tReal* xyz = rCoords + i*rStride;
+				const tReal vecX = xyz[0];
+				const tReal vecY = xyz[1];
+				const tReal vecZ = xyz[2];
+				xyz[0] = m0*vecX + m1*vecY + m2*vecZ;
+				xyz[1] = m4*vecX + m5*vecY + m6*vecZ;
+				xyz[2] = m8*vecX + m9*vecY + m10*vecZ;
+			}
+		}
+
+	private:
+		tReal mCoeff[12]; //!< Row-major 3x4 matrix: linear part in columns 0-2 and translation in column 3.
+};
+
+#endif // AFFINETRANSFORM_H
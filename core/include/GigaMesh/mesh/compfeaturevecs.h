@@ -43,6 +43,7 @@ struct sMeshDataStruct {
 	double* descriptSurface{nullptr}; //!< Surface descriptors
 	// and the voxel filter
 	voxelFilter2DElements** sparseFilters{nullptr};
+	voxelFilter2DMultiscale* multiscaleFilter{nullptr}; //!< Optional merged sparseFilters for a single pass over all scales.
 	// Collect compute time
 	int     mWallTimeThread{0};
 };
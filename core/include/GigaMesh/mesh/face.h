@@ -27,6 +27,7 @@
 #include <deque>
 
 #include "primitive.h"
+#include "affinetransform.h"
 
 class Plane;
 class EdgeGeodesic;
@@ -166,6 +167,7 @@ class Face : public Primitive {
 
 		// Transformation
 		virtual bool     applyTransfrom( Matrix4D* transMat ) override;
+		        double   applyAffineTransformToNormal( const AffineTransform3x4<double>& rCofactor );
 		        bool     applyReOrient();
 
 		// Labeling - common functions, inherited from Primitive.
@@ -0,0 +1,87 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FACEBVH_H
+#define FACEBVH_H
+
+#include <cstdint>
+#include <vector>
+
+//!
+//! \brief Bounding volume hierarchy of triangles for ray casting. (Layer 0)
+//!
+//! Built from plain arrays of vertex coordinates and vertex indices per
+//! triangle i.e. independent of the Face and Vertex classes. The nodes are
+//! stored depth-first in a single vector, so the left child directly follows
+//! its parent. The triangles are reordered, so that each leaf refers to a
+//! contiguous range.
+//!
+//! Rays with a common origin are traced as packets of up to PACKET_SIZE
+//! rays: a node is visited once for all rays of the packet, which are tested
+//! against its box by loops over the rays without branches. Only any-hit
+//! queries are supported as required for occlusion e.g. ambient occlusion.
+//!
+//! Layer 0
+//!
+
+class FaceBVH {
+	public:
+		//! Maximum number of rays per packet - see isOccludedPacket.
+		static constexpr unsigned int PACKET_SIZE = 8;
+
+		FaceBVH() = default;
+		~FaceBVH() = default;
+
+		bool     build( const std::vector<double>& rVertexCoords, const std::vector<uint64_t>& rFaceVertexIndices,
+		                unsigned int rMaxLeafSize=4 );
+		uint64_t getFaceNr() const;
+		uint64_t getNodeNr() const;
+
+		bool     isOccluded( const double* rOrigin, const double* rDirection, double rTMin, double rTMax,
+		                     uint64_t rIgnoreVertexIdx ) const;
+		uint32_t isOccludedPacket( const double* rOrigin, const double* rDirections, unsigned int rRayCount,
+		                           double rTMin, double rTMax, uint64_t rIgnoreVertexIdx ) const;
+
+	private:
+		//! Node of the hierarchy.
+		struct sNode {
+			double   mMin[3];    //!< Lower corner of the axis aligned bounding box.
+			double   mMax[3];    //!< Upper corner of the axis aligned bounding box.
+			uint64_t mFirst;     //!< Leaf: index of the first triangle. Inner node: index of the right child.
+			uint64_t mCount;     //!< Leaf: number of triangles. Zero for inner nodes.
+		};
+		//! Triangle prepared for the intersection test of Moeller and Trumbore.
+		struct sTriangle {
+			double   mVertA[3];       //!< Position of the first vertex.
+			double   mEdgeAB[3];      //!< Edge from the first to the second vertex.
+			double   mEdgeAC[3];      //!< Edge from the first to the third vertex.
+			uint64_t mVertexIdx[3];   //!< Indices of the vertices to skip triangles adjacent to the origin of a ray.
+		};
+
+		uint64_t buildNode( std::vector<uint64_t>& rFaceOrder, const std::vector<double>& rCentroids,
+		                    const std::vector<double>& rVertexCoords, const std::vector<uint64_t>& rFaceVertexIndices,
+		                    uint64_t rBegin, uint64_t rEnd, unsigned int rMaxLeafSize );
+
+		std::vector<sNode>     mNodes;      //!< Nodes depth-first i.e. the root is the first node.
+		std::vector<sTriangle> mTriangles;  //!< Triangles in the order of the leaves.
+};
+
+#endif // FACEBVH_H
@@ -0,0 +1,79 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FEATUREVECSTORE_H
+#define FEATUREVECSTORE_H
+
+#include <cstdint>
+#include <vector>
+
+//!
+//! \brief Contiguous matrix of feature vectors. (Layer 0)
+//!
+//! Holds the feature vectors of all vertices of a mesh as one row-major
+//! matrix i.e. one row per vertex. The vertices keep views into their
+//! rows (see Vertex::setFeatureVecView), so there is a single allocation
+//! instead of one per vertex. Buffers computed elsewhere e.g. by the MSII
+//! filter can be adopted without copying.
+//!
+//! The distances of all rows to a reference vector are computed in
+//! parallel by loops over the contiguous rows, which are unrolled with
+//! independent partial sums, so that they can be vectorized. Weighted
+//! distances i.e. Mahalanobis-like quadratic forms reuse one weight matrix
+//! for all rows.
+//!
+//! Layer 0
+//!
+
+class FeatureVecStore {
+	public:
+		//! Distance measures - see Vertex::getFeatureDist* and Vertex::getFeatureVec*.
+		enum eFeatureDistance {
+			FEATURE_DIST_MANHATTAN,        //!< 1-norm of the difference.
+			FEATURE_DIST_EUCLIDEAN,        //!< 2-norm of the difference.
+			FEATURE_DIST_EUCLIDEAN_NORM,   //!< 2-norm of the difference divided by the standard deviation of the elements.
+			FEATURE_DIST_COSINE_ACOS,      //!< Arccosine of the cosine similarity.
+			FEATURE_DIST_TANIMOTO          //!< Tanimoto distance.
+		};
+
+		FeatureVecStore() = default;
+		~FeatureVecStore() = default;
+
+		void     clear();
+		bool     adopt( std::vector<double>& rValues, uint64_t rFeatureVecLen );
+
+		bool     isEmpty() const;
+		uint64_t getFeatureVecLen() const;
+		uint64_t getRowCount() const;
+		double*  getRow( uint64_t rRowIdx );
+
+		bool     computeDistances( eFeatureDistance rDistance, const double* rReferenceVec,
+		                           std::vector<double>& rDistances,
+		                           const std::vector<double>* rFeatureVecStdDev=nullptr ) const;
+		bool     computeWeightedDistances( const double* rReferenceVec, const std::vector<double>& rWeightMatrix,
+		                                   std::vector<double>& rDistances ) const;
+
+	private:
+		std::vector<double> mValues;             //!< Row-major matrix of rows x mFeatureVecLen elements.
+		uint64_t            mFeatureVecLen = 0;  //!< Number of elements per row.
+};
+
+#endif // FEATUREVECSTORE_H
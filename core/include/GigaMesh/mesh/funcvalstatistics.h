@@ -0,0 +1,72 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FUNCVALSTATISTICS_H
+#define FUNCVALSTATISTICS_H
+
+#include <cstdint>
+#include <vector>
+
+class Vertex;
+
+//!
+//! \brief Cached statistics of the vertices' function values. (Layer 0)
+//!
+//! Holds the finite function values in a contiguous array to answer
+//! requests for minimum, maximum, quantiles and histograms without
+//! touching the vertices again. Quantiles are determined by selection
+//! (nth_element). After a few requests the array is sorted once, so that
+//! further quantiles e.g. while dragging the cut-off of the colormap are
+//! a lookup.
+//!
+//! Has to be invalidated, when the function values change, which is done
+//! by Mesh::changedVertFuncVal.
+//!
+//! Layer 0
+//!
+
+class FuncValStatistics {
+	public:
+		FuncValStatistics() = default;
+		~FuncValStatistics() = default;
+
+		void     invalidate();
+		bool     isValid( uint64_t rVertexCount ) const;
+		bool     update( const std::vector<Vertex*>& rVertices );
+
+		uint64_t getFiniteCount() const;
+		bool     getMinMax( double& rMinVal, double& rMaxVal ) const;
+		bool     getQuantile( double rQuantile, double& rValue );
+		bool     getHistogram( std::vector<unsigned int>& rBins, double& rMinVal, double& rMaxVal ) const;
+
+	private:
+		void     sortValues();
+
+		std::vector<double> mValues;             //!< Finite function values - unordered, partially ordered by selection or sorted.
+		uint64_t     mVertexCount    = 0;        //!< Number of vertices the statistics were computed for.
+		double       mMinVal         = 0.0;      //!< Smallest finite value.
+		double       mMaxVal         = 0.0;      //!< Largest finite value.
+		bool         mValid          = false;    //!< Flag signalling that the values are up-to-date.
+		bool         mSorted         = false;    //!< Flag signalling that mValues is sorted.
+		unsigned int mSelectionCount = 0;        //!< Number of quantiles determined by selection since the last update.
+};
+
+#endif // FUNCVALSTATISTICS_H
@@ -57,6 +57,8 @@
 #endif
 
 #include "meshinfodata.h"
+#include "funcvalstatistics.h"
+#include "featurevecstore.h"
 #include "meshio.h"
 #include "mesh_params.h"
 
@@ -84,6 +86,7 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		Mesh();
 		Mesh( const std::filesystem::path& rFileName, bool& rReadSuccess );
 		Mesh( std::set<Face*>* someFaces );
+		Mesh( std::vector<sVertexProperties>& rVertexProps, std::vector<sFaceProperties>& rFaceProps );
 		~Mesh();
 
 		// Menu handling
@@ -116,8 +119,12 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		        bool     writeFilesForConnectedComponents();
 		virtual bool     importFeatureVectorsFromFile( const std::filesystem::path& rFileName );
 		virtual bool     exportFeatureVectors( const std::filesystem::path& rFileName );
+		        bool     adoptFeatureVectors( std::vector<double>& rFeatureVecs, const uint64_t rFeatureVecLen );
 	private:
 		        bool     assignFeatureVectors( const std::vector<double>& rFeatureVecs, const uint64_t& rMaxFeatVecLen );
+		        bool     isFeatureVecStoreInUse();
+		        bool     estFeatureDistByStore( FeatureVecStore::eFeatureDistance rDistance, const double* rSomeFeatureVector,
+		                                        double** rFuncValues, Vertex*** rVertices, int* rVertCount );
 
 	public:
 		// IO Operations - overloaded from MeshSeed
@@ -303,6 +310,9 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		virtual bool   applyTransfromToPlane( Matrix4D rTransMat );
 		virtual bool   splitByPlane( Vector3D planeHNF, bool duplicateVertices = false, bool noRedraw = false );
 		virtual bool   splitByIsoLine( double rIsoVal, bool duplicateVertices = false, bool noRedraw = false, Vector3D rUniformOffset=Vector3D( 0.0, 0.0, 0.0, 0.0 ) );
+		        bool   splitByPlanes( Vector3D rPlaneHNF, const std::vector<double>& rDistances, bool rDuplicateVertices = false, bool rNoRedraw = false );
+		        bool   splitByIsoLines( const std::vector<double>& rIsoVals, bool rDuplicateVertices = false, bool rNoRedraw = false, Vector3D rUniformOffset=Vector3D( 0.0, 0.0, 0.0, 0.0 ) );
+		        bool   splitByLevels( const std::vector<double>& rVertexValues, const std::vector<double>& rLevels, bool rDuplicateVertices, bool rNoRedraw, Vector3D rUniformOffset );
 		virtual bool   splitMesh(const std::function<bool(Face*)>& intersectTest, const std::function<double(VertexOfFace*)>& signedDistanceFunction, const std::function<void(VertexOfFace*, VertexOfFace*, Vector3D&)>& getIntersectionVector, bool duplicateVertices = false, bool noRedraw = false, Vector3D rUniformOffset=Vector3D( 0.0, 0.0, 0.0, 0.0 ));
 
 				Plane::ePlaneDefinedBy getPlaneDefinition();
@@ -408,7 +418,7 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				bool         getDoubleCones( std::set<Vertex*>* rSomeVerts );
 				bool         getVertLabelAreaLargest( uint64_t& rLargestLabelId );
 				bool         getVertLabelAreaLT( double rAreaMax, std::set<Vertex*>* rSomeVerts );
-				bool         getVertLabelAreaRelativeLT( double rPercent, std::set<Vertex*>* rSomeVerts );
+				bool         getVertLabelAreaRelativeLT( double rPercent, std::set<Vertex*>* rSomeVerts, double* rAreaKeptMin=nullptr );
 				bool         getVertLabled( std::set<Vertex*>* rSomeVerts );
 				bool         getVertBorder( std::set<Vertex*>* rSomeVerts );
 				bool         getVertFaceMinAngleLT( double rMaxAngle, std::set<Vertex*>* rSomeVerts );
@@ -480,6 +490,8 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 
 		virtual bool compPolylinesIntInvRunLen( double rIIRadius, PolyLine::ePolyIntInvDirection rDirection );
 		virtual bool compPolylinesIntInvAngle( double rIIRadius );
+				bool compPolylinesIntInvRunLenRadii( const std::vector<double>& rRadii, PolyLine::ePolyIntInvDirection rDirection, std::vector<std::vector<double>>* rValues );
+				bool compPolylinesIntInv( const std::function<bool(unsigned int,PolyLine*)>& rCompute, bool rSetCogNormal=true );
 		virtual void getPolylineExtrema( bool absolut );
 		virtual bool setPolylinesNormalToVert();
 				bool planeIntersectionToPolyline();
@@ -487,6 +499,7 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				bool isolineToPolylineMultiple();
 		virtual bool isolineToPolyline();
 		virtual bool isolineToPolyline( double rIsoValue, Plane* rPlaneIntersect=nullptr );
+				bool isolinesToPolylines( const std::vector<double>& rIsoValues, Plane* rPlaneIntersect=nullptr );
 		virtual bool extrudePolylines();
 				bool labelVertSurface( uint64_t& rlabelsNr, double** rArea );
 				bool labelFacesVert( std::set<Face*>** rLabelFaces, uint64_t& rlabelsNr );
@@ -537,6 +550,12 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 			FEATURE_VECTOR_PNORM_WEIGTH_LINEAR,
 			FEATURE_VECTOR_PNORM_WEIGTH_QUADRATIC,
 			FEATURE_VECTOR_PNORM_WEIGTH_CUBIC
+		};
+		//! Descriptors of the intersection of a sphere with the mesh - see Mesh::computeSphereDescriptors.
+		enum eSphereDescriptor {
+			SPHERE_DESCRIPTOR_SURFACE_LENGTH         = 1, //!< Normalized arc length - see funcVertSphereSurfaceLength.
+			SPHERE_DESCRIPTOR_VOLUME_AREA            = 2, //!< Normalized area - see funcVertSphereVolumeArea.
+			SPHERE_DESCRIPTOR_NUMBER_OF_COMPONENTS   = 4  //!< Number of components - see funcVertSphereSurfaceNumberOfComponents.
 		};
 		        bool funcVertMedianOneRingUI( bool rPreferMeanOverMedian );
 				bool funcVertMedianOneRing( unsigned int rIterations=1, double rFilterSize=0.0, bool rPreferMeanOverMedian=true, bool rStoreDiffAsFeatureVec=false );
@@ -550,19 +569,24 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		virtual bool funcVertFeatureVecMinSigned();
 		virtual bool funcVertFeatureVecMaxSigned();
 		virtual bool funcVertFeatureVecMahalDist();
+		virtual bool funcVertFeatureVecMahalDist( const std::vector<double>& rReferenceVector, eFuncFeatureVecPNormWeigth rWeigthType );
 		virtual bool funcVertFeatureVecPNorm();
 		virtual bool funcVertFeatureVecPNorm( const std::vector<double>& rReferenceVector, const double& rpNorm, eFuncFeatureVecPNormWeigth rWeigthType );
 		virtual bool funcVertFeatureVecElementByIndex( unsigned int rElementNr );
 		virtual bool funcVertDistanceToPlane( Vector3D rPlaneHNF, bool rAbsDist, bool rSilent=false );
 				bool funcVertAddLight( Matrix4D &rTransformMat, unsigned int rArrayWidth, unsigned int rArrayHeight, const std::vector<float>& rDepths, float rZTolerance );
+				bool funcVertAmbientOcclusionRayCast( unsigned int rNumberOfDirections, double rZTolerance );
 				bool funcVertSphereSurfaceLength();
 				bool funcVertSphereVolumeArea();
 				bool funcVertSphereSurfaceNumberOfComponents();
+				bool funcVertSphereDescriptors();
+				bool computeSphereDescriptors( const std::vector<double>& rRadii, unsigned int rDescriptors, std::vector<double>& rValues );
 				bool funcValToFeatureVector(unsigned int dim);
 		// Again some old style function value calls:
 				bool setVertFuncValCorrTo( std::vector<double>* rFeatVector );
 				bool setVertFuncValDistanceToSelPrim();
 				bool setVertFuncValDistanceTo( const Vector3D& rPos );
+				bool setVertFuncValFromCoarse( Mesh& rCoarse, const std::vector<uint64_t>& rFineToCoarse );
 		// Stubs for notification
 		virtual void changedFaceFuncVal();
 		virtual void changedVertFuncVal();
@@ -575,6 +599,9 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				bool   getFuncValuesMinMaxQuantil( double rMinQuantil, double rMaxQuantil, double& rMinVal, double& rMaxVal );
 				bool   getFuncValuesMinMaxInfNanFail( double& rMinVal, double& rMaxVal, int& rInfCount, int& rNanCount, int& rFailCount );
 				bool   getFuncValuesMinMaxInfNanFail( double& rMinVal, double& rMaxVal, Vertex*& rVertMin, Vertex*& rVertMax, int& rInfCount, int& rNanCount, int& rFailCount, uint64_t& rFiniteCount );
+	private:
+				bool   updateFuncValStatistics();
+	public:
 
 		// --- Mesh manipulation - GENERIC -------------------------------------------------------------------------------------------------------------
 		virtual bool   changedMesh();
@@ -583,14 +610,27 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		virtual bool   removeVerticesSelected();
 		        bool   removeUncleanSmall( const std::filesystem::path& rFileName, double rPercentArea, bool rApplyErosion );
 		private:
+		        //! Region checked by the incremental cleaning - see Mesh::completeRestore
+		        struct sCleaningRegion {
+		            bool              mWholeMesh   = true;            //!< Check all primitives. Otherwise only mVertices and their adjacent faces.
+		            std::set<Vertex*> mVertices;                      //!< In: vertices to check. Out: vertices next to removed primitives.
+		            double            mAreaKeptMin = _INFINITE_DBL_;  //!< Lower bound for the area of each connected component kept.
+		        };
 		        bool   removeUncleanSmallCore( const std::filesystem::path& rFileName, double rPercentArea, bool rApplyErosion, 
 		                                       uint64_t& rIterationCount );
+		        bool   removeUncleanSmallCore( const std::filesystem::path& rFileName, double rPercentArea, bool rApplyErosion,
+		                                       uint64_t& rIterationCount, sCleaningRegion& rRegion );
+		        bool   getVertLabelAreaRelativeLTRegion( double rPercent, const std::set<Vertex*>& rRegionVerts,
+		                                                 double& rAreaKeptMin, std::set<Vertex*>* rSomeVerts );
+		        bool   erodeBorderFaces( const std::set<Vertex*>* rRegionVerts, const std::function<bool(std::set<Face*>&)>& rRemoveFaces,
+		                                 std::set<Vertex*>& rVerticesEroded, uint64_t& rIterations );
 		public:
 		virtual bool   removeSyntheticComponents( const std::set<Vertex *> &rVerticesSeeds );
 		virtual bool   removeFacesSelected();
 				bool   removeFaces( std::set<Face*>* facesToRemove );            // removal of a list of faces
 		virtual bool   removeFacesZeroArea();
 				bool   removeFacesBorderErosion();
+		        bool   weldVertices( double rTolerance, VertexWelding::eAttributePolicy rPolicy, uint64_t& rMergedNr );
 		// --- Mesh manipulation - MESH POLISHING ------------------------------------------------------------------------------------------------------
 		virtual bool   completeRestore(); // AKA Mesh polishing
 		virtual bool   completeRestore( const std::filesystem::path& rFilename, double rPercentArea, bool rApplyErosion,
@@ -599,6 +639,17 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		virtual bool   insertVerticesEnterManual();
 		virtual bool   insertVerticesCoordTriplets( std::vector<double>* rCoordTriplets );
 		virtual bool   insertVertices( std::vector<Vertex*>* rNewVertices );
+		// --- Mesh manipulation - Batched edits i.e. transactions -------------------------------------------------------------------------------------
+		        bool   editBegin();
+		        bool   editRemoveVertices( const std::set<Vertex*>& rVerticesToRemove );
+		        bool   editRemoveFaces( const std::set<Face*>& rFacesToRemove );
+		        bool   editInsertVertices( const std::vector<Vertex*>& rNewVertices );
+		        bool   editInsertFaces( const std::vector<Face*>& rNewFaces );
+		virtual bool   editCommit();
+		        bool   isEditActive() const;
+		// --- Mesh manipulation - SIMPLIFICATION ------------------------------------------------------------------------------------------------------
+		        bool   decimateQuadricError( uint64_t rTargetFaceNr, double rMaxError, std::vector<sVertexProperties>& rVertexProps,
+		                                     std::vector<sFaceProperties>& rFaceProps, std::vector<uint64_t>& rFineToCoarse );
 		// ---------------------------------------------------------------------------------------------------------------------------------------------
 
 		// mainly used to set the initial view (see objwidget)
@@ -664,6 +715,27 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 				                                  uint64_t rVertNrLongs, uint64_t* rVertBitArrayVisited,
 				                                  uint64_t rFaceNrLongs, uint64_t* rFaceBitArrayVisited,
 				                                  bool rOrderToFuncVal=false );
+		//! Neighbourhood of a vertex within a sphere as passed to the functor of Mesh::mapSphereNeighbourhoods.
+		//! Same faces as fetched by Mesh::fetchSphereBitArray.
+		struct sSphereNeighbourhood {
+			Vertex*               mSeed = nullptr;  //!< Center of the sphere.
+			uint64_t              mSeedIdx = 0;     //!< Index of the center.
+			std::vector<Vertex*>  mVertices;        //!< Vertices within the sphere connected to the center - including the center.
+			std::vector<uint64_t> mFaceIndices;     //!< Indices of the faces adjacent to mVertices in ascending order.
+		};
+		//! Values of the faces within a sphere - see Mesh::estSphereNeighbourhoodStats.
+		enum eSphereNeighbourhoodStat {
+			SPHERE_STAT_FACE_ANGLE_MAX,          //!< Maximum angle between the face normals and the vertex normal.
+			SPHERE_STAT_FACE_MEAN_ANGLE_MAX,     //!< Maximum angle between the face normals and their mean.
+			SPHERE_STAT_FACE_MEAN_ANGLE_MEAN,    //!< Mean angle between the face normals and their mean i.e. mean normal deviation.
+			SPHERE_STAT_FACE_AREA,               //!< Area of the faces.
+			SPHERE_STAT_FACE_COUNT,              //!< Number of faces.
+			SPHERE_STAT_VERTEX_COUNT             //!< Number of vertices within the sphere.
+		};
+				bool       mapSphereNeighbourhoods( double rRadius,
+				                                    const std::function<void(const sSphereNeighbourhood&, unsigned int)>& rFunc );
+				bool       estSphereNeighbourhoodStats( double rRadius, const std::vector<eSphereNeighbourhoodStat>& rStats,
+				                                        std::vector<double>& rValues );
 
 			// Compute or estimate Multi-Scale Integral Invariants (MSII) ----------------------------------------------------------------------------------
 				double     fetchSphereCubeVolume25D( Vertex* seedVertex, std::set<Face*>*    facesInSphere, double radius, double* rasterArray, int cubeEdgeLengthInVoxels=256 );
@@ -692,6 +764,8 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		        Matrix4D rotateToZ( Vector3D directionVec );          // generate rotation matrix to transform mesh so that the given direction vector is paralllel to the z-axis
         virtual bool     applyTransformationToWholeMesh( Matrix4D rTrans, bool rResetNormals = true, bool rSaveTransMat = true );
         virtual bool     applyTransformation( Matrix4D rTrans, std::set<Vertex*>* rSomeVerts, bool rResetNormals = true, bool rSaveTransMat = true );
+        virtual bool     applyTransformationToVertices( const Matrix4D& rTrans, const std::vector<Vertex*>& rSomeVerts, const bool rAllVertices,
+		                                                const bool rResetNormals = true, const bool rSaveTransMat = true );
 		virtual bool     applyTransformationPlacement( eTranslate rType, Matrix4D* rAppliedMat=nullptr );
 		virtual bool     applyTransformationAxisToY( Matrix4D* rAppliedMat=nullptr );
 		virtual bool     applyTransformationDefaultViewMatrix( Matrix4D* rViewMatrix );
@@ -702,7 +776,7 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		// Surface normals
 		virtual bool     normalsVerticesChanged();
 		        bool     resetFaceNormals( double* rAreaTotal=nullptr );
-		        bool     resetVertexNormals();
+		        bool     resetVertexNormals( Vertex::eNormalWeighting rWeighting=Vertex::NORMAL_WEIGHT_AREA_ANGLE, float* rNormalsXYZ=nullptr );
 		        bool     normalsVerticesComputeSphere( double rRadius );
 
 		virtual bool     changedBoundingBox();
@@ -808,6 +882,17 @@ class Mesh : public Primitive, public MeshIO, public MeshParams,
 		//! \todo these values are only set, when a 3D-model is loaded, but NOT when feature vectors are added at a later time.
 		std::vector<double>        mVerticesFeatVecMean;   //!< Mean values of all the elements of feature std::vectors of the vertices.
 		std::vector<double>        mVerticesFeatVecStd;    //!< Standard deviation of all the elements of feature vectors of the vertices.
+		FuncValStatistics          mFuncValStatistics;     //!< Cached min, max, quantiles and histogram of the function values. Invalidated by changedVertFuncVal, which has to be called after any direct change of the function values.
+		FeatureVecStore            mFeatureVecStore;       //!< Contiguous feature vectors of the vertices, which hold views into its rows.
+		//! Pending batch of edits - see Mesh::editBegin and Mesh::editCommit.
+		struct sEditTransaction {
+			bool                 mActive          = false;  //!< Flag signalling an open transaction.
+			uint64_t             mVerticesRemoved = 0;      //!< Number of vertices tagged with FLAG_REMOVED.
+			uint64_t             mFacesRemoved    = 0;      //!< Number of faces tagged with FLAG_REMOVED.
+			std::vector<Vertex*> mVerticesNew;              //!< Vertices to be appended.
+			std::vector<Face*>   mFacesNew;                 //!< Faces to be appended.
+		};
+		sEditTransaction           mEdit;                  //!< Pending batch of removals and insertions.
 
 		//----------------------------------------------------------------------
 		// Selection of points for a plane:
@@ -151,6 +151,7 @@ class MeshParams {
 			FUNCVAL_SPHERE_SURFACE_LENGTH,             //!< Compute a normalized arc length of the intersection of a local part of the mesh surface with a sphere
 			FUNCVAL_SPHERE_VOLUME_AREA,                //!< Compute a normalized area of the intersection of a local part of the mesh volume with a sphere
 			FUNCVAL_SPHERE_SURFACE_NUMBER_OF_COMPONENTS,  //!< Compute the number of components of the intersection of a local part of the mesh surface with a sphere
+			FUNCVAL_SPHERE_DESCRIPTORS,                //!< Compute several of the above sphere intersection descriptors for several radii in a single pass and store them as feature vectors
 			EDIT_REMOVE_SELMFACES,                     //!< Remove selected faces (SelMFace).
 			EDIT_REMOVE_FACESZERO,                     //!< Call to remove face with zero area.
 			EDIT_REMOVE_FACES_BORDER_EROSION,          //!< Call to remove faces having three border vertices iterativly.
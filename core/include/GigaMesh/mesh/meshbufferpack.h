@@ -0,0 +1,118 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MESHBUFFERPACK_H
+#define MESHBUFFERPACK_H
+
+#include <cstdint>
+#include <vector>
+
+class Vertex;
+class Face;
+
+//!
+//! \brief Interleaved vertex and index buffers for rendering. (Layer 1)
+//!
+//! Packs the data of the vertices into one interleaved array and the
+//! vertex indices of (flagged) faces and vertices into index arrays, which
+//! can be uploaded as they are e.g. as OpenGL vertex buffer objects. This
+//! class does not depend on OpenGL, so a GUI layer only has to upload the
+//! arrays.
+//!
+//! The vertices are packed in parallel. When only some vertices change
+//! e.g. their color, only these are packed again and the range of changed
+//! elements is kept, so that only this range has to be uploaded. As the
+//! number of vertices has to remain the same, their border, non-manifold
+//! and double cone flags are kept, which are the most expensive to fetch.
+//! Changes can also be marked first and packed later by updateMarkedVertices,
+//! so that several changes between two uploads are packed only once.
+//!
+//! The index arrays are compacted in parallel by counting per block
+//! followed by an exclusive prefix sum - see parallelSelectBlocks.
+//!
+//! The indices of the vertices have to be set e.g. by Vertex::setIndex,
+//! because the faces refer to their vertices by Vertex::getIndex.
+//!
+//! Layer 1
+//!
+
+class MeshBufferPack {
+	public:
+		//! Bits of sVertexStripe::mFlags.
+		enum eStripeFlags {
+			STRIPE_FLAG_BORDER       = 1,   //!< Vertex along the border of the mesh.
+			STRIPE_FLAG_NON_MANIFOLD = 2,   //!< Vertex along a non-manifold edge.
+			STRIPE_FLAG_DOUBLE_CONE  = 4,   //!< Singular vertex.
+			STRIPE_FLAG_NOT_LABELED  = 8    //!< Vertex without label.
+		};
+		//! Interleaved vertex data i.e. one element of the vertex buffer.
+		//! The layout is the same as of MeshGL::grVertexStripeElment.
+		struct sVertexStripe {
+			float         mPosition[3];  //!< xyz-coordinate.
+			float         mNormal[3];    //!< Normal vector.
+			unsigned char mColor[4];     //!< Color information (RGBA).
+			float         mFuncVal;      //!< Function value.
+			float         mLabelID;      //!< Label number as float, which will be interpolated for faces i.e. non-integer values indicate faces along label borders.
+			float         mFlags;        //!< Sum of eStripeFlags as float, because the buffer data is normalized.
+		};
+
+		MeshBufferPack() = default;
+		~MeshBufferPack() = default;
+
+		void     clear();
+
+		// Interleaved vertex buffer:
+		bool     packVertices( const std::vector<Vertex*>& rVertices, const std::vector<Face*>& rFaces );
+		bool     updateVertices( const std::vector<Vertex*>& rVertices, const std::vector<Face*>& rFaces,
+		                         uint64_t rBegin, uint64_t rEnd );
+		bool     updateVertices( const std::vector<Vertex*>& rVertices, const std::vector<Face*>& rFaces,
+		                         const std::vector<uint64_t>& rVertexIndices );
+		void     markVerticesChanged( uint64_t rBegin, uint64_t rEnd );
+		void     markVerticesChanged( const std::vector<uint64_t>& rVertexIndices );
+		bool     updateMarkedVertices( const std::vector<Vertex*>& rVertices, const std::vector<Face*>& rFaces );
+		const std::vector<sVertexStripe>& getVertexStripes() const;
+		bool     getChangedRange( uint64_t* rBegin, uint64_t* rEnd ) const;
+		void     clearChangedRange();
+
+		static bool fetchVertex( Vertex* rVertex, sVertexStripe* rWriteTo, bool rFetchTopology=true );
+
+		// Index buffers:
+		static void packFaceIndices( const std::vector<Face*>& rFaces, std::vector<uint32_t>& rIndices );
+		static void packFaceIndicesWithFlag( const std::vector<Face*>& rFaces, uint64_t rFlagNr,
+		                                     std::vector<uint32_t>& rIndices );
+		static void packVertexIndicesWithFlag( const std::vector<Vertex*>& rVertices, uint64_t rFlagNr,
+		                                       std::vector<uint32_t>& rIndices );
+
+	private:
+		static void prepareFaceNormals( const std::vector<Face*>& rFaces );
+		bool        fetchVertices( const std::vector<Vertex*>& rVertices, const std::vector<Face*>& rFaces,
+		                           uint64_t rFirst, uint64_t rCount, const uint64_t* rVertexIndices, bool rFetchTopology );
+
+		std::vector<sVertexStripe> mVertexStripes;     //!< One element per vertex.
+		uint64_t                   mChangedBegin = 0;  //!< First changed element.
+		uint64_t                   mChangedEnd   = 0;  //!< Behind the last changed element i.e. equal to mChangedBegin, when nothing changed.
+		uint64_t                   mMarkedBegin  = 0;  //!< First element marked by markVerticesChanged.
+		uint64_t                   mMarkedEnd    = 0;  //!< Behind the last marked element of the range i.e. equal to mMarkedBegin, when no range was marked.
+		std::vector<uint64_t>      mMarkedIndices;     //!< Marked elements outside of the marked range.
+};
+
+#endif // MESHBUFFERPACK_H
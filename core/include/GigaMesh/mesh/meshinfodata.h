@@ -23,8 +23,12 @@
 #define MESHINFODATA_H
 
 #include <string>
+#include <vector>
 #include <filesystem>
 
+struct sVertexProperties;
+struct sFaceProperties;
+
 class MeshInfoData {
 	public:
 		MeshInfoData();
@@ -112,6 +116,10 @@ class MeshInfoData {
 	public:
 		void reset();
 
+		// Fast mode without mesh structure
+		bool fetchPrimitiveProperties( const std::vector<sVertexProperties>& rVertexProps,
+		                               const std::vector<sFaceProperties>&   rFaceProps );
+
 		// Fetch formatted text
 		bool getMeshInfoTTL(  std::string& rInfoTTL  );
 		bool getMeshInfoHTML( std::string& rInfoHTML );
@@ -24,6 +24,7 @@
 
 #include "meshseedext.h"
 #include <GigaMesh/mesh/MeshIO/ModelMetaData.h>
+#include <GigaMesh/mesh/vertexwelding.h>
 
 #include <list>
 
@@ -65,6 +66,9 @@ class MeshIO : public MeshSeedExt {
 		// Read:
 		virtual bool readFile( const std::filesystem::path& rFileName, std::vector<sVertexProperties>& rVertexProps, std::vector<sFaceProperties>& rFaceProps );
 		virtual bool readIsRegularGrid( bool* rIsGrid );
+		        void setImportWeldVertices( double rTolerance, VertexWelding::eAttributePolicy rPolicy=VertexWelding::ATTRIBUTES_FIRST );
+		        bool weldVertexProps( std::vector<sVertexProperties>& rVertexProps, std::vector<sFaceProperties>& rFaceProps,
+		                           double rTolerance, VertexWelding::eAttributePolicy rPolicy, uint64_t* rMergedNr=nullptr );
 
 
 		bool importTEXMap( const std::filesystem::path& rFileName, int* rNrLines, uint64_t** rRefToPrimitves, unsigned char** rTexMap );
@@ -89,10 +93,13 @@ class MeshIO : public MeshSeedExt {
 		virtual std::filesystem::path getFullName() const;
 
 		virtual bool writeIcoNormalSphereData(const std::filesystem::path& rFilename, const std::list<sVertexProperties>& rVertexProps, int subdivisions, bool sphereCoordinates = false);
+		        bool writeIcoNormalSphereData(const std::filesystem::path& rFilename, const std::vector<double>& rNormalsXYZ, int subdivisions, bool sphereCoordinates = false);
 
 	private:
 		std::array<bool, EXPORT_FLAG_COUNT>   mExportFlags; //!< Handles export options.
 		bool   mSystemIsBigEndian; //!< Flag for proper Byte ordering during write/read.
+		double mImportWeldTolerance = -1.0;                                        //!< Vertices within this distance are welded by readFile. Negative to disable.
+		VertexWelding::eAttributePolicy mImportWeldPolicy = VertexWelding::ATTRIBUTES_FIRST; //!< Policy for the attributes of vertices welded by readFile.
 
 		// File properties
 		std::filesystem::path mFileNameFull;      //!< Full name and path of the current file.
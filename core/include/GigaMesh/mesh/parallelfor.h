@@ -0,0 +1,169 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#ifdef THREADS
+    // Multithreading (CPU):
+    #include <thread>
+#endif
+
+//!
+//! \brief Minimal helpers for data parallel loops over primitives. (Layer 0)
+//!
+//! The range [0,rCount) is split into chunks, which are fetched by the
+//! threads via an atomic cursor i.e. dynamic load balancing. The functor is
+//! called as rFunc( rBegin, rEnd, rThreadIdx ), where rThreadIdx is within
+//! [0,getParallelThreadCount()) and can be used to address per-thread
+//! scratch memory or accumulators. Without THREADS the functor is called
+//! once for the whole range.
+//!
+//! Layer 0
+//!
+
+//! Number of threads used by parallelFor - at least one.
+inline unsigned int getParallelThreadCount() {
+#ifdef THREADS
+	return std::max( 1U, std::thread::hardware_concurrency() );
+#else
+	return 1;
+#endif
+}
+
+//! Applies rFunc to consecutive chunks of [0,rCount).
+//! @param rChunkSize number of elements per chunk. Zero chooses a size providing ~8 chunks per thread.
+template<typename tFunc>
+void parallelFor( const uint64_t rCount, tFunc&& rFunc, uint64_t rChunkSize=0 ) {
+	if( rCount == 0 ) {
+		return;
+	}
+	const unsigned int threadCount = getParallelThreadCount();
+	if( rChunkSize == 0 ) {
+		rChunkSize = std::max( static_cast<uint64_t>(1024), rCount / ( 8 * static_cast<uint64_t>(threadCount) ) + 1 );
+	}
+#ifdef THREADS
+	const uint64_t chunkCount = ( rCount + rChunkSize - 1 ) / rChunkSize;
+	const unsigned int threadsUsed = static_cast<unsigned int>( std::min( static_cast<uint64_t>(threadCount), chunkCount ) );
+	if( threadsUsed <= 1 ) {
+		rFunc( static_cast<uint64_t>(0), rCount, 0U );
+		return;
+	}
+	std::atomic<uint64_t> nextChunk{ 0 };
+	auto worker = [&]( const unsigned int rThreadIdx ) {
+		for( uint64_t chunkIdx = nextChunk++; chunkIdx < chunkCount; chunkIdx = nextChunk++ ) {
+			const uint64_t begin = chunkIdx * rChunkSize;
+			rFunc( begin, std::min( begin + rChunkSize, rCount ), rThreadIdx );
+		}
+	};
+	std::vector<std::thread> threads;
+	threads.reserve( threadsUsed - 1 );
+	for( unsigned int t=1; t<threadsUsed; t++ ) {
+		threads.emplace_back( worker, t );
+	}
+	worker( 0 ); // the calling thread takes part.
+	for( auto& currThread : threads ) {
+		currThread.join();
+	}
+#else
+	rFunc( static_cast<uint64_t>(0), rCount, 0U );
+#endif
+}
+
+//! Block size used for the parallel compaction of rCount elements - at least 4096 to keep the overhead per block low.
+inline uint64_t getParallelBlockSize( const uint64_t rCount ) {
+	return( std::max( static_cast<uint64_t>(4096), rCount / ( 8 * static_cast<uint64_t>( getParallelThreadCount() ) ) + 1 ) );
+}
+
+//! Evaluates rSelect( i ) once for each i within [0,rCount) in parallel blocks of rBlockSize and marks the
+//! selected elements in rSelected. The counts per block are summed up to an exclusive prefix sum, which
+//! provides the position of the first selected element of each block among all selected elements.
+//! So the elements of the blocks can be scattered in parallel - see parallelCompact.
+//! @returns the prefix sum having one entry per block followed by the total number of selected elements.
+template<typename tSelect>
+std::vector<uint64_t> parallelSelectBlocks( const uint64_t rCount, const uint64_t rBlockSize, tSelect&& rSelect,
+                                            std::vector<uint8_t>& rSelected ) {
+	const uint64_t blockCount = ( rCount + rBlockSize - 1 ) / rBlockSize;
+	rSelected.assign( rCount, 0 );
+	std::vector<uint64_t> blockOffset( blockCount+1, 0 );
+	parallelFor( rCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		uint64_t selectedCount = 0;
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			if( rSelect( i ) ) {
+				rSelected[i] = 1;
+				selectedCount++;
+			}
+		}
+		blockOffset[rBegin/rBlockSize+1] = selectedCount;
+	}, rBlockSize );
+	for( uint64_t b=0; b<blockCount; b++ ) {
+		blockOffset[b+1] += blockOffset[b];
+	}
+	return( blockOffset );
+}
+
+//! Stable removal of the elements fulfilling rRemove from rVec - like std::remove_if followed by erase.
+//! The elements to remove are counted per block by parallelSelectBlocks. The elements kept in front of
+//! a block are the elements in front of it minus the removed ones, so both are scattered in parallel.
+//! @param rRemoved optional vector, where the removed elements are appended in their original order.
+//! @returns the number of removed elements.
+template<typename T, typename tPred>
+uint64_t parallelCompact( std::vector<T>& rVec, tPred&& rRemove, std::vector<T>* rRemoved=nullptr ) {
+	const uint64_t elementCount = rVec.size();
+	if( elementCount == 0 ) {
+		return( 0 );
+	}
+	const uint64_t blockSize = getParallelBlockSize( elementCount );
+	// The predicate is evaluated once per element - it might be more expensive than a flag lookup.
+	std::vector<uint8_t> removeElement;
+	const std::vector<uint64_t> removedOffset = parallelSelectBlocks( elementCount, blockSize,
+	        [&]( uint64_t rIdx ) { return( static_cast<bool>( rRemove( rVec[rIdx] ) ) ); }, removeElement );
+	const uint64_t removedTotal = removedOffset.back();
+	if( removedTotal == 0 ) {
+		return( 0 );
+	}
+	std::vector<T> vecKept( elementCount - removedTotal );
+	const uint64_t removedFirst = ( rRemoved != nullptr ) ? rRemoved->size() : 0;
+	if( rRemoved != nullptr ) {
+		rRemoved->resize( removedFirst + removedTotal );
+	}
+	parallelFor( elementCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		const uint64_t blockIdx = rBegin / blockSize;
+		uint64_t keptPos    = rBegin - removedOffset[blockIdx];
+		uint64_t removedPos = removedFirst + removedOffset[blockIdx];
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			if( removeElement[i] == 0 ) {
+				vecKept[keptPos++] = rVec[i];
+			} else if( rRemoved != nullptr ) {
+				(*rRemoved)[removedPos++] = rVec[i];
+			}
+		}
+	}, blockSize );
+	rVec.swap( vecKept );
+	return( removedTotal );
+}
+
+#endif // PARALLELFOR_H
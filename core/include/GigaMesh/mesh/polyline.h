@@ -79,8 +79,10 @@ class PolyLine : public Vertex {
 		bool estCurvatureSmooth( double gaussWidth );
 		bool compIntInv( double rIIRadius, ePolyIntInvDirection rDirection );
 		bool compIntInv( int rVertNr, double rIIRadius, ePolyIntInvDirection rDirection );
+		bool compIntInvRadii( const std::vector<double>& rRadii, ePolyIntInvDirection rDirection, std::vector<double>* rValues );
 		bool compIntInvAngle( double rIIRadius );
 		bool compIntInvAngle( int rVertNr, double rIIRadius );
+		bool compIntInvAngleRadii( const std::vector<double>& rRadii, std::vector<double>* rValues );
 		bool getExtrema( std::set<Vertex*>* someVerts, double gaussWidth, bool absolut );
 		bool getNeighboursRunLen( int rVertNr, double rDist, std::vector<int>* rNeighVerts, std::vector<double>* rDists, std::vector<double>* rWeights );
 		size_t  getSafeIndex( size_t someIdx );
@@ -132,6 +134,8 @@ class PolyLine : public Vertex {
 		void  dumpRunLenMat();
 
 	private:
+		bool compIntInvSliding( const std::vector<double>& rRadii, ePolyIntInvDirection rDirection, bool rAngle, std::vector<double>* rValues );
+
 		std::vector<PolyEdge*> mEdgeList;     //!< List of Edgels of the polyline organized by a std::vector.
 
 		Plane*            mPlaneUsed;    //!< For intersections i.e. profile lines: Rember the plane used to compute this polygonal line.
@@ -193,7 +193,8 @@ class Primitive : public BitFlagArray  {
 			FLAG_MARCHING_FRONT_ABORT = BitFlagArray::FLAG_09,  //!< Flag used to tag Primitve's as abort criteria for a marching front.
 			FLAG_SELECTED             = BitFlagArray::FLAG_10,  //!< Flag used to tag Primitve's selected either by the user or a method.
 			FLAG_MANUAL               = BitFlagArray::FLAG_11,  //!< Flag used to tag a primitive added manually by an user.
-			FLAG_CIRCLE_CENTER        = BitFlagArray::FLAG_12   //!< Flag used to tag a vertex, which was computed from a circle matching method.
+			FLAG_CIRCLE_CENTER        = BitFlagArray::FLAG_12,  //!< Flag used to tag a vertex, which was computed from a circle matching method.
+			FLAG_REMOVED              = BitFlagArray::FLAG_13   //!< Flag used to tag a primitive to be removed by Mesh::editCommit. Reserved i.e. neither read from nor written to files.
 		};
 
 		// Common usefull functions
@@ -0,0 +1,119 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef QUADRICDECIMATION_H
+#define QUADRICDECIMATION_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+//!
+//! \brief Mesh decimation by edge collapses using quadric error metrics. (Layer 0)
+//!
+//! Garland and Heckbert: Surface Simplification Using Quadric Error Metrics,
+//! SIGGRAPH 1997. Built from plain arrays of vertex coordinates and vertex
+//! indices per triangle i.e. independent of the Face and Vertex classes.
+//!
+//! Half-edge collapses are used i.e. a vertex is merged into one of its
+//! neighbours, which keeps its position. Therefore the remaining vertices
+//! are a subset of the original vertices keeping all their properties like
+//! color, label and function value. Each removed vertex refers to the
+//! remaining vertex it was merged into - see getFineToCoarse - so results
+//! computed on the coarse mesh can be propagated back to the original mesh.
+//!
+//! The collapses are done in passes: the cheapest collapse of each vertex is
+//! estimated in parallel. Then the collapses are chosen by increasing costs,
+//! so that their adjacent faces do not overlap, which allows to apply them in
+//! parallel too.
+//!
+//! Borders are preserved: border vertices are only collapsed along border
+//! edges and constraint planes perpendicular to the border are added to their
+//! quadrics. Labels are preserved likewise: vertices are only merged with
+//! vertices of the same label and vertices along the border of a label are
+//! only merged with other vertices along the same border. Vertices along
+//! non-manifold edges are kept.
+//!
+//! Layer 0
+//!
+
+class QuadricDecimation {
+	public:
+		QuadricDecimation() = default;
+		~QuadricDecimation() = default;
+
+		bool     decimate( const std::vector<double>& rVertexCoords, const std::vector<uint64_t>& rFaceVertexIndices,
+		                   const std::vector<uint64_t>& rVertexLabels, uint64_t rTargetFaceNr,
+		                   double rMaxError=std::numeric_limits<double>::infinity() );
+
+		uint64_t getVertexNr() const;
+		uint64_t getFaceNr() const;
+		const std::vector<uint64_t>& getFaceVertexIndices() const;
+		const std::vector<uint64_t>& getCoarseToFine() const;
+		const std::vector<uint64_t>& getFineToCoarse() const;
+
+	private:
+		//! Symmetric 4x4 matrix of a quadric error metric stored as its upper triangle.
+		struct sQuadric {
+			double mA[10] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };   //!< a00, a01, a02, a11, a12, a22, b0, b1, b2, c.
+
+			void   addPlane( const double* rNormal, double rDist, double rWeight );
+			void   add( const sQuadric& rOther );
+			double eval( const double* rPos ) const;
+		};
+		//! Merge of the vertex mFrom into its neighbour mTo.
+		struct sCollapse {
+			double   mCost;       //!< Value of the sum of both quadrics at the position of mTo.
+			uint64_t mFrom;       //!< Index of the removed vertex.
+			uint64_t mTo;         //!< Index of the remaining vertex.
+			uint64_t mFacesNr;    //!< Number of removed faces i.e. faces adjacent to the edge.
+		};
+		//! Scratch memory per thread.
+		struct sScratch {
+			std::vector<uint64_t> mNeighbours;         //!< Neighbours of the vertex to collapse.
+			std::vector<uint64_t> mNeighbourFaces;     //!< Number of faces adjacent to the edges to mNeighbours.
+			std::vector<uint64_t> mOtherNeighbours;    //!< Neighbours of the candidate.
+			std::vector<uint64_t> mOtherFaces;         //!< Number of faces adjacent to the edges to mOtherNeighbours.
+		};
+
+		void     buildAdjacency();
+		void     collectNeighbours( uint64_t rVertIdx, std::vector<uint64_t>& rNeighbours, std::vector<uint64_t>& rFaceCounts ) const;
+		bool     isLabelBorder( uint64_t rVertIdx, const std::vector<uint64_t>& rNeighbours ) const;
+		void     initQuadric( uint64_t rVertIdx, sScratch& rScratch );
+		bool     findCollapse( uint64_t rVertIdx, sScratch& rScratch, sCollapse& rCollapse ) const;
+		bool     isFlipped( uint64_t rFrom, uint64_t rTo ) const;
+
+		const double*         mVertexCoords = nullptr;   //!< Coordinates of the original vertices during decimate.
+		const uint64_t*       mVertexLabels = nullptr;   //!< Optional labels of the original vertices during decimate.
+		std::vector<uint64_t> mFaces;                    //!< Vertex indices of the faces - changed by the collapses.
+		std::vector<uint8_t>  mFaceRemoved;              //!< Non-zero for faces removed by collapses.
+		std::vector<uint64_t> mAdjacencyOffset;          //!< Position of the first adjacent face of each vertex within mAdjacentFaces.
+		std::vector<uint64_t> mAdjacentFaces;            //!< Remaining faces adjacent to the vertices.
+		std::vector<sQuadric> mQuadrics;                 //!< Quadric per vertex.
+		std::vector<uint64_t> mMergedInto;               //!< Vertex, which a removed vertex was merged into. Remaining vertices refer to themselves.
+
+		std::vector<uint64_t> mCoarseFaces;              //!< Result: vertex indices of the remaining faces referring to the remaining vertices.
+		std::vector<uint64_t> mCoarseToFine;             //!< Result: index of the original vertex for each remaining vertex.
+		std::vector<uint64_t> mFineToCoarse;             //!< Result: index of the remaining vertex for each original vertex.
+};
+
+#endif // QUADRICDECIMATION_H
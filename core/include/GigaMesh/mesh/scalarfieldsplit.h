@@ -0,0 +1,115 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCALARFIELDSPLIT_H
+#define SCALARFIELDSPLIT_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//!
+//! \brief Splits triangles along level sets of a scalar field. (Layer 0)
+//!
+//! The field is given by a value per vertex and is linear within each
+//! triangle e.g. the signed distance to a plane or the function value.
+//! Built from plain arrays of vertex indices per triangle i.e. independent
+//! of the Face and Vertex classes. Any number of levels can be applied at
+//! once e.g. parallel planes cutting a mesh into slabs.
+//!
+//! The triangles are classified in parallel. A triangle is split, when one of
+//! its edges strictly crosses a level. Each crossing of an edge and a level
+//! results in exactly one new vertex (or two, when duplicated), which is
+//! shared by the triangles adjacent to the edge. The part of a triangle
+//! between two consecutive levels is a convex polygon, whose corners are the
+//! points along the border of the triangle within that range. These are
+//! triangulated as fan, so the orientation of the triangle is kept.
+//!
+//! Vertices exactly on a level are not considered as crossing. When vertices
+//! are duplicated, such vertices of split triangles are duplicated too.
+//!
+//! Layer 0
+//!
+
+class ScalarFieldSplit {
+	public:
+		//! New vertex on the edge between two vertices of the input.
+		struct sNewVertex {
+			uint64_t mVertA;   //!< Index of the first vertex of the edge.
+			uint64_t mVertB;   //!< Index of the second vertex of the edge. Equal to mVertA for duplicates of vertices on a level.
+			double   mT;       //!< Position on the edge i.e. zero at mVertA and one at mVertB.
+			int      mSide;    //!< Side of the level: +1 for the side of larger values, -1 for the other side and zero when not duplicated.
+		};
+		//! New triangle replacing a part of a triangle of the input.
+		struct sNewFace {
+			uint64_t      mFaceIdx;        //!< Index of the split triangle.
+			uint64_t      mVertIdx[3];     //!< Indices of the vertices: input vertices are below getVertexNr() and new vertices above.
+			unsigned char mCornerFrom[3];  //!< Corner (0,1,2) of the split triangle at the start of the edge of each vertex.
+			unsigned char mCornerTo[3];    //!< Corner (0,1,2) of the split triangle at the end of the edge of each vertex.
+			double        mCornerT[3];     //!< Position on these edges e.g. to interpolate texture coordinates.
+		};
+
+		ScalarFieldSplit() = default;
+		~ScalarFieldSplit() = default;
+
+		bool     split( const std::vector<double>& rVertexValues, const std::vector<uint64_t>& rFaceVertexIndices,
+		                const std::vector<double>& rLevels, bool rDuplicateVertices,
+		                const std::vector<unsigned char>* rFaceMask=nullptr );
+
+		uint64_t                       getVertexNr() const;
+		const std::vector<uint64_t>&   getSplitFaces() const;
+		const std::vector<sNewVertex>& getNewVertices() const;
+		const std::vector<sNewFace>&   getNewFaces() const;
+
+	private:
+		//! Point along the border of a triangle.
+		struct sBorderPoint {
+			double        mValue;      //!< Value of the field.
+			int64_t       mLevelIdx;   //!< Index of the level the point is on or -1.
+			uint64_t      mVertIdx;    //!< Index of the vertex - below the level when duplicated.
+			uint64_t      mVertIdxUp;  //!< Index of the vertex above the level when duplicated. Otherwise equal to mVertIdx.
+			unsigned char mCornerFrom; //!< Corner of the triangle at the start of the edge.
+			unsigned char mCornerTo;   //!< Corner of the triangle at the end of the edge.
+			double        mT;          //!< Position on the edge.
+		};
+
+		uint64_t getCrossings( double rValA, double rValB, uint64_t* rFirstLevel ) const;
+		bool     isSplit( uint64_t rFaceIdx ) const;
+		uint64_t findEdge( uint64_t rVertA, uint64_t rVertB ) const;
+		uint64_t findDuplicate( uint64_t rVertIdx ) const;
+		void     collectBorder( uint64_t rFaceIdx, std::vector<sBorderPoint>& rBorder ) const;
+		uint64_t triangulate( uint64_t rFaceIdx, const std::vector<sBorderPoint>& rBorder, sNewFace* rNewFaces ) const;
+
+		const double*            mValues = nullptr;       //!< Values of the field per vertex during split.
+		const uint64_t*          mFaces  = nullptr;       //!< Vertex indices of the triangles during split.
+		std::vector<double>      mLevels;                 //!< Sorted levels without duplicates.
+		bool                     mDuplicate = false;      //!< Flag for duplicated vertices along the levels.
+		uint64_t                 mVertexNr = 0;           //!< Number of input vertices.
+		std::vector<std::pair<uint64_t,uint64_t>> mEdges; //!< Sorted pairs of vertex indices of the crossed edges.
+		std::vector<uint64_t>    mEdgeFirstVertex;        //!< Index of the first new vertex per crossed edge.
+		std::vector<uint64_t>    mDuplicated;             //!< Sorted vertices on a level, which are duplicated.
+		uint64_t                 mDuplicatedFirst = 0;    //!< Index of the first new vertex of the duplicated vertices.
+		std::vector<uint64_t>    mSplitFaces;             //!< Indices of the split triangles.
+		std::vector<sNewVertex>  mNewVertices;            //!< New vertices.
+		std::vector<sNewFace>    mNewFaces;               //!< New triangles.
+};
+
+#endif // SCALARFIELDSPLIT_H
@@ -23,6 +23,7 @@
 #define VERTEX_H
 
 #include "primitive.h"
+#include "affinetransform.h"
 
 #include <deque>
 #include <map>
@@ -51,6 +52,12 @@ class Vertex : public Primitive {
 			RGB_TO_GRAY_SATURATION_REMOVAL,
 			RGB_TO_GRAY_HSV_DECOMPOSITION,
 		};
+		//! Weights of the adjacent face normals for the vertex normal - see VertexOfFace::estNormalAvgAdjacentFaces
+		enum eNormalWeighting {
+			NORMAL_WEIGHT_AREA_ANGLE, //!< Area and angle at the vertex (default).
+			NORMAL_WEIGHT_AREA,       //!< Area of the faces.
+			NORMAL_WEIGHT_ANGLE,      //!< Angle at the vertex.
+		};
 
 		// Const- & destructor:
 		Vertex();
@@ -126,6 +133,7 @@ virtual bool     setAlpha(unsigned char alpha);
 		        bool     copyCoordsTo( double* rCoordArr );
 		        bool     copyVertexPropsTo( sVertexProperties& rVertexProps ) const;
 		virtual bool     estNormalAvgAdjacentFaces(); // ***
+		virtual bool     estNormalAvgAdjacentFaces( eNormalWeighting rWeighting, uint64_t& rFacesInvalid ); // ***
 		        bool     setNormal( double rNormX, double rNormY, double rNormZ );
 		        bool     setNormal( Vector3D* rNormal );
 		        bool     unsetNormal();
@@ -182,6 +190,7 @@ virtual bool     setAlpha(unsigned char alpha);
 		
 		// Transformation:
 		        bool     applyTransfrom( Matrix4D* transMat ) override;
+		        void     applyAffineTransform( const AffineTransform3x4<double>& rTrans );
 		        bool     applyMeltingSphere( double rRadius, double rRel=1.0 ) override;
         virtual Vertex*  applyNormalShift(float offsetDistance,int index);
 
@@ -278,6 +287,8 @@ virtual bool     setAlpha(unsigned char alpha);
 				unsigned int getFeatureVectorLen() override;
 				int          cutOffFeatureElements( double rMinVal, double rMaxVal, bool rSetToNotANumber );
 		virtual void         resizeFeatureVector(unsigned int size);
+				bool         setFeatureVecView( double* rFeatureVec, unsigned int rFeatureVecLen );
+				bool         isFeatureVecViewOf( const double* rFeatureVec ) const;
 		// Feature vector smoothing:
 		virtual bool     getFeatureVecMedianOneRing( std::vector<double>& rMedianValues, double rMinDist );
 		virtual bool     getFeatureVecMeanOneRing(   std::vector<double>& rMeanValues,   double rMinDist );
@@ -298,6 +309,8 @@ virtual bool     setAlpha(unsigned char alpha);
 		        void     dumpInfoAsDOT( std::string fileSuffix="" );
 
 private:
+		        void     freeFeatureVec();
+
 		// Position, Normal and Color:
 		double        mPosition[3];      //!< Position vector of the Vertex.
 		double        mNormalXYZ[3];     //!< Normal vector for the vertex - has to be initalized, e.g. by the average normal of adjacent faces.
@@ -311,6 +324,7 @@ private:
 		uint64_t      mLabelNr;          //!< Number of a label of connected mesh part. Label 0 means background. Default: _PRIMITIVE_NOT_LABLED_
 		// Feature vector:
 		unsigned int  mFeatureVecLen;    //!< Length of the Feature vector (e.g. from multi-scale volume integral)
+		bool          mFeatureVecView;   //!< Flag signalling that mFeatureVec is a row of the mesh's FeatureVecStore i.e. not owned by the Vertex.
 		double*       mFeatureVec;       //!< Feature vector (e.g. from multi-scale volume integral)
 };
 
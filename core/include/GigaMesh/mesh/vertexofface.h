@@ -37,6 +37,7 @@ class VertexOfFace : public Vertex {
 
 		// Value access:
 		virtual bool     estNormalAvgAdjacentFaces(); // ***
+		virtual bool     estNormalAvgAdjacentFaces( eNormalWeighting rWeighting, uint64_t& rFacesInvalid ); // ***
 		virtual double   get1RingArea(); // ***
 		virtual uint64_t get1RingFaceCount() const; // ***
 		virtual double   get1RingSumAngles(); // ***
@@ -0,0 +1,82 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef VERTEXWELDING_H
+#define VERTEXWELDING_H
+
+#include <cstdint>
+#include <vector>
+
+#include <GigaMesh/mesh/gmcommon.h>
+
+//!
+//! \brief Merges vertices within a given distance i.e. welding. (Layer 0)
+//!
+//! Built from a plain array of vertex coordinates i.e. independent of the
+//! Face and Vertex classes, so it can be applied to the primitives read from
+//! a file as well as to a mesh.
+//!
+//! The vertices are hashed into a grid with cells having the size of the
+//! tolerance. Each vertex is compared with the vertices of the 27 cells
+//! around it. The keys are computed, sorted and searched in parallel.
+//! The pairs of vertices within the tolerance are joined into clusters, so
+//! chains of close vertices are welded into one vertex. A tolerance of zero
+//! merges only vertices having identical coordinates. Vertices with
+//! coordinates being not-a-number are never merged.
+//!
+//! Each cluster is represented by its vertex with the lowest index. The
+//! welded vertices keep the order of their representatives.
+//!
+//! Layer 0
+//!
+
+class VertexWelding {
+	public:
+		//! Policy for the attributes of the welded vertices.
+		enum eAttributePolicy {
+			ATTRIBUTES_FIRST,   //!< Attributes of the representative i.e. the vertex with the lowest index.
+			ATTRIBUTES_MEAN     //!< Mean position, normal, color, function value and feature vector. Label and flags of the representative.
+		};
+
+		VertexWelding() = default;
+		~VertexWelding() = default;
+
+		bool     weld( const std::vector<double>& rVertexCoords, double rTolerance );
+
+		uint64_t getVertexNr() const;
+		uint64_t getMergedNr() const;
+		const std::vector<uint64_t>& getVertexMap() const;
+		const std::vector<uint64_t>& getClusterOffsets() const;
+		const std::vector<uint64_t>& getClusterMembers() const;
+
+		bool     mergeVertexProps( const std::vector<sVertexProperties>& rVertexProps, eAttributePolicy rPolicy,
+		                           std::vector<sVertexProperties>& rWeldedProps ) const;
+		bool     mergeRows( const std::vector<double>& rRows, uint64_t rRowLen, eAttributePolicy rPolicy,
+		                    std::vector<double>& rWeldedRows ) const;
+
+	private:
+		std::vector<uint64_t> mVertexMap;        //!< Index of the welded vertex for each vertex.
+		std::vector<uint64_t> mClusterOffsets;   //!< Range of the members of each welded vertex within mClusterMembers. One more than welded vertices.
+		std::vector<uint64_t> mClusterMembers;   //!< Vertices of each welded vertex in ascending order i.e. starting with the representative.
+};
+
+#endif // VERTEXWELDING_H
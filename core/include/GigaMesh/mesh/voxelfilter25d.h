@@ -42,12 +42,32 @@ struct voxelFilter2DElements {
 	double* elementValues;  //!< Values of the non-nan elements - has length nrFilterElementsSet.
 };
 
+//! Sparse filters of all scales merged for a single pass over the raster.
+//!
+//! The filter masks are concentric discs, so a column (=pixel) covered by a
+//! scale is also covered by all larger scales. Therefore the heights of the
+//! scales covering a column are stored as prefix of the scales ordered by
+//! decreasing size. Each column of the raster is fetched once for all scales
+//! and the inner loop over the scales is contiguous and free of branches.
+struct voxelFilter2DMultiscale {
+	uint    nrScales;      //!< Number of scales i.e. sparse filters.
+	uint    nrColumns;     //!< Number of columns within the largest filter.
+	uint*   scaleOrder;    //!< Scales in decreasing order of their sizes - has length nrScales.
+	int*    columnIndices; //!< Raster indices of the columns in ascending order - has length nrColumns.
+	uint*   columnOffsets; //!< Position of the first height of a column within columnHeights - has length nrColumns+1.
+	double* columnHeights; //!< Heights of the scales covering each column - in the order of scaleOrder.
+};
+
 double*  generateVoxelFilter2D( double radiusRel, uint xyzDim, voxelFilter2DElements* sparseFilter );
 double** generateVoxelFilters2D( uint multiscaleRadiiSize, double* multiscaleRadii, uint xyzDim, voxelFilter2DElements** sparseFilters );
 
 bool     applyVoxelFilter2D( double* featureElement, double* rasterArray, voxelFilter2DElements* sparseFilter, uint xyzDim );
 void     applyVoxelFilters2D( double* featureArray, double* rasterArray, voxelFilter2DElements** sparseFilters, uint multiscaleRadiiSize, uint xyzDim );
 
+bool     generateVoxelFilters2DMultiscale( voxelFilter2DElements* sparseFilters, uint multiscaleRadiiSize, uint xyzDim, voxelFilter2DMultiscale* multiscaleFilter );
+void     freeVoxelFilters2DMultiscale( voxelFilter2DMultiscale* multiscaleFilter );
+void     applyVoxelFilters2D( double* featureArray, double* rasterArray, voxelFilter2DMultiscale* multiscaleFilter );
+
 double   sumVoxelFilter2D( double* voxelFilter2D, uint xyzDim );
 bool     applyVoxelFilter2D( double* featureElement, double* rasterArray, double* voxelFilter2D, uint xyzDim );
 void     applyVoxelFilters2D( double* featureArray, double* rasterArray, uint multiscaleRadiiSize, double** voxelFilters2D, uint xyzDim );
@@ -181,8 +181,8 @@ bool ObjWriter::writeFile(const std::filesystem::path& rFilename, const std::vec
 			for(size_t i = 0; i<faceProp.textureCoordinates.size(); i+=2)
 			{
 				filestr << "vt ";
-				filestr << faceProp.textureCoordinates[i * 2    ] << " ";
-				filestr << faceProp.textureCoordinates[i * 2 + 1] << "\n";
+				filestr << faceProp.textureCoordinates[i    ] << " ";
+				filestr << faceProp.textureCoordinates[i + 1] << "\n";
 			}
 		}
 	}
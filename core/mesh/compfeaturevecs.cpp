@@ -128,8 +128,13 @@ void compFeatureVectorsThread(
 			rMeshData->meshToAnalyze->fetchSphereCubeVolume25D( currentVertex, &facesInSphere,
 			                                                   rMeshData->radius, rasterArray,
 			                                                   rMeshData->xyzDim );
-			applyVoxelFilters2D( &(tDescriptVolume[descriptIndexOffset]), rasterArray,
-			                        rMeshData->sparseFilters, rMeshData->multiscaleRadiiSize, rMeshData->xyzDim );
+			if( rMeshData->multiscaleFilter != nullptr ) {
+				applyVoxelFilters2D( &(tDescriptVolume[descriptIndexOffset]), rasterArray,
+				                     rMeshData->multiscaleFilter );
+			} else {
+				applyVoxelFilters2D( &(tDescriptVolume[descriptIndexOffset]), rasterArray,
+				                     rMeshData->sparseFilters, rMeshData->multiscaleRadiiSize, rMeshData->xyzDim );
+			}
 		}
 
 		// Get surface descriptor:
@@ -1578,6 +1578,24 @@ bool Face::applyTransfrom( Matrix4D* transMat ) {
 	return true;
 }
 
+//! Updates the normal, when the vertices were transformed by an affine
+//! transformation. The cofactor matrix (see AffineTransform3x4::getCofactor)
+//! maps the cross product of the edges directly, so the vertices are not accessed.
+//! Falls back to Face::getAreaNormal, when the normal was not set before.
+//!
+//! @returns the area of the face.
+double Face::applyAffineTransformToNormal( const AffineTransform3x4<double>& rCofactor ) {
+	if( !getFlag( FLAG_NORMAL_SET ) ) {
+		return( getAreaNormal() );
+	}
+	rCofactor.applyToDirection( mNormalXYZ );
+	double faceArea = sqrt( ( NORMAL_X * NORMAL_X ) + ( NORMAL_Y * NORMAL_Y ) + ( NORMAL_Z * NORMAL_Z ) ) / 2.0;
+	if( faceArea <= DBL_EPSILON ) {
+		setFlag( FLAG_FACE_ZERO_AREA );
+	}
+	return( faceArea );
+}
+
 //! Changes the orientation of a face.
 //!
 //! @returns false in case of an error. True otherwise.
@@ -0,0 +1,277 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/facebvh.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//! Builds the hierarchy by splitting the triangles at the median of their centroids along the
+//! longest axis until a node holds at most rMaxLeafSize triangles.
+//!
+//! @returns false for invalid vertex indices or an empty mesh. True otherwise.
+bool FaceBVH::build(
+                const std::vector<double>&   rVertexCoords,        //!< Vertex coordinates as xyz-triplets.
+                const std::vector<uint64_t>& rFaceVertexIndices,   //!< Three vertex indices per triangle.
+                unsigned int                 rMaxLeafSize          //!< Maximum number of triangles per leaf.
+) {
+	mNodes.clear();
+	mTriangles.clear();
+	const uint64_t vertexNr = rVertexCoords.size() / 3;
+	const uint64_t faceNr   = rFaceVertexIndices.size() / 3;
+	if( faceNr == 0 ) {
+		return( false );
+	}
+	for( const uint64_t vertexIdx : rFaceVertexIndices ) {
+		if( vertexIdx >= vertexNr ) {
+			return( false );
+		}
+	}
+	std::vector<double>   centroids( faceNr * 3 );
+	std::vector<uint64_t> faceOrder( faceNr );
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		const double* posA = &rVertexCoords[rFaceVertexIndices[faceIdx*3]*3];
+		const double* posB = &rVertexCoords[rFaceVertexIndices[faceIdx*3+1]*3];
+		const double* posC = &rVertexCoords[rFaceVertexIndices[faceIdx*3+2]*3];
+		for( unsigned int k=0; k<3; k++ ) {
+			centroids[faceIdx*3+k] = ( posA[k] + posB[k] + posC[k] ) / 3.0;
+		}
+		faceOrder[faceIdx] = faceIdx;
+	}
+	mNodes.reserve( 2 * ( faceNr / std::max( 1U, rMaxLeafSize ) ) + 1 );
+	buildNode( faceOrder, centroids, rVertexCoords, rFaceVertexIndices, 0, faceNr, std::max( 1U, rMaxLeafSize ) );
+
+	mTriangles.resize( faceNr );
+	for( uint64_t i=0; i<faceNr; i++ ) {
+		const uint64_t* vertexIdx = &rFaceVertexIndices[faceOrder[i]*3];
+		const double*   posA      = &rVertexCoords[vertexIdx[0]*3];
+		const double*   posB      = &rVertexCoords[vertexIdx[1]*3];
+		const double*   posC      = &rVertexCoords[vertexIdx[2]*3];
+		sTriangle& triangle = mTriangles[i];
+		for( unsigned int k=0; k<3; k++ ) {
+			triangle.mVertA[k]     = posA[k];
+			triangle.mEdgeAB[k]    = posB[k] - posA[k];
+			triangle.mEdgeAC[k]    = posC[k] - posA[k];
+			triangle.mVertexIdx[k] = vertexIdx[k];
+		}
+	}
+	return( true );
+}
+
+//! Recursively appends the node for the triangles rFaceOrder[rBegin,rEnd) and its children.
+//! @returns the index of the node.
+uint64_t FaceBVH::buildNode(
+                std::vector<uint64_t>&       rFaceOrder,
+                const std::vector<double>&   rCentroids,
+                const std::vector<double>&   rVertexCoords,
+                const std::vector<uint64_t>& rFaceVertexIndices,
+                uint64_t                     rBegin,
+                uint64_t                     rEnd,
+                unsigned int                 rMaxLeafSize
+) {
+	const uint64_t nodeIdx = mNodes.size();
+	mNodes.emplace_back();
+	sNode node;
+	double centroidMin[3];
+	double centroidMax[3];
+	for( unsigned int k=0; k<3; k++ ) {
+		node.mMin[k]   = +DBL_MAX;
+		node.mMax[k]   = -DBL_MAX;
+		centroidMin[k] = +DBL_MAX;
+		centroidMax[k] = -DBL_MAX;
+	}
+	for( uint64_t i=rBegin; i<rEnd; i++ ) {
+		const uint64_t faceIdx = rFaceOrder[i];
+		for( unsigned int j=0; j<3; j++ ) {
+			const double* pos = &rVertexCoords[rFaceVertexIndices[faceIdx*3+j]*3];
+			for( unsigned int k=0; k<3; k++ ) {
+				node.mMin[k] = std::min( node.mMin[k], pos[k] );
+				node.mMax[k] = std::max( node.mMax[k], pos[k] );
+			}
+		}
+		for( unsigned int k=0; k<3; k++ ) {
+			centroidMin[k] = std::min( centroidMin[k], rCentroids[faceIdx*3+k] );
+			centroidMax[k] = std::max( centroidMax[k], rCentroids[faceIdx*3+k] );
+		}
+	}
+	// Padding to compensate rounding within the slab test, which must not miss a triangle on the border of the box:
+	for( unsigned int k=0; k<3; k++ ) {
+		const double padding = 1e-9 * ( ( node.mMax[k] - node.mMin[k] ) + std::abs( node.mMin[k] ) + std::abs( node.mMax[k] ) ) + DBL_MIN;
+		node.mMin[k] -= padding;
+		node.mMax[k] += padding;
+	}
+	unsigned int splitAxis = 0;
+	for( unsigned int k=1; k<3; k++ ) {
+		if( centroidMax[k] - centroidMin[k] > centroidMax[splitAxis] - centroidMin[splitAxis] ) {
+			splitAxis = k;
+		}
+	}
+	const uint64_t count = rEnd - rBegin;
+	if( ( count <= rMaxLeafSize ) || ( centroidMax[splitAxis] <= centroidMin[splitAxis] ) ) {
+		node.mFirst = rBegin;
+		node.mCount = count;
+		mNodes[nodeIdx] = node;
+		return( nodeIdx );
+	}
+	const uint64_t middle = rBegin + count / 2;
+	std::nth_element( rFaceOrder.begin() + rBegin, rFaceOrder.begin() + middle, rFaceOrder.begin() + rEnd,
+	                  [&rCentroids,splitAxis]( uint64_t rFaceA, uint64_t rFaceB ) {
+		return( rCentroids[rFaceA*3+splitAxis] < rCentroids[rFaceB*3+splitAxis] );
+	} );
+	buildNode( rFaceOrder, rCentroids, rVertexCoords, rFaceVertexIndices, rBegin, middle, rMaxLeafSize );
+	node.mFirst = buildNode( rFaceOrder, rCentroids, rVertexCoords, rFaceVertexIndices, middle, rEnd, rMaxLeafSize );
+	node.mCount = 0;
+	mNodes[nodeIdx] = node;
+	return( nodeIdx );
+}
+
+//! @returns the number of triangles.
+uint64_t FaceBVH::getFaceNr() const {
+	return( mTriangles.size() );
+}
+
+//! @returns the number of nodes including the leaves.
+uint64_t FaceBVH::getNodeNr() const {
+	return( mNodes.size() );
+}
+
+//! Any-hit test of a single ray - see isOccludedPacket.
+//! @returns true, when a triangle is hit within ( rTMin, rTMax ).
+bool FaceBVH::isOccluded( const double* rOrigin, const double* rDirection, double rTMin, double rTMax,
+                          uint64_t rIgnoreVertexIdx ) const {
+	return( isOccludedPacket( rOrigin, rDirection, 1, rTMin, rTMax, rIgnoreVertexIdx ) != 0 );
+}
+
+//! Any-hit test of up to PACKET_SIZE rays with a common origin e.g. a vertex.
+//! A ray hits, when a triangle is intersected at a distance t within ( rTMin, rTMax ) - in
+//! multiples of the length of its direction. Triangles referencing rIgnoreVertexIdx are skipped,
+//! which prevents rays from hitting the triangles adjacent to their origin.
+//! @returns bitmask with bit i set, when ray i hits a triangle.
+uint32_t FaceBVH::isOccludedPacket(
+                const double* rOrigin,            //!< Common origin as xyz.
+                const double* rDirections,        //!< Directions as xyz-triplets.
+                unsigned int  rRayCount,          //!< Number of rays - at most PACKET_SIZE.
+                double        rTMin,              //!< Lower bound of the ray parameter.
+                double        rTMax,              //!< Upper bound of the ray parameter.
+                uint64_t      rIgnoreVertexIdx    //!< Index of the vertex, which adjacent triangles are ignored.
+) const {
+	rRayCount = std::min( rRayCount, PACKET_SIZE );
+	if( ( rRayCount == 0 ) || ( mNodes.empty() ) ) {
+		return( 0 );
+	}
+	// Rays in structure-of-arrays layout for the loops over the packet. Zero elements of the directions are
+	// replaced for the slab test, because 0 * inf would result in not-a-number for rays within a slab.
+	double dirX[PACKET_SIZE];
+	double dirY[PACKET_SIZE];
+	double dirZ[PACKET_SIZE];
+	double invDirX[PACKET_SIZE];
+	double invDirY[PACKET_SIZE];
+	double invDirZ[PACKET_SIZE];
+	for( unsigned int ray=0; ray<rRayCount; ray++ ) {
+		dirX[ray] = rDirections[ray*3];
+		dirY[ray] = rDirections[ray*3+1];
+		dirZ[ray] = rDirections[ray*3+2];
+		invDirX[ray] = 1.0 / ( ( dirX[ray] != 0.0 ) ? dirX[ray] : DBL_MIN );
+		invDirY[ray] = 1.0 / ( ( dirY[ray] != 0.0 ) ? dirY[ray] : DBL_MIN );
+		invDirZ[ray] = 1.0 / ( ( dirZ[ray] != 0.0 ) ? dirZ[ray] : DBL_MIN );
+	}
+	const double   origX   = rOrigin[0];
+	const double   origY   = rOrigin[1];
+	const double   origZ   = rOrigin[2];
+	const uint32_t allRays = ( static_cast<uint32_t>(1) << rRayCount ) - 1;
+	uint32_t occluded = 0;
+
+	// Depth of the hierarchy is logarithmic due to the median split:
+	struct sStackEntry {
+		uint64_t mNodeIdx;
+		uint32_t mRays;
+	};
+	sStackEntry stack[128];
+	unsigned int stackSize = 0;
+	stack[stackSize++] = { 0, allRays };
+	while( stackSize > 0 ) {
+		const sStackEntry entry = stack[--stackSize];
+		uint32_t rays = entry.mRays & ~occluded;
+		if( rays == 0 ) {
+			continue;
+		}
+		const sNode& node = mNodes[entry.mNodeIdx];
+		// Slab test for all rays of the packet:
+		uint32_t raysHit = 0;
+		for( unsigned int ray=0; ray<rRayCount; ray++ ) {
+			const double tX0 = ( node.mMin[0] - origX ) * invDirX[ray];
+			const double tX1 = ( node.mMax[0] - origX ) * invDirX[ray];
+			const double tY0 = ( node.mMin[1] - origY ) * invDirY[ray];
+			const double tY1 = ( node.mMax[1] - origY ) * invDirY[ray];
+			const double tZ0 = ( node.mMin[2] - origZ ) * invDirZ[ray];
+			const double tZ1 = ( node.mMax[2] - origZ ) * invDirZ[ray];
+			const double tNear = std::max( std::max( std::min( tX0, tX1 ), std::min( tY0, tY1 ) ), std::max( std::min( tZ0, tZ1 ), rTMin ) );
+			const double tFar  = std::min( std::min( std::max( tX0, tX1 ), std::max( tY0, tY1 ) ), std::min( std::max( tZ0, tZ1 ), rTMax ) );
+			raysHit |= static_cast<uint32_t>( tNear <= tFar ) << ray;
+		}
+		rays &= raysHit;
+		if( rays == 0 ) {
+			continue;
+		}
+		if( node.mCount == 0 ) {
+			stack[stackSize++] = { node.mFirst, rays };
+			stack[stackSize++] = { entry.mNodeIdx + 1, rays };
+			continue;
+		}
+		// Leaf - intersection test of Moeller and Trumbore:
+		for( uint64_t triIdx=node.mFirst; triIdx<node.mFirst+node.mCount; triIdx++ ) {
+			const sTriangle& tri = mTriangles[triIdx];
+			if( ( tri.mVertexIdx[0] == rIgnoreVertexIdx ) || ( tri.mVertexIdx[1] == rIgnoreVertexIdx ) ||
+			    ( tri.mVertexIdx[2] == rIgnoreVertexIdx ) ) {
+				continue;
+			}
+			const double sX = origX - tri.mVertA[0];
+			const double sY = origY - tri.mVertA[1];
+			const double sZ = origZ - tri.mVertA[2];
+			// q = s x edgeAB is the same for all rays due to the common origin:
+			const double qX = sY * tri.mEdgeAB[2] - sZ * tri.mEdgeAB[1];
+			const double qY = sZ * tri.mEdgeAB[0] - sX * tri.mEdgeAB[2];
+			const double qZ = sX * tri.mEdgeAB[1] - sY * tri.mEdgeAB[0];
+			const double t  = tri.mEdgeAC[0] * qX + tri.mEdgeAC[1] * qY + tri.mEdgeAC[2] * qZ;
+			uint32_t raysTri = 0;
+			for( unsigned int ray=0; ray<rRayCount; ray++ ) {
+				// p = dir x edgeAC
+				const double pX  = dirY[ray] * tri.mEdgeAC[2] - dirZ[ray] * tri.mEdgeAC[1];
+				const double pY  = dirZ[ray] * tri.mEdgeAC[0] - dirX[ray] * tri.mEdgeAC[2];
+				const double pZ  = dirX[ray] * tri.mEdgeAC[1] - dirY[ray] * tri.mEdgeAC[0];
+				const double det = tri.mEdgeAB[0] * pX + tri.mEdgeAB[1] * pY + tri.mEdgeAB[2] * pZ;
+				const double u   = ( sX * pX + sY * pY + sZ * pZ ) / det;
+				const double v   = ( dirX[ray] * qX + dirY[ray] * qY + dirZ[ray] * qZ ) / det;
+				const double tHit = t / det;
+				// Comparisons are false for not-a-number i.e. rays parallel to the triangle:
+				const bool hit = ( u >= 0.0 ) && ( v >= 0.0 ) && ( u + v <= 1.0 ) && ( tHit > rTMin ) && ( tHit < rTMax );
+				raysTri |= static_cast<uint32_t>( hit ) << ray;
+			}
+			occluded |= raysTri & rays;
+			if( occluded == allRays ) {
+				return( occluded );
+			}
+		}
+	}
+	return( occluded );
+}
@@ -0,0 +1,222 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/featurevecstore.h>
+
+#include <cmath>
+
+#include <GigaMesh/mesh/parallelfor.h>
+
+//! Sum of rElement( i ) for i within [0,rLen) using four independent partial sums,
+//! which allows the compiler to vectorize the loop without reordering a single sum.
+template<typename tElement>
+static inline double sumElements( const uint64_t rLen, tElement&& rElement ) {
+	double sum0 = 0.0;
+	double sum1 = 0.0;
+	double sum2 = 0.0;
+	double sum3 = 0.0;
+	uint64_t i = 0;
+	for( ; i+4<=rLen; i+=4 ) {
+		sum0 += rElement( i );
+		sum1 += rElement( i+1 );
+		sum2 += rElement( i+2 );
+		sum3 += rElement( i+3 );
+	}
+	for( ; i<rLen; i++ ) {
+		sum0 += rElement( i );
+	}
+	return( ( sum0 + sum1 ) + ( sum2 + sum3 ) );
+}
+
+//! Removes all feature vectors.
+void FeatureVecStore::clear() {
+	mValues.clear();
+	mValues.shrink_to_fit();
+	mFeatureVecLen = 0;
+}
+
+//! Takes the given row-major matrix without copying. rValues is left with the previous content of the store.
+//!
+//! @returns false, when the number of values is not a multiple of the length. True otherwise.
+bool FeatureVecStore::adopt(
+                std::vector<double>& rValues,        //!< Feature vectors of all rows.
+                uint64_t             rFeatureVecLen  //!< Number of elements per row.
+) {
+	if( ( rFeatureVecLen == 0 ) || ( rValues.size() % rFeatureVecLen != 0 ) ) {
+		return( false );
+	}
+	mValues.swap( rValues );
+	mFeatureVecLen = rFeatureVecLen;
+	return( true );
+}
+
+//! @returns true, when there are no feature vectors.
+bool FeatureVecStore::isEmpty() const {
+	return( mValues.empty() );
+}
+
+//! @returns the number of elements per row.
+uint64_t FeatureVecStore::getFeatureVecLen() const {
+	return( mFeatureVecLen );
+}
+
+//! @returns the number of rows.
+uint64_t FeatureVecStore::getRowCount() const {
+	if( mFeatureVecLen == 0 ) {
+		return( 0 );
+	}
+	return( mValues.size() / mFeatureVecLen );
+}
+
+//! @returns pointer to the first element of the given row or nullptr for an invalid index.
+double* FeatureVecStore::getRow( uint64_t rRowIdx ) {
+	if( rRowIdx >= getRowCount() ) {
+		return( nullptr );
+	}
+	return( mValues.data() + rRowIdx*mFeatureVecLen );
+}
+
+//! Distances of all rows to the given reference vector, which has to be of length getFeatureVecLen().
+//! The values are the same as computed by the according methods of the Vertex class apart from
+//! rounding caused by the different order of summation.
+//!
+//! @returns false in case of an error e.g. missing standard deviations for FEATURE_DIST_EUCLIDEAN_NORM. True otherwise.
+bool FeatureVecStore::computeDistances(
+                eFeatureDistance           rDistance,          //!< Distance measure.
+                const double*              rReferenceVec,      //!< Reference feature vector.
+                std::vector<double>&       rDistances,         //!< Output: distance per row.
+                const std::vector<double>* rFeatureVecStdDev   //!< Standard deviation per element - required for FEATURE_DIST_EUCLIDEAN_NORM.
+) const {
+	if( rReferenceVec == nullptr ) {
+		return( false );
+	}
+	const uint64_t featureVecLen = mFeatureVecLen;
+	std::vector<double> variances;
+	if( rDistance == FEATURE_DIST_EUCLIDEAN_NORM ) {
+		if( ( rFeatureVecStdDev == nullptr ) || ( rFeatureVecStdDev->size() < featureVecLen ) ) {
+			return( false );
+		}
+		variances.resize( featureVecLen );
+		for( uint64_t i=0; i<featureVecLen; i++ ) {
+			variances[i] = (*rFeatureVecStdDev)[i] * (*rFeatureVecStdDev)[i];
+		}
+	}
+	const double  refLenSqr = sumElements( featureVecLen, [rReferenceVec]( uint64_t i ) {
+		return( rReferenceVec[i] * rReferenceVec[i] );
+	} );
+	const double  refLen    = std::sqrt( refLenSqr );
+	const double* variance  = variances.data();
+
+	const uint64_t rowCount = getRowCount();
+	rDistances.resize( rowCount );
+	parallelFor( rowCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t rowIdx=rBegin; rowIdx<rEnd; rowIdx++ ) {
+			const double* row = mValues.data() + rowIdx*featureVecLen;
+			double dist = 0.0;
+			switch( rDistance ) {
+				case FEATURE_DIST_MANHATTAN:
+					dist = sumElements( featureVecLen, [row, rReferenceVec]( uint64_t i ) {
+						return( std::abs( rReferenceVec[i] - row[i] ) );
+					} );
+					break;
+				case FEATURE_DIST_EUCLIDEAN:
+					dist = std::sqrt( sumElements( featureVecLen, [row, rReferenceVec]( uint64_t i ) {
+						const double diff = rReferenceVec[i] - row[i];
+						return( diff * diff );
+					} ) );
+					break;
+				case FEATURE_DIST_EUCLIDEAN_NORM:
+					dist = std::sqrt( sumElements( featureVecLen, [row, rReferenceVec, variance]( uint64_t i ) {
+						const double diff = rReferenceVec[i] - row[i];
+						return( diff * diff / variance[i] );
+					} ) );
+					break;
+				case FEATURE_DIST_COSINE_ACOS:
+				case FEATURE_DIST_TANIMOTO: {
+					const double nom = sumElements( featureVecLen, [row, rReferenceVec]( uint64_t i ) {
+						return( rReferenceVec[i] * row[i] );
+					} );
+					const double rowLen = std::sqrt( sumElements( featureVecLen, [row]( uint64_t i ) {
+						return( row[i] * row[i] );
+					} ) );
+					if( rDistance == FEATURE_DIST_COSINE_ACOS ) {
+						dist = std::acos( nom / ( refLen * rowLen ) );
+					} else {
+						dist = nom / ( refLen + rowLen - nom );
+					}
+					} break;
+			}
+			rDistances[rowIdx] = dist;
+		}
+	} );
+	return( true );
+}
+
+//! Weighted distances sqrt( d^T W d ) of all rows to the given reference vector with d = row - reference
+//! i.e. the distance of Mahalanobis using W as inverse covariance matrix. Negative quadratic forms result in NaN.
+//!
+//! The product d^T W is accumulated row by row of W, so the inner loop runs over contiguous elements
+//! and is vectorized, while W stays in the cache for all rows.
+//!
+//! @returns false in case of an error e.g. a weight matrix not being of size getFeatureVecLen()^2. True otherwise.
+bool FeatureVecStore::computeWeightedDistances(
+                const double*              rReferenceVec,   //!< Reference feature vector.
+                const std::vector<double>& rWeightMatrix,   //!< Row-major matrix W of getFeatureVecLen() x getFeatureVecLen() weights.
+                std::vector<double>&       rDistances       //!< Output: distance per row.
+) const {
+	const uint64_t featureVecLen = mFeatureVecLen;
+	if( ( rReferenceVec == nullptr ) || ( rWeightMatrix.size() != featureVecLen * featureVecLen ) ) {
+		return( false );
+	}
+	const double*  weights  = rWeightMatrix.data();
+	const uint64_t rowCount = getRowCount();
+	rDistances.resize( rowCount );
+	std::vector<std::vector<double>> scratch( getParallelThreadCount() );
+	parallelFor( rowCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		std::vector<double>& threadScratch = scratch[rThreadIdx];
+		threadScratch.assign( 2 * featureVecLen, 0.0 );
+		double* diff     = threadScratch.data();
+		double* weighted = diff + featureVecLen;
+		for( uint64_t rowIdx=rBegin; rowIdx<rEnd; rowIdx++ ) {
+			const double* row = mValues.data() + rowIdx*featureVecLen;
+			for( uint64_t i=0; i<featureVecLen; i++ ) {
+				diff[i]     = row[i] - rReferenceVec[i];
+				weighted[i] = 0.0;
+			}
+			// weighted = d^T W
+			for( uint64_t k=0; k<featureVecLen; k++ ) {
+				const double  diffK      = diff[k];
+				const double* weightsRow = weights + k*featureVecLen;
+				for( uint64_t j=0; j<featureVecLen; j++ ) {
+					weighted[j] += diffK * weightsRow[j];
+				}
+			}
+			// d^T W d
+			double quadForm = 0.0;
+			for( uint64_t j=0; j<featureVecLen; j++ ) {
+				quadForm += weighted[j] * diff[j];
+			}
+			rDistances[rowIdx] = std::sqrt( quadForm );
+		}
+	} );
+	return( true );
+}
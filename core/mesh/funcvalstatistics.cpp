@@ -0,0 +1,192 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/funcvalstatistics.h>
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include <GigaMesh/mesh/vertex.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/mesh/gmcommon.h>
+
+//! Number of quantiles determined by selection before the values are sorted.
+#define FUNCVAL_STATISTICS_SELECTIONS_BEFORE_SORT 2
+
+//! Marks the statistics as outdated.
+void FuncValStatistics::invalidate() {
+	mValid = false;
+	mSorted = false;
+	mSelectionCount = 0;
+}
+
+//! @returns true, when the statistics are up-to-date for a mesh with the given number of vertices.
+bool FuncValStatistics::isValid( uint64_t rVertexCount ) const {
+	return( mValid && ( mVertexCount == rVertexCount ) );
+}
+
+//! Gathers the finite function values of the given vertices and determines minimum and maximum.
+//!
+//! @returns false, when no finite value was found. True otherwise.
+bool FuncValStatistics::update( const std::vector<Vertex*>& rVertices ) {
+	invalidate();
+	const uint64_t vertexCount = rVertices.size();
+	mValues.resize( vertexCount );
+
+	// Fetch values and per-thread extrema.
+	const unsigned int threadCount = getParallelThreadCount();
+	std::vector<double>   threadMin( threadCount, +_INFINITE_DBL_ );
+	std::vector<double>   threadMax( threadCount, -_INFINITE_DBL_ );
+	std::vector<uint64_t> threadFinite( threadCount, 0 );
+	parallelFor( vertexCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		double   minVal = threadMin[rThreadIdx];
+		double   maxVal = threadMax[rThreadIdx];
+		uint64_t finiteCount = 0;
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			double funcVal = _NOT_A_NUMBER_DBL_;
+			rVertices[i]->getFuncValue( &funcVal );
+			mValues[i] = funcVal;
+			if( !std::isfinite( funcVal ) ) {
+				continue;
+			}
+			finiteCount++;
+			minVal = std::min( minVal, funcVal );
+			maxVal = std::max( maxVal, funcVal );
+		}
+		threadMin[rThreadIdx] = minVal;
+		threadMax[rThreadIdx] = maxVal;
+		threadFinite[rThreadIdx] += finiteCount;
+	} );
+
+	// Keep the finite values only.
+	mValues.erase( std::remove_if( mValues.begin(), mValues.end(),
+	                               []( double rVal ) { return !std::isfinite( rVal ); } ),
+	               mValues.end() );
+	mMinVal = *std::min_element( threadMin.begin(), threadMin.end() );
+	mMaxVal = *std::max_element( threadMax.begin(), threadMax.end() );
+	mVertexCount = vertexCount;
+	mValid = true;
+	return( !mValues.empty() );
+}
+
+//! @returns the number of finite function values.
+uint64_t FuncValStatistics::getFiniteCount() const {
+	return( mValues.size() );
+}
+
+//! Minimum and maximum of the finite function values.
+//!
+//! @returns false, when there are no finite values. True otherwise.
+bool FuncValStatistics::getMinMax( double& rMinVal, double& rMaxVal ) const {
+	if( !mValid || mValues.empty() ) {
+		rMinVal = _NOT_A_NUMBER_DBL_;
+		rMaxVal = _NOT_A_NUMBER_DBL_;
+		return( false );
+	}
+	rMinVal = mMinVal;
+	rMaxVal = mMaxVal;
+	return( true );
+}
+
+//! Value of the given quantile within [0.0,1.0] using the same position
+//! within the ascending order as Mesh::getFuncValuesMinMaxQuantil did
+//! i.e. round( rQuantile * ( n-1 ) ).
+//!
+//! @returns false in case of an error. True otherwise.
+bool FuncValStatistics::getQuantile( double rQuantile, double& rValue ) {
+	if( !mValid || mValues.empty() || ( rQuantile < 0.0 ) || ( rQuantile > 1.0 ) ) {
+		return( false );
+	}
+	const uint64_t quantilIdx = std::lround( rQuantile * static_cast<double>( mValues.size() - 1 ) );
+	if( !mSorted ) {
+		if( mSelectionCount < FUNCVAL_STATISTICS_SELECTIONS_BEFORE_SORT ) {
+			mSelectionCount++;
+			std::nth_element( mValues.begin(), mValues.begin() + quantilIdx, mValues.end() );
+			rValue = mValues[quantilIdx];
+			return( true );
+		}
+		sortValues();
+	}
+	rValue = mValues[quantilIdx];
+	return( true );
+}
+
+//! Histogram of the finite function values between minimum and maximum.
+//! The number of bins is given by the size of rBins. The largest value is
+//! counted within the last bin.
+//!
+//! @returns false, when there is no range of values. True otherwise.
+bool FuncValStatistics::getHistogram( std::vector<unsigned int>& rBins, double& rMinVal, double& rMaxVal ) const {
+	if( !getMinMax( rMinVal, rMaxVal ) || rBins.empty() ) {
+		return( false );
+	}
+	const double histRange = rMaxVal - rMinVal;
+	if( histRange <= DBL_EPSILON ) {
+		return( false );
+	}
+	const uint64_t binCount = rBins.size();
+	const double   histIntervalLen = histRange / static_cast<double>( binCount );
+
+	// Per-thread histograms avoid atomics.
+	std::vector<std::vector<unsigned int>> threadBins( getParallelThreadCount(),
+	                                                   std::vector<unsigned int>( binCount, 0 ) );
+	parallelFor( mValues.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		std::vector<unsigned int>& bins = threadBins[rThreadIdx];
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			uint64_t histIndex = static_cast<uint64_t>( std::floor( ( mValues[i] - rMinVal ) / histIntervalLen ) );
+			bins[std::min( histIndex, binCount-1 )]++;
+		}
+	} );
+	for( const auto& bins : threadBins ) {
+		for( uint64_t i=0; i<binCount; i++ ) {
+			rBins[i] += bins[i];
+		}
+	}
+	return( true );
+}
+
+//! Sorts the values in parallel: chunks are sorted by the threads and merged pairwise.
+void FuncValStatistics::sortValues() {
+	const uint64_t valueCount = mValues.size();
+	const uint64_t chunkCount = std::min( static_cast<uint64_t>( getParallelThreadCount() ),
+	                                      valueCount / 65536 + 1 );
+	const uint64_t chunkSize  = ( valueCount + chunkCount - 1 ) / chunkCount;
+	parallelFor( chunkCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t c=rBegin; c<rEnd; c++ ) {
+			std::sort( mValues.begin() + std::min( c*chunkSize, valueCount ),
+			           mValues.begin() + std::min( (c+1)*chunkSize, valueCount ) );
+		}
+	}, 1 );
+	for( uint64_t width=chunkSize; width<valueCount; width*=2 ) {
+		const uint64_t mergeCount = ( valueCount + 2*width - 1 ) / ( 2*width );
+		parallelFor( mergeCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+			for( uint64_t m=rBegin; m<rEnd; m++ ) {
+				const uint64_t first  = m*2*width;
+				const uint64_t middle = std::min( first+width, valueCount );
+				const uint64_t last   = std::min( first+2*width, valueCount );
+				std::inplace_merge( mValues.begin()+first, mValues.begin()+middle, mValues.begin()+last );
+			}
+		}, 1 );
+	}
+	mSorted = true;
+}
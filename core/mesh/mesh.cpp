@@ -31,6 +31,9 @@
 #include <random>
 #include <algorithm> // std::find_if
 #include <iomanip>
+#include <chrono>
+#include <numeric> // std::accumulate
+#include <unordered_map>
 #include <regex>
 
 #include <cstdlib>
@@ -56,6 +59,10 @@
 #include <GigaMesh/mesh/marchingfront.h>
 
 #include <GigaMesh/mesh/compfeaturevecs.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/mesh/facebvh.h>
+#include <GigaMesh/mesh/quadricdecimation.h>
+#include <GigaMesh/mesh/scalarfieldsplit.h>
 
 #include <GigaMesh/mesh/ellipsedisc.h>
 #include <GigaMesh/logging/Logging.h>
@@ -146,7 +153,8 @@ const auto NUM_THREADS = std::thread::hardware_concurrency() * 2;
 	    Vertex* currVertex = getVertexPos( vertIdx ); \
 	    currVertex->setFuncValue( funcValStash.at( vertIdx ) ); \
 	} \
-	funcValStash.clear();
+	funcValStash.clear(); \
+	changedVertFuncVal();
 
 #define MESHINITDEFAULTS                        \
 	ShowProgress( "[Mesh]" )
@@ -231,6 +239,17 @@ Mesh::Mesh( std::set<Face*>* someFaces )
 	showProgressStop( string( "Construct Mesh" ) );
 }
 
+//! Constructor using vertex and face properties e.g. generated in memory instead of read from a file.
+Mesh::Mesh(
+                std::vector<sVertexProperties>& rVertexProps,
+                std::vector<sFaceProperties>& rFaceProps
+)
+    : MESHINITDEFAULTS {
+	showProgressStart( string( "Construct Mesh" ) );
+	establishStructure( rVertexProps, rFaceProps );
+	showProgressStop( string( "Construct Mesh" ) );
+}
+
 //! Destructor. Destroys all primitives referenced by lists.
 //! Does a lot of freeing memory in the following steps:
 Mesh::~Mesh() {
@@ -602,6 +621,9 @@ bool Mesh::callFunction(
 		case FUNCVAL_SPHERE_SURFACE_NUMBER_OF_COMPONENTS:
 			retVal = funcVertSphereSurfaceNumberOfComponents();
 			break;
+		case FUNCVAL_SPHERE_DESCRIPTORS:
+			retVal = funcVertSphereDescriptors();
+			break;
 		// Edit
 		case EDIT_REMOVE_SELMFACES:
 			retVal &= removeFacesSelected();
@@ -914,13 +936,8 @@ void Mesh::establishStructure(
 	mMaxY = -DBL_MAX;
 	mMinZ = +DBL_MAX;
 	mMaxZ = -DBL_MAX;
-	double* featureVecVerticesPtr = mFeatureVecVertices.data();
 	for(size_t i=0; i<rVertexProps.size(); ++i ) {
 		VertexOfFace* newVert = new VertexOfFace( i, rVertexProps[i] );
-		// Assign feature vectors, when present:
-		if( mFeatureVecVerticesLen > 0 ) {
-			newVert->assignFeatureVec( featureVecVerticesPtr+(i*mFeatureVecVerticesLen), mFeatureVecVerticesLen );
-		}
 		// Bounding Box:
 		if( mMinX > rVertexProps.at( i ).mCoordX ) {
 			mMinX = rVertexProps.at( i ).mCoordX;
@@ -944,9 +961,15 @@ void Mesh::establishStructure(
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------
+	// Assign feature vectors, when present - the vertices become views into the mesh's store.
+	if( ( mFeatureVecVerticesLen > 0 ) && !mFeatureVecVertices.empty() ) {
+		if( !adoptFeatureVectors( mFeatureVecVertices, mFeatureVecVerticesLen ) ) {
+			assignFeatureVectors( mFeatureVecVertices, mFeatureVecVerticesLen );
+		}
+	}
 	// Initalize storage for precomuted information about the feature vectors
 	changedVertFeatureVectors();
-	mFeatureVecVertices.clear(); // Can be clearad, because of newVert->assignFeatureVec (see above)
+	mFeatureVecVertices.clear(); // Can be cleared, because the vertices refer to mFeatureVecStore (see above)
 	//------------------------------------------------------------------------------------------------------------------------------------------------------
 
     #ifdef SHOW_MALLOC_STATS
@@ -1513,6 +1536,8 @@ bool Mesh::exportFeatureVectors(const filesystem::path& rFileName)
 //! Assigns the feature vectors within Mesh::mFeatureVecVertices
 //! to the vertices.
 //!
+//! The feature vectors are copied once into the contiguous store of the mesh.
+//!
 //! Not to be confused with the method having a similar name defined in the Primitive class.
 //!
 //! @returns false in case of an error. True otherwise.
@@ -1525,26 +1550,64 @@ bool Mesh::assignFeatureVectors(
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No feature vectors found!" << endl;
 		return( false );
 	}
-	const double* featureVecVerticesPtr = rFeatureVecs.data();
-	if( featureVecVerticesPtr == nullptr ) {
-		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No pointer to feature vectors!" << endl;
+	const uint64_t featureVecElements = getVertexNr() * rMaxFeatVecLen;
+	if( rFeatureVecs.size() < featureVecElements ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Less feature vectors than vertices!" << endl;
 		return( false );
 	}
-	Vertex* curVertex;
-	bool assignOk = true;
-	uint64_t vertexCount = getVertexNr();
-	for( uint64_t vertIdx=0; vertIdx<vertexCount; vertIdx++ ) {
-		curVertex = getVertexPos( vertIdx );
-		//cout << featureVecVertices[featureVecVerticesLen*vertIdx] << endl;
-		const double* nextFeatureVecPtr = &(featureVecVerticesPtr[rMaxFeatVecLen*vertIdx]);
-		if( !curVertex->assignFeatureVec( nextFeatureVecPtr, rMaxFeatVecLen ) ) {
-			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Could not assign feature vector!" << endl;
-			assignOk = false;
+	vector<double> featureVecs( rFeatureVecs.begin(), rFeatureVecs.begin() + featureVecElements );
+	return( adoptFeatureVectors( featureVecs, rMaxFeatVecLen ) );
+}
+
+//! Takes a row-major matrix of feature vectors - one row per vertex - without copying.
+//! The vertices become views into the rows of Mesh::mFeatureVecStore.
+//! The given vector is left with the previous content of the store.
+//!
+//! @returns false in case of an error e.g. a number of rows not matching the number of vertices. True otherwise.
+bool Mesh::adoptFeatureVectors(
+        vector<double>& rFeatureVecs,    //!< Feature vectors of all vertices.
+        const uint64_t  rFeatureVecLen   //!< Number of elements per vertex.
+) {
+	if( ( rFeatureVecLen == 0 ) || ( rFeatureVecs.size() != getVertexNr() * rFeatureVecLen ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Number of feature vectors does not match the number of vertices!" << endl;
+		return( false );
+	}
+	if( !mFeatureVecStore.adopt( rFeatureVecs, rFeatureVecLen ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Could not adopt the feature vectors!" << endl;
+		return( false );
+	}
+	std::atomic<bool> assignOk{ true };
+	parallelFor( getVertexNr(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			if( !mVertices[vertIdx]->setFeatureVecView( mFeatureVecStore.getRow( vertIdx ), rFeatureVecLen ) ) {
+				assignOk = false;
+			}
 		}
+	} );
+	if( !assignOk ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Could not assign feature vector!" << endl;
 	}
 	return( assignOk );
 }
 
+//! @returns true, when all vertices refer to their row of Mesh::mFeatureVecStore in the order of Mesh::mVertices.
+//!          False e.g. after adding or removing vertices or assigning a feature vector to a single vertex.
+bool Mesh::isFeatureVecStoreInUse() {
+	const uint64_t vertexCount = getVertexNr();
+	if( mFeatureVecStore.isEmpty() || ( mFeatureVecStore.getRowCount() != vertexCount ) ) {
+		return( false );
+	}
+	std::atomic<bool> inUse{ true };
+	parallelFor( vertexCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; ( vertIdx<rEnd ) && inUse; vertIdx++ ) {
+			if( !mVertices[vertIdx]->isFeatureVecViewOf( mFeatureVecStore.getRow( vertIdx ) ) ) {
+				inUse = false;
+			}
+		}
+	} );
+	return( inUse );
+}
+
 //! Fetchs the normal into a given array of double values, which has to be of size 3.
 //! @returns false in case of an error.
 bool Mesh::getVertNormal( int rVertIdx, double* rNormal ) {
@@ -4010,23 +4073,7 @@ bool Mesh::applyTransfromToPlane( Matrix4D rTransMat ) {
 //! @param noRedraw If set, does not force a redraw after each splitting
 //!        operation. Increases speed.
 bool Mesh::splitByPlane( Vector3D planeHNF, bool duplicateVertices, bool noRedraw ) {
-
-	Plane cutPlane( &planeHNF );
-
-	//! \todo sanity checks for plane, because the following is deprecated:
-	//if(!isPlanePosCSet()) {
-	//	return(false);
-	//}
-
-	auto interSectFun = [&planeHNF](Face* face) { return face->intersectsPlane(&planeHNF);};
-
-	auto distFun = [&planeHNF](VertexOfFace* vertex) { return vertex->estDistanceToPlane(&planeHNF);};
-
-	auto getIntersectionVectorFun = [&cutPlane]( VertexOfFace* vertX, VertexOfFace* vertY, Vector3D& rVecIntersection)  {
-		cutPlane.getIntersectionFacePlaneLinePos(vertX->getPositionVector(), vertY->getPositionVector(), rVecIntersection);
-	};
-
-	return splitMesh( interSectFun, distFun, getIntersectionVectorFun, duplicateVertices, noRedraw, 1000.0*numeric_limits<double>::epsilon() * planeHNF);
+	return( splitByPlanes( planeHNF, { 0.0 }, duplicateVertices, noRedraw ) );
 }
 
 //! Splits the mesh using a threshold (Iso Value) for the vertice's function value.
@@ -4039,20 +4086,203 @@ bool Mesh::splitByPlane( Vector3D planeHNF, bool duplicateVertices, bool noRedra
 //! @param noRedraw If set, does not force a redraw after each splitting
 //!        operation. Increases speed.
 bool Mesh::splitByIsoLine( double rIsoVal, bool duplicateVertices, bool noRedraw, Vector3D rUniformOffset ) {
+	return( splitByIsoLines( { rIsoVal }, duplicateVertices, noRedraw, rUniformOffset ) );
+}
+
+//! Splits the mesh by planes parallel to the given plane in a single pass e.g. to cut it into slabs.
+//! If faces are currently selected, the function will only split selected faces.
+//! @param rPlaneHNF Hesse Normal Form of the plane.
+//! @param rDistances signed distances of the planes to the given plane along its normal.
+//! @param rDuplicateVertices If set, vertices will be duplicated along the planes.
+//! @param rNoRedraw If set, does not force a redraw. Increases speed.
+bool Mesh::splitByPlanes( Vector3D rPlaneHNF, const std::vector<double>& rDistances, bool rDuplicateVertices, bool rNoRedraw ) {
+	const double normalLen = rPlaneHNF.getLength3();
+	if( !( normalLen > 0.0 ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Bad plane!\n";
+		return( false );
+	}
+	vector<double> vertexDistances( getVertexNr() );
+	parallelFor( vertexDistances.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			vertexDistances[vertIdx] = getVertexPos( vertIdx )->estDistanceToPlane( rPlaneHNF, false ) / normalLen;
+		}
+	} );
+	return( splitByLevels( vertexDistances, rDistances, rDuplicateVertices, rNoRedraw,
+	                       1000.0*numeric_limits<double>::epsilon() * rPlaneHNF ) );
+}
+
+//! Splits the mesh along several iso lines of the function values in a single pass.
+//! If faces are currently selected, the function will only split selected faces.
+//! @param rIsoVals thresholds.
+//! @param rDuplicateVertices If set, vertices will be duplicated along the iso lines.
+//! @param rNoRedraw If set, does not force a redraw. Increases speed.
+//! @param rUniformOffset vector to move duplicated vertices apart.
+bool Mesh::splitByIsoLines( const std::vector<double>& rIsoVals, bool rDuplicateVertices, bool rNoRedraw, Vector3D rUniformOffset ) {
+	vector<double> vertexFuncVals( getVertexNr(), _NOT_A_NUMBER_DBL_ );
+	parallelFor( vertexFuncVals.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			getVertexPos( vertIdx )->getFuncValue( &vertexFuncVals[vertIdx] );
+		}
+	} );
+	return( splitByLevels( vertexFuncVals, rIsoVals, rDuplicateVertices, rNoRedraw, rUniformOffset ) );
+}
+
+//! Splits the faces along level sets of a scalar field given per vertex - see ScalarFieldSplit.
+//! The faces are classified and the intersections are computed in parallel and once per edge.
+//! The new primitives are inserted in bulk by a transaction - see Mesh::editCommit.
+//! The new vertices get the position, color and function value interpolated along their edge.
+//! The texture coordinates of the new faces are interpolated likewise.
+//! If faces are currently selected, the function will only split selected faces.
+//!
+//! @param rVertexValues value per vertex.
+//! @param rLevels values of the level sets.
+//! @param rDuplicateVertices If set, vertices will be duplicated along the level sets.
+//! @param rNoRedraw If set, does not force a redraw. Increases speed.
+//! @param rUniformOffset vector to move duplicated vertices apart, which is added on the side of the larger values.
+//! @returns False in case of an error. True otherwise.
+bool Mesh::splitByLevels(
+                const std::vector<double>& rVertexValues,
+                const std::vector<double>& rLevels,
+                bool                       rDuplicateVertices,
+                bool                       rNoRedraw,
+                Vector3D                   rUniformOffset
+) {
+	if( isEditActive() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Not possible within an open transaction!\n";
+		return( false );
+	}
+	const uint64_t vertexNr = getVertexNr();
+	const uint64_t faceNr   = getFaceNr();
+	// Maintain indices in case the index do not match the position within the vector.
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			getVertexPos( vertIdx )->setIndex( vertIdx );
+		}
+	} );
+	vector<uint64_t> faceVertexIndices( faceNr * 3 );
+	parallelFor( faceNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* face = getFacePos( faceIdx );
+			face->setIndex( faceIdx );
+			faceVertexIndices[faceIdx*3]   = face->getVertAIndex();
+			faceVertexIndices[faceIdx*3+1] = face->getVertBIndex();
+			faceVertexIndices[faceIdx*3+2] = face->getVertCIndex();
+		}
+	} );
+	const bool selectedOnly = !mFacesSelected.empty();
+	vector<unsigned char> faceMask;
+	if( selectedOnly ) {
+		cout << "[Mesh::" << __FUNCTION__ << "] Processing only selected faces: " << mFacesSelected.size() << endl;
+		faceMask.resize( faceNr, 0 );
+		for( Face* currFace : mFacesSelected ) {
+			faceMask[currFace->getIndex()] = 1;
+		}
+	}
+
+	ScalarFieldSplit fieldSplit;
+	if( !fieldSplit.split( rVertexValues, faceVertexIndices, rLevels, rDuplicateVertices, selectedOnly ? &faceMask : nullptr ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Bad values or vertex indices!\n";
+		return( false );
+	}
+	const vector<uint64_t>&                     splitFaces  = fieldSplit.getSplitFaces();
+	const vector<ScalarFieldSplit::sNewVertex>& newVertices = fieldSplit.getNewVertices();
+	const vector<ScalarFieldSplit::sNewFace>&   newFaces    = fieldSplit.getNewFaces();
+	cout << "[Mesh::" << __FUNCTION__ << "] Faces split: " << splitFaces.size() << " New faces: " << newFaces.size()
+	     << " New vertices: " << newVertices.size() << endl;
 
-	auto intersectFun = [rIsoVal](Face* face) { return face->isOnFuncValIsoLine( rIsoVal);};
-
-	auto distFun = [rIsoVal](VertexOfFace* vertex) {
-		double retVal;
-		vertex->getFuncValue(&retVal);
-		return retVal - rIsoVal;
+	// If `rDuplicateVertices` is set, the vertex position will be changed by this vector
+	Vector3D vecOffset = rUniformOffset;
+	vecOffset.setH( 1.0 );
+	vector<Vertex*> verticesNew( newVertices.size() );
+	parallelFor( newVertices.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			const ScalarFieldSplit::sNewVertex& newVertex = newVertices[i];
+			Vertex* vertA = getVertexPos( newVertex.mVertA );
+			Vertex* vertB = getVertexPos( newVertex.mVertB );
+			const double t = newVertex.mT;
+			Vector3D position = vertA->getPositionVector() * ( 1.0 - t ) + vertB->getPositionVector() * t;
+			if( newVertex.mSide > 0 ) {
+				position += vecOffset;
+			} else if( newVertex.mSide < 0 ) {
+				position -= vecOffset;
+			}
+			position.setH( 1.0 );
+			VertexOfFace* vertexCreated = new VertexOfFace( position );
+			vertexCreated->setRGB( static_cast<unsigned char>( ( 1.0 - t ) * vertA->getR() + t * vertB->getR() + 0.5 ),
+			                       static_cast<unsigned char>( ( 1.0 - t ) * vertA->getG() + t * vertB->getG() + 0.5 ),
+			                       static_cast<unsigned char>( ( 1.0 - t ) * vertA->getB() + t * vertB->getB() + 0.5 ) );
+			double funcValA = _NOT_A_NUMBER_DBL_;
+			double funcValB = _NOT_A_NUMBER_DBL_;
+			vertA->getFuncValue( &funcValA );
+			vertB->getFuncValue( &funcValB );
+			vertexCreated->setFuncValue( ( t == 0.0 ) ? funcValA : ( 1.0 - t ) * funcValA + t * funcValB );
+			verticesNew[i] = vertexCreated;
+		}
+	} );
+	// Sequential, as the constructor of a face connects it to its vertices:
+	auto getVertexOfFace = [&]( uint64_t rVertIdx ) {
+		return( static_cast<VertexOfFace*>( ( rVertIdx < vertexNr ) ? getVertexPos( rVertIdx ) : verticesNew[rVertIdx - vertexNr] ) );
 	};
+	vector<Face*> facesNew( newFaces.size() );
+	for( uint64_t i=0; i<newFaces.size(); i++ ) {
+		const uint64_t* vertIdx = newFaces[i].mVertIdx;
+		facesNew[i] = new Face( faceNr + i, getVertexOfFace( vertIdx[0] ), getVertexOfFace( vertIdx[1] ), getVertexOfFace( vertIdx[2] ) );
+	}
+	parallelFor( newFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			const ScalarFieldSplit::sNewFace& newFace = newFaces[i];
+			const Face* faceSplit = getFacePos( newFace.mFaceIdx );
+			const std::array<float,6> uvsSplit = faceSplit->getUVs();
+			std::array<float,6> uvs;
+			for( unsigned int k=0; k<3; k++ ) {
+				const float t = static_cast<float>( newFace.mCornerT[k] );
+				uvs[2*k]   = ( 1.0f - t ) * uvsSplit[2*newFace.mCornerFrom[k]]   + t * uvsSplit[2*newFace.mCornerTo[k]];
+				uvs[2*k+1] = ( 1.0f - t ) * uvsSplit[2*newFace.mCornerFrom[k]+1] + t * uvsSplit[2*newFace.mCornerTo[k]+1];
+			}
+			facesNew[i]->setUVs( uvs );
+			facesNew[i]->setTextureId( faceSplit->getTextureId() );
+		}
+	} );
+
+	// Vertices of the split faces, whose adjacent faces have to be reconnected.
+	set<Face*>      facesRemove;
+	vector<Vertex*> verticesAdjacent;
+	verticesAdjacent.reserve( 3 * splitFaces.size() );
+	for( const uint64_t faceIdx : splitFaces ) {
+		Face* face = getFacePos( faceIdx );
+		facesRemove.insert( face );
+		verticesAdjacent.push_back( face->getVertA() );
+		verticesAdjacent.push_back( face->getVertB() );
+		verticesAdjacent.push_back( face->getVertC() );
+	}
+	editBegin();
+	editRemoveFaces( facesRemove );
+	editInsertVertices( verticesNew );
+	editInsertFaces( facesNew );
+	if( rNoRedraw ) {
+		Mesh::editCommit();
+	} else {
+		editCommit();
+	}
 
-	auto getIntersectionVectorFun = [rIsoVal, this] (VertexOfFace* vertX, VertexOfFace* vertY, Vector3D& rVecIntersection)  {
-		this->getPointOnIsoLine(&rVecIntersection, vertX, vertY, rIsoVal);
-	};
+	// Re-establish mesh
+	vector<Face*> facesReconnect( facesNew );
+	for( Vertex* vertex : verticesAdjacent ) {
+		vertex->getFaces( &facesReconnect );
+	}
+	std::sort( facesReconnect.begin(), facesReconnect.end() );
+	facesReconnect.erase( std::unique( facesReconnect.begin(), facesReconnect.end() ), facesReconnect.end() );
+	for( Face* face : facesReconnect ) {
+		face->reconnectToFaces();
+	}
+	if( selectedOnly ) {
+		// The selected faces are either replaced or not intersected.
+		mFacesSelected.clear();
+		selectedMFacesChanged();
+	}
 
-	return splitMesh(intersectFun, distFun, getIntersectionVectorFun, duplicateVertices, noRedraw, rUniformOffset);
+	// Apply other nessary methods
+	return( changedMesh() );
 }
 
 //----------------------------------
@@ -5374,6 +5604,9 @@ int Mesh::removeFeatureVectors() {
 			vertNotAssigned++;
 		}
 	}
+	if( vertNotAssigned == 0 ) {
+		mFeatureVecStore.clear();
+	}
 	return vertNotAssigned;
 }
 
@@ -5414,12 +5647,15 @@ bool Mesh::computeMSIIQuick(
 	// Pre-compute sparse filte:
 	voxelFilter2DElements* sparseFilters;
 	generateVoxelFilters2D( multiscaleRadiiSize, multiscaleRadii, rxyzDim, &sparseFilters );
+	// ... merged for a single pass over all scales:
+	voxelFilter2DMultiscale multiscaleFilter;
+	const bool multiscaleFilterValid = generateVoxelFilters2DMultiscale( sparseFilters, multiscaleRadiiSize, rxyzDim, &multiscaleFilter );
 
 	// Prepare array for (1st) volume integral invariant filter responses
-	double* descriptVolume = new double[this->getVertexNr()*multiscaleRadiiSize];
+	std::vector<double> descriptVolume( this->getVertexNr()*multiscaleRadiiSize );
 
 	// Determine number of threads using CPU cores minus one.
-	const unsigned int availableConcurrentThreads =  std::thread::hardware_concurrency() - 1;
+	const unsigned int availableConcurrentThreads = std::max( 2U, std::thread::hardware_concurrency() ) - 1;
 	std::cout << "[GigaMesh::" << __FUNCTION__ << "] Computing vertex normals using "
 	          << availableConcurrentThreads << " threads" << std::endl;
 
@@ -5433,31 +5669,28 @@ bool Mesh::computeMSIIQuick(
 		setMeshData[t].multiscaleRadiiSize    = multiscaleRadiiSize;
 		setMeshData[t].multiscaleRadii        = multiscaleRadii;
 		setMeshData[t].sparseFilters          = &sparseFilters;
+		setMeshData[t].multiscaleFilter       = multiscaleFilterValid ? &multiscaleFilter : nullptr;
 		setMeshData[t].mPatchNormal           = nullptr;
-		setMeshData[t].descriptVolume         = descriptVolume;
+		setMeshData[t].descriptVolume         = descriptVolume.data();
 		setMeshData[t].descriptSurface        = nullptr;
 	}
 
 	// Use MSII function for parallel processing and normal estimation
 	compFeatureVectorsMain( setMeshData, availableConcurrentThreads );
 
-	// Assing computed feature vectors to vertices
-	for( uint64_t i=0; i<this->getVertexNr(); i++ ) {
-		Vertex* currVert = this->getVertexPos( i );
-		if( !currVert->assignFeatureVec( &descriptVolume[i*multiscaleRadiiSize],
-		                                 multiscaleRadiiSize ) ) {
-			std::cerr << "[GigaMesh] ERROR: Assignment of volume based feature vectors"
-			          << "to vertices failed for Vertex No. " << i << "!" << std::endl;
-			retVal |= false;
-		}
+	// Assing computed feature vectors to vertices - without copying.
+	if( !adoptFeatureVectors( descriptVolume, multiscaleRadiiSize ) ) {
+		std::cerr << "[GigaMesh] ERROR: Assignment of volume based feature vectors"
+		          << "to vertices failed!" << std::endl;
+		retVal |= false;
 	}
 
 	// Compute a function value per vertex using the feature vectors
 	retVal |= funcVertFeatureVecMax();
 
 	// Cleanup
-	delete[] descriptVolume;
 	delete[] setMeshData;
+	freeVoxelFilters2DMultiscale( &multiscaleFilter );
 	showProgressStop( "MSII filtering (Quick)" );
 
 	return( retVal );
@@ -5699,6 +5932,10 @@ bool Mesh::estFeatureDistManToVertex( Primitive* rSomePrim, double** funcValues,
 //! Computes the manhattan distances of a given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureDistManToVertex( double* someFeatureVector, double** funcValues, Vertex*** vertices, int* vertCount ) {
+	// Contiguous feature vectors, when available:
+	if( estFeatureDistByStore( FeatureVecStore::FEATURE_DIST_MANHATTAN, someFeatureVector, funcValues, vertices, vertCount ) ) {
+		return true;
+	}
 	*vertices   = new Vertex*[getVertexNr()];
 	*funcValues = new double[getVertexNr()];
 	*vertCount  = getVertexNr();
@@ -5743,6 +5980,10 @@ bool Mesh::estFeatureDistEucToVertex( Primitive* rSomePrim, double** rFuncValues
 //! Computes the distances of a the given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureDistEucToVertex( double* someFeatureVector, double** funcValues, Vertex*** vertices, int* vertCount ) {
+	// Contiguous feature vectors, when available:
+	if( estFeatureDistByStore( FeatureVecStore::FEATURE_DIST_EUCLIDEAN, someFeatureVector, funcValues, vertices, vertCount ) ) {
+		return true;
+	}
 	*vertices   = new Vertex*[getVertexNr()];
 	*funcValues = new double[getVertexNr()];
 	*vertCount  = getVertexNr();
@@ -5787,6 +6028,10 @@ bool Mesh::estFeatureDistEucNormToVertex( Primitive* rSomePrim, double** rFuncVa
 //! Computes the distances of a the given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureDistEucNormToVertex( double* someFeatureVector, double** funcValues, Vertex*** vertices, int* vertCount ) {
+	// Contiguous feature vectors, when available:
+	if( estFeatureDistByStore( FeatureVecStore::FEATURE_DIST_EUCLIDEAN_NORM, someFeatureVector, funcValues, vertices, vertCount ) ) {
+		return true;
+	}
 	*vertices   = new Vertex*[getVertexNr()];
 	*funcValues = new double[getVertexNr()];
 	*vertCount  = getVertexNr();
@@ -5831,6 +6076,10 @@ bool Mesh::estFeatureCosineSimToVertex( Primitive* rSomePrim, double** rFuncValu
 //! Computes the cosine similarity of a given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureCosineSimToVertex( double* rSomeFeatureVector, double** rFuncValues, Vertex*** rVertices, int* rVertCount ) {
+	// Contiguous feature vectors, when available:
+	if( estFeatureDistByStore( FeatureVecStore::FEATURE_DIST_COSINE_ACOS, rSomeFeatureVector, rFuncValues, rVertices, rVertCount ) ) {
+		return true;
+	}
 	*rVertices   = new Vertex*[getVertexNr()];
 	*rFuncValues = new double[getVertexNr()];
 	*rVertCount  = getVertexNr();
@@ -5876,6 +6125,10 @@ bool Mesh::estFeatureTanimotoDistTo( Primitive* rSomePrim, double** rFuncValues,
 //! Computes the cosine similarity of a given feature vector to the feature vectors of all Vertices.
 //! @returns false in case of an error. True otherwise.
 bool Mesh::estFeatureTanimotoDistTo( double* rSomeFeatureVector, double** rFuncValues, Vertex*** rVertices, int* rVertCount ) {
+	// Contiguous feature vectors, when available:
+	if( estFeatureDistByStore( FeatureVecStore::FEATURE_DIST_TANIMOTO, rSomeFeatureVector, rFuncValues, rVertices, rVertCount ) ) {
+		return true;
+	}
 	*rVertices   = new Vertex*[getVertexNr()];
 	*rFuncValues = new double[getVertexNr()];
 	*rVertCount  = getVertexNr();
@@ -5893,6 +6146,32 @@ bool Mesh::estFeatureTanimotoDistTo( double* rSomeFeatureVector, double** rFuncV
 	return true;
 }
 
+//! Computes the distances of a given feature vector to the feature vectors of all Vertices
+//! using the contiguous Mesh::mFeatureVecStore.
+//! @returns false, when the store is not in use by the vertices or in case of an error - the caller has to fall back to the vertices. True otherwise.
+bool Mesh::estFeatureDistByStore(
+                FeatureVecStore::eFeatureDistance rDistance,            //!< Distance measure.
+                const double*                     rSomeFeatureVector,   //!< Reference feature vector.
+                double**                          rFuncValues,          //!< Output: distances.
+                Vertex***                         rVertices,            //!< Output: vertices.
+                int*                              rVertCount            //!< Output: number of vertices.
+) {
+	if( !isFeatureVecStoreInUse() ) {
+		return false;
+	}
+	vector<double> distances;
+	if( !mFeatureVecStore.computeDistances( rDistance, rSomeFeatureVector, distances, &mVerticesFeatVecStd ) ) {
+		return false;
+	}
+	const uint64_t vertexCount = getVertexNr();
+	*rVertices   = new Vertex*[vertexCount];
+	*rFuncValues = new double[vertexCount];
+	*rVertCount  = vertexCount;
+	std::copy( mVertices.begin(), mVertices.end(), *rVertices );
+	std::copy( distances.begin(), distances.end(), *rFuncValues );
+	return true;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
 // --- Other feature vector related functions ------------------------------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -6356,6 +6635,7 @@ bool Mesh::estFeatureAutoCorrelationVertex( Primitive* somePrim, double** funcVa
 	}
 	cout << "[Mesh::estFeatureCorrelationVertex] fetch indices time: " << static_cast<float>( clock() - timeStart ) / CLOCKS_PER_SEC << " seconds."  << endl;
 
+	changedVertFuncVal();
 	return true;
 #endif
 }
@@ -6912,6 +7192,9 @@ bool Mesh::labelVertices(
 	rVerticesSeeds.clear();
 	// tell other methods (e.g. OpenGL) that stuff has changed
 	labelsChanged();
+	if( setLabelStepToFuncVal ) {
+		changedVertFuncVal();
+	}
 	setLabel -= 1; // Correct for indexing begining at ONE.
 	cout << "[Mesh::" << __FUNCTION__ << "] " << verticesLabeled << " vertices labeld out of " << verticesToLabel << endl;
 	cout << "[Mesh::" << __FUNCTION__ << "] " << setLabel << " Labels set." << endl;
@@ -7231,49 +7514,71 @@ Vector3D Mesh::getCentroidByNormal(std::set<Vertex*> *clusterSet)
 // ---------------------------------------------------------------------------------------------------
 
 //! Compute the integral invariants and their extrema of the polylines using the run-length. See PolyLine.
+//! The polylines are processed in parallel.
 bool Mesh::compPolylinesIntInvRunLen( double rIIRadius, PolyLine::ePolyIntInvDirection rDirection ) {
-	unsigned int ctrError = 0;
-	PolyLine* currPoly;
-	for( unsigned int i=0; i<getPolyLineNr(); i++ ) {
-		currPoly = getPolyLinePos( i );
-		if( !currPoly->isClosed() ) {
-			cout << "[Mesh::" << __FUNCTION__ << "] Polyline " << i << " ignored as it is not closed." << endl;
-			continue;
-		}
-		if( !currPoly->compIntInv( rIIRadius, rDirection ) ) {
-			ctrError++;
-		}
-		// Compute COG
-		currPoly->compVertAvgCog();
-		// Compute normal
-		currPoly->compVertAvgNormal();
-	}
-	if( ctrError > 0 ) {
-		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: " << getPolyLineNr() << " Polylines processed - " << ctrError << " errors occured!" << endl;
-		return false;
-	}
-	cout << "[Mesh::" << __FUNCTION__ << "] " << getPolyLineNr() << " Polylines processed." << endl;
-	return true;
+	return compPolylinesIntInv( [rIIRadius,rDirection]( unsigned int, PolyLine* rPoly ) {
+		return rPoly->compIntInv( rIIRadius, rDirection );
+	} );
 }
 
 //! Compute the integral invariants and their extrema of the polylines using the angle. See PolyLine.
+//! The polylines are processed in parallel.
 bool Mesh::compPolylinesIntInvAngle( double rIIRadius ) {
 	cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
-	unsigned int ctrError = 0;
-	PolyLine* currPoly;
+	return compPolylinesIntInv( [rIIRadius]( unsigned int, PolyLine* rPoly ) {
+		return rPoly->compIntInvAngle( rIIRadius );
+	} );
+}
+
+//! Compute the run-length integral invariants of all closed polylines for several radii in a single pass.
+//! See PolyLine::compIntInvRadii.
+//! @param rValues per polyline: row-major matrix with one value per vertex and radius. Empty for open polylines.
+//! @returns false in case of an error.
+bool Mesh::compPolylinesIntInvRunLenRadii(
+                const vector<double>&           rRadii,      //!< Radii of the spheres.
+                PolyLine::ePolyIntInvDirection  rDirection,  //!< Direction(s) for the run-length.
+                vector<vector<double>>*         rValues      //!< Output: one matrix per polyline.
+) {
+	if( rValues == nullptr ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: NULL pointer given!" << endl;
+		return false;
+	}
+	rValues->clear();
+	rValues->resize( getPolyLineNr() );
+	return compPolylinesIntInv( [&rRadii,rDirection,rValues]( unsigned int rPolyIdx, PolyLine* rPoly ) {
+		return rPoly->compIntInvRadii( rRadii, rDirection, &(*rValues)[rPolyIdx] );
+	}, false );
+}
+
+//! Applies rCompute( index, polyline ) to all closed polylines in parallel - open polylines are ignored.
+//! @param rSetCogNormal sets the center of gravity and normal of the polylines afterwards.
+//! @returns false in case of an error.
+bool Mesh::compPolylinesIntInv( const std::function<bool(unsigned int,PolyLine*)>& rCompute, bool rSetCogNormal ) {
+	vector<unsigned int> closedPolys;
 	for( unsigned int i=0; i<getPolyLineNr(); i++ ) {
-		currPoly = getPolyLinePos( i );
+		PolyLine* currPoly = getPolyLinePos( i );
 		if( !currPoly->isClosed() ) {
 			cout << "[Mesh::" << __FUNCTION__ << "] Polyline " << i << " ignored as it is not closed." << endl;
 			continue;
 		}
-		if( !currPoly->compIntInvAngle( rIIRadius ) ) {
-			ctrError++;
+		closedPolys.push_back( i );
+	}
+	std::atomic<unsigned int> ctrError{ 0 };
+	parallelFor( closedPolys.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			if( !rCompute( closedPolys[i], mPolyLines[closedPolys[i]] ) ) {
+				ctrError++;
+			}
+		}
+	}, 1 );
+	if( rSetCogNormal ) {
+		for( const unsigned int polyIdx : closedPolys ) {
+			PolyLine* currPoly = mPolyLines[polyIdx];
+			// Compute COG
+			currPoly->compVertAvgCog();
+			// Compute normal
+			currPoly->compVertAvgNormal();
 		}
-		// Compute COG
-		currPoly->compVertAvgCog();
-		// Compute normal
-		currPoly->compVertAvgNormal();
 	}
 	if( ctrError > 0 ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: " << getPolyLineNr() << " Polylines processed - " << ctrError << " errors occured!" << endl;
@@ -7395,11 +7700,7 @@ bool Mesh::isolineToPolylineMultiple() {
 	if( !showEnterText( multipleIsoValues, "Enter multiple isovalues" ) ) {
 		return( false );
 	}
-	bool retVal = true;
-	for( auto const& isoValue: multipleIsoValues ) {
-		retVal |= isolineToPolyline( isoValue );
-	}
-	return( retVal );
+	return( isolinesToPolylines( multipleIsoValues ) );
 }
 
 //! Compute isolines using the function values using the stored threshold.
@@ -7451,6 +7752,50 @@ bool Mesh::isolineToPolyline(
 		std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Given iso-value is not finite!" << std::endl;
 		return( false );
 	}
+	return( isolinesToPolylines( vector<double>{ rIsoValue }, rPlaneIntersect ) );
+}
+
+//! Compute the isolines of multiple iso-values within a single pass over the faces.
+//!
+//! The faces are bucketed by the iso-values within the range of their function values,
+//! so each face is only checked for the iso-values it can intersect. Afterwards the
+//! iso-values are traced in parallel - each with its own bit array of visited faces.
+//!
+//! The polylines are identical to calling isolineToPolyline for each iso-value:
+//! they are appended in the order of the given iso-values and for each iso-value
+//! in the order of the faces they start from.
+//!
+//! Optional: plane, which is typically stored with isolines based on distances to planes
+//!           and used for projection to 2D during SVG export.
+//!
+//! @returns false in case of an error e.g. non-finite iso-values, which are skipped. True otherwise.
+bool Mesh::isolinesToPolylines(
+    const vector<double>& rIsoValues,      //!< Isovalues to compute the isolines.
+    Plane*                rPlaneIntersect  //!< Optional plane for intersections. Will be stored with the isolines.
+) {
+	bool retVal = true;
+	// Finite iso-values in ascending order - as indices into rIsoValues.
+	vector<uint64_t> isoOrder;
+	isoOrder.reserve( rIsoValues.size() );
+	for( uint64_t i=0; i<rIsoValues.size(); i++ ) {
+		if( !isfinite( rIsoValues[i] ) ) {
+			std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Iso-value no. " << i << " is not finite!" << std::endl;
+			retVal = false;
+			continue;
+		}
+		isoOrder.push_back( i );
+	}
+	if( isoOrder.empty() ) {
+		return( false );
+	}
+	std::stable_sort( isoOrder.begin(), isoOrder.end(), [&rIsoValues]( uint64_t rIdx1, uint64_t rIdx2 ) {
+		return( rIsoValues[rIdx1] < rIsoValues[rIdx2] );
+	} );
+	const uint64_t isoCount = isoOrder.size();
+	vector<double> isoSorted( isoCount );
+	for( uint64_t k=0; k<isoCount; k++ ) {
+		isoSorted[k] = rIsoValues[isoOrder[k]];
+	}
 
 	//! \todo Fetching the label related information, makes only sense for outlines of connected components. Therefore optimizations might be possible at this point.
 	// Fetch label normals first.
@@ -7462,146 +7807,213 @@ bool Mesh::isolineToPolyline(
 		labelCenter /= labelCenter.getH();
 	}
 
-	// Bit array:
-	      uint64_t* facesVisitedBitArray;
-	const uint64_t  faceBlocksNr = getBitArrayFaces( &facesVisitedBitArray );
-
-	auto setFaceVisited = [&facesVisitedBitArray] (Face* face) {
-		uint64_t  bOffset;
-		uint64_t  bNr;
-		face->getIndexOffsetBit(&bOffset, &bNr);
-		facesVisitedBitArray[bOffset] |= static_cast<uint64_t>(1) << bNr;
-	};
-
-	auto traceIsoLine = [&setFaceVisited, &facesVisitedBitArray] (Face* startFace, bool forward, double rIsoValue, PolyLine* isoLine)
-	{
-		Vector3D  isoPoint;
-		Face*     nextFace = nullptr;
-		Face*     excludeFace = nullptr;
-		uint64_t  bitOffset;
-		uint64_t  bitNr;
+	// Range of sorted iso-values within the function values of each face.
+	// Face::isOnFuncValIsoLine tests the signs of products, which underflow to zero for
+	// iso-values closer than ~1e-162 to a function value. Therefore the range is widened
+	// slightly, so that the buckets contain all faces along an isoline.
+	const double   isoRangeMargin = 1e-150;
+	const uint64_t faceCount = getFaceNr();
+	vector<uint64_t> faceIsoFirst( faceCount );
+	vector<uint64_t> faceIsoLast( faceCount );
+	parallelFor( faceCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* currFace = getFacePos( faceIdx );
+			double funcValA = _NOT_A_NUMBER_DBL_;
+			double funcValB = _NOT_A_NUMBER_DBL_;
+			double funcValC = _NOT_A_NUMBER_DBL_;
+			currFace->getVertA()->getFuncValue( &funcValA );
+			currFace->getVertB()->getFuncValue( &funcValB );
+			currFace->getVertC()->getFuncValue( &funcValC );
+			// fmin and fmax ignore not-a-number.
+			const double funcValMin = std::fmin( std::fmin( funcValA, funcValB ), funcValC ) - isoRangeMargin;
+			const double funcValMax = std::fmax( std::fmax( funcValA, funcValB ), funcValC ) + isoRangeMargin;
+			if( !( funcValMin <= funcValMax ) ) {
+				faceIsoFirst[faceIdx] = 0;
+				faceIsoLast[faceIdx]  = 0;
+				continue;
+			}
+			faceIsoFirst[faceIdx] = std::lower_bound( isoSorted.begin(), isoSorted.end(), funcValMin ) - isoSorted.begin();
+			faceIsoLast[faceIdx]  = std::upper_bound( isoSorted.begin(), isoSorted.end(), funcValMax ) - isoSorted.begin();
+		}
+	} );
 
-		// Trace in forward direction:
-		//----------------------------
-		if(!startFace->getFuncValIsoPoint( rIsoValue, &isoPoint, &nextFace, forward, &excludeFace ))
-		{
-			return; //skip face, because it only touches the isoLine on its vertices
+	// Buckets of candidate faces per iso-value in ascending order of the faces.
+	vector<uint64_t> bucketOffset( isoCount+1, 0 );
+	for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+		for( uint64_t k=faceIsoFirst[faceIdx]; k<faceIsoLast[faceIdx]; k++ ) {
+			bucketOffset[k+1]++;
 		}
-		if(excludeFace != nullptr)
-		{
-			setFaceVisited(excludeFace);
+	}
+	for( uint64_t k=0; k<isoCount; k++ ) {
+		bucketOffset[k+1] += bucketOffset[k];
+	}
+	vector<uint64_t> bucketFaces( bucketOffset[isoCount] );
+	{
+		vector<uint64_t> bucketPos( bucketOffset.begin(), bucketOffset.end()-1 );
+		for( uint64_t faceIdx=0; faceIdx<faceCount; faceIdx++ ) {
+			for( uint64_t k=faceIsoFirst[faceIdx]; k<faceIsoLast[faceIdx]; k++ ) {
+				bucketFaces[bucketPos[k]++] = faceIdx;
+			}
 		}
-		// ... add to polyline with normal ....
-		Vector3D normalPos = startFace->getNormal( true );
+	}
+	faceIsoFirst.clear();
+	faceIsoFirst.shrink_to_fit();
+	faceIsoLast.clear();
+	faceIsoLast.shrink_to_fit();
+
+	// Bit arrays of visited faces per thread. Only the touched blocks are reset for the next iso-value.
+	const uint64_t faceBlocksNr = faceCount / ( 8*sizeof( uint64_t ) ) + 1;
+	vector<vector<uint64_t>> threadFacesVisited( getParallelThreadCount() );
+	vector<vector<uint64_t>> threadBlocksTouched( getParallelThreadCount() );
+	vector<vector<PolyLine*>> isoLinesPerIsoValue( rIsoValues.size() );
 
-		forward ? isoLine->addFront( isoPoint, normalPos, startFace )
-		        : isoLine->addBack ( isoPoint, normalPos, startFace );
+	parallelFor( isoCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		vector<uint64_t>& facesVisitedBitArray = threadFacesVisited[rThreadIdx];
+		vector<uint64_t>& blocksTouched        = threadBlocksTouched[rThreadIdx];
+		if( facesVisitedBitArray.empty() ) {
+			facesVisitedBitArray.resize( faceBlocksNr, 0 );
+		}
 
-		Face* checkFace = nextFace;
-		while( checkFace != nullptr ) {
-			checkFace->getIndexOffsetBit( &bitOffset, &bitNr );
+		auto isFaceVisited = [&facesVisitedBitArray] ( Face* rFace ) {
+			uint64_t  bOffset;
+			uint64_t  bNr;
+			rFace->getIndexOffsetBit( &bOffset, &bNr );
+			return( ( facesVisitedBitArray[bOffset] & static_cast<uint64_t>(1) << bNr ) != 0 );
+		};
 
-			// check if we have been there to prevent infinite loops:
-			if( facesVisitedBitArray[bitOffset] & static_cast<uint64_t>(1)<<bitNr ) {
-				break;
+		auto setFaceVisited = [&facesVisitedBitArray, &blocksTouched] ( Face* rFace ) {
+			uint64_t  bOffset;
+			uint64_t  bNr;
+			rFace->getIndexOffsetBit( &bOffset, &bNr );
+			if( facesVisitedBitArray[bOffset] == 0 ) {
+				blocksTouched.push_back( bOffset );
 			}
-			// set visited
-			facesVisitedBitArray[bitOffset] |= static_cast<uint64_t>(1)<<bitNr;
+			facesVisitedBitArray[bOffset] |= static_cast<uint64_t>(1) << bNr;
+		};
 
-			// get the point ...
-			if(!checkFace->getFuncValIsoPoint( rIsoValue, &isoPoint, &nextFace, forward, &excludeFace ))
+		auto traceIsoLine = [&setFaceVisited, &isFaceVisited] ( Face* startFace, bool forward, double rIsoValue, PolyLine* isoLine )
+		{
+			Vector3D  isoPoint;
+			Face*     nextFace = nullptr;
+			Face*     excludeFace = nullptr;
+
+			// Trace in forward direction:
+			//----------------------------
+			if(!startFace->getFuncValIsoPoint( rIsoValue, &isoPoint, &nextFace, forward, &excludeFace ))
 			{
-				nextFace = nullptr;
-				continue;
+				return; //skip face, because it only touches the isoLine on its vertices
 			}
 			if(excludeFace != nullptr)
 			{
 				setFaceVisited(excludeFace);
 			}
-			// ... add to polyline with normal ...
-			normalPos = checkFace->getNormal( true );
+			// ... add to polyline with normal ....
+			Vector3D normalPos = startFace->getNormal( true );
 
-			forward ? isoLine->addFront( isoPoint, normalPos, checkFace )
-			        : isoLine->addBack ( isoPoint, normalPos, checkFace );
+			forward ? isoLine->addFront( isoPoint, normalPos, startFace )
+			        : isoLine->addBack ( isoPoint, normalPos, startFace );
 
-			// .... move on:
-			checkFace = nextFace;
-		}
-	};
+			Face* checkFace = nextFace;
+			while( checkFace != nullptr ) {
+				// check if we have been there to prevent infinite loops:
+				if( isFaceVisited( checkFace ) ) {
+					break;
+				}
+				// set visited
+				setFaceVisited( checkFace );
 
-	const uint64_t numBits = sizeof(uint64_t) * 8;
+				// get the point ...
+				if(!checkFace->getFuncValIsoPoint( rIsoValue, &isoPoint, &nextFace, forward, &excludeFace ))
+				{
+					nextFace = nullptr;
+					continue;
+				}
+				if(excludeFace != nullptr)
+				{
+					setFaceVisited(excludeFace);
+				}
+				// ... add to polyline with normal ...
+				normalPos = checkFace->getNormal( true );
 
-	for( uint64_t i=0; i<faceBlocksNr; ++i ) {
-		if( facesVisitedBitArray[i] == 0xFFFFFFFFFFFFFFFF ) {
-			// whole block visited.
-			continue;
-		}
-		for( uint64_t j=0; j<numBits; ++j ) {
-			const uint64_t currFaceIndex = i*numBits+j;
+				forward ? isoLine->addFront( isoPoint, normalPos, checkFace )
+				        : isoLine->addBack ( isoPoint, normalPos, checkFace );
 
-			// skip unused bits within the last block:
-			if( ( i==faceBlocksNr-1 ) && ( currFaceIndex >= getFaceNr() ) ) {
-				break;
+				// .... move on:
+				checkFace = nextFace;
 			}
+		};
 
-			uint64_t currentBit = static_cast<uint64_t>(1) << j;
-			if( facesVisitedBitArray[i] & currentBit ) {
-				// face already visited.
-				continue;
-			}
-			//cout << "[Mesh::isolineToPolyline] Check Face in Block No. " << i << " Bit No. " << j << endl;
-			Face* checkFace = getFacePos( currFaceIndex );
-			if( !checkFace->isOnFuncValIsoLine( rIsoValue ) ) {
-				// when the face is not along the isoline, we mark it visited and move on:
-				facesVisitedBitArray[i] |= currentBit;
-				continue;
-			}
-			// store reference for our starting point
-			Face*     checkFaceFirst = checkFace;
-			//
-			bool isLabelLabelBorder;
-			int  labelFromBorder = -1;
-			bool isLabelBorder = checkFaceFirst->vertLabelLabelBorder( &isLabelLabelBorder, &labelFromBorder );
-			if( isLabelBorder ) {
-				if( isLabelLabelBorder ) {
-					LOG::debug() << "[Mesh::" << __FUNCTION__ << "] is on a label-label border.\n";
+		for( uint64_t k=rBegin; k<rEnd; k++ ) {
+			const double       isoValue = isoSorted[k];
+			vector<PolyLine*>& isoLines = isoLinesPerIsoValue[isoOrder[k]];
+			// Faces outside the buckets are not along the isoline and therefore never a starting point.
+			for( uint64_t b=bucketOffset[k]; b<bucketOffset[k+1]; b++ ) {
+				Face* checkFace = getFacePos( bucketFaces[b] );
+				if( isFaceVisited( checkFace ) ) {
+					// face already visited.
+					continue;
+				}
+				if( !checkFace->isOnFuncValIsoLine( isoValue ) ) {
+					// when the face is not along the isoline, we mark it visited and move on:
+					setFaceVisited( checkFace );
+					continue;
+				}
+				// store reference for our starting point
+				Face*     checkFaceFirst = checkFace;
+				//
+				bool isLabelLabelBorder;
+				int  labelFromBorder = -1;
+				bool isLabelBorder = checkFaceFirst->vertLabelLabelBorder( &isLabelLabelBorder, &labelFromBorder );
+				if( isLabelBorder ) {
+					if( isLabelLabelBorder ) {
+						LOG::debug() << "[Mesh::" << __FUNCTION__ << "] is on a label-label border.\n";
+					} else {
+						LOG::debug() << "[Mesh::" << __FUNCTION__ << "] is on a nolabel-label border. labelFromBorder: " << labelFromBorder << "\n";
+					}
 				} else {
-					LOG::debug() << "[Mesh::" << __FUNCTION__ << "] is on a nolabel-label border. labelFromBorder: " << labelFromBorder << "\n";
+					LOG::debug() << "[Mesh::" << __FUNCTION__ << "] is NOT on a label related border.\n";
 				}
-			} else {
-				LOG::debug() << "[Mesh::" << __FUNCTION__ << "] is NOT on a label related border.\n";
-			}
 
-			PolyLine* isoLine;
-			if( isLabelBorder && !isLabelLabelBorder ) {
-				// Remeber: Labels start at index 1!
-				isoLine = new PolyLine( labelCenters.at( labelFromBorder-1 ),
-				                        labelNormals.at( labelFromBorder-1 ),
-				                        labelFromBorder );
-			} else {
-				if( rPlaneIntersect != nullptr ) {
-					isoLine = new PolyLine( *rPlaneIntersect );
+				PolyLine* isoLine;
+				if( isLabelBorder && !isLabelLabelBorder ) {
+					// Remeber: Labels start at index 1!
+					isoLine = new PolyLine( labelCenters.at( labelFromBorder-1 ),
+					                        labelNormals.at( labelFromBorder-1 ),
+					                        labelFromBorder );
 				} else {
-					isoLine = new PolyLine();
+					if( rPlaneIntersect != nullptr ) {
+						isoLine = new PolyLine( *rPlaneIntersect );
+					} else {
+						isoLine = new PolyLine();
+					}
 				}
-			}
 
-			setFaceVisited(checkFaceFirst);
+				setFaceVisited(checkFaceFirst);
 
-			// Trace in forward and backward direction:
-			//----------------------------
-			traceIsoLine(checkFaceFirst, true , rIsoValue, isoLine);
-			traceIsoLine(checkFaceFirst, false, rIsoValue, isoLine);
+				// Trace in forward and backward direction:
+				//----------------------------
+				traceIsoLine(checkFaceFirst, true , isoValue, isoLine);
+				traceIsoLine(checkFaceFirst, false, isoValue, isoLine);
+
+				isoLines.push_back( isoLine );
+			}
+			// Reset the bit array for the next iso-value.
+			for( const uint64_t& blockIdx : blocksTouched ) {
+				facesVisitedBitArray[blockIdx] = 0;
+			}
+			blocksTouched.clear();
+		}
+	}, 1 );
 
-			// Add vertices of the polyline:
+	// Add the polylines and their vertices in the order of the given iso-values.
+	for( auto& isoLines : isoLinesPerIsoValue ) {
+		for( auto& isoLine : isoLines ) {
 			isoLine->addVerticesTo( &mVertices );
-			// Add polyline:
 			mPolyLines.push_back( isoLine );
 		}
 	}
-    polyLinesChanged();
-	delete[] facesVisitedBitArray;
-	return( true );
+	polyLinesChanged();
+	return( retVal );
 }
 
 //! Use the rotational axis to extrude the poylines.
@@ -8663,77 +9075,28 @@ bool Mesh::setVertFuncValOctreeIdx( double rEdgeLen ) {
 
 bool Mesh::setVertFuncValFaceSphereAngleMax( double rRadius ) {
 	//! Compute the maximum face angle to the vertex normal within a spherical neighbourhood and store it as function value
-
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited;
-	int vertNrLongs = getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited;
-	int faceNrLongs = getBitArrayFaces( &faceBitArrayVisited );
-
-	vector<Face*> facesInSphere;
-	vector<Face*>::iterator itFace;
-	Vertex* currVertex;
+	vector<double> maxAngles;
+	if( !estSphereNeighbourhoodStats( rRadius, { SPHERE_STAT_FACE_ANGLE_MAX }, maxAngles ) ) {
+		return false;
+	}
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		Vector3D vertNorm = currVertex->getNormal();
-		fetchSphereBitArray( currVertex, &facesInSphere, static_cast<float>(rRadius), vertNrLongs, vertBitArrayVisited, faceNrLongs, faceBitArrayVisited, false );
-		double maxAngle = -DBL_MAX;
-		for( itFace=facesInSphere.begin(); itFace!=facesInSphere.end(); itFace++ ) {
-			Vector3D faceNorm = (*itFace)->getNormal();
-			double currAngle = angle( faceNorm, vertNorm );
-			if( maxAngle < currAngle ) {
-				maxAngle = currAngle;
-			}
-		}
-		currVertex->setFuncValue( maxAngle );
-		facesInSphere.clear();
+		getVertexPos( vertIdx )->setFuncValue( maxAngles[vertIdx] );
 	}
 
-	delete[] vertBitArrayVisited;
-	delete[] faceBitArrayVisited;
-
 	changedVertFuncVal();
 	return true;
 }
 
 bool Mesh::setVertFuncValFaceSphereMeanAngleMax( double rRadius ) {
 	//! Compute the maximum face angle to the faces mean normal normal within a spherical neighbourhood and store it as function value per vertex.
-
-	// Allocate the bit arrays for vertices:
-	uint64_t* vertBitArrayVisited;
-	int vertNrLongs = getBitArrayVerts( &vertBitArrayVisited );
-	// Allocate the bit arrays for faces:
-	uint64_t* faceBitArrayVisited;
-	int faceNrLongs = getBitArrayFaces( &faceBitArrayVisited );
-
-	vector<Face*> facesInSphere;
-	vector<Face*>::iterator itFace;
-	Vertex* currVertex;
+	vector<double> maxAngles;
+	if( !estSphereNeighbourhoodStats( rRadius, { SPHERE_STAT_FACE_MEAN_ANGLE_MAX }, maxAngles ) ) {
+		return false;
+	}
 	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		fetchSphereBitArray( currVertex, &facesInSphere, static_cast<float>(rRadius), vertNrLongs, vertBitArrayVisited, faceNrLongs, faceBitArrayVisited, false );
-		//! .) Compute weighted mean normal of the faces.
-		Vector3D vertFaceMean( 0.0, 0.0, 0.0, 0.0 );
-		for( itFace=facesInSphere.begin(); itFace!=facesInSphere.end(); itFace++ ) {
-			vertFaceMean += (*itFace)->getNormal();
-		}
-		//! .) Compute max angle to mean normal.
-		double maxAngle = -DBL_MAX;
-		for( itFace=facesInSphere.begin(); itFace!=facesInSphere.end(); itFace++ ) {
-			Vector3D faceNorm = (*itFace)->getNormal();
-			double currAngle = angle( faceNorm, vertFaceMean );
-			if( maxAngle < currAngle ) {
-				maxAngle = currAngle;
-			}
-		}
-		currVertex->setFuncValue( maxAngle );
-		facesInSphere.clear();
+		getVertexPos( vertIdx )->setFuncValue( maxAngles[vertIdx] );
 	}
 
-	delete[] vertBitArrayVisited;
-	delete[] faceBitArrayVisited;
-
 	changedVertFuncVal();
 	return true;
 }
@@ -9172,65 +9535,9 @@ bool Mesh::funcVertFeatureVecMaxSigned() {
 //! Compute a Mahalanobis distance using the feature vector of the vertices.
 //! Note: that this method is only inspired by the Mahalanobis distance
 //!       in the current implementation (06/2017).
-//! @returns false in case of an error e.g. Alglib not present. True otherwise.
+//! Asks for the reference vector and the weights - see funcVertFeatureVecMahalDist( const vector<double>&, eFuncFeatureVecPNormWeigth ).
+//! @returns false in case of an error or user cancel. True otherwise.
 bool Mesh::funcVertFeatureVecMahalDist() {
-#ifndef ALGLIB
-	cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: ALGLIB is missing and required for this method!" << endl;
-	return false;
-#else
-	// ALGLIB minimal workin example for the matrix multiplication
-	// Requires "ablas.h"
-/*
-	int m = 2; // a - Zeilen
-	int n = 4; // b - Spalten
-	int k = 3; // a - Spalten == b - Zeilen
-	double a[m*k] = { // 2 x 3
-		1,2,3,
-		4,5,6
-	};
-	double b[k*n] = { // 3 x 4
-		7,8,9,10,
-		11,12,13,14,
-		15,16,17,18
-	};
-	ap::real_2d_array aa;
-	ap::real_2d_array bb;
-	aa.setcontent(0,3,0,2,a);
-	bb.setcontent(0,4,0,3,b);
-	for( int i = 0; i < 2; i++ ) { // y
-		for( int j = 0; j < 3; j++ ) { // x
-			cout << aa(i,j) << " ";
-		}
-		cout << endl;
-	}
-	cout << "..........." << endl;
-	for( int i = 0; i < 3; i++ ) { // y
-		for( int j = 0; j < 4; j++ ) { // x
-			cout << bb(i,j) << " ";
-		}
-		cout << endl;
-	}
-	cout << "----------" << endl;
-	ap::real_2d_array cc;
-	cc.setlength( m, n );
-	rmatrixgemm( m, n, k, 1, aa,0,0,0, bb,0,0,0, 0, cc, 0,0 );
-	for( int i = 0; i < 2; i++ ) { // y
-		for( int j = 0; j < 4; j++ ) { // x
-			cout << cc(i,j) << " ";
-		}
-		cout << endl;
-	}
-*/
-	string funcName = "Compute Mahalanobis inspired distance for feature vectors";
-	time_t timeStart = clock();
-
-	// STUB - Reference Vector
-	// 0.611369 0.657464 0.691763 0.7143540.726667 0.727034 0.722448 0.717575 0.713068 0.708751 0.701904 0.68729 0.648809 0.583745 0.475463 0.222697
-	//double refVec[] = { 0.611369, 0.657464, 0.691763, 0.714354,
-	//                    0.726667, 0.727034, 0.722448, 0.717575,
-	//                    0.713068, 0.708751, 0.701904, 0.68729,
-	//                    0.648809, 0.583745, 0.475463, 0.222697 };
-
 	// Fetch feature vector from selection, when present.
 	vector<double> referenceVector;
 	if( mPrimSelected != nullptr ) {
@@ -9241,121 +9548,125 @@ bool Mesh::funcVertFeatureVecMahalDist() {
 		cerr << "[Mesh::" << __FUNCTION__ << "] User cancel or bad values!" << endl;
 		return false;
 	}
-	if( referenceVector.size() == 0 ) {
-		cerr << "[Mesh::" << __FUNCTION__ << "] No reference vector given!" << endl;
-		return false;
-	}
 
 	// Let the user choose between quadric and cubic i.e. for surface or volume integral invariants.
 	bool useCubic = true;
 	bool useLinear = !showQuestion( &useCubic, string( "Cubic, quadric or linear weights" ), \
 	                                string( "YES for cubic weights i.e. volume based integral invariant feature vectors.<br /><br />NO for quadric weights i.e. surface based integral invariant feature vectors.<br /><br />CANCEL for linear weights." ) );
 
-	// Prepare Matrix with weights
-	unsigned int scaleCount = referenceVector.size(); // 16;
-	ap::real_2d_array weightMat;
-	weightMat.setlength( scaleCount, scaleCount );
-	// Init with zeros
-	for( unsigned int i=0; i<scaleCount; i++ ) {         // y
-		for( unsigned int j=0; j<scaleCount; j++ ) { // x
-			weightMat(i,j) = 0.0;
+	eFuncFeatureVecPNormWeigth weigthChoosen = FEATURE_VECTOR_PNORM_WEIGTH_LINEAR;
+	if( !useLinear ) {
+		if( useCubic ) {
+			weigthChoosen = FEATURE_VECTOR_PNORM_WEIGTH_CUBIC;
+		} else {
+			weigthChoosen = FEATURE_VECTOR_PNORM_WEIGTH_QUADRATIC;
 		}
 	}
-	// Fill half of the diagonal
-	for( unsigned int ny=1; ny<=scaleCount; ny++ ) {  // y
-		double rowSum = 0.0;                                                                                                // For validation / Debug
-		for( unsigned int nx=1; nx<=ny; nx++ ) {  // x
-			double volumeWeight = 1.0 / ny;
-			if( !useLinear ) {
-				if( useCubic ) {
-					volumeWeight = ( 3.0*pow( nx, 2.0 ) - 3.0*nx + 1.0 ) / ( pow( ny, 3.0 ) );
-				} else {
+	return( funcVertFeatureVecMahalDist( referenceVector, weigthChoosen ) );
+}
+
+//! Compute a Mahalanobis inspired distance sqrt( d^T W d ) with d being the difference of the
+//! feature vector of a vertex to the reference vector. W is a lower triangular matrix holding the
+//! weights of the scales of integral invariants up to the scale of the row.
+//!
+//! All feature vectors are processed at once as rows of a matrix (see FeatureVecStore::computeWeightedDistances).
+//! Vertices with a feature vector not matching the length of the reference vector get a function value of NaN.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::funcVertFeatureVecMahalDist(
+                const vector<double>&        rReferenceVector,
+                eFuncFeatureVecPNormWeigth   rWeigthType
+) {
+	if( rReferenceVector.size() == 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] No reference vector given!" << endl;
+		return false;
+	}
+	string funcName = "Compute Mahalanobis inspired distance for feature vectors";
+	using namespace std::chrono;
+	high_resolution_clock::time_point tStart = high_resolution_clock::now();
+
+	// Prepare row-major matrix with weights - transposed as the vector is also transposed.
+	const uint64_t scaleCount = rReferenceVector.size();
+	vector<double> weightMat( scaleCount * scaleCount, 0.0 );
+	for( unsigned int ny=1; ny<=scaleCount; ny++ ) {  // y
+		for( unsigned int nx=1; nx<=ny; nx++ ) {  // x
+			double volumeWeight = 1.0 / ny;
+			switch( rWeigthType ) {
+				case FEATURE_VECTOR_PNORM_WEIGTH_LINEAR:
+					// do nothing
+					break;
+				case FEATURE_VECTOR_PNORM_WEIGTH_QUADRATIC:
 					volumeWeight = ( 2.0*nx - 1.0 ) / ( pow( ny, 2.0 ) );
-				}
+					break;
+				case FEATURE_VECTOR_PNORM_WEIGTH_CUBIC:
+					volumeWeight = ( 3.0*pow( nx, 2.0 ) - 3.0*nx + 1.0 ) / ( pow( ny, 3.0 ) );
+					break;
+				default:
+					cerr << "[Mesh::" << __FUNCTION__ << "] Unknown weigth!" << endl;
+					return false;
 			}
-			rowSum += volumeWeight;                                                                                     // For validation / Debug
-			//weightMat( nx-1, ny-1 ) = volumeWeight;
-			weightMat( ny-1, nx-1 ) = volumeWeight; // transposed as the vector is also transposed
+			weightMat[(ny-1)*scaleCount + (nx-1)] = volumeWeight;
 		}
-		cout << "[Mesh::" << __FUNCTION__ << "] Checksum for Row " << ny << " Sum: " << rowSum << endl;                                  // For validation / Debug
 	}
 
-	// for( int i=0; i<scaleCount; i++ ) {         // y                                                                            // For validation / Debug
-	//	cout << "[Mesh::" << __FUNCTION__ << "] Weight Matrix ";
-	//	for( int j=0; j<scaleCount; j++ ) { // x
-	//		cout << weightMat(i,j) << " ";
-	//	}
-	//	cout << endl;
-	//}
-
-	ap::real_2d_array featureVec;        // scaleCount x 1
-	ap::real_2d_array featureVecMultTmp; // scaleCount x 1
-	ap::real_2d_array featureVecTransp;  // 1 x scaleCount
-	ap::real_2d_array featureVecResult;  // 1 x 1
-//	featureVec.setlength( scaleCount, 1 );
-	featureVecMultTmp.setlength( scaleCount, 1 );
-	featureVecTransp.setlength( scaleCount, 1 );
-	featureVecResult.setlength( 1, 1 );
-
-	int nrOfVertices = getVertexNr();
-	double* currFeatVec = new double[scaleCount];
-	unsigned int noMatchingDimension = 0;
+	// Use the contiguous feature vectors, when present. Otherwise gather the matching feature vectors.
+	const uint64_t nrOfVertices = getVertexNr();
+	vector<double> distances;
+	uint64_t noMatchingDimension = 0;
 	showProgressStart( funcName );
-	for( int vertIdx=0; vertIdx<nrOfVertices; vertIdx++ ) {
-		Vertex* currVertex = getVertexPos( vertIdx );
-		if( currVertex->getFeatureVectorLen() != scaleCount ) {
-			currVertex->setFuncValue( _NOT_A_NUMBER_DBL_ );
-			noMatchingDimension++;
-			continue;
+	if( isFeatureVecStoreInUse() && ( mFeatureVecStore.getFeatureVecLen() == scaleCount ) ) {
+		if( !mFeatureVecStore.computeWeightedDistances( rReferenceVector.data(), weightMat, distances ) ) {
+			showProgressStop( funcName );
+			return false;
+		}
+	} else {
+		vector<uint64_t> rowOfVertex( nrOfVertices, std::numeric_limits<uint64_t>::max() );
+		uint64_t rowCount = 0;
+		for( uint64_t vertIdx=0; vertIdx<nrOfVertices; vertIdx++ ) {
+			if( mVertices[vertIdx]->getFeatureVectorLen() == scaleCount ) {
+				rowOfVertex[vertIdx] = rowCount++;
+			}
+		}
+		noMatchingDimension = nrOfVertices - rowCount;
+		FeatureVecStore featureVecs;
+		if( rowCount > 0 ) {
+			vector<double> featureVecValues( rowCount * scaleCount );
+			parallelFor( nrOfVertices, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+				for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+					if( rowOfVertex[vertIdx] != std::numeric_limits<uint64_t>::max() ) {
+						mVertices[vertIdx]->copyFeatureVecTo( &featureVecValues[rowOfVertex[vertIdx]*scaleCount] );
+					}
+				}
+			} );
+			featureVecs.adopt( featureVecValues, scaleCount );
+		}
+		vector<double> rowDistances;
+		if( !featureVecs.computeWeightedDistances( rReferenceVector.data(), weightMat, rowDistances ) ) {
+			showProgressStop( funcName );
+			return false;
+		}
+		distances.assign( nrOfVertices, _NOT_A_NUMBER_DBL_ );
+		for( uint64_t vertIdx=0; vertIdx<nrOfVertices; vertIdx++ ) {
+			if( rowOfVertex[vertIdx] != std::numeric_limits<uint64_t>::max() ) {
+				distances[vertIdx] = rowDistances[rowOfVertex[vertIdx]];
+			}
 		}
-		currVertex->copyFeatureVecTo( currFeatVec );
-		for( unsigned int i=0; i<scaleCount; i++ ) {
-			//currFeatVec[i] -= refVec[i];
-			currFeatVec[i] -= referenceVector.at( i );
-			//currFeatVec[i] = pow( currFeatVec[i] - refVec[i], 2.0 );
-			//currFeatVec[i] = abs( currFeatVec[i] - refVec[i] );
-		}
-//		featureVec.setcontent( 0, scaleCount, 0, 1, currFeatVec );
-		featureVec.setcontent( 0, scaleCount - 1, 0, 0, currFeatVec );
-		rmatrixtranspose( 1, scaleCount, featureVec, 0, 0, featureVecTransp, 0, 0 );
-		// cout << "Feature Vector Ori:    ";
-		// for( int i=0; i<scaleCount; i++ ) {         // x | Spalte
-		//	cout << currFeatVec[i] << " ";
-		// }
-		// cout << "Feature Vector:        ";
-		// for( int i=0; i<scaleCount; i++ ) {         // x | Spalte
-		//	cout << featureVec(0,i) << " ";
-		// }
-		// cout << endl;
-		// cout << "Feature Vector Transp: ";
-		// for( int i=0; i<scaleCount; i++ ) {         // y | Zeile
-		//	cout << featureVecTransp(i,0) << " ";
-		// }
-		//cout << endl;
-		rmatrixgemm( 1, scaleCount, scaleCount, 1, featureVec,0,0,0, weightMat,0,0,0, 0, featureVecMultTmp, 0,0 );
-		// cout << "Intermediate result: ";
-		// for( int i=0; i<scaleCount; i++ ) {         // y
-		//	cout << featureVecMultTmp(0,i) << " ";
-		//}
-		// cout << endl;
-		rmatrixgemm( 1, 1, scaleCount, 1, featureVecMultTmp,0,0,0, featureVecTransp,0,0,0, 0, featureVecResult, 0,0 );
-		//cout << "Res: " << featureVecResult(0,0) << endl;
-		currVertex->setFuncValue( sqrt( featureVecResult(0,0) ) ); // SQRT as suggest by the original Mahalanobis distance.
-		//currVertex->setFuncValue( featureVecResult(0,0) );
-		showProgress( static_cast<double>(vertIdx+1)/static_cast<double>(nrOfVertices), funcName );
 	}
-	delete[] currFeatVec;
+	parallelFor( nrOfVertices, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			mVertices[vertIdx]->setFuncValue( distances[vertIdx] );
+		}
+	} );
 
 	if( noMatchingDimension > 0 ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] Vertices with non-matching dimension of feature vector: " << noMatchingDimension << "!"  << endl;
 	}
 
-	cout << "[Mesh::" << __FUNCTION__ << "] took " << static_cast<float>( clock() - timeStart ) / CLOCKS_PER_SEC << " seconds."  << endl;
+	cout << "[Mesh::" << __FUNCTION__ << "] took " << duration_cast<duration<double>>( high_resolution_clock::now() - tStart ).count() << " seconds."  << endl;
 	showProgressStop( funcName );
 	changedVertFuncVal();
 
 	return true;
-#endif
 }
 
 //! Compute p-Norm using the feature vector of the vertices.
@@ -9543,9 +9854,11 @@ bool Mesh::funcVertDistanceToPlane(
 //! @param rArrayHeight vertical resolution of the depth buffer represented by rDepths
 //! @param rZTolerance tolerance that is used during comparisons with the values of rDepths (rays are extended by rZTolerance)
 //! @warning The function does not notify the mesh about these changes (i.e. Mesh::changedVertFuncVal() is not called)!
+//!          Only the cached statistics of the function values are invalidated.
 //! @returns False in case of an error. True otherwise.
 bool Mesh::funcVertAddLight( Matrix4D &rTransformMat, unsigned int rArrayWidth, unsigned int rArrayHeight, const vector<float>& rDepths, float rZTolerance ) {
 	unsigned int nrOfVertices = getVertexNr();
+	mFuncValStatistics.invalidate();
 
 	for( unsigned int vertIdx = 0; vertIdx < nrOfVertices; vertIdx++ ) {
 		Vertex* vertex = getVertexPos( vertIdx );
@@ -9581,9 +9894,123 @@ bool Mesh::funcVertAddLight( Matrix4D &rTransformMat, unsigned int rArrayWidth,
 	return true;
 }
 
+//! Sets function values to the local brightness using ambient occlusion computed by ray casting on the CPU,
+//! i.e. without an OpenGL context as required by MeshGL::funcVertAmbientOcclusion.
+//!
+//! The light directions are the points of the spherical Fibonacci lattice used by MeshGL, which are
+//! stratified over the sphere. From each vertex rays are cast in the directions within the hemisphere of
+//! its normal. Each unoccluded direction adds its cosine to the normal, so an unoccluded vertex has
+//! a function value of about rNumberOfDirections/4 - the same scale as MeshGL.
+//! The rays of a vertex are traced in packets through a bounding volume hierarchy of the faces
+//! (see FaceBVH) and the vertices are processed in parallel.
+//!
+//! @param rNumberOfDirections number of light directions on the whole sphere.
+//! @param rZTolerance occluders closer than this distance are ignored. Relative to 2r, where r is the radius of the bounding box - as for MeshGL.
+//! @returns False in case of an error. True otherwise.
+bool Mesh::funcVertAmbientOcclusionRayCast( unsigned int rNumberOfDirections, double rZTolerance ) {
+	const uint64_t vertexNr = getVertexNr();
+	const uint64_t faceNr   = getFaceNr();
+	if( ( rNumberOfDirections == 0 ) || ( faceNr == 0 ) || ( rZTolerance < 0.0 ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Bad parameters or no faces!\n";
+		return( false );
+	}
+	showProgressStart( "Ambient Occlusion" );
+
+	// Normals are fetched in advance, as Vertex::getNormal might estimate and store them.
+	// The indices of the vertices are not maintained by edits, but referenced by the faces below.
+	vector<double>   vertexCoords( vertexNr * 3 );
+	vector<double>   vertexNormals( vertexNr * 3 );
+	vector<uint64_t> faceVertexIndices( faceNr * 3 );
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		Vertex* vertex = getVertexPos( vertIdx );
+		vertex->setIndex( vertIdx );
+		vertex->copyXYZTo( &vertexCoords[vertIdx*3] );
+		Vector3D normal = vertex->getNormal( true );
+		vertexNormals[vertIdx*3]   = normal.getX();
+		vertexNormals[vertIdx*3+1] = normal.getY();
+		vertexNormals[vertIdx*3+2] = normal.getZ();
+	}
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		Face* face = getFacePos( faceIdx );
+		faceVertexIndices[faceIdx*3]   = face->getVertAIndex();
+		faceVertexIndices[faceIdx*3+1] = face->getVertBIndex();
+		faceVertexIndices[faceIdx*3+2] = face->getVertCIndex();
+	}
+	FaceBVH faceBVH;
+	if( !faceBVH.build( vertexCoords, faceVertexIndices ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Bad vertex indices of the faces!\n";
+		showProgressStop( "Ambient Occlusion" );
+		return( false );
+	}
+
+	// Spherical Fibonacci lattice with the z-axis flipped as by the transformation used in MeshGL.
+	const double goldenRatio = 0.5 * ( sqrt( 5.0 ) + 1.0 );
+	vector<double> directions( rNumberOfDirections * 3 );
+	for( unsigned int i=0; i<rNumberOfDirections; i++ ) {
+		const double phi   = 2.0 * M_PI * ( i / goldenRatio );
+		const double theta = acos( 1.0 - ( ( 2.0 * i + 1.0 ) / rNumberOfDirections ) );
+		directions[i*3]   = cos( phi ) * sin( theta );
+		directions[i*3+1] = sin( phi ) * sin( theta );
+		directions[i*3+2] = -cos( theta );
+	}
+	const double radius = getBoundingBoxRadius();
+	// Additional offset for rays grazing faces, which touch the vertex without referencing it.
+	const double tMin   = rZTolerance * 2.0 * radius + 1e-9 * radius;
+
+	vector<double> ambientOcclusion( vertexNr, 0.0 );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		double packetDirs[FaceBVH::PACKET_SIZE*3];
+		double packetCosines[FaceBVH::PACKET_SIZE];
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			const double* origin = &vertexCoords[vertIdx*3];
+			const double* normal = &vertexNormals[vertIdx*3];
+			double brightness = 0.0;
+			unsigned int packetSize = 0;
+			auto tracePacket = [&]() {
+				const uint32_t occluded = faceBVH.isOccludedPacket( origin, packetDirs, packetSize, tMin, DBL_MAX, vertIdx );
+				for( unsigned int ray=0; ray<packetSize; ray++ ) {
+					if( ( occluded & ( static_cast<uint32_t>(1) << ray ) ) == 0 ) {
+						brightness += packetCosines[ray];
+					}
+				}
+				packetSize = 0;
+			};
+			for( unsigned int i=0; i<rNumberOfDirections; i++ ) {
+				const double* dir = &directions[i*3];
+				const double cosine = normal[0]*dir[0] + normal[1]*dir[1] + normal[2]*dir[2];
+				// False for not-a-number i.e. vertices without normal:
+				if( !( cosine > 0.0 ) ) {
+					continue;
+				}
+				packetDirs[packetSize*3]   = dir[0];
+				packetDirs[packetSize*3+1] = dir[1];
+				packetDirs[packetSize*3+2] = dir[2];
+				packetCosines[packetSize]  = cosine;
+				packetSize++;
+				if( packetSize == FaceBVH::PACKET_SIZE ) {
+					tracePacket();
+				}
+			}
+			if( packetSize > 0 ) {
+				tracePacket();
+			}
+			ambientOcclusion[vertIdx] = brightness;
+		}
+	}, 256 );
+
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		getVertexPos( vertIdx )->setFuncValue( ambientOcclusion[vertIdx] );
+	}
+	changedVertFuncVal();
+	showProgressStop( "Ambient Occlusion" );
+	return( true );
+}
+
 #ifdef LIBSPHERICAL_INTERSECTION
 namespace {
 //! Converts a Mesh to a spherical_intersecton::Mesh
+//! The faces are passed as one flat index buffer, so that the edges are found by
+//! bucketing instead of a hash map lookup per triangle side - see spherical_intersection::Mesh::add_triangles.
 //! @param original the given Mesh
 //! @returns The spherical_intersection::Mesh
 spherical_intersection::Mesh convertMesh( Mesh &original ) {
@@ -9598,29 +10025,29 @@ spherical_intersection::Mesh convertMesh( Mesh &original ) {
 	}
 
 	// add all faces
-	const auto &convertedVertices = converted.get_vertices();
 	auto faceCount = original.getFaceNr();
-	for ( uint64_t faceIndex = 0; faceIndex < faceCount; faceIndex++ ) {
-		auto *face = original.getFacePos( faceIndex );
-		const auto &convertedVertex0 = convertedVertices[face->getVertAIndex()];
-		const auto &convertedVertex1 = convertedVertices[face->getVertBIndex()];
-		const auto &convertedVertex2 = convertedVertices[face->getVertCIndex()];
-		converted.add_triangle(convertedVertex0, convertedVertex1, convertedVertex2);
-	}
+	vector<array<size_t,3>> faceVertexIndices( faceCount );
+	parallelFor( faceCount, [&original, &faceVertexIndices]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIndex = rBegin; faceIndex < rEnd; faceIndex++ ) {
+			auto *face = original.getFacePos( faceIndex );
+			faceVertexIndices[faceIndex] = { face->getVertAIndex(), face->getVertBIndex(), face->getVertCIndex() };
+		}
+	} );
+	converted.add_triangles( faceVertexIndices );
 
 	return converted;
 }
 #ifdef THREADS
 //! Calculates the results obtained from applying a given algorithm to all vertices of a given spherical_intersection::Mesh
 //! @param mesh the given spherical_intersection::mesh
-//! @param algorithm the given algorithm
+//! @param algorithm the given algorithm, which gets a graph to be reused for the vertices of a thread
 //! @param threadCount number of worker threads used
 //! @param maximumBatchSize maximum number of vertices processed before updating the progress
 //! @param notifyAboutProgress a function that is occasionally called with the faction of processed vertices as its argument
 //! @returns The calculation results where the i-th result is the result corresponding to the i-th vertex
 vector<double> calculateSphericalIntersectionFuncValues(
 	const spherical_intersection::Mesh &mesh,
-	function<double(const spherical_intersection::Mesh::Vertex &)> algorithm,
+	function<double(const spherical_intersection::Mesh::Vertex &, spherical_intersection::Graph &)> algorithm,
 	const size_t threadCount,
 	const size_t maximumBatchSize,
 	function<void(double)> notifyAboutProgress
@@ -9630,9 +10057,10 @@ vector<double> calculateSphericalIntersectionFuncValues(
 	size_t startIndex = 0;
 	vector<double> results(vertexCount);
 	auto setResults = [&mesh, &algorithm, &results](size_t startIndex, size_t count) {
+		spherical_intersection::Graph graph;
 		for( size_t vertexIndex = startIndex; vertexIndex < startIndex+count; vertexIndex++ ) {
 			const auto &vertex = mesh.get_vertices()[vertexIndex];
-			results[vertexIndex] = algorithm(vertex);
+			results[vertexIndex] = algorithm(vertex, graph);
 		}
 	};
 
@@ -9660,21 +10088,22 @@ vector<double> calculateSphericalIntersectionFuncValues(
 #else
 //! Calculates the results obtained from applying a given algorithm to all vertices of a given spherical_intersection::Mesh
 //! @param mesh the given spherical_intersection::mesh
-//! @param algorithm the given algorithm
+//! @param algorithm the given algorithm, which gets a graph to be reused for all vertices
 //! @param notifyAboutProgress a function that is occasionally called with the faction of processed vertices as its argument
 //! @returns The calculation results where the i-th result is the result corresponding to the i-th vertex
 vector<double> calculateSphericalIntersectionFuncValues(
 	const spherical_intersection::Mesh &mesh,
-	function<double(const spherical_intersection::Mesh::Vertex &)> algorithm,
+	function<double(const spherical_intersection::Mesh::Vertex &, spherical_intersection::Graph &)> algorithm,
 	function<void(double)> notifyAboutProgress
 ) {
 	auto vertexCount = mesh.get_vertices().size();
 	vector<double> results(vertexCount);
 
 	// calculate results
+	spherical_intersection::Graph graph;
 	for( size_t vertexIndex = 0; vertexIndex < vertexCount; vertexIndex++ ) {
 		const auto &vertex = mesh.get_vertices()[vertexIndex];
-		results[vertexIndex] = algorithm(vertex);
+		results[vertexIndex] = algorithm(vertex, graph);
 		notifyAboutProgress( static_cast<double>(vertexIndex+1)/vertexCount );
 	}
 
@@ -9755,9 +10184,9 @@ bool Mesh::funcVertSphereSurfaceLength() {
 	auto notifyAboutProgress = [&funcName, this](double value){
 		this->showProgress(value, funcName);
 	};
-	auto algorithm = [&radius](const spherical_intersection::Mesh::Vertex &vertex) {
+	auto algorithm = [&radius](const spherical_intersection::Mesh::Vertex &vertex, spherical_intersection::Graph &graph) {
 		spherical_intersection::math3d::Sphere sphere{vertex.get_location(), radius};
-		spherical_intersection::Graph graph{vertex, sphere};
+		graph.assign(vertex, sphere);
 		return spherical_intersection::algorithm::get_sphere_surface_length(graph);
 	};
 	showProgressStart( funcName );
@@ -9837,9 +10266,9 @@ bool Mesh::funcVertSphereVolumeArea() {
 	auto notifyAboutProgress = [&funcName, this](double value){
 		this->showProgress(value, funcName);
 	};
-	auto algorithm = [&radius](const spherical_intersection::Mesh::Vertex &vertex) {
+	auto algorithm = [&radius](const spherical_intersection::Mesh::Vertex &vertex, spherical_intersection::Graph &graph) {
 		spherical_intersection::math3d::Sphere sphere{vertex.get_location(), radius};
-		spherical_intersection::Graph graph{vertex, sphere};
+		graph.assign(vertex, sphere);
 		return spherical_intersection::algorithm::get_sphere_volume_area(graph);
 	};
 	showProgressStart( funcName );
@@ -9918,9 +10347,9 @@ bool Mesh::funcVertSphereSurfaceNumberOfComponents() {
 	auto notifyAboutProgress = [&funcName, this](double value){
 		this->showProgress(value, funcName);
 	};
-	auto algorithm = [&radius](const spherical_intersection::Mesh::Vertex &vertex) {
+	auto algorithm = [&radius](const spherical_intersection::Mesh::Vertex &vertex, spherical_intersection::Graph &graph) {
 		spherical_intersection::math3d::Sphere sphere{vertex.get_location(), radius};
-		spherical_intersection::Graph graph{vertex, sphere};
+		graph.assign(vertex, sphere);
 		return spherical_intersection::algorithm::get_component_count(graph);
 	};
 	showProgressStart( funcName );
@@ -9941,6 +10370,134 @@ bool Mesh::funcVertSphereSurfaceNumberOfComponents() {
 	return false;
 #endif
 }
+
+//! Sets the feature vector of every vertex to descriptors of the intersections of the mesh with spheres
+//! of several radii having the vertex as their center. Asks for the radii and the descriptors.
+//! The function value is set to the first element of the feature vectors.
+//! @returns False in case of an error. True otherwise.
+bool Mesh::funcVertSphereDescriptors() {
+#ifdef LIBSPHERICAL_INTERSECTION
+	vector<double> radii{ 0.1, 0.2, 0.4 };
+	if( !showEnterText( radii, "Radii (at least 1 value)" ) ) {
+		return false;
+	}
+	unsigned int descriptors = 0;
+	bool useDescriptor = true;
+	if( !showQuestion( &useDescriptor, "Sphere Descriptors", "Compute the Sphere Surface Length?" ) ) {
+		return false;
+	}
+	descriptors |= useDescriptor ? SPHERE_DESCRIPTOR_SURFACE_LENGTH : 0;
+	useDescriptor = true;
+	if( !showQuestion( &useDescriptor, "Sphere Descriptors", "Compute the Sphere Volume Area?" ) ) {
+		return false;
+	}
+	descriptors |= useDescriptor ? SPHERE_DESCRIPTOR_VOLUME_AREA : 0;
+	useDescriptor = true;
+	if( !showQuestion( &useDescriptor, "Sphere Descriptors", "Compute the Sphere Surface Number of Components?" ) ) {
+		return false;
+	}
+	descriptors |= useDescriptor ? SPHERE_DESCRIPTOR_NUMBER_OF_COMPONENTS : 0;
+
+	vector<double> values;
+	if( !computeSphereDescriptors( radii, descriptors, values ) ) {
+		return false;
+	}
+	if( !adoptFeatureVectors( values, values.size() / getVertexNr() ) ) {
+		return false;
+	}
+	return funcVertFeatureVecElementByIndex( 0 );
+#else
+	cerr << "[Mesh::" << __FUNCTION__ << "] Functionality missing!" << endl;
+	return false;
+#endif
+}
+
+//! Computes descriptors of the intersections of the mesh with spheres having a vertex as their center
+//! for all vertices and the given radii. The intersection graph is built once per vertex and radius
+//! and all requested descriptors are evaluated on it - instead of once per descriptor as by the
+//! funcVertSphere* methods. The values are the same as computed by these methods.
+//!
+//! The result is a row-major matrix with one row per vertex. A row holds the requested descriptors
+//! in the order of eSphereDescriptor for the first radius followed by those for the next radius etc.
+//!
+//! @returns False in case of an error. True otherwise.
+bool Mesh::computeSphereDescriptors(
+                const vector<double>& rRadii,        //!< Radii of the spheres.
+                unsigned int          rDescriptors,  //!< Bitwise or of eSphereDescriptor.
+                vector<double>&       rValues        //!< Output: descriptors per vertex.
+) {
+#ifdef LIBSPHERICAL_INTERSECTION
+	if( rRadii.empty() ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No radius given!" << endl;
+		return false;
+	}
+	for( const double radius : rRadii ) {
+		if( !( radius > 0.0 ) ) {
+			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Radius has to be > 0 (given radius: " << radius << ")" << endl;
+			return false;
+		}
+	}
+	const bool computeLength     = ( rDescriptors & SPHERE_DESCRIPTOR_SURFACE_LENGTH ) != 0;
+	const bool computeArea       = ( rDescriptors & SPHERE_DESCRIPTOR_VOLUME_AREA ) != 0;
+	const bool computeComponents = ( rDescriptors & SPHERE_DESCRIPTOR_NUMBER_OF_COMPONENTS ) != 0;
+	const uint64_t descriptorCount = static_cast<uint64_t>( computeLength ) + computeArea + computeComponents;
+	if( descriptorCount == 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No descriptor selected!" << endl;
+		return false;
+	}
+	if( getVertexNr() == 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No vertices!" << endl;
+		return false;
+	}
+
+	const auto convertedMesh = convertMesh( *this );
+	const auto& vertices = convertedMesh.get_vertices();
+	const uint64_t vertexCount = vertices.size();
+	const uint64_t rowLen = rRadii.size() * descriptorCount;
+	rValues.resize( vertexCount * rowLen );
+
+	// One graph per thread, which is reused for all its vertices and radii.
+	vector<spherical_intersection::Graph> graphs( getParallelThreadCount() );
+	string funcName = "Sphere Descriptors";
+	showProgressStart( funcName );
+	// Processing in batches allows to show the progress from this thread.
+	const uint64_t batchSize = 10000;
+	for( uint64_t batchBegin = 0; batchBegin < vertexCount; batchBegin += batchSize ) {
+		const uint64_t batchEnd = min( batchBegin + batchSize, vertexCount );
+		parallelFor( batchEnd - batchBegin, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+			spherical_intersection::Graph& graph = graphs[rThreadIdx];
+			for( uint64_t vertIdx = batchBegin + rBegin; vertIdx < batchBegin + rEnd; vertIdx++ ) {
+				const auto& vertex = vertices[vertIdx];
+				double* values = rValues.data() + vertIdx * rowLen;
+				for( const double radius : rRadii ) {
+					graph.assign( vertex, spherical_intersection::math3d::Sphere{ vertex.get_location(), radius } );
+					double* areaValue = nullptr;
+					if( computeLength ) {
+						*values++ = spherical_intersection::algorithm::get_sphere_surface_length( graph );
+					}
+					if( computeArea ) {
+						areaValue = values++;
+					}
+					if( computeComponents ) {
+						*values++ = spherical_intersection::algorithm::count_components( graph );
+					}
+					// Erases the arcs of the graph, so it has to be last.
+					if( computeArea ) {
+						*areaValue = spherical_intersection::algorithm::get_sphere_volume_area( graph );
+					}
+				}
+			}
+		}, 64 );
+		showProgress( static_cast<double>( batchEnd ) / vertexCount, funcName );
+	}
+	showProgressStop( funcName );
+	return true;
+#else
+	cerr << "[Mesh::" << __FUNCTION__ << "] Functionality missing!" << endl;
+	return false;
+#endif
+}
+
 //! Copies the function value from each vertex to the nth component of its feature vector
 //! @param dim the component of the feature vector, where the function value is written to. If dim > featureVecSize, then the vector gets padded with zeros to fit dim
 //! @returns False in case of an error
@@ -10105,6 +10662,31 @@ bool Mesh::setVertFuncValDistanceTo( const Vector3D& rPos ) {
 	return( true );
 }
 
+//! Sets the function values to those of the according vertices of a simplified mesh, e.g. to transfer
+//! values computed on the result of Mesh::decimateQuadricError back to this mesh.
+//!
+//! @param rCoarse simplified mesh.
+//! @param rFineToCoarse index of the vertex of rCoarse for each vertex of this mesh.
+//! @returns False in case of an error e.g. indices out of range. True otherwise.
+bool Mesh::setVertFuncValFromCoarse( Mesh& rCoarse, const std::vector<uint64_t>& rFineToCoarse ) {
+	const uint64_t vertexNr = getVertexNr();
+	const uint64_t coarseNr = rCoarse.getVertexNr();
+	if( ( rFineToCoarse.size() != vertexNr ) ||
+	    std::any_of( rFineToCoarse.begin(), rFineToCoarse.end(), [coarseNr]( uint64_t rIdx ) { return( rIdx >= coarseNr ); } ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Mapping does not match the meshes!\n";
+		return( false );
+	}
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			double funcVal = _NOT_A_NUMBER_DBL_;
+			rCoarse.getVertexPos( rFineToCoarse[vertIdx] )->getFuncValue( &funcVal );
+			getVertexPos( vertIdx )->setFuncValue( funcVal );
+		}
+	} );
+	changedVertFuncVal();
+	return( true );
+}
+
 
 //! Stub to be called, when a the function values of the faces were changed,
 void Mesh::changedFaceFuncVal() {
@@ -10115,30 +10697,33 @@ void Mesh::changedFaceFuncVal() {
 void Mesh::changedVertFuncVal() {
 	int timeStartSub = clock(); // for performance mesurement
 	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Begin.\n";
-	for( auto const& currVertex: mVertices ) {
-		// Set flags by calling the according method.
-		currVertex->isFuncValLocalMinimum();
-		currVertex->isFuncValLocalMaximum();
-	}
+	mFuncValStatistics.invalidate();
+	// Each vertex sets only its own flags, while reading the function values of its 1-ring.
+	parallelFor( mVertices.size(), [this]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			// Set flags by calling the according method.
+			mVertices[vertIdx]->isFuncValLocalMinimum();
+			mVertices[vertIdx]->isFuncValLocalMaximum();
+		}
+	} );
 	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Time: " << static_cast<float>( clock() - timeStartSub ) / CLOCKS_PER_SEC << " seconds.\n";
 }
 
 //! To be called, when the feature vectors were manipulated.
 void Mesh::changedVertFeatureVectors() {
-	//! \todo compute for feature vectors stored within the vertices.
-	//! \bug mFeatureVecVertices seems to hold bad values.
-	if( mFeatureVecVertices.size() == 0 ) {
+	const uint64_t featureVecLen = getFeatureVecLenMax( Primitive::IS_VERTEX );
+	if( featureVecLen == 0 ) {
 		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] ERROR: No feature vectors found!\n";
 		return;
 	}
 	auto timeStartSub = clock(); // for performance mesurement
 	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Begin.\n";
-	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] mFeatureVecVertices.size: " << mFeatureVecVertices.size() << "\n";
+	LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Feature vector length: " << featureVecLen << "\n";
 	mVerticesFeatVecMean.clear();
 	mVerticesFeatVecStd.clear();
-	mVerticesFeatVecMean.resize(mFeatureVecVerticesLen,0.0);
-	mVerticesFeatVecStd.resize(mFeatureVecVerticesLen,0.0);
-	vector<uint64_t> verticesFeatVecNormal(mFeatureVecVerticesLen,0); // Number of elements having normal values of the feature vectors of the vertices. See std::isnormal()
+	mVerticesFeatVecMean.resize(featureVecLen,0.0);
+	mVerticesFeatVecStd.resize(featureVecLen,0.0);
+	vector<uint64_t> verticesFeatVecNormal(featureVecLen,0); // Number of elements having normal values of the feature vectors of the vertices. See std::isnormal()
 
 	// Accumulate values for the mean values:
 	for( uint64_t i=0; i<getVertexNr(); i++ ) {
@@ -10154,22 +10739,24 @@ void Mesh::changedVertFeatureVectors() {
 	}
 
 	// Compute and show mean values:
-	for( uint64_t j=0; j<mFeatureVecVerticesLen; j++ ) {
+	for( uint64_t j=0; j<featureVecLen; j++ ) {
 		mVerticesFeatVecMean[j] /= static_cast<double>(verticesFeatVecNormal[j]);
 		LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Feature vector mean [" << j << "]: " << mVerticesFeatVecMean[j] << '\n';
 		LOG::debug() << " using " << verticesFeatVecNormal[j] << " values.\n";
 	}
 	// Accumulate values for the standard deviations:
 	for( uint64_t i=0; i<getVertexNr(); i++ ) {
-		for( uint64_t j=0; j<mFeatureVecVerticesLen; j++ ) {
-			double val = mFeatureVecVertices.at( i*mFeatureVecVerticesLen+j );
+		Vertex* currVert = getVertexPos( i );
+		for( uint64_t j=0; j<currVert->getFeatureVectorLen(); j++ ) {
+			double val = _NOT_A_NUMBER_DBL_;
+			currVert->getFeatureElement( j, &val );
 			if( isnormal( val ) ) {
 				mVerticesFeatVecStd[j] += pow( val - mVerticesFeatVecMean[j], 2.0 );
 			}
 		}
 	}
 	// Compute and show standard deviations:
-	for( uint64_t j=0; j<mFeatureVecVerticesLen; j++ ) {
+	for( uint64_t j=0; j<featureVecLen; j++ ) {
 		mVerticesFeatVecStd[j] /= static_cast<double>(verticesFeatVecNormal[j]);
 		mVerticesFeatVecStd[j] = sqrt( mVerticesFeatVecStd[j] );
 		LOG::debug() << "[Mesh::" << __FUNCTION__ << "] Feature vector standard deviation [" << j << "]: " << mVerticesFeatVecStd[j] << "\n";
@@ -10213,38 +10800,16 @@ bool Mesh::getVertFuncValAverage( double* rAverage ) {
 //!
 //! Remark: Do not use this method too often (e.g. in a loop) as it may slow down the calling method/function.
 //!
+//! The values are served from a cache, which is only updated after Mesh::changedVertFuncVal
+//! or a change of the number of vertices. Function values set directly e.g. by
+//! Vertex::setFuncValue have to be followed by Mesh::changedVertFuncVal.
+//!
 //! @return false in case of an error (e.g. no values set). True otherwise.
 bool Mesh::getFuncValuesMinMax( double& rMinVal, double& rMaxVal ) {
 	// Check if there is any valid number
-	bool valueSet = false;
-	rMinVal = +DBL_MAX;
-	rMaxVal = -DBL_MAX;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		Vertex* currVertex = getVertexPos( vertIdx );
-		double  currFuncVal;
-		if( !currVertex->getFuncValue( &currFuncVal ) ) {
-			continue;
-		}
-		if( std::isnan( currFuncVal ) ) {
-			continue;
-		}
-		if( std::isinf( currFuncVal ) ) {
-			continue;
-		}
-		valueSet = true;
-		if( rMinVal > currFuncVal ) {
-			rMinVal = currFuncVal;
-		}
-		if( rMaxVal < currFuncVal ) {
-			rMaxVal = currFuncVal;
-		}
-	}
-
-	// Typical for meshs without a quality field:
-	if( !valueSet ) {
-		rMinVal = _NOT_A_NUMBER_DBL_;
-		rMaxVal = _NOT_A_NUMBER_DBL_;
-	}
+	bool valueSet = updateFuncValStatistics();
+	// Typical for meshs without a quality field i.e. NaN is returned:
+	mFuncValStatistics.getMinMax( rMinVal, rMaxVal );
 
 	cout << "[Mesh::" << __FUNCTION__ << "] min: " << rMinVal << " max: " << rMaxVal << " valueSet: " << valueSet << endl;
 	return( valueSet );
@@ -10254,6 +10819,9 @@ bool Mesh::getFuncValuesMinMax( double& rMinVal, double& rMaxVal ) {
 //!
 //! Remark: Do not use this method too often (e.g. in a loop) as it may slow down the calling method/function.
 //!
+//! Served from the same cache as Mesh::getFuncValuesMinMax, i.e. direct changes of the function
+//! values have to be followed by Mesh::changedVertFuncVal.
+//!
 //! @return false in case of an error (e.g. no values set). True otherwise.
 bool Mesh::getFuncValuesMinMaxQuantil( double  rMinQuantil,
                                        double  rMaxQuantil,
@@ -10270,48 +10838,39 @@ bool Mesh::getFuncValuesMinMaxQuantil( double  rMinQuantil,
 		return( false );
 	}
 
-	// Fetch all vertices with finite values:
-	vector<Vertex*> verticesSortedAndSelected;
-	getVertexListValidFuncVal( &verticesSortedAndSelected );
-	if( verticesSortedAndSelected.empty() ) {
+	// Fetch all finite values:
+	if( !updateFuncValStatistics() ) {
 		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: No vertices!" << endl;
 		return( false );
 	}
 
-	// Sort:
-	sort( verticesSortedAndSelected.begin(), verticesSortedAndSelected.end(), Vertex::funcValLower );
 	// valid numbers for the quantil exclude NaN, +Inf and - Inf
-	// because the first vertices will have -Inf after sorting we need to add their number as an offset:
-	long quantilIdxLow  = round( rMinQuantil*static_cast<double>(verticesSortedAndSelected.size()-1) );
-	long quantilIdxHigh = round( rMaxQuantil*static_cast<double>(verticesSortedAndSelected.size()-1) );
-
-	// Fetch values:
-	double valCur;
-	if( !verticesSortedAndSelected.at( quantilIdxLow )->getFuncValue( &valCur ) ) {
+	if( !mFuncValStatistics.getQuantile( rMinQuantil, rMinVal ) ) {
 		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: UNEXPECTED minimum Value (Quantile)!" << endl;
 		return( false );
-	} else if( !std::isfinite(valCur) ) {
-		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: INFINITE minimum Value (Quantile)!" << endl;
-		return( false );
-	} else {
-		rMinVal = valCur;
 	}
-	if( !verticesSortedAndSelected.at( quantilIdxHigh )->getFuncValue( &valCur ) ) {
+	if( !mFuncValStatistics.getQuantile( rMaxQuantil, rMaxVal ) ) {
 		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: UNEXPECTED maximum Value (Quantile)!" << endl;
 		return( false );
-	} else if( !std::isfinite(valCur) ) {
-		cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: INFINITE maximum Value (Quantile)!" << endl;
-		return( false );
-	} else {
-		rMaxVal = valCur;
 	}
 
 	// Done:
-	cout << "[Mesh::" << __FUNCTION__ << "] Quantil Min: " << rMinVal << " at position: " << quantilIdxLow << endl;
-	cout << "[Mesh::" << __FUNCTION__ << "] Quantil Max: " << rMaxVal << " at position: " << quantilIdxHigh << endl;
+	cout << "[Mesh::" << __FUNCTION__ << "] Quantil Min: " << rMinVal << " of " << mFuncValStatistics.getFiniteCount() << " values" << endl;
+	cout << "[Mesh::" << __FUNCTION__ << "] Quantil Max: " << rMaxVal << " of " << mFuncValStatistics.getFiniteCount() << " values" << endl;
 	return( true );
 }
 
+//! Updates the cached statistics of the function values, when they were invalidated
+//! by Mesh::changedVertFuncVal or the number of vertices has changed.
+//!
+//! @returns false, when there are no finite function values. True otherwise.
+bool Mesh::updateFuncValStatistics() {
+	if( !mFuncValStatistics.isValid( mVertices.size() ) ) {
+		mFuncValStatistics.update( mVertices );
+	}
+	return( mFuncValStatistics.getFiniteCount() > 0 );
+}
+
 //! Returns the minimum of the feature function value.
 //! Returns false in case of an error (e.g. no values set).
 //!
@@ -10414,52 +10973,30 @@ bool Mesh::changedMesh() {
 // --- Mesh manipulation - REMOVAL -----------------------------------------------------------------------------------------------------------------------------
 //! Removes multiple Vertices from the vertexList. It will also (has to)
 //! remove Faces which are defined by the Vertices.
+//!
+//! Within an open transaction the removal is deferred until Mesh::editCommit.
+//! Otherwise the vertices and faces are removed at once by a transaction of its own.
+//! The given set will be empty afterwards.
 bool Mesh::removeVertices( set<Vertex*>* verticesToRemove ) {
 	if( verticesToRemove->empty() ) {
 		cout << "[Mesh::" << __FUNCTION__ << "] Nothing to do - no vertices given." << endl;
 		return false;
 	}
 
-	int facesBefore = getFaceNr();
-	int verticesBefore = getVertexNr();
-	set<Face*>   facesToRemove;
-	set<Vertex*>::iterator itVertexRm;
-
+	const bool ownTransaction = !isEditActive();
+	if( ownTransaction ) {
+		editBegin();
+	}
 	// to remove a vertex, we have to determine the faces it belongs to and
 	// then remove these faces - otherwise we will screw-up our meshs
-	// internal references!
-
-	for(auto vertToRemove : *verticesToRemove)
-	{
-		vertToRemove->getFaces( &facesToRemove);
-	}
-
-	removeFaces( &facesToRemove );
-	facesToRemove.clear();
-	cout << "[Mesh::" << __FUNCTION__ << "] " << facesBefore-getFaceNr() << " Faces removed." << endl;
-
-	vector<Vertex*> mVerticesNew;
-	vector<Vertex*>::iterator itVertex;
-	for( itVertex=mVertices.begin(); itVertex!=mVertices.end(); itVertex++ ) {
-		if( verticesToRemove->find( (*itVertex) ) != verticesToRemove->end() ) {
-			delete (*itVertex);
-			continue;
-		}
-		mVerticesNew.push_back( (*itVertex) );
-	}
-	mVertices.clear();
-	mVertices.swap( mVerticesNew );
-
-	cout << "[Mesh::" << __FUNCTION__ << "] " << verticesBefore - getVertexNr() << " Vertices removed." << endl;
+	// internal references! This is done by tagging.
+	editRemoveVertices( *verticesToRemove );
 	verticesToRemove->clear();
-	mPrimSelected = nullptr;
-	estBoundingBox();
-	cout << "[Mesh::" << __FUNCTION__ << "] Bounding box estimated." << endl;
-	delete mOctree;
-	mOctree = nullptr;
-	cout << "[Mesh::" << __FUNCTION__ << "] Octree for vertices removed." << endl;
-
-	return true;
+	if( !ownTransaction ) {
+		return true;
+	}
+	// "Mesh::" as derived classes e.g. MeshGL take care of their buffers within their removeVertices.
+	return( Mesh::editCommit() );
 }
 
 //! Removes all vertices (and their related faces) stored in mSelectedMVerts.
@@ -10531,6 +11068,32 @@ bool Mesh::removeUncleanSmallCore(
         double                    rPercentArea,   //!< Area relative to the whole mesh.
         bool                      rApplyErosion,  //!< Add extra border cleaning.
         uint64_t&                 rIteration      //!< Returns the number of iterations in step #7.
+) {
+	sCleaningRegion wholeMesh;
+	return( removeUncleanSmallCore( rFileName, rPercentArea, rApplyErosion, rIteration, wholeMesh ) );
+}
+
+//! Select and remove solo, non-manifold, double-cones and small area vertices
+//! within a region.
+//! Optional: save result to rFileName.
+//! This method has to follow a strict order to achieve a clean Mesh.
+//!
+//! When rRegion.mWholeMesh is not set, only the given vertices and their
+//! adjacent faces are checked. The neighbours of removed primitives are added
+//! to the region while processing the steps, because these are the only
+//! places where new defects can emerge. In any case rRegion.mVertices returns
+//! the vertices next to removed primitives, which have to be checked again
+//! after further changes e.g. by filling holes. See Mesh::completeRestore
+//!
+//! Core version without writing meta-data.
+//!
+//! \returns false in case of an error. True otherwise.
+bool Mesh::removeUncleanSmallCore(
+        const filesystem::path&   rFileName,      //!< Filename to store intermediate results and the final mesh.
+        double                    rPercentArea,   //!< Area relative to the whole mesh.
+        bool                      rApplyErosion,  //!< Add extra border cleaning.
+        uint64_t&                 rIteration,     //!< Returns the number of iterations in step #7.
+        sCleaningRegion&          rRegion         //!< Region to be checked and returns the changed vertices.
 ) {
 	uint64_t vertNoPrev = getVertexNr();
 	uint64_t faceNoPrev = getFaceNr();
@@ -10540,6 +11103,59 @@ bool Mesh::removeUncleanSmallCore(
 	std::set<Vertex*> verticesToRemove;
 	std::set<Face*> facesToRemove;
 
+	// Vertices to be checked, when the whole mesh is not checked.
+	const bool wholeMesh = rRegion.mWholeMesh;
+	std::set<Vertex*> regionVertices;
+	if( !wholeMesh ) {
+		regionVertices.swap( rRegion.mVertices );
+		std::cout << "[Mesh::" << __FUNCTION__ << "] Region of " << regionVertices.size() << " vertices." << std::endl;
+	}
+	std::set<Vertex*>& verticesChanged = rRegion.mVertices;
+	verticesChanged.clear();
+
+	// Removal, which maintains the region and the changed vertices. Removed vertices must not remain within the sets.
+	auto removeVerticesTracked = [&]( std::set<Vertex*>& rVertsToRemove, bool rMeshOnly ) {
+		std::set<Vertex*> verticesAdjacent;
+		for( auto const& currVertex: rVertsToRemove ) {
+			currVertex->getNeighbourVertices( &verticesAdjacent );
+		}
+		for( auto const& currVertex: rVertsToRemove ) {
+			verticesAdjacent.erase( currVertex );
+			regionVertices.erase( currVertex );
+			verticesChanged.erase( currVertex );
+		}
+		if( !wholeMesh ) {
+			regionVertices.insert( verticesAdjacent.begin(), verticesAdjacent.end() );
+		}
+		verticesChanged.insert( verticesAdjacent.begin(), verticesAdjacent.end() );
+		// "Mesh::" avoids the unnecessary regeneration of OpenGL VBOs within the GUI version - will be taken care of in step 10.
+		return( rMeshOnly ? Mesh::removeVertices( &rVertsToRemove ) : removeVertices( &rVertsToRemove ) );
+	};
+	auto removeFacesTracked = [&]( std::set<Face*>& rFacesToRemove ) {
+		for( auto const& currFace: rFacesToRemove ) {
+			currFace->getVertABC( &verticesChanged );
+			if( !wholeMesh ) {
+				currFace->getVertABC( &regionVertices );
+			}
+		}
+		return( removeFaces( &rFacesToRemove ) );
+	};
+	// Vertices of the region fulfilling the given predicate.
+	auto getRegionVertices = [&]( std::set<Vertex*>& rSomeVerts, bool (Vertex::*rPredicate)() ) {
+		for( auto const& currVertex: regionVertices ) {
+			if( (currVertex->*rPredicate)() ) {
+				rSomeVerts.insert( currVertex );
+			}
+		}
+	};
+	auto getRegionFaces = [&]() {
+		std::set<Face*> regionFaces;
+		for( auto const& currVertex: regionVertices ) {
+			currVertex->getFaces( &regionFaces );
+		}
+		return( regionFaces );
+	};
+
 	//! 0.) Remove all polylines.
 	//!     \todo this has to be done as the polylines will cause a segementation fault, when written to the VBO.
 	//!     \bug when polylines are not removed, they cause a crash at the end of this method - seems like a memory leak.
@@ -10548,54 +11164,113 @@ bool Mesh::removeUncleanSmallCore(
 	//! 1a.) Select and remove vertices with not-a-number coordinates and ...
 	//!     These vertices have to be removed before Non-Manifold and Double-Cones (Singularities) as they may introduce these other types.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Not-A-Number Vertices -----------------------" << std::endl;
-	getVertNotANumber( &verticesToRemove );
-	Mesh::removeVertices( &verticesToRemove );
+	if( wholeMesh ) {
+		getVertNotANumber( &verticesToRemove );
+	} else {
+		getRegionVertices( verticesToRemove, &Vertex::isNotANumber );
+	}
+	removeVerticesTracked( verticesToRemove, true );
 	//! 1b.) Select and remove vertices of faces having an areo of zero.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Zero area faces -----------------------------" << std::endl;
-	getVertPartOfZeroFace( &verticesToRemove );
-	Mesh::removeVertices( &verticesToRemove );
+	if( wholeMesh ) {
+		getVertPartOfZeroFace( &verticesToRemove );
+	} else {
+		getRegionVertices( verticesToRemove, &Vertex::isPartOfZeroFace );
+	}
+	removeVerticesTracked( verticesToRemove, true );
 	//! 2.) Select and remove sticky faces.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Sticky --------------------------------------" << std::endl;
-	getFaceSticky( &facesToRemove );
-	removeFaces( &facesToRemove );
+	if( wholeMesh ) {
+		getFaceSticky( &facesToRemove );
+	} else {
+		for( auto const& currFace: getRegionFaces() ) {
+			if( currFace->getFlag( FLAG_FACE_STICKY ) ) {
+				facesToRemove.insert( currFace );
+			}
+		}
+	}
+	removeFacesTracked( facesToRemove );
 	//! 3.) Select and remove non-manifold faces.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Non-Manifold --------------------------------" << std::endl;
-	getFaceNonManifold( &facesToRemove );
-	removeFaces( &facesToRemove );
+	if( wholeMesh ) {
+		getFaceNonManifold( &facesToRemove );
+	} else {
+		for( auto const& currFace: getRegionFaces() ) {
+			if( currFace->isNonManifold() ) {
+				facesToRemove.insert( currFace );
+			}
+		}
+	}
+	removeFacesTracked( facesToRemove );
 	// more agressive removal: getVertNonManifoldFaces( &verticesToRemove );
 	//! 4.) Select and remove vertices on edges connecting faces with inverted orientation.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Inverted ------------------------------------" << std::endl;
-	getVertInverted( verticesToRemove );
-	Mesh::removeVertices( &verticesToRemove );
+	if( wholeMesh ) {
+		getVertInverted( verticesToRemove );
+	} else {
+		getRegionVertices( verticesToRemove, &Vertex::isInverse );
+	}
+	removeVerticesTracked( verticesToRemove, true );
 	//! 5.) OPTIONAL apply erosion to remove 'dangling' faces.
+	//!     Same as Mesh::removeFacesBorderErosion, but restricted to the region.
 	if( rApplyErosion ) {
 		std::cout << "[Mesh::" << __FUNCTION__ << "] --- Border Erosion ------------------------------" << std::endl;
-		if( !removeFacesBorderErosion() ) {
-			std::cout << "[Mesh::" << __FUNCTION__ << "] ERROR: removeFacesBorderErosion failed!" << std::endl;
+		std::set<Vertex*> verticesCandidatesForRemoval;
+		uint64_t erosionIterations = 0;
+		erodeBorderFaces( wholeMesh ? nullptr : &regionVertices, removeFacesTracked,
+		                  verticesCandidatesForRemoval, erosionIterations );
+		// Remove solo vertices found in candidate list
+		for( auto const& currVertex: verticesCandidatesForRemoval ) {
+			if( currVertex->isSolo() ) {
+				verticesToRemove.insert( currVertex );
+			}
 		}
+		removeVerticesTracked( verticesToRemove, true );
+		std::cout << "[Mesh::" << __FUNCTION__ << "] Border erosion: " << erosionIterations << " iterations." << std::endl;
 	}
 	//! 6.) Select double cones.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Double Cones --------------------------------" << std::endl;
-	getDoubleCones( &verticesToRemove );
+	auto getDoubleConesRegion = [&]() {
+		if( wholeMesh ) {
+			getDoubleCones( &verticesToRemove );
+			return;
+		}
+		for( auto const& currVertex: regionVertices ) {
+			// Skip vertices not belonging to any face as in Mesh::getDoubleCones
+			if( ( currVertex->connectedToFacesCount() > 0 ) && currVertex->isDoubleCone() ) {
+				verticesToRemove.insert( currVertex );
+			}
+		}
+	};
+	getDoubleConesRegion();
 	//! 7.) Remove and select double-cones until there are no more showing up.
 	do {
-		Mesh::removeVertices( &verticesToRemove ); // "Mesh::" avoids the unnecessary regeneration of OpenGL VBOs within the GUI version - will be taken care of in step 7.
-		getDoubleCones( &verticesToRemove );
+		removeVerticesTracked( verticesToRemove, true );
+		getDoubleConesRegion();
 		rIteration++;
 	} while( verticesToRemove.size() > 0 );
 	//!     In very rare cases there may be new 'dangling' faces at this point, but no further optional
 	//!     erosion will be applied as it requires another slow loop over 4., 5. and 6.
 	//! 8.) ... solo vertices and ...
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Solo Vertices -------------------------------" << std::endl;
-	getVertSolo( &verticesToRemove );
-	Mesh::removeVertices( &verticesToRemove );
+	if( wholeMesh ) {
+		getVertSolo( &verticesToRemove );
+	} else {
+		getRegionVertices( verticesToRemove, &Vertex::isSolo );
+	}
+	removeVerticesTracked( verticesToRemove, true );
 	//! 9.) ... label and select small areas.
 	std::cout << "[Mesh::" << __FUNCTION__ << "] --- Small Areas ---------------------------------" << std::endl;
-	// first we reset the label and set all NOT to be labled.
-	labelVerticesAll();
-	getVertLabelAreaRelativeLT( rPercentArea, &verticesToRemove );
+	if( wholeMesh ) {
+		// first we reset the label and set all NOT to be labled.
+		labelVerticesAll();
+		rRegion.mAreaKeptMin = _INFINITE_DBL_;
+		getVertLabelAreaRelativeLT( rPercentArea, &verticesToRemove, &rRegion.mAreaKeptMin );
+	} else {
+		getVertLabelAreaRelativeLTRegion( rPercentArea, regionVertices, rRegion.mAreaKeptMin, &verticesToRemove );
+	}
 	//! 10.) Final remove (including reloading OpenGL buffers and lists.
-	removeVertices( &verticesToRemove );
+	removeVerticesTracked( verticesToRemove, false );
 
 	std::cout << "[Mesh::" << __FUNCTION__ << "] removed " << vertNoPrev - getVertexNr() << " vertices and " 
 	          << faceNoPrev - getFaceNr() << " faces." << std::endl;
@@ -10604,6 +11279,10 @@ bool Mesh::removeUncleanSmallCore(
 	}
 
 	//! 11.) Optional: save to file.
+	//!      The labels of the connected components are stored too, which are not determined for a region.
+	if( !wholeMesh ) {
+		labelVerticesAll();
+	}
 	return writeFile( rFileName );
 }
 
@@ -10659,6 +11338,10 @@ bool Mesh::removeFacesSelected() {
 }
 
 //! Removes multiple Faces from the faceList.
+//!
+//! Within an open transaction the removal is deferred until Mesh::editCommit.
+//! The given set will be empty afterwards.
+//!
 //! @returns false in case of an error or when no faces were removed.
 bool Mesh::removeFaces( set<Face*>* facesToRemove ) {
 	if( facesToRemove == nullptr ) {
@@ -10669,31 +11352,18 @@ bool Mesh::removeFaces( set<Face*>* facesToRemove ) {
 		// nothing to do.
 		return false;
 	}
-	int facesBefore = getFaceNr();
-	// Maintain face index!
-	unsigned int newFaceIndex = 0;
-	vector<Face*> mFacesNew;
-	bool faceRemoved = false;
-	set<Face*>::iterator itFound;
-	vector<Face*>::iterator itFace;
-	for( itFace = mFaces.begin(); itFace != mFaces.end(); itFace++ ) {
-		itFound = facesToRemove->find( (*itFace) );
-		if( itFound != facesToRemove->end() ) {
-			delete (*itFound);
-			facesToRemove->erase( itFound );
-			faceRemoved = true;
-			continue;
-		}
-		mFacesNew.push_back( (*itFace) );
-		(*itFace)->setIndex( newFaceIndex );
-		newFaceIndex++;
+	const bool ownTransaction = !isEditActive();
+	if( ownTransaction ) {
+		editBegin();
 	}
-	mFaces.clear();
-	mFaces.swap( mFacesNew );
-	// Set things straight:
-	mPrimSelected = nullptr;
-	cout << "[Mesh::" << __FUNCTION__ << "] " << facesBefore - getFaceNr() << " Faces removed." << endl;
-	return faceRemoved;
+	editRemoveFaces( *facesToRemove );
+	facesToRemove->clear();
+	if( !ownTransaction ) {
+		return true;
+	}
+	const uint64_t facesBefore = getFaceNr();
+	Mesh::editCommit();
+	return( getFaceNr() < facesBefore );
 }
 
 //! Removes faces with zero area.
@@ -10722,30 +11392,15 @@ bool Mesh::removeFacesZeroArea() {
 //!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::removeFacesBorderErosion() {
-	bool retVal = true;
-
 	uint64_t erosionIterations = 0;
 	uint64_t initialVertexNr = getVertexNr();
 	uint64_t initialFaceNr = getFaceNr();
-	uint64_t oldFaceNr;
 
-	set<Face*> facesToRemove;
 	set<Vertex*> verticesCandidatesForRemoval;
 
-	// Erode iterativly
-	do {
-		oldFaceNr = getFaceNr();
-		facesToRemove.clear();
-		retVal &= getFaceBorderVertsEdges( facesToRemove, 3, 2 ); // i.e. Dangling faces.
-		// Fetch all vertices, which have to be checked for becoming solo/singe.
-		for( auto const& currFace: facesToRemove ) {
-			currFace->getVertABC( &verticesCandidatesForRemoval );
-		}
-		if( facesToRemove.size() > 0 ) {
-			retVal &= removeFaces( &facesToRemove ); // removeFacesSelected() will be slow due to OpenGL interaction.
-		}
-		erosionIterations++;
-	} while( oldFaceNr - getFaceNr() != 0 );
+	// Erode iterativly - removeFacesSelected() would be slow due to OpenGL interaction.
+	bool retVal = erodeBorderFaces( nullptr, [this]( set<Face*>& rFacesToRemove ) { return( removeFaces( &rFacesToRemove ) ); },
+	                                verticesCandidatesForRemoval, erosionIterations );
 
 	// Remove solo vertices found in candidate list
 	set<Vertex*> verticesToRemove;
@@ -10765,6 +11420,224 @@ bool Mesh::removeFacesBorderErosion() {
 	return( retVal );
 }
 
+//! Iterativly removes 'dangling' faces i.e. faces having three vertices along the border
+//! and two edges along the border, until there are no more.
+//! Shared by Mesh::removeFacesBorderErosion and Mesh::removeUncleanSmallCore.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::erodeBorderFaces(
+                const set<Vertex*>*                       rRegionVerts,     //!< Only faces adjacent to these vertices are checked. nullptr for the whole mesh.
+                const std::function<bool(set<Face*>&)>&   rRemoveFaces,     //!< Removes the faces of one iteration - might extend rRegionVerts.
+                set<Vertex*>&                             rVerticesEroded,  //!< Output: vertices of the removed faces, which have to be checked for becoming solo.
+                uint64_t&                                 rIterations       //!< Output: number of iterations.
+) {
+	bool retVal = true;
+	rIterations = 0;
+	set<Face*> facesToRemove;
+	uint64_t oldFaceNr;
+	do {
+		oldFaceNr = getFaceNr();
+		facesToRemove.clear();
+		if( rRegionVerts == nullptr ) {
+			retVal &= getFaceBorderVertsEdges( facesToRemove, 3, 2 ); // i.e. Dangling faces.
+		} else {
+			set<Face*> regionFaces;
+			for( auto const& currVertex: (*rRegionVerts) ) {
+				currVertex->getFaces( &regionFaces );
+			}
+			for( auto const& currFace: regionFaces ) {
+				unsigned int numberBorderVertices;
+				currFace->hasBorderVertex( numberBorderVertices );
+				unsigned int numberBorderEdges;
+				currFace->hasBorderEdges( numberBorderEdges );
+				if( ( numberBorderVertices >= 3 ) && ( numberBorderEdges == 2 ) ) {
+					facesToRemove.insert( currFace );
+				}
+			}
+		}
+		// Fetch all vertices, which have to be checked for becoming solo/singe.
+		for( auto const& currFace: facesToRemove ) {
+			currFace->getVertABC( &rVerticesEroded );
+		}
+		if( facesToRemove.size() > 0 ) {
+			retVal &= rRemoveFaces( facesToRemove );
+		}
+		rIterations++;
+	} while( oldFaceNr - getFaceNr() != 0 );
+	return( retVal );
+}
+
+//! Merges vertices within the given distance e.g. duplicated per face by STL-style exports, which
+//! are otherwise treated as borders. Each cluster of vertices is replaced by its vertex with the
+//! lowest index, which gets the attributes according to the given policy - see VertexWelding.
+//! The faces of the other vertices are replaced by faces referring to the remaining vertices.
+//! Faces becoming degenerated i.e. having two corners welded into one vertex are removed.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::weldVertices(
+                double                          rTolerance,   //!< Maximum distance of vertices to be welded. Zero for identical coordinates.
+                VertexWelding::eAttributePolicy rPolicy,      //!< Policy for the attributes of the welded vertices.
+                uint64_t&                       rMergedNr     //!< Output: number of vertices removed by welding.
+) {
+	rMergedNr = 0;
+	if( isEditActive() ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Not possible within an open transaction!\n";
+		return( false );
+	}
+	const uint64_t vertexNr = getVertexNr();
+	const uint64_t faceNr   = getFaceNr();
+	const bool     useMean  = ( rPolicy == VertexWelding::ATTRIBUTES_MEAN );
+	vector<double>            vertexCoords( vertexNr * 3 );
+	vector<sVertexProperties> vertexProps( useMean ? vertexNr : 0 );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			Vertex* vertex = getVertexPos( vertIdx );
+			vertex->setIndex( vertIdx );
+			vertexCoords[vertIdx*3]   = vertex->getX();
+			vertexCoords[vertIdx*3+1] = vertex->getY();
+			vertexCoords[vertIdx*3+2] = vertex->getZ();
+			if( useMean ) {
+				vertex->copyVertexPropsTo( vertexProps[vertIdx] );
+			}
+		}
+	} );
+	VertexWelding welding;
+	if( !welding.weld( vertexCoords, rTolerance ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Invalid tolerance " << rTolerance << "!\n";
+		return( false );
+	}
+	rMergedNr = welding.getMergedNr();
+	cout << "[Mesh::" << __FUNCTION__ << "] Vertices merged: " << rMergedNr << " of " << vertexNr << endl;
+	if( rMergedNr == 0 ) {
+		return( true );
+	}
+	const vector<uint64_t>& vertexMap      = welding.getVertexMap();
+	const vector<uint64_t>& clusterOffsets = welding.getClusterOffsets();
+	const vector<uint64_t>& clusterMembers = welding.getClusterMembers();
+	auto getRepresentative = [&]( uint64_t rVertIdx ) {
+		return( static_cast<VertexOfFace*>( getVertexPos( clusterMembers[clusterOffsets[vertexMap[rVertIdx]]] ) ) );
+	};
+
+	// Attributes of the remaining vertices.
+	if( useMean ) {
+		vector<sVertexProperties> weldedProps;
+		welding.mergeVertexProps( vertexProps, rPolicy, weldedProps );
+		parallelFor( weldedProps.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+			vector<double> featureVec;
+			vector<double> featureVecMember;
+			for( uint64_t weldedIdx=rBegin; weldedIdx<rEnd; weldedIdx++ ) {
+				const uint64_t memberFirst = clusterOffsets[weldedIdx];
+				const uint64_t memberEnd   = clusterOffsets[weldedIdx+1];
+				if( memberEnd - memberFirst == 1 ) {
+					continue;
+				}
+				const sVertexProperties& props = weldedProps[weldedIdx];
+				Vertex* vertex = getVertexPos( clusterMembers[memberFirst] );
+				vertex->setPosition( props.mCoordX, props.mCoordY, props.mCoordZ );
+				if( !std::isnan( props.mNormalX ) ) {
+					vertex->setNormal( props.mNormalX, props.mNormalY, props.mNormalZ );
+				}
+				vertex->setRGB( props.mColorRed, props.mColorGrn, props.mColorBle );
+				vertex->setAlpha( props.mColorAlp );
+				vertex->setFuncValue( props.mFuncVal );
+				// Mean of the feature vectors, when all have the same length.
+				const unsigned int featureVecLen = vertex->getFeatureVectorLen();
+				if( featureVecLen == 0 ) {
+					continue;
+				}
+				featureVec.assign( featureVecLen, 0.0 );
+				featureVecMember.resize( featureVecLen );
+				bool sameLen = true;
+				for( uint64_t memberPos=memberFirst; memberPos<memberEnd; memberPos++ ) {
+					Vertex* member = getVertexPos( clusterMembers[memberPos] );
+					if( member->getFeatureVectorLen() != featureVecLen ) {
+						sameLen = false;
+						break;
+					}
+					member->copyFeatureVecTo( featureVecMember.data() );
+					for( unsigned int i=0; i<featureVecLen; i++ ) {
+						featureVec[i] += featureVecMember[i];
+					}
+				}
+				if( sameLen ) {
+					for( double& element : featureVec ) {
+						element /= static_cast<double>( memberEnd - memberFirst );
+					}
+					vertex->assignFeatureVec( featureVec.data(), featureVecLen );
+				}
+			}
+		} );
+	}
+
+	// Faces referring to removed vertices are replaced.
+	vector<unsigned char> faceReplace( faceNr, 0 );
+	parallelFor( faceNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* face = getFacePos( faceIdx );
+			for( const uint64_t vertIdx : { face->getVertAIndex(), face->getVertBIndex(), face->getVertCIndex() } ) {
+				if( getRepresentative( vertIdx ) != getVertexPos( vertIdx ) ) {
+					faceReplace[faceIdx] = 1;
+				}
+			}
+		}
+	} );
+	// Sequential, as the constructor of a face connects it to its vertices:
+	vector<Face*>   facesNew;
+	uint64_t        facesDegenerated = 0;
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		if( faceReplace[faceIdx] == 0 ) {
+			continue;
+		}
+		Face* face = getFacePos( faceIdx );
+		VertexOfFace* vertA = getRepresentative( face->getVertAIndex() );
+		VertexOfFace* vertB = getRepresentative( face->getVertBIndex() );
+		VertexOfFace* vertC = getRepresentative( face->getVertCIndex() );
+		if( ( vertA == vertB ) || ( vertB == vertC ) || ( vertC == vertA ) ) {
+			facesDegenerated++;
+			continue;
+		}
+		Face* faceCreated = new Face( faceNr + facesNew.size(), vertA, vertB, vertC );
+		faceCreated->setUVs( face->getUVs() );
+		faceCreated->setTextureId( face->getTextureId() );
+		facesNew.push_back( faceCreated );
+	}
+	set<Vertex*>    verticesRemove;
+	vector<Vertex*> verticesKept;
+	for( uint64_t weldedIdx=0; weldedIdx+1<clusterOffsets.size(); weldedIdx++ ) {
+		if( clusterOffsets[weldedIdx+1] - clusterOffsets[weldedIdx] == 1 ) {
+			continue;
+		}
+		verticesKept.push_back( getVertexPos( clusterMembers[clusterOffsets[weldedIdx]] ) );
+		for( uint64_t memberPos=clusterOffsets[weldedIdx]+1; memberPos<clusterOffsets[weldedIdx+1]; memberPos++ ) {
+			verticesRemove.insert( getVertexPos( clusterMembers[memberPos] ) );
+		}
+	}
+	cout << "[Mesh::" << __FUNCTION__ << "] Faces replaced: " << facesNew.size() << " Degenerated faces removed: " << facesDegenerated << endl;
+	editBegin();
+	editRemoveVertices( verticesRemove );
+	editInsertFaces( facesNew );
+	editCommit();
+
+	// Re-establish mesh - the faces around the new faces and the remaining vertices.
+	for( Face* face : facesNew ) {
+		verticesKept.push_back( face->getVertA() );
+		verticesKept.push_back( face->getVertB() );
+		verticesKept.push_back( face->getVertC() );
+	}
+	std::sort( verticesKept.begin(), verticesKept.end() );
+	verticesKept.erase( std::unique( verticesKept.begin(), verticesKept.end() ), verticesKept.end() );
+	vector<Face*> facesReconnect;
+	for( Vertex* vertex : verticesKept ) {
+		vertex->getFaces( &facesReconnect );
+	}
+	std::sort( facesReconnect.begin(), facesReconnect.end() );
+	facesReconnect.erase( std::unique( facesReconnect.begin(), facesReconnect.end() ), facesReconnect.end() );
+	for( Face* face : facesReconnect ) {
+		face->reconnectToFaces();
+	}
+	return( changedMesh() );
+}
+
 // --- Mesh manipulation - MESH POLISHING ------------------------------------------------------------------------------------------------------
 
 //! Automatic mesh polishing -- stub used for the GUI.
@@ -10777,6 +11650,11 @@ bool Mesh::completeRestore() {
 
 //! Automatic mesh polishing.
 //!
+//! Cleaning and filling holes is repeated until the mesh does not change
+//! anymore. Only the first iteration checks the whole mesh. The following
+//! iterations check the vertices next to primitives removed or added by the
+//! previous iteration - see Mesh::removeUncleanSmallCore
+//!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::completeRestore(
         const filesystem::path& rFilename,            //!< Optional filname for storing the mesh after each operation. An empty string will prevent saving the mesh.
@@ -10807,6 +11685,10 @@ bool Mesh::completeRestore(
 	uint64_t totalHolesSkipped = 0;
 	bool someHolesFilled = true; // Exit condition for the following do-while loop
 
+	// The first iteration checks the whole mesh. Afterwards only the regions
+	// next to removed primitives and the filled holes can have new defects.
+	sCleaningRegion cleaningRegion;
+
 	do {
 		// Track changes to the number of vertices and faces.
 		// One cleaning iteration with hole filling.
@@ -10814,7 +11696,8 @@ bool Mesh::completeRestore(
 		oldVertexNr = getVertexNr();
 		oldFaceNr = getFaceNr();
 		uint64_t subIterationCount = 0;
-		removeUncleanSmallCore( rFilename, rPercentArea, rApplyErosion, subIterationCount );
+		removeUncleanSmallCore( rFilename, rPercentArea, rApplyErosion, subIterationCount, cleaningRegion );
+		cleaningRegion.mWholeMesh = false;
 		convertBordersToPolylines();
 
 		if( rPrevent ) {
@@ -10826,7 +11709,12 @@ bool Mesh::completeRestore(
 		uint64_t holesFilled  = 0;
 		uint64_t holesFail    = 0;
 		uint64_t holesSkipped = 0;
+		const uint64_t faceNrBeforeFill = getFaceNr();
 		fillPolyLines( rMaxNumberVertices, holesFilled, holesFail, holesSkipped );
+		// New faces are appended - their vertices include the former border.
+		for( uint64_t faceIdx=faceNrBeforeFill; faceIdx<getFaceNr(); faceIdx++ ) {
+			getFacePos( faceIdx )->getVertABC( &cleaningRegion.mVertices );
+		}
 		totalHolesFilled  += holesFilled;
 		totalHolesFail    += holesFail;
 		totalHolesSkipped += holesSkipped;
@@ -10840,6 +11728,12 @@ bool Mesh::completeRestore(
 	         ( oldFaceNr - getFaceNr() ) !=0      ||
 	         ( someHolesFilled ) );
 
+	// The incremental iterations do not label the vertices - refresh the labels
+	// of the connected components, unless it was done for saving.
+	if( ( rIterationCount > 1 ) && rFilename.empty() ) {
+		labelVerticesAll();
+	}
+
 	string tempstr;
 	if( ( totalHolesFail == 0 ) && ( totalHolesSkipped == 0 ) ) {
 		tempstr = "All holes were filled.";
@@ -10947,11 +11841,271 @@ bool Mesh::insertVertices( vector<Vertex*>* rNewVertices ) {
 	if( rNewVertices == nullptr ) {
 		return false;
 	}
-	// Insert by appending:
-	for( auto const& currVertexRef: (*rNewVertices) ) {
-		mVertices.push_back( currVertexRef );
+	// Insert by appending:
+	for( auto const& currVertexRef: (*rNewVertices) ) {
+		mVertices.push_back( currVertexRef );
+	}
+	return true;
+}
+
+// --- Mesh manipulation - Batched edits i.e. transactions -------------------------------------------------------------------------------------
+
+//! Opens a transaction for a batch of removals and insertions.
+//!
+//! Removed primitives are only tagged with FLAG_REMOVED and remain within the
+//! mesh, until Mesh::editCommit compacts the arrays of vertices and faces
+//! once. Therefore removed primitives are still visible to other methods
+//! within the transaction. Nested transactions are not supported.
+//!
+//! @returns false in case of an error e.g. an already open transaction. True otherwise.
+bool Mesh::editBegin() {
+	if( mEdit.mActive ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Transaction already open!\n";
+		return( false );
+	}
+	mEdit = sEditTransaction();
+	mEdit.mActive = true;
+	return( true );
+}
+
+//! Tags vertices and their adjacent faces for removal.
+//! The vertices have to belong to this mesh.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::editRemoveVertices( const set<Vertex*>& rVerticesToRemove ) {
+	if( !mEdit.mActive ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: No transaction open!\n";
+		return( false );
+	}
+	vector<Face*> facesAdjacent;
+	for( auto const& currVertex: rVerticesToRemove ) {
+		if( currVertex->getFlag( FLAG_REMOVED ) ) {
+			continue;
+		}
+		currVertex->setFlag( FLAG_REMOVED );
+		mEdit.mVerticesRemoved++;
+		facesAdjacent.clear();
+		currVertex->getFaces( &facesAdjacent );
+		for( auto const& currFace: facesAdjacent ) {
+			if( !currFace->getFlag( FLAG_REMOVED ) ) {
+				currFace->setFlag( FLAG_REMOVED );
+				mEdit.mFacesRemoved++;
+			}
+		}
+	}
+	return( true );
+}
+
+//! Tags faces for removal. The faces have to belong to this mesh.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::editRemoveFaces( const set<Face*>& rFacesToRemove ) {
+	if( !mEdit.mActive ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: No transaction open!\n";
+		return( false );
+	}
+	for( auto const& currFace: rFacesToRemove ) {
+		if( !currFace->getFlag( FLAG_REMOVED ) ) {
+			currFace->setFlag( FLAG_REMOVED );
+			mEdit.mFacesRemoved++;
+		}
+	}
+	return( true );
+}
+
+//! Adds new vertices, which will be appended by Mesh::editCommit.
+//! The mesh takes ownership.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::editInsertVertices( const vector<Vertex*>& rNewVertices ) {
+	if( !mEdit.mActive ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: No transaction open!\n";
+		return( false );
+	}
+	mEdit.mVerticesNew.insert( mEdit.mVerticesNew.end(), rNewVertices.begin(), rNewVertices.end() );
+	return( true );
+}
+
+//! Adds new faces, which will be appended by Mesh::editCommit.
+//! The mesh takes ownership. Their vertices have to belong to the mesh or
+//! have to be inserted within the same transaction.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::editInsertFaces( const vector<Face*>& rNewFaces ) {
+	if( !mEdit.mActive ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: No transaction open!\n";
+		return( false );
+	}
+	mEdit.mFacesNew.insert( mEdit.mFacesNew.end(), rNewFaces.begin(), rNewFaces.end() );
+	return( true );
+}
+
+//! Applies the batch of removals and insertions and closes the transaction.
+//!
+//! New primitives are appended first, so that primitives inserted and removed
+//! within the same transaction are handled by the compaction. The arrays of
+//! vertices and faces are compacted in parallel maintaining the order of the
+//! remaining primitives. The removed primitives are deleted sequentially as
+//! the destructor of a face changes its vertices and neighbours. Selections
+//! are cleared of removed primitives. Finally the derived data is updated or
+//! invalidated once: the face indices and the octree, which refers to faces
+//! and vertices, for any change; the bounding box and the statistics of the
+//! function values only when vertices were removed or inserted.
+//!
+//! Derived classes extend this method to update their buffers e.g. OpenGL VBOs.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::editCommit() {
+	if( !mEdit.mActive ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: No transaction open!\n";
+		return( false );
+	}
+	sEditTransaction edit;
+	std::swap( edit, mEdit );
+	if( ( edit.mVerticesRemoved == 0 ) && ( edit.mFacesRemoved == 0 ) &&
+	    edit.mVerticesNew.empty() && edit.mFacesNew.empty() ) {
+		return( true );
+	}
+
+	mVertices.insert( mVertices.end(), edit.mVerticesNew.begin(), edit.mVerticesNew.end() );
+	mFaces.insert( mFaces.end(), edit.mFacesNew.begin(), edit.mFacesNew.end() );
+
+	// Selections must not keep references to removed primitives.
+	auto eraseRemoved = []( auto& rSomeSet ) {
+		uint64_t erasedCount = 0;
+		for( auto it = rSomeSet.begin(); it != rSomeSet.end(); ) {
+			if( (*it)->getFlag( FLAG_REMOVED ) ) {
+				it = rSomeSet.erase( it );
+				erasedCount++;
+				continue;
+			}
+			it++;
+		}
+		return( erasedCount > 0 );
+	};
+	bool selVertsChanged = false;
+	bool selFacesChanged = false;
+	if( edit.mVerticesRemoved > 0 ) {
+		selVertsChanged = eraseRemoved( mSelectedMVerts );
+		eraseRemoved( mLabelSeedVerts );
+	}
+	if( edit.mFacesRemoved > 0 ) {
+		selFacesChanged = eraseRemoved( mFacesSelected );
+	}
+
+	// Faces first - their destructor disconnects them from the vertices.
+	vector<Face*> facesRemoved;
+	parallelCompact( mFaces, []( const Face* rFace ) { return( rFace->getFlag( FLAG_REMOVED ) ); }, &facesRemoved );
+	for( auto const& currFace: facesRemoved ) {
+		delete currFace;
+	}
+	vector<Vertex*> verticesRemoved;
+	parallelCompact( mVertices, []( const Vertex* rVertex ) { return( rVertex->getFlag( FLAG_REMOVED ) ); }, &verticesRemoved );
+	for( auto const& currVertex: verticesRemoved ) {
+		delete currVertex;
+	}
+	cout << "[Mesh::" << __FUNCTION__ << "] " << facesRemoved.size() << " Faces and " << verticesRemoved.size() << " Vertices removed. "
+	     << edit.mFacesNew.size() << " Faces and " << edit.mVerticesNew.size() << " Vertices inserted." << endl;
+
+	// Maintain face index!
+	parallelFor( mFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			mFaces[faceIdx]->setIndex( static_cast<int>( faceIdx ) );
+		}
+	} );
+
+	// Set things straight - once per transaction:
+	mPrimSelected = nullptr;
+	delete mOctree;
+	mOctree = nullptr;
+	if( ( edit.mVerticesRemoved > 0 ) || !edit.mVerticesNew.empty() ) {
+		estBoundingBox();
+		mFuncValStatistics.invalidate();
+	}
+	if( selVertsChanged ) {
+		selectedMVertsChanged();
+	}
+	if( selFacesChanged ) {
+		selectedMFacesChanged();
+	}
+	return( true );
+}
+
+//! @returns true, when a transaction was opened by Mesh::editBegin and not yet committed.
+bool Mesh::isEditActive() const {
+	return( mEdit.mActive );
+}
+
+// --- Mesh manipulation - SIMPLIFICATION ------------------------------------------------------------------------------------------------------
+
+//! Simplifies the mesh by edge collapses guided by quadric error metrics - see QuadricDecimation.
+//! Borders and the borders between labels are preserved. This mesh is not changed, instead
+//! the properties of the simplified mesh are returned, which can be passed to the according constructor.
+//! The remaining vertices keep all their properties including the function values.
+//!
+//! @param rTargetFaceNr number of faces to reach - might not be reached, e.g. because of rMaxError.
+//! @param rMaxError maximum costs of a single collapse i.e. sum of weighted squared distances. Infinity for no limit.
+//! @param rFineToCoarse index of the vertex of the simplified mesh for each vertex of this mesh.
+//! @returns False in case of an error. True otherwise.
+bool Mesh::decimateQuadricError(
+                uint64_t                        rTargetFaceNr,
+                double                          rMaxError,
+                std::vector<sVertexProperties>& rVertexProps,
+                std::vector<sFaceProperties>&   rFaceProps,
+                std::vector<uint64_t>&          rFineToCoarse
+) {
+	const uint64_t vertexNr = getVertexNr();
+	const uint64_t faceNr   = getFaceNr();
+	if( faceNr == 0 ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: No faces!\n";
+		return( false );
+	}
+	showProgressStart( "Quadric Decimation" );
+	vector<double>   vertexCoords( vertexNr * 3 );
+	vector<uint64_t> vertexLabels( vertexNr );
+	vector<uint64_t> faceVertexIndices( faceNr * 3 );
+	// The index is set to the position within the vector to fetch the indices of the vertices of the faces.
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			Vertex* vertex = getVertexPos( vertIdx );
+			vertex->setIndex( vertIdx );
+			vertex->copyXYZTo( &vertexCoords[vertIdx*3] );
+			// Background and unlabeled vertices share a label distinct from all label numbers:
+			if( !vertex->getLabel( vertexLabels[vertIdx] ) ) {
+				vertexLabels[vertIdx] = std::numeric_limits<uint64_t>::max();
+			}
+		}
+	} );
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		Face* face = getFacePos( faceIdx );
+		faceVertexIndices[faceIdx*3]   = face->getVertAIndex();
+		faceVertexIndices[faceIdx*3+1] = face->getVertBIndex();
+		faceVertexIndices[faceIdx*3+2] = face->getVertCIndex();
 	}
-	return true;
+
+	QuadricDecimation decimation;
+	if( !decimation.decimate( vertexCoords, faceVertexIndices, vertexLabels, rTargetFaceNr, rMaxError ) ) {
+		LOG::error() << "[Mesh::" << __FUNCTION__ << "] ERROR: Bad vertex indices of the faces!\n";
+		showProgressStop( "Quadric Decimation" );
+		return( false );
+	}
+	const vector<uint64_t>& coarseToFine = decimation.getCoarseToFine();
+	rVertexProps.resize( coarseToFine.size() );
+	parallelFor( coarseToFine.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t coarseIdx=rBegin; coarseIdx<rEnd; coarseIdx++ ) {
+			getVertexPos( coarseToFine[coarseIdx] )->copyVertexPropsTo( rVertexProps[coarseIdx] );
+		}
+	} );
+	const vector<uint64_t>& coarseFaces = decimation.getFaceVertexIndices();
+	rFaceProps.resize( decimation.getFaceNr() );
+	for( uint64_t faceIdx=0; faceIdx<rFaceProps.size(); faceIdx++ ) {
+		rFaceProps[faceIdx].vertexIndices.assign( coarseFaces.begin() + faceIdx*3, coarseFaces.begin() + faceIdx*3 + 3 );
+	}
+	rFineToCoarse = decimation.getFineToCoarse();
+	LOG::info() << "[Mesh::" << __FUNCTION__ << "] Faces: " << faceNr << " -> " << rFaceProps.size()
+	            << " Vertices: " << vertexNr << " -> " << rVertexProps.size() << "\n";
+	showProgressStop( "Quadric Decimation" );
+	return( true );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------------------------------
@@ -11347,7 +12501,14 @@ bool Mesh::getVertLabelAreaLT( double rAreaMax, set<Vertex*>* rSomeVerts ) {
 //! rPercent accepts only ] 0.0... 1.0 [
 //!
 //! Remark: this will not select single vertices, even they got their own label no!
-bool Mesh::getVertLabelAreaRelativeLT( double rPercent, set<Vertex*>* rSomeVerts ) {
+//!
+//! Optionally returns the smallest area of the labels kept, which is used by
+//! the incremental cleaning - see Mesh::getVertLabelAreaRelativeLTRegion
+bool Mesh::getVertLabelAreaRelativeLT(
+                double        rPercent,       //!< Relative area within ] 0.0... 1.0 [
+                set<Vertex*>* rSomeVerts,     //!< Vertices of the labels smaller than rPercent.
+                double*       rAreaKeptMin    //!< Optional: smallest area of the labels kept.
+) {
 
 	set<Face*>*   labelFaces;
 	uint64_t labelsNr;
@@ -11386,6 +12547,9 @@ bool Mesh::getVertLabelAreaRelativeLT( double rPercent, set<Vertex*>* rSomeVerts
 	int labelsRemoved = 0;
 	for( uint64_t i=0; i<labelsNrConst; i++ ) {
 		if( labelAreas[i]/labelAreaTotal >= rPercent ) {
+			if( rAreaKeptMin != nullptr ) {
+				(*rAreaKeptMin) = std::min( (*rAreaKeptMin), labelAreas[i] );
+			}
 			// We don't need the faces anymore and jump to the next label.
 			labelFaces[i].clear();
 			continue;
@@ -11412,6 +12576,113 @@ bool Mesh::getVertLabelAreaRelativeLT( double rPercent, set<Vertex*>* rSomeVerts
 	return true;
 }
 
+//! Fetches all vertices of connected components having an area smaller than
+//! rPercent of the whole mesh, which are adjacent to the given region.
+//! Incremental variant of Mesh::getVertLabelAreaRelativeLT used by
+//! Mesh::removeUncleanSmallCore after the first pass.
+//!
+//! The components are traversed from the region via the faces sharing a
+//! vertex - the same connectivity as labelVerticesAll. A traversal stops as
+//! soon as the area exceeds the threshold, so that the large components are
+//! not visited completely. Components away from the region did not change
+//! and are kept, as long as rAreaKeptMin, which is a lower bound of their
+//! area, is above the threshold. Otherwise e.g. the total area has grown
+//! significantly the whole mesh is labeled again.
+//!
+//! Remark: this will not select single vertices.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::getVertLabelAreaRelativeLTRegion(
+                double                   rPercent,       //!< Relative area within ] 0.0... 1.0 [
+                const std::set<Vertex*>& rRegionVerts,   //!< Vertices of the region, which changed since the last labeling.
+                double&                  rAreaKeptMin,   //!< Lower bound for the area of the components kept - updated.
+                std::set<Vertex*>*       rSomeVerts      //!< Vertices of the components smaller than rPercent.
+) {
+	if( ( rPercent <= 0.0 ) || ( rPercent >= 1.0 ) ) {
+		cout << "[Mesh::" << __FUNCTION__ << "] value out of range ] 0.0 ... 1.0 [ given: " << rPercent << endl;
+		return( false );
+	}
+
+	// Total area - in parallel as it is the only step touching all faces.
+	std::vector<double> threadArea( getParallelThreadCount(), 0.0 );
+	parallelFor( getFaceNr(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		double areaSum = 0.0;
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			areaSum += getFacePos( faceIdx )->getAreaNormal();
+		}
+		threadArea[rThreadIdx] += areaSum;
+	} );
+	const double areaTotal = std::accumulate( threadArea.begin(), threadArea.end(), 0.0 );
+	cout << "[Mesh::" << __FUNCTION__ << "] Total area: " << areaTotal << endl;
+	if( !( areaTotal > 0.0 ) ) {
+		return( false );
+	}
+
+	// Components away from the region might fall below the threshold.
+	if( rAreaKeptMin/areaTotal < rPercent ) {
+		cout << "[Mesh::" << __FUNCTION__ << "] Threshold exceeds the smallest component kept - labeling the whole mesh." << endl;
+		labelVerticesAll();
+		rAreaKeptMin = _INFINITE_DBL_;
+		return( getVertLabelAreaRelativeLT( rPercent, rSomeVerts, &rAreaKeptMin ) );
+	}
+
+	// Traverse the components adjacent to the region.
+	std::unordered_map<Face*, uint64_t> faceComponent; // Number of the traversal visiting a face.
+	std::vector<Face*> facesComponent;
+	std::vector<Face*> facesAdjacent;
+	std::vector<Face*> facesNext;
+	uint64_t componentNr = 0;
+	uint64_t componentsRemoved = 0;
+	for( auto const& seedVertex: rRegionVerts ) {
+		facesAdjacent.clear();
+		seedVertex->getFaces( &facesAdjacent );
+		for( auto const& seedFace: facesAdjacent ) {
+			if( !faceComponent.emplace( seedFace, componentNr ).second ) {
+				continue;
+			}
+			// Breadth first, until the threshold is reached or another traversal is met.
+			// The latter has stopped at the threshold, because otherwise all its faces were visited.
+			facesComponent.clear();
+			facesComponent.push_back( seedFace );
+			double componentArea = 0.0;
+			bool   componentLarge = false;
+			for( uint64_t i=0; ( i<facesComponent.size() ) && !componentLarge; i++ ) {
+				Face* currFace = facesComponent[i];
+				componentArea += currFace->getAreaNormal();
+				if( componentArea/areaTotal >= rPercent ) {
+					rAreaKeptMin = std::min( rAreaKeptMin, componentArea );
+					componentLarge = true;
+					break;
+				}
+				for( Vertex* currVertex: { currFace->getVertA(), currFace->getVertB(), currFace->getVertC() } ) {
+					facesNext.clear();
+					currVertex->getFaces( &facesNext );
+					for( auto const& nextFace: facesNext ) {
+						auto visited = faceComponent.emplace( nextFace, componentNr );
+						if( visited.second ) {
+							facesComponent.push_back( nextFace );
+						} else if( visited.first->second != componentNr ) {
+							componentLarge = true;
+						}
+					}
+				}
+			}
+			componentNr++;
+			if( componentLarge ) {
+				continue;
+			}
+			// Add the faces vertices to the given set of vertices.
+			for( auto const& currFace: facesComponent ) {
+				currFace->getVertABC( rSomeVerts );
+			}
+			componentsRemoved++;
+		}
+	}
+
+	cout << "[Mesh::" << __FUNCTION__ << "] " << componentsRemoved << " out of " << componentNr << " components adjacent to the region selected." << endl;
+	return( true );
+}
+
 bool Mesh::getVertLabled( set<Vertex*>* rSomeVerts ) {
 	//! Adds all vertices having the status labeld to rSomeVerts.
 	//! Returns false in case of an error.
@@ -12063,6 +13334,10 @@ bool Mesh::compVolumePlane( double* rVolumePos, double* rVolumeNeg ) {
 // Histogram (NEW) ---------------------------------------------------------------------------------------------------------------------------------------------
 
 //! Returns an integer array for rendering a raster image of a histogram
+//!
+//! The histogram of the vertices' function values is served from the same cache as
+//! Mesh::getFuncValuesMinMax, i.e. direct changes of the function values have to be
+//! followed by Mesh::changedVertFuncVal.
 bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of the values shown by the histogram
                            vector<unsigned int>* rNumArray,  //!< Array to be filled has to be of length rNumValues
                            double* rValMin,                  //!< Minimum value represented by rNumArray.
@@ -12075,13 +13350,24 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 		return false;
 	}
 
+	// Function values are served from the cache.
+	if( rHistType == HISTOGRAM_FUNCTION_VALUES_VERTEX ) {
+		updateFuncValStatistics();
+		if( !mFuncValStatistics.getHistogram( *rNumArray, *rValMin, *rValMax ) ) {
+			cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Histogram values have no range!" << endl;
+			return false;
+		}
+		cout << "[Mesh::" << __FUNCTION__ << "] Histogram # " << rHistType << " successful." << endl;
+		return true;
+	}
+
 	// Fetch values
-	unsigned int histValuesNr = 0;
-	double*      histValues = nullptr;
+	unsigned int   histValuesNr = 0;
+	vector<double> histValues;
 	switch( rHistType ) {
 		case HISTOGRAM_EDGE_LENGTH: {
 			histValuesNr = 3*getFaceNr();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			Face* currFace;
 			for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
 				currFace = getFacePos( faceIdx );
@@ -12094,7 +13380,7 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 				currVertex = getVertexPos( vertIdx );
 				histValuesNr += currVertex->getFeatureVectorLen();
 			}
-			histValues = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			unsigned int arrayPos = 0;
 			for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
 				currVertex = getVertexPos( vertIdx );
@@ -12104,7 +13390,7 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 		} break;
 		case HISTOGRAM_FEATURE_ELEMENTS_VERTEX_DIM: {
 			histValuesNr = getVertexNr();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			int dimNr;
 			getParamIntMesh( HISTOGRAM_SHOW_FEATURE_ELEMENT_VERTEX_DIM, &dimNr );
 			Vertex* currVertex;
@@ -12113,18 +13399,9 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 				currVertex->getFeatureElement( dimNr, &histValues[vertIdx] );
 			}
 		} break;
-		case HISTOGRAM_FUNCTION_VALUES_VERTEX: {
-			histValuesNr = getVertexNr();
-			histValues   = new double[histValuesNr];
-			Vertex* currVertex;
-			for( unsigned int vertIdx=0; vertIdx<histValuesNr; vertIdx++ ) {
-				currVertex = getVertexPos( vertIdx );
-				currVertex->getFuncValue( &histValues[vertIdx] );
-			}
-		} break;
 		case HISTOGRAM_FUNCTION_VALUES_VERTEX_LOCAL_MINIMA: {
 			histValuesNr = getVertexNr();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			Vertex* currVertex;
 			for( unsigned int vertIdx=0; vertIdx<histValuesNr; vertIdx++ ) {
 				currVertex = getVertexPos( vertIdx );
@@ -12136,7 +13413,7 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 		} break;
 		case HISTOGRAM_FUNCTION_VALUES_VERTEX_LOCAL_MAXIMA: {
 			histValuesNr = getVertexNr();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			Vertex* currVertex;
 			for( unsigned int vertIdx=0; vertIdx<histValuesNr; vertIdx++ ) {
 				currVertex = getVertexPos( vertIdx );
@@ -12148,7 +13425,7 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 		} break;
 		case HISTOGRAM_ANGLES_FACES_MINIMUM: {
 			histValuesNr = getFaceNr();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			Face* currFace;
 			// Step thru all faces, fetch largest face angle and determine the global minimum and maximum
 			for( unsigned int faceIdx=0; faceIdx<histValuesNr; faceIdx++ ) {
@@ -12161,7 +13438,7 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 		} break;
 		case HISTOGRAM_ANGLES_FACES_MAXIMUM: {
 			histValuesNr = getFaceNr();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 			Face* currFace;
 			// Step thru all faces, fetch largest face angle and determine the global minimum and maximum
 			for( unsigned int faceIdx=0; faceIdx<histValuesNr; faceIdx++ ) {
@@ -12187,7 +13464,7 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 			sort( polyLens.begin(), polyLens.end() );
 
 			histValuesNr = polyLens.size();
-			histValues   = new double[histValuesNr];
+			histValues.resize( histValuesNr );
 //			double* polyIndex = new double[histValuesNr];
 			for( unsigned int i=0; i<histValuesNr; i++ ) {
 //				polyIndex[i] = static_cast<double>(i);
@@ -12224,19 +13501,11 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 	double histRange = (*rValMax) - (*rValMin);
 	if( histRange <= DBL_EPSILON ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Histogram values have no range!" << endl;
-		if(histValues)
-		{
-			delete[] histValues;
-		}
 		return false;
 	}
 	double histIntervalLen = histRange / rNumArray->size();
 	if( histIntervalLen <= DBL_EPSILON ) {
 		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Numeric Error: Zero interval length for histogram!" << endl;
-		if(histValues)
-		{
-			delete[] histValues;
-		}
 		return false;
 	}
 
@@ -12256,10 +13525,6 @@ bool Mesh::getHistogramValues( eHistogramType        rHistType,  //!< Type of th
 	}
 
 	cout << "[Mesh::" << __FUNCTION__ << "] Histogram # " << rHistType << " successful." << endl;
-	if(histValues)
-	{
-		delete[] histValues;
-	}
 	return true;
 }
 
@@ -13259,7 +14524,7 @@ bool Mesh::fetchSphereBitArray( Vertex*        rSeedVertex,          //!< point
 	int  currIdx = rSeedVertex->getIndex();
 	double seqNr = 0.0; // Only used, when rOrderToFuncVal is setS
 	rSeedVertex->getIndexOffsetBit( &bitOffset, &bitNr );
-	rVertBitArrayVisited[bitOffset] = 1U <<bitNr;
+	rVertBitArrayVisited[bitOffset] |= static_cast<uint64_t>(1) << bitNr;
 	nextArray.insert( rSeedVertex );
 	//! While there are vertices at the front:
 	while( nextArray.size() > 0 ) {
@@ -13372,6 +14637,194 @@ bool Mesh::fetchSphereBitArray1R(
 	return( true );
 }
 
+//! Calls rFunc for the neighbourhood of each vertex within a sphere of the given radius - see sSphereNeighbourhood.
+//! The vertices are processed in parallel. rFunc gets the index of the calling thread within
+//! [0,getParallelThreadCount()) to address per-thread accumulators. Each thread uses its own bit
+//! arrays, which are cleared only for the visited primitives.
+//! ATTENTION: Requires that the vertex and face indices are set properly!
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::mapSphereNeighbourhoods(
+                double rRadius,                                                                 //!< Radius of the spheres.
+                const std::function<void(const sSphereNeighbourhood&, unsigned int)>& rFunc     //!< Called once per vertex - possibly in parallel.
+) {
+	if( !( rRadius >= 0.0 ) ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: Invalid radius of " << rRadius << " given!" << endl;
+		return( false );
+	}
+	const uint64_t vertNrLongs = getVertexNr() / 64 + 1;
+	const uint64_t faceNrLongs = getFaceNr() / 64 + 1;
+	auto markVisited = []( vector<uint64_t>& rBitArray, uint64_t rIdx ) {
+		uint64_t& bitBlock = rBitArray[rIdx/64];
+		const uint64_t bit = static_cast<uint64_t>(1) << ( rIdx%64 );
+		if( bitBlock & bit ) {
+			return( false );
+		}
+		bitBlock |= bit;
+		return( true );
+	};
+
+	struct sThreadScratch {
+		vector<uint64_t>     mVertBitArrayVisited;
+		vector<uint64_t>     mFaceBitArrayVisited;
+		vector<Face*>        mAdjacentFaces;
+		sSphereNeighbourhood mNeighbourhood;
+	};
+	vector<sThreadScratch> threadScratch( getParallelThreadCount() );
+	parallelFor( getVertexNr(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		sThreadScratch& scratch = threadScratch[rThreadIdx];
+		vector<uint64_t>& vertBitArrayVisited = scratch.mVertBitArrayVisited;
+		vector<uint64_t>& faceBitArrayVisited = scratch.mFaceBitArrayVisited;
+		vertBitArrayVisited.resize( vertNrLongs, 0 );
+		faceBitArrayVisited.resize( faceNrLongs, 0 );
+		sSphereNeighbourhood& neighbourhood = scratch.mNeighbourhood;
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			Vertex* seedVertex = getVertexPos( vertIdx );
+			double seedXYZ[3];
+			seedVertex->copyCoordsTo( seedXYZ );
+			neighbourhood.mSeed    = seedVertex;
+			neighbourhood.mSeedIdx = vertIdx;
+			neighbourhood.mVertices.clear();
+			neighbourhood.mFaceIndices.clear();
+			// Marching front of the vertices within the sphere - the front is the tail of mVertices.
+			markVisited( vertBitArrayVisited, seedVertex->getIndex() );
+			neighbourhood.mVertices.push_back( seedVertex );
+			for( size_t frontPos=0; frontPos<neighbourhood.mVertices.size(); frontPos++ ) {
+				scratch.mAdjacentFaces.clear();
+				neighbourhood.mVertices[frontPos]->getFaces( &scratch.mAdjacentFaces );
+				for( Face* adjacentFace : scratch.mAdjacentFaces ) {
+					if( ( adjacentFace == nullptr ) || !markVisited( faceBitArrayVisited, adjacentFace->getIndex() ) ) {
+						continue;
+					}
+					neighbourhood.mFaceIndices.push_back( adjacentFace->getIndex() );
+					for( Vertex* faceVertex : { adjacentFace->getVertA(), adjacentFace->getVertB(), adjacentFace->getVertC() } ) {
+						if( ( faceVertex->distanceToCoord( seedXYZ ) <= rRadius ) &&
+						    markVisited( vertBitArrayVisited, faceVertex->getIndex() ) ) {
+							neighbourhood.mVertices.push_back( faceVertex );
+						}
+					}
+				}
+			}
+			std::sort( neighbourhood.mFaceIndices.begin(), neighbourhood.mFaceIndices.end() );
+			rFunc( neighbourhood, rThreadIdx );
+			// Clear the bits of the visited primitives - other bits are not set.
+			for( Vertex* visitedVertex : neighbourhood.mVertices ) {
+				vertBitArrayVisited[visitedVertex->getIndex()/64] = 0;
+			}
+			for( const uint64_t faceIdx : neighbourhood.mFaceIndices ) {
+				faceBitArrayVisited[faceIdx/64] = 0;
+			}
+		}
+	}, 64 );
+	return( true );
+}
+
+//! Unsigned angle between two vectors given as double[3] - same as angle( const Vector3D&, const Vector3D& ).
+static inline double angleBetween( const double* rVec1, const double* rVec2 ) {
+	const double numerator   = rVec1[0]*rVec2[0] + rVec1[1]*rVec2[1] + rVec1[2]*rVec2[2];
+	const double denominator = sqrt( rVec1[0]*rVec1[0] + rVec1[1]*rVec1[1] + rVec1[2]*rVec1[2] ) *
+	                           sqrt( rVec2[0]*rVec2[0] + rVec2[1]*rVec2[1] + rVec2[2]*rVec2[2] );
+	const double lambda      = acos( numerator / denominator );
+	if( std::isnan( lambda ) ) {
+		return( numerator < 0.0 ? M_PI : 0.0 );
+	}
+	return( lambda );
+}
+
+//! Computes the given statistics of the faces within a sphere around each vertex in a single pass
+//! over the sphere neighbourhoods - see Mesh::mapSphereNeighbourhoods.
+//! The face normals and areas are fetched once instead of once per sphere containing the face.
+//!
+//! The result is a row-major matrix with one row per vertex holding the statistics in the given order.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::estSphereNeighbourhoodStats(
+                double                                   rRadius,  //!< Radius of the spheres.
+                const vector<eSphereNeighbourhoodStat>&  rStats,   //!< Statistics to compute.
+                vector<double>&                          rValues   //!< Output: statistics per vertex.
+) {
+	if( rStats.empty() ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: No statistics given!" << endl;
+		return( false );
+	}
+	const uint64_t faceCount = getFaceNr();
+	vector<double> faceNormals( 3*faceCount );
+	vector<double> faceAreas( faceCount );
+	parallelFor( faceCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* currFace = getFacePos( faceIdx );
+			const Vector3D faceNormal = currFace->getNormal();
+			faceNormals[3*faceIdx]   = faceNormal.getX();
+			faceNormals[3*faceIdx+1] = faceNormal.getY();
+			faceNormals[3*faceIdx+2] = faceNormal.getZ();
+			faceAreas[faceIdx] = currFace->getAreaNormal();
+		}
+	} );
+
+	const uint64_t statCount = rStats.size();
+	rValues.assign( getVertexNr() * statCount, _NOT_A_NUMBER_DBL_ );
+	return mapSphereNeighbourhoods( rRadius, [&]( const sSphereNeighbourhood& rNeighbourhood, unsigned int ) {
+		const vector<uint64_t>& faceIndices = rNeighbourhood.mFaceIndices;
+		double* values = rValues.data() + rNeighbourhood.mSeedIdx * statCount;
+		// Sum of the face normals in order of the face indices - computed on demand.
+		double meanNormal[3];
+		bool   meanNormalSet = false;
+		auto getMeanNormal = [&]() {
+			if( !meanNormalSet ) {
+				meanNormal[0] = meanNormal[1] = meanNormal[2] = 0.0;
+				for( const uint64_t faceIdx : faceIndices ) {
+					meanNormal[0] += faceNormals[3*faceIdx];
+					meanNormal[1] += faceNormals[3*faceIdx+1];
+					meanNormal[2] += faceNormals[3*faceIdx+2];
+				}
+				meanNormalSet = true;
+			}
+			return( meanNormal );
+		};
+		for( uint64_t statIdx=0; statIdx<statCount; statIdx++ ) {
+			double statValue = _NOT_A_NUMBER_DBL_;
+			switch( rStats[statIdx] ) {
+				case SPHERE_STAT_FACE_ANGLE_MAX: {
+					const Vector3D vertNormal = rNeighbourhood.mSeed->getNormal();
+					const double vertNormalXYZ[3] = { vertNormal.getX(), vertNormal.getY(), vertNormal.getZ() };
+					statValue = -DBL_MAX;
+					for( const uint64_t faceIdx : faceIndices ) {
+						statValue = std::max( statValue, angleBetween( &faceNormals[3*faceIdx], vertNormalXYZ ) );
+					}
+					} break;
+				case SPHERE_STAT_FACE_MEAN_ANGLE_MAX: {
+					const double* meanNormalXYZ = getMeanNormal();
+					statValue = -DBL_MAX;
+					for( const uint64_t faceIdx : faceIndices ) {
+						statValue = std::max( statValue, angleBetween( &faceNormals[3*faceIdx], meanNormalXYZ ) );
+					}
+					} break;
+				case SPHERE_STAT_FACE_MEAN_ANGLE_MEAN: {
+					const double* meanNormalXYZ = getMeanNormal();
+					double angleSum = 0.0;
+					for( const uint64_t faceIdx : faceIndices ) {
+						angleSum += angleBetween( &faceNormals[3*faceIdx], meanNormalXYZ );
+					}
+					statValue = angleSum / static_cast<double>( faceIndices.size() );
+					} break;
+				case SPHERE_STAT_FACE_AREA:
+					statValue = 0.0;
+					for( const uint64_t faceIdx : faceIndices ) {
+						statValue += faceAreas[faceIdx];
+					}
+					break;
+				case SPHERE_STAT_FACE_COUNT:
+					statValue = static_cast<double>( faceIndices.size() );
+					break;
+				case SPHERE_STAT_VERTEX_COUNT:
+					statValue = static_cast<double>( rNeighbourhood.mVertices.size() );
+					break;
+			}
+			values[statIdx] = statValue;
+		}
+	} );
+}
+
 // Compute or estimate Multi-Scale Integral Invariants (MSII) --------------------------------------------------------------------------------------------------
 
 double Mesh::fetchSphereCubeVolume25D( Vertex*     seedVertex,            //!< equals sphere center
@@ -13461,7 +14914,7 @@ double Mesh::fetchSphereCubeVolume25D( Vertex*     seedVertex,            //!< e
 	matAllTransformations *= Matrix4D( static_cast<float>(cubeEdgeLengthInVoxels)/2.0, -0.5+static_cast<float>(cubeEdgeLengthInVoxels)/2.0, 0.0 );
 	// 7. Apply the transformatio
 	//cout << "[Mesh::fetchSphereCubeVolume25D] (7) " << endl;
-	matAllTransformations.applyTo( vertexArray, vertexSize );
+	AffineTransform3x4<double>( matAllTransformations ).applyToPoints( vertexArray, vertexSize, 4 );
 //	for( int i=0; i<vertexSize; i++ ) {
 //		cout << "V[" << i << "]: " << vertexArray[i*4] << " " << vertexArray[i*4+1] << " " << vertexArray[i*4+2] << endl;
 //	}
@@ -13599,7 +15052,7 @@ double Mesh::fetchSphereCubeVolume25D( Vertex*        seedVertex,            //!
 //	for( int i=0; i<vertexSize; i++ ) {
 //		cout << vertexArray[i*4+0] << " " << vertexArray[i*4+1] << " " << vertexArray[i*4+2] << " " << vertexArray[i*4+3] << endl;
 //	}
-	matAllTransformations.applyTo( vertexArray, vertexSize );
+	AffineTransform3x4<double>( matAllTransformations ).applyToPoints( vertexArray, vertexSize, 4 );
 	//cout << vertexArray[i*4+0] << " " << vertexArray[i*4+1] << " " << vertexArray[i*4+2] << " " << vertexArray[i*4+3] << endl;
 //	cout << "pts = [ " << endl;
 //	for( int i=0; i<vertexSize; i++ ) {
@@ -13860,14 +15313,8 @@ bool Mesh::applyTransformationToWholeMesh( Matrix4D rTrans, bool rResetNormals,
 		return false;
 	}
 
-	// Apply to ALL vertices:
-	set<Vertex*> allVertices;
-	for( auto const& currVertex: mVertices ) {
-		allVertices.insert( currVertex );
-	}
-
 	//!\todo Apply to all cone paramters, the sphere and the mesh plane.
-    if(applyTransformation(rTrans, &allVertices, rResetNormals, rSaveTransMat))
+    if( applyTransformationToVertices( rTrans, mVertices, true, rResetNormals, rSaveTransMat ) )
 	{
 		//! .) Apply to (cone/cylinder) axis
 		mConeAxisPoints[0] *= rTrans;
@@ -14025,60 +15472,140 @@ bool Mesh::applyTransformationDefaultViewMatrix( Matrix4D* rViewMatrix ) {
 
 //! Apply a given transformation matrix Matrix4D all given Vertices.
 //!
-//! As this function uses the coordinate-vertex-array instead the Vertex
-//! objects, the array has to be set. If not the method can not be executed
-//! and false is returned.
-//!
-//! This method also re-estimates the normals of the faces and the bounding box (for performance reasons).
+//! See Mesh::applyTransformationToVertices
 bool Mesh::applyTransformation( Matrix4D rTrans, set<Vertex*>* rSomeVerts, bool rResetNormals, bool rSaveTransMat ) {
-	//cout << "[Mesh::" << __FUNCTION__ << "] Start" << endl;
-	//rTrans.dumpInfo();
 	// Sanity checks:
 	if( rSomeVerts->size() == 0 ) {
 		cout << "[Mesh::" << __FUNCTION__ << "] No vertices given!" << endl;
 		return true;
 	}
+	const std::vector<Vertex*> someVertices( rSomeVerts->begin(), rSomeVerts->end() );
+	return( applyTransformationToVertices( rTrans, someVertices, ( someVertices.size() == getVertexNr() ), rResetNormals, rSaveTransMat ) );
+}
 
+//! Apply a given (affine) transformation matrix Matrix4D to the given vertices.
+//!
+//! The vertices are transformed in parallel by a 3x4 kernel (see AffineTransform3x4),
+//! while the bounding box is updated incrementally within the same pass:
+//! Transforming all vertices yields the new bounding box directly. For a subset
+//! the box is extended by the transformed vertices, which is exact as long as
+//! none of them was on the previous box - otherwise it is re-estimated.
+//!
+//! The face normals are transformed by the cofactor matrix, when all vertices
+//! are transformed. Otherwise they are recomputed from their vertices.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Mesh::applyTransformationToVertices(
+                const Matrix4D&             rTrans,          //!< Transformation matrix. The last row is expected to be ( 0 0 0 1 ).
+                const std::vector<Vertex*>& rSomeVerts,      //!< Vertices to be transformed.
+                const bool                  rAllVertices,    //!< True, when rSomeVerts are all vertices of the mesh.
+                const bool                  rResetNormals,   //!< Update the face normals.
+                const bool                  rSaveTransMat    //!< Write the matrix to the side-car file.
+) {
+	//cout << "[Mesh::" << __FUNCTION__ << "] Start" << endl;
+	//rTrans.dumpInfo();
 	showProgressStart("Apply Transformation");
 	showProgress(0.0, "Apply Transformation");
 
-	//! .) Apply transformation matrix for each of the given vertices.
-	unsigned int errCtr = 0;
-	double percentDone = 0.0;
-	const unsigned int progressStep = rSomeVerts->size() / 10;
-	unsigned int count = 0;
-	float timeStart = clock();
-	for( auto const& currVertex: (*rSomeVerts) ) {
-		if( !(currVertex->applyTransfrom( &rTrans )) ) {
-			errCtr++;
+	const AffineTransform3x4<double> affineTrans( rTrans );
+	const uint64_t vertexCount = rSomeVerts.size();
+	const double   progressSteps = static_cast<double>( vertexCount + ( rResetNormals ? getFaceNr() : 0 ) );
+	std::atomic<uint64_t> primitivesDone{ 0 };
+
+	//! .) Apply transformation matrix for each of the given vertices including the bounding box.
+	struct sBoundingBox {
+		double mMin[3] = { +DBL_MAX, +DBL_MAX, +DBL_MAX };
+		double mMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+		bool   mTouchedPrevious = false; //!< Subset: a vertex was on the previous bounding box.
+	};
+	const double bbPrevMin[3] = { mMinX, mMinY, mMinZ };
+	const double bbPrevMax[3] = { mMaxX, mMaxY, mMaxZ };
+	std::vector<sBoundingBox> threadBox( getParallelThreadCount() );
+	auto timeStart = std::chrono::steady_clock::now();
+	parallelFor( vertexCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		sBoundingBox& box = threadBox[rThreadIdx];
+		double vertXYZ[3];
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			Vertex* currVertex = rSomeVerts[i];
+			if( !rAllVertices && !box.mTouchedPrevious ) {
+				currVertex->copyXYZTo( vertXYZ );
+				for( unsigned int k=0; k<3; k++ ) {
+					box.mTouchedPrevious |= ( vertXYZ[k] <= bbPrevMin[k] ) || ( vertXYZ[k] >= bbPrevMax[k] );
+				}
+			}
+			currVertex->applyAffineTransform( affineTrans );
+			currVertex->copyXYZTo( vertXYZ );
+			for( unsigned int k=0; k<3; k++ ) {
+				if( box.mMin[k] > vertXYZ[k] ) {
+					box.mMin[k] = vertXYZ[k];
+				}
+				if( box.mMax[k] < vertXYZ[k] ) {
+					box.mMax[k] = vertXYZ[k];
+				}
+			}
+		}
+		const uint64_t done = primitivesDone.fetch_add( rEnd - rBegin ) + ( rEnd - rBegin );
+		if( rThreadIdx == 0 ) {
+			showProgress( static_cast<double>( done )/progressSteps, "Apply Transformation" );
 		}
+	} );
+	cout << "[Mesh::" << __FUNCTION__ << "] time: " << std::chrono::duration<double>( std::chrono::steady_clock::now() - timeStart ).count() << " seconds."  << endl;
 
-		++count;
-		if(count >= progressStep)
-		{
-			count = 0;
-			percentDone += 0.1;
-			showProgress(percentDone, "Apply Transformation");
+	//! .) Update the bounding box
+	sBoundingBox boxNew;
+	if( !rAllVertices ) {
+		// Extend the previous box.
+		for( unsigned int k=0; k<3; k++ ) {
+			boxNew.mMin[k] = bbPrevMin[k];
+			boxNew.mMax[k] = bbPrevMax[k];
 		}
 	}
-
-	showProgress(1.0, "Apply Transformation");
-
-	cout << "[Mesh::" << __FUNCTION__ << "] time: " << ( clock() - timeStart ) / CLOCKS_PER_SEC << " seconds."  << endl;
-	if( errCtr > 0 ) {
-		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: applyTransfrom failed " << errCtr << " times!" << endl;
+	for( auto const& box : threadBox ) {
+		for( unsigned int k=0; k<3; k++ ) {
+			boxNew.mMin[k] = std::min( boxNew.mMin[k], box.mMin[k] );
+			boxNew.mMax[k] = std::max( boxNew.mMax[k], box.mMax[k] );
+		}
+		boxNew.mTouchedPrevious |= box.mTouchedPrevious;
+	}
+	if( boxNew.mTouchedPrevious ) {
+		// The box might shrink.
+		estBoundingBox();
+	} else {
+		mMinX = boxNew.mMin[0];
+		mMinY = boxNew.mMin[1];
+		mMinZ = boxNew.mMin[2];
+		mMaxX = boxNew.mMax[0];
+		mMaxY = boxNew.mMax[1];
+		mMaxZ = boxNew.mMax[2];
+		changedBoundingBox();
 	}
-
-	//! .) Recompute the bounding box
-	estBoundingBox();
 	cout << "[Mesh::" << __FUNCTION__ << "] Bounding box is now: " << mMaxX-mMinX << " x "  << mMaxY-mMinY << " x "  << mMaxZ-mMinZ << " mm (unit assumed)." << endl;
 
-	//! .) Reset face normals
+	//! .) Update face normals
 	if( rResetNormals ) {
-		double meshArea;
-		resetFaceNormals( &meshArea );
+		const AffineTransform3x4<double> affineCofactor = affineTrans.getCofactor();
+		std::vector<double> threadArea( getParallelThreadCount(), 0.0 );
+		parallelFor( getFaceNr(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+			double areaSum = 0.0;
+			for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+				Face* currFace = getFacePos( faceIdx );
+				if( rAllVertices ) {
+					areaSum += currFace->applyAffineTransformToNormal( affineCofactor );
+				} else {
+					currFace->clearFlag( FLAG_NORMAL_SET );
+					areaSum += currFace->getAreaNormal();
+				}
+			}
+			threadArea[rThreadIdx] += areaSum;
+			const uint64_t done = primitivesDone.fetch_add( rEnd - rBegin ) + ( rEnd - rBegin );
+			if( rThreadIdx == 0 ) {
+				showProgress( static_cast<double>( done )/progressSteps, "Apply Transformation" );
+			}
+		} );
+		double meshArea = std::accumulate( threadArea.begin(), threadArea.end(), 0.0 );
 		cout << "[Mesh::" << __FUNCTION__ << "] Area of the mesh is now: " << meshArea << " mm² (unit assumed)." << endl;
 	}
+	showProgress(1.0, "Apply Transformation");
 
 	//! .) Can also affect the polylines - reset them too:
 	polyLinesChanged();
@@ -14095,7 +15622,7 @@ bool Mesh::applyTransformation( Matrix4D rTrans, set<Vertex*>* rSomeVerts, bool
             std::strftime( mbstr, sizeof( mbstr ), "%A %c", std::localtime( &t ) );
             // Fetch matrix as text
             string matStr;
-            rTrans.getTextMatrix( &matStr );
+            Matrix4D( rTrans ).getTextMatrix( &matStr );
             // Write matrix
             transMatFile << "#------------------------------------------------------" << endl;
             transMatFile << "# Transformation applied to " << getBaseName() << endl;
@@ -14112,7 +15639,7 @@ bool Mesh::applyTransformation( Matrix4D rTrans, set<Vertex*>* rSomeVerts, bool
         }
     }
 	showProgressStop("Apply Transformation");
-	return ( errCtr == 0 );
+	return( true );
 }
 
 //! Apply melting with sqrt(r^2-x^2-y^2) -- see also Vertex::applyMeltingSphere
@@ -14192,20 +15719,28 @@ bool Mesh::normalsVerticesChanged() {
 }
 
 //! Resets all face normals and calculates them based on the current positions
-//! of the face vertices.
+//! of the face vertices. The faces are processed in parallel.
 //!
 //! @returns false in case of an error. True otherwise.
 bool Mesh::resetFaceNormals(
     double* rAreaTotal   //!< Optional pointer to double to retrieve the total area of the mesh.
 ) {
-	bool retVal = true;
-	double meshArea = 0.0;
-	Face* currFace;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		currFace = getFacePos( faceIdx );
-		retVal &= currFace->clearFlag( FLAG_NORMAL_SET );
-		meshArea += currFace->getAreaNormal();
-	}
+	std::vector<double> threadArea( getParallelThreadCount(), 0.0 );
+	std::atomic<bool>   retVal{ true };
+	parallelFor( getFaceNr(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		double areaSum = 0.0;
+		bool   flagsCleared = true;
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* currFace = getFacePos( faceIdx );
+			flagsCleared &= currFace->clearFlag( FLAG_NORMAL_SET );
+			areaSum += currFace->getAreaNormal();
+		}
+		threadArea[rThreadIdx] += areaSum;
+		if( !flagsCleared ) {
+			retVal = false;
+		}
+	} );
+	const double meshArea = std::accumulate( threadArea.begin(), threadArea.end(), 0.0 );
 	if( rAreaTotal != nullptr ) {
 		(*rAreaTotal) = meshArea;
 	}
@@ -14216,21 +15751,59 @@ bool Mesh::resetFaceNormals(
 //! Resets vertex normals using the faces of the 1-ring.
 //! See VertexOfFace::estNormalAvgAdjacentFaces
 //!
+//! The face normals have to be up-to-date e.g. by resetFaceNormals. Each
+//! vertex gathers the normals of its adjacent faces and writes only its own
+//! normal, so the vertices are processed in parallel without locks.
+//!
+//! Optionally the normals are written as float into rNormalsXYZ, which has to
+//! provide 3*getVertexNr() elements e.g. a vertex buffer for rendering.
+//! Vertices without valid normal get ( 0, 0, 0 ).
+//!
 //! @returns true, when all normals were (re)set. False otherwise.
-bool Mesh::resetVertexNormals() {
+bool Mesh::resetVertexNormals(
+                Vertex::eNormalWeighting rWeighting,    //!< Weights of the adjacent face normals.
+                float*                   rNormalsXYZ    //!< Optional array for the normals as float.
+) {
 	bool retVal(true);
 	showProgressStart( __FUNCTION__ );
-	uint64_t errorCtr = 0;
-	uint64_t nrOfVertices = getVertexNr();
-	for( uint64_t vertexIdx = 0; vertexIdx < nrOfVertices; vertexIdx++ ) {
-		Vertex* currVertex = getVertexPos( vertexIdx );
-		if( !currVertex->estNormalAvgAdjacentFaces() ) {
-			errorCtr++;
+	const uint64_t nrOfVertices = getVertexNr();
+	const unsigned int threadCount = getParallelThreadCount();
+	std::vector<uint64_t> threadErrors( threadCount, 0 );
+	std::vector<uint64_t> threadFacesInvalid( threadCount, 0 );
+	std::atomic<uint64_t> verticesDone{ 0 };
+	parallelFor( nrOfVertices, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		uint64_t errorCtr = 0;
+		uint64_t facesInvalid = 0;
+		for( uint64_t vertexIdx=rBegin; vertexIdx<rEnd; vertexIdx++ ) {
+			Vertex* currVertex = getVertexPos( vertexIdx );
+			const bool normalSet = currVertex->estNormalAvgAdjacentFaces( rWeighting, facesInvalid );
+			if( !normalSet ) {
+				errorCtr++;
+			}
+			if( rNormalsXYZ == nullptr ) {
+				continue;
+			}
+			float* normalXYZ = rNormalsXYZ + 3*vertexIdx;
+			if( normalSet ) {
+				currVertex->copyNormalXYZTo( normalXYZ, false );
+			} else {
+				normalXYZ[0] = normalXYZ[1] = normalXYZ[2] = 0.0f;
+			}
 		}
-		showProgress( static_cast<double>(vertexIdx+1)/static_cast<double>(nrOfVertices), __FUNCTION__ );
-	}
+		threadErrors[rThreadIdx] += errorCtr;
+		threadFacesInvalid[rThreadIdx] += facesInvalid;
+		const uint64_t done = verticesDone.fetch_add( rEnd - rBegin ) + ( rEnd - rBegin );
+		if( rThreadIdx == 0 ) {
+			showProgress( static_cast<double>(done)/static_cast<double>(nrOfVertices), __FUNCTION__ );
+		}
+	} );
 	showProgressStop( __FUNCTION__ );
 
+	const uint64_t facesInvalid = std::accumulate( threadFacesInvalid.begin(), threadFacesInvalid.end(), static_cast<uint64_t>(0) );
+	if( facesInvalid > 0 ) {
+		LOG::warn() << "[Mesh::" << __FUNCTION__ << "] " << facesInvalid << " adjacent faces without valid normal were neglected!\n";
+	}
+	const uint64_t errorCtr = std::accumulate( threadErrors.begin(), threadErrors.end(), static_cast<uint64_t>(0) );
 	if( errorCtr > 0 ) {
 		std::cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: estNormalAvgAdjacentFaces failed " << errorCtr << " times!" << std::endl;
 		std::cerr << "[Mesh::" << __FUNCTION__ << "]        Faces having a zero area are a possible reason!" << std::endl;
@@ -16124,12 +17697,6 @@ bool Mesh::getMeshInfoData(
 	rMeshInfos.mCountULong[MeshInfoData::VERTICES_TOTAL] = this->getVertexNr();
 	rMeshInfos.mCountULong[MeshInfoData::FACES_TOTAL]    = this->getFaceNr();
 
-	// Area and average resolution
-	double areaAcq = 0.0;
-	this->getFaceSurfSum( &areaAcq );
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] = std::round( areaAcq );
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] /= 100.0; // cm^2
-	
 	// Fetch Bounding Box
 	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_X]  = static_cast<double>( std::round( mMinX*10000.0 ) )/10000.0;
 	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_MIN_Y]  = static_cast<double>( std::round( mMinY*10000.0 ) )/10000.0;
@@ -16143,138 +17710,229 @@ bool Mesh::getMeshInfoData(
 	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_HEIGHT] = static_cast<double>( std::round( bbDim.getY()*1.0 ) )/10.0; // cm
 	rMeshInfos.mCountDouble[MeshInfoData::BOUNDINGBOX_THICK]  = static_cast<double>( std::round( bbDim.getZ()*1.0 ) )/10.0; // cm
 
-	// Volume
-	double volDXYZ[3];
-	this->getMeshVolumeDivergence( volDXYZ[0], volDXYZ[1], volDXYZ[2] );
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DX] = volDXYZ[0];
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DY] = volDXYZ[1];
-	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DZ] = volDXYZ[2];
-
-	double progressSteps = static_cast<double>( getVertexNr() + getFaceNr() );
+	const uint64_t vertexCount = getVertexNr();
+	const uint64_t faceCount   = getFaceNr();
+	const double progressSteps = static_cast<double>( vertexCount + 2*faceCount );
 	showProgressStart( "Mesh information" );
 
-	Vertex* currVertex;
-	for( uint64_t vertIdx=0; vertIdx<getVertexNr(); vertIdx++ ) {
-		currVertex = getVertexPos( vertIdx );
-		if( currVertex->isNotANumber() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_NAN]++;
-		}
-		double vertexNormalLen = currVertex->getNormalLen();
-		if( !isnormal( vertexNormalLen ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_NORMAL_LEN_NORMAL]++;
-		}
-		// Mesh structure:
-		if( currVertex->isSolo() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SOLO]++;
-		}
-		if( currVertex->isBorder() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_BORDER]++;
-		}
-		if( currVertex->isNonManifold() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_NONMANIFOLD]++;
-		}
-		if( currVertex->isDoubleCone() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SINGULAR]++;
-		}
-		if( currVertex->isPartOfZeroFace() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_PART_OF_ZERO_FACE]++;
-		}
-		if( currVertex->isInverse() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_ON_INVERTED_EDGE]++;
-		}
-		// Special flags and conditions:
-		if( currVertex->getFlag( FLAG_BELONGS_TO_POLYLINE ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_POLYLINE]++;
-		}
-		if( currVertex->getFlag( FLAG_SYNTHETIC ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SYNTHETIC]++;
+	// All predicates are evaluated in fused parallel sweeps. Each thread counts
+	// into its own set of counters, which are summed up afterwards.
+	// The sweeps are ordered by their dependencies:
+	//   1. Faces: area, volume and flags of the face itself - sets FLAG_FACE_ZERO_AREA used by the vertices.
+	//   2. Vertices: all properties - stores the expensive border test for the next sweep.
+	//   3. Faces: configurations depending on border vertices.
+	// Only the calling thread i.e. thread zero reports progress.
+	struct sInfoAccumulator {
+		uint64_t mCount[MeshInfoData::ULONG_COUNT] = { 0 };
+		double   mArea          = 0.0;
+		double   mAreaSmallest  = std::numeric_limits<double>::infinity();
+		double   mAreaLargest   = 0.0;
+		double   mVolumeDXYZ[3] = { 0.0, 0.0, 0.0 };
+		uint64_t mVolumeFail    = 0;
+	};
+	std::vector<sInfoAccumulator> threadAcc( getParallelThreadCount() );
+	std::atomic<uint64_t> primitivesDone{ 0 };
+	auto reportProgress = [&]( const uint64_t rDone, const unsigned int rThreadIdx ) {
+		const uint64_t done = primitivesDone.fetch_add( rDone ) + rDone;
+		if( rThreadIdx == 0 ) {
+			showProgress( static_cast<double>( done )/progressSteps, "Mesh information" );
 		}
-		if( currVertex->getFlag( FLAG_MANUAL ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_MANUAL]++;
+	};
+
+	// 1. Faces
+	parallelFor( faceCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		sInfoAccumulator acc;
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* currFace = getFacePos( faceIdx );
+			// floating point properties - also sets FLAG_FACE_ZERO_AREA
+			double faceArea = currFace->getAreaNormal();
+			acc.mArea += faceArea;
+			acc.mAreaSmallest = std::min( acc.mAreaSmallest, faceArea );
+			acc.mAreaLargest  = std::max( acc.mAreaLargest,  faceArea );
+			if( !currFace->getVolumeDivergence( acc.mVolumeDXYZ[0], acc.mVolumeDXYZ[1], acc.mVolumeDXYZ[2] ) ) {
+				acc.mVolumeFail++;
+			}
+			if( currFace->isBorder() ) {
+				acc.mCount[MeshInfoData::FACES_BORDER]++;
+			}
+			unsigned int nrEdgesBorder = 0;
+			currFace->hasBorderEdges( nrEdgesBorder );
+			if( nrEdgesBorder == 3 ) { // Same as: if( currFace->isSolo() ) {
+				acc.mCount[MeshInfoData::FACES_SOLO]++;
+			}
+			if( currFace->isManifold() ) {
+				acc.mCount[MeshInfoData::FACES_MANIFOLD]++;
+			} else {
+				acc.mCount[MeshInfoData::FACES_NONMANIFOLD]++;
+			}
+			if( currFace->getFlag( FLAG_FACE_STICKY ) ) {
+				acc.mCount[MeshInfoData::FACES_STICKY]++;
+			}
+			if( currFace->getFlag( FLAG_FACE_ZERO_AREA ) ) {
+				acc.mCount[MeshInfoData::FACES_ZEROAREA]++;
+			}
+			if( currFace->isInverse() ) {
+				acc.mCount[MeshInfoData::FACES_INVERTED]++;
+			}
+			unsigned int synthVerticesNr = _NOT_A_NUMBER_UINT_;
+			currFace->hasSyntheticVertex( synthVerticesNr );
+			if( synthVerticesNr >= 3 ) {
+				acc.mCount[MeshInfoData::FACES_WITH_SYNTH_VERTICES]++;
+			}
+			if( currFace->getFlag( FLAG_SELECTED ) ) {
+				acc.mCount[MeshInfoData::FACES_SELECTED]++;
+			}
 		}
-		if( currVertex->getFlag( FLAG_CIRCLE_CENTER ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_CIRCLE_CENTER]++;
+		sInfoAccumulator& threadSum = threadAcc[rThreadIdx];
+		for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+			threadSum.mCount[i] += acc.mCount[i];
+		}
+		threadSum.mArea += acc.mArea;
+		threadSum.mAreaSmallest = std::min( threadSum.mAreaSmallest, acc.mAreaSmallest );
+		threadSum.mAreaLargest  = std::max( threadSum.mAreaLargest,  acc.mAreaLargest );
+		for( unsigned int i=0; i<3; i++ ) {
+			threadSum.mVolumeDXYZ[i] += acc.mVolumeDXYZ[i];
+		}
+		threadSum.mVolumeFail += acc.mVolumeFail;
+		reportProgress( rEnd - rBegin, rThreadIdx );
+	} );
+
+	// 2. Vertices
+	// The index is set to the position within the vector to address the stored border test.
+	std::vector<unsigned char> vertexIsBorder( vertexCount, false );
+	parallelFor( vertexCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		uint64_t count[MeshInfoData::ULONG_COUNT] = { 0 };
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			Vertex* currVertex = getVertexPos( vertIdx );
+			currVertex->setIndex( vertIdx );
+			if( currVertex->isNotANumber() ) {
+				count[MeshInfoData::VERTICES_NAN]++;
+			}
+			double vertexNormalLen = currVertex->getNormalLen();
+			if( !isnormal( vertexNormalLen ) ) {
+				count[MeshInfoData::VERTICES_NORMAL_LEN_NORMAL]++;
+			}
+			// Mesh structure:
+			if( currVertex->isSolo() ) {
+				count[MeshInfoData::VERTICES_SOLO]++;
+			}
+			if( currVertex->isBorder() ) {
+				count[MeshInfoData::VERTICES_BORDER]++;
+				vertexIsBorder[vertIdx] = true;
+			}
+			if( currVertex->isNonManifold() ) {
+				count[MeshInfoData::VERTICES_NONMANIFOLD]++;
+			}
+			if( currVertex->isDoubleCone() ) {
+				count[MeshInfoData::VERTICES_SINGULAR]++;
+			}
+			if( currVertex->isPartOfZeroFace() ) {
+				count[MeshInfoData::VERTICES_PART_OF_ZERO_FACE]++;
+			}
+			if( currVertex->isInverse() ) {
+				count[MeshInfoData::VERTICES_ON_INVERTED_EDGE]++;
+			}
+			// Special flags and conditions:
+			if( currVertex->getFlag( FLAG_BELONGS_TO_POLYLINE ) ) {
+				count[MeshInfoData::VERTICES_POLYLINE]++;
+			}
+			if( currVertex->getFlag( FLAG_SYNTHETIC ) ) {
+				count[MeshInfoData::VERTICES_SYNTHETIC]++;
+			}
+			if( currVertex->getFlag( FLAG_MANUAL ) ) {
+				count[MeshInfoData::VERTICES_MANUAL]++;
+			}
+			if( currVertex->getFlag( FLAG_CIRCLE_CENTER ) ) {
+				count[MeshInfoData::VERTICES_CIRCLE_CENTER]++;
+			}
+			if( currVertex->getFlag( FLAG_SELECTED ) ) {
+				count[MeshInfoData::VERTICES_SELECTED]++;
+			}
+			// Function value related - the local extrema set/clear flags of the vertex itself only:
+			if( currVertex->isFuncValFinite() ) {
+				count[MeshInfoData::VERTICES_FUNCVAL_FINITE]++;
+			}
+			if( currVertex->isFuncValLocalMinimum() ) {
+				count[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MIN]++;
+			}
+			if( currVertex->isFuncValLocalMaximum() ) {
+				count[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MAX]++;
+			}
 		}
-		if( currVertex->getFlag( FLAG_SELECTED ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_SELECTED]++;
+		sInfoAccumulator& threadSum = threadAcc[rThreadIdx];
+		for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+			threadSum.mCount[i] += count[i];
+		}
+		reportProgress( rEnd - rBegin, rThreadIdx );
+	} );
+
+	// 3. Faces - special border configurations using the stored border test of the vertices.
+	parallelFor( faceCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		uint64_t count[MeshInfoData::ULONG_COUNT] = { 0 };
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* currFace = getFacePos( faceIdx );
+			unsigned int nrVerticesBorder = vertexIsBorder[currFace->getVertA()->getIndex()] +
+			                                vertexIsBorder[currFace->getVertB()->getIndex()] +
+			                                vertexIsBorder[currFace->getVertC()->getIndex()];
+			if( nrVerticesBorder != 3 ) {
+				continue;
+			}
+			count[MeshInfoData::FACES_BORDER_THREE_VERTICES]++;
+			unsigned int nrEdgesBorder = 0;
+			currFace->hasBorderEdges( nrEdgesBorder );
+			if( nrEdgesBorder == 0 ) {
+				count[MeshInfoData::FACES_BORDER_BRDIGE_TRICONN]++;
+			}
+			if( nrEdgesBorder == 1 ) {
+				count[MeshInfoData::FACES_BORDER_BRDIGE]++;
+			}
+			if( nrEdgesBorder == 2 ) {
+				count[MeshInfoData::FACES_BORDER_DANGLING]++;
+			}
 		}
-		// Function value related:
-		if( currVertex->isFuncValFinite() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_FUNCVAL_FINITE]++;
+		sInfoAccumulator& threadSum = threadAcc[rThreadIdx];
+		for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+			threadSum.mCount[i] += count[i];
 		}
-		if( currVertex->isFuncValLocalMinimum() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MIN]++;
+		reportProgress( rEnd - rBegin, rThreadIdx );
+	} );
+
+	// Merge the per-thread results.
+	const uint64_t verticesTotal = rMeshInfos.mCountULong[MeshInfoData::VERTICES_TOTAL];
+	const uint64_t facesTotal    = rMeshInfos.mCountULong[MeshInfoData::FACES_TOTAL];
+	sInfoAccumulator totals;
+	for( const sInfoAccumulator& acc : threadAcc ) {
+		for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+			totals.mCount[i] += acc.mCount[i];
 		}
-		if( currVertex->isFuncValLocalMaximum() ) {
-			rMeshInfos.mCountULong[MeshInfoData::VERTICES_FUNCVAL_LOCAL_MAX]++;
+		totals.mArea += acc.mArea;
+		totals.mAreaSmallest = std::min( totals.mAreaSmallest, acc.mAreaSmallest );
+		totals.mAreaLargest  = std::max( totals.mAreaLargest,  acc.mAreaLargest );
+		for( unsigned int i=0; i<3; i++ ) {
+			totals.mVolumeDXYZ[i] += acc.mVolumeDXYZ[i];
 		}
-		showProgress( static_cast<double>(vertIdx)/progressSteps, "Mesh information" );
+		totals.mVolumeFail += acc.mVolumeFail;
+	}
+	for( unsigned int i=0; i<MeshInfoData::ULONG_COUNT; i++ ) {
+		rMeshInfos.mCountULong[i] = totals.mCount[i];
 	}
+	rMeshInfos.mCountULong[MeshInfoData::VERTICES_TOTAL] = verticesTotal;
+	rMeshInfos.mCountULong[MeshInfoData::FACES_TOTAL]    = facesTotal;
 
-	// Set initial values
-	rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] = std::numeric_limits<double>::infinity();
-	rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST]  = 0.0;
+	// Area and average resolution
+	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] = std::round( totals.mArea );
+	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_AREA] /= 100.0; // cm^2
+	rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] = totals.mAreaSmallest;
+	rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST]  = totals.mAreaLargest;
 
-	Face* currFace;
-	for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-		currFace = getFacePos( faceIdx );
-		if( currFace->isBorder() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER]++;
-		}
-		// Special border configurations
-		unsigned int nrEdgesBorder = 0;
-		currFace->hasBorderEdges( nrEdgesBorder );
-		if( nrEdgesBorder == 3 ) { // Same as: if( currFace->isSolo() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_SOLO]++;
-		}
-		unsigned int nrVerticesBorder = 0;
-		currFace->hasBorderVertex( nrVerticesBorder );
-		if( ( nrVerticesBorder == 3 ) && ( nrEdgesBorder == 0 ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_BRDIGE_TRICONN]++;
-		}
-		if( ( nrVerticesBorder == 3 ) && ( nrEdgesBorder == 1 ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_BRDIGE]++;
-		}
-		if( ( nrVerticesBorder == 3 ) && ( nrEdgesBorder == 2 ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_DANGLING]++;
-		}
-		if( nrVerticesBorder == 3 ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_BORDER_THREE_VERTICES]++;
-		}
-		// ...
-		if( currFace->isManifold() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_MANIFOLD]++;
-		}
-		if( currFace->isNonManifold() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_NONMANIFOLD]++;
-		}
-		if( currFace->getFlag( FLAG_FACE_STICKY ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_STICKY]++;
-		}
-		if( currFace->getFlag( FLAG_FACE_ZERO_AREA ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_ZEROAREA]++;
-		}
-		if( currFace->isInverse() ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_INVERTED]++;
-		}
-		unsigned int synthVerticesNr = _NOT_A_NUMBER_UINT_;
-		currFace->hasSyntheticVertex( synthVerticesNr );
-		if( synthVerticesNr >= 3 ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_WITH_SYNTH_VERTICES]++;
-		}
-		if( currFace->getFlag( FLAG_SELECTED ) ) {
-			rMeshInfos.mCountULong[MeshInfoData::FACES_SELECTED]++;
-		}
-		// floating point properties
-		double faceArea = currFace->getAreaNormal();
-		if( faceArea < rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] ) {
-			rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_SMALLEST] = faceArea;
-		}
-		if( faceArea > rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST] ) {
-			rMeshInfos.mCountDouble[MeshInfoData::FACES_AREA_LARGEST] = faceArea;
-		}
-		showProgress( static_cast<double>( faceIdx+getVertexNr() )/progressSteps, "Mesh information" );
+	// Volume
+	if( totals.mVolumeFail > 0 ) {
+		cerr << "[Mesh::" << __FUNCTION__ << "] ERROR: getVolumeDivergence did not return a result for " << totals.mVolumeFail << " faces. Probably zero area faces were encountered!" << endl;
 	}
+	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DX] = totals.mVolumeDXYZ[0];
+	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DY] = totals.mVolumeDXYZ[1];
+	rMeshInfos.mCountDouble[MeshInfoData::TOTAL_VOLUME_DZ] = totals.mVolumeDXYZ[2];
+
     //detect self itersection
     if(rWithSelfIntersectedFaces){
         // Octree required - time consuming
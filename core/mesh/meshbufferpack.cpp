@@ -0,0 +1,383 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/meshbufferpack.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <GigaMesh/mesh/face.h>
+#include <GigaMesh/mesh/parallelfor.h>
+#include <GigaMesh/mesh/vertex.h>
+
+//! Writes rIndicesPer indices for each element i within [0,rCount) fulfilling rSelect( i ) into rIndices
+//! using rWrite( i, target ). The order of the elements is kept. The elements are selected in parallel by
+//! parallelSelectBlocks, which provides the target position of each block, so that the indices are
+//! written in parallel too.
+template<typename tSelect, typename tWrite>
+static void compactIndices(
+                const uint64_t         rCount,
+                const unsigned int     rIndicesPer,
+                tSelect&&              rSelect,
+                tWrite&&               rWrite,
+                std::vector<uint32_t>& rIndices
+) {
+	rIndices.clear();
+	if( rCount == 0 ) {
+		return;
+	}
+	const uint64_t blockSize = getParallelBlockSize( rCount );
+	std::vector<uint8_t> selected;
+	const std::vector<uint64_t> blockOffset = parallelSelectBlocks( rCount, blockSize, rSelect, selected );
+	rIndices.resize( blockOffset.back() * rIndicesPer );
+	parallelFor( rCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		uint32_t* target = rIndices.data() + blockOffset[rBegin/blockSize] * rIndicesPer;
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			if( selected[i] != 0 ) {
+				rWrite( i, target );
+				target += rIndicesPer;
+			}
+		}
+	}, blockSize );
+}
+
+//! Removes the packed vertices.
+void MeshBufferPack::clear() {
+	mVertexStripes.clear();
+	mVertexStripes.shrink_to_fit();
+	mChangedBegin = 0;
+	mChangedEnd   = 0;
+	mMarkedBegin  = 0;
+	mMarkedEnd    = 0;
+	mMarkedIndices.clear();
+}
+
+//! Packs all vertices into the interleaved buffer in parallel. As the whole buffer has to be
+//! uploaded anyway, the range of changed elements and the marked vertices are cleared.
+//!
+//! @returns false in case of an error of at least one vertex. True otherwise.
+bool MeshBufferPack::packVertices(
+                const std::vector<Vertex*>& rVertices,  //!< All vertices of the mesh.
+                const std::vector<Face*>&   rFaces      //!< All faces of the mesh - required for missing vertex normals.
+) {
+	mVertexStripes.resize( rVertices.size() );
+	mChangedBegin = 0;
+	mChangedEnd   = 0;
+	mMarkedBegin  = 0;
+	mMarkedEnd    = 0;
+	mMarkedIndices.clear();
+	return( fetchVertices( rVertices, rFaces, 0, rVertices.size(), nullptr, true ) );
+}
+
+//! Packs the vertices within [rBegin,rEnd) again e.g. after their color was changed.
+//! The range of changed elements is extended accordingly. The flags regarding the
+//! topology are kept - see fetchVertex.
+//!
+//! @returns false, when the vertices were not packed before, the number of vertices changed or
+//!          in case of an error of a vertex. True otherwise.
+bool MeshBufferPack::updateVertices(
+                const std::vector<Vertex*>& rVertices,  //!< All vertices of the mesh.
+                const std::vector<Face*>&   rFaces,     //!< All faces of the mesh - required for missing vertex normals.
+                uint64_t                    rBegin,     //!< Index of the first vertex to pack.
+                uint64_t                    rEnd        //!< Index behind the last vertex to pack.
+) {
+	if( ( mVertexStripes.empty() ) || ( rVertices.size() != mVertexStripes.size() ) ) {
+		return( false );
+	}
+	rEnd = std::min( rEnd, static_cast<uint64_t>( rVertices.size() ) );
+	if( rBegin >= rEnd ) {
+		return( true );
+	}
+	if( mChangedBegin == mChangedEnd ) {
+		mChangedBegin = rBegin;
+		mChangedEnd   = rEnd;
+	} else {
+		mChangedBegin = std::min( mChangedBegin, rBegin );
+		mChangedEnd   = std::max( mChangedEnd, rEnd );
+	}
+	return( fetchVertices( rVertices, rFaces, rBegin, rEnd - rBegin, nullptr, false ) );
+}
+
+//! Packs the given vertices again e.g. after the color of the selected vertices was changed.
+//! The range of changed elements is extended to enclose all given vertices. The flags
+//! regarding the topology are kept - see fetchVertex.
+//!
+//! @returns false, when the vertices were not packed before, the number of vertices changed or
+//!          in case of an invalid index or an error of a vertex. True otherwise.
+bool MeshBufferPack::updateVertices(
+                const std::vector<Vertex*>&  rVertices,       //!< All vertices of the mesh.
+                const std::vector<Face*>&    rFaces,          //!< All faces of the mesh - required for missing vertex normals.
+                const std::vector<uint64_t>& rVertexIndices   //!< Indices of the vertices to pack in arbitrary order.
+) {
+	if( ( mVertexStripes.empty() ) || ( rVertices.size() != mVertexStripes.size() ) ) {
+		return( false );
+	}
+	if( rVertexIndices.empty() ) {
+		return( true );
+	}
+	const auto minMax = std::minmax_element( rVertexIndices.begin(), rVertexIndices.end() );
+	if( (*minMax.second) >= rVertices.size() ) {
+		return( false );
+	}
+	if( mChangedBegin == mChangedEnd ) {
+		mChangedBegin = (*minMax.first);
+		mChangedEnd   = (*minMax.second) + 1;
+	} else {
+		mChangedBegin = std::min( mChangedBegin, (*minMax.first) );
+		mChangedEnd   = std::max( mChangedEnd, (*minMax.second) + 1 );
+	}
+	return( fetchVertices( rVertices, rFaces, 0, rVertexIndices.size(), rVertexIndices.data(), false ) );
+}
+
+//! Marks the vertices within [rBegin,rEnd) as changed without packing them.
+//! See updateMarkedVertices.
+void MeshBufferPack::markVerticesChanged(
+                uint64_t rBegin,  //!< Index of the first changed vertex.
+                uint64_t rEnd     //!< Index behind the last changed vertex.
+) {
+	if( rBegin >= rEnd ) {
+		return;
+	}
+	if( mMarkedBegin == mMarkedEnd ) {
+		mMarkedBegin = rBegin;
+		mMarkedEnd   = rEnd;
+	} else {
+		mMarkedBegin = std::min( mMarkedBegin, rBegin );
+		mMarkedEnd   = std::max( mMarkedEnd, rEnd );
+	}
+}
+
+//! Marks the given vertices as changed without packing them.
+//! See updateMarkedVertices.
+void MeshBufferPack::markVerticesChanged(
+                const std::vector<uint64_t>& rVertexIndices   //!< Indices of the changed vertices in arbitrary order.
+) {
+	mMarkedIndices.insert( mMarkedIndices.end(), rVertexIndices.begin(), rVertexIndices.end() );
+}
+
+//! Packs the vertices marked by markVerticesChanged since the last call. Each vertex is packed
+//! once, even when it was marked several times. The range of changed elements is extended
+//! as by updateVertices.
+//!
+//! @returns false, when the vertices were not packed before, the number of vertices changed or
+//!          in case of an invalid index or an error of a vertex. True otherwise.
+bool MeshBufferPack::updateMarkedVertices(
+                const std::vector<Vertex*>& rVertices,  //!< All vertices of the mesh.
+                const std::vector<Face*>&   rFaces      //!< All faces of the mesh - required for missing vertex normals.
+) {
+	const uint64_t markedBegin = mMarkedBegin;
+	const uint64_t markedEnd   = mMarkedEnd;
+	std::vector<uint64_t> markedIndices;
+	markedIndices.swap( mMarkedIndices );
+	mMarkedBegin = 0;
+	mMarkedEnd   = 0;
+	if( ( markedBegin == markedEnd ) && ( markedIndices.empty() ) ) {
+		return( true );
+	}
+	// Vertices within the marked range are packed anyway:
+	markedIndices.erase( std::remove_if( markedIndices.begin(), markedIndices.end(),
+	                                     [markedBegin, markedEnd]( uint64_t rIdx ) {
+		                                     return( ( rIdx >= markedBegin ) && ( rIdx < markedEnd ) );
+	                                     } ), markedIndices.end() );
+	std::sort( markedIndices.begin(), markedIndices.end() );
+	markedIndices.erase( std::unique( markedIndices.begin(), markedIndices.end() ), markedIndices.end() );
+	if( !updateVertices( rVertices, rFaces, markedBegin, markedEnd ) ) {
+		return( false );
+	}
+	return( updateVertices( rVertices, rFaces, markedIndices ) );
+}
+
+//! @returns the interleaved vertex data - one element per vertex.
+const std::vector<MeshBufferPack::sVertexStripe>& MeshBufferPack::getVertexStripes() const {
+	return( mVertexStripes );
+}
+
+//! Range of elements changed by updateVertices since the last call of packVertices or clearChangedRange.
+//!
+//! @returns false, when nothing was changed. True otherwise.
+bool MeshBufferPack::getChangedRange(
+                uint64_t* rBegin,  //!< Output: first changed element.
+                uint64_t* rEnd     //!< Output: behind the last changed element.
+) const {
+	if( mChangedBegin == mChangedEnd ) {
+		return( false );
+	}
+	(*rBegin) = mChangedBegin;
+	(*rEnd)   = mChangedEnd;
+	return( true );
+}
+
+//! To be called after the changed range was uploaded.
+void MeshBufferPack::clearChangedRange() {
+	mChangedBegin = 0;
+	mChangedEnd   = 0;
+}
+
+//! Fetch one vertex into an interleaved element.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshBufferPack::fetchVertex(
+                Vertex*        rVertex,         //!< Vertex to fetch.
+                sVertexStripe* rWriteTo,        //!< Element to write to.
+                bool           rFetchTopology   //!< False keeps the border, non-manifold and double cone flags of rWriteTo.
+) {
+	bool noError = true;
+
+	if( !rVertex->copyCoordsTo( rWriteTo->mPosition ) ) {
+		noError = false;
+	}
+	if( !rVertex->copyNormalXYZTo( rWriteTo->mNormal ) ) {
+		noError = false;
+	}
+	if( !rVertex->copyRGBATo( rWriteTo->mColor ) ) {
+		noError = false;
+	}
+	double funcVal;
+	if( !rVertex->getFuncValue( &funcVal ) ) {
+		noError = false;
+	}
+	rWriteTo->mFuncVal = static_cast<float>(funcVal);
+	uint64_t labelID = 0;
+	rVertex->getLabel( labelID ); // No ERROR check, here as getLabel also returns false, when no label is set!
+	rWriteTo->mLabelID = static_cast<float>(labelID);  // This is INTENTIONAL - to determine faces along the border of a label!
+	const unsigned int topologyFlags = STRIPE_FLAG_BORDER | STRIPE_FLAG_NON_MANIFOLD | STRIPE_FLAG_DOUBLE_CONE;
+	unsigned int flags = 0;
+	if( !rFetchTopology ) {
+		flags = static_cast<unsigned int>( rWriteTo->mFlags ) & topologyFlags;
+	} else {
+		if( rVertex->isBorder() ) {
+			flags |= STRIPE_FLAG_BORDER;
+		}
+		if( rVertex->isNonManifold() ) {
+			flags |= STRIPE_FLAG_NON_MANIFOLD;
+		}
+		if( rVertex->isDoubleCone() ) {
+			flags |= STRIPE_FLAG_DOUBLE_CONE;
+		}
+	}
+	if( !rVertex->isLabled() ) {
+		flags |= STRIPE_FLAG_NOT_LABELED;
+	}
+	rWriteTo->mFlags = static_cast<float>(flags);
+
+	return( noError );
+}
+
+//! Packs the vertex indices of all faces in parallel i.e. three indices per face.
+void MeshBufferPack::packFaceIndices(
+                const std::vector<Face*>& rFaces,    //!< Faces to pack.
+                std::vector<uint32_t>&    rIndices   //!< Output: vertex indices.
+) {
+	rIndices.resize( 3*rFaces.size() );
+	parallelFor( rFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			Face* currFace = rFaces[faceIdx];
+			rIndices[3*faceIdx]   = static_cast<uint32_t>( currFace->getVertAIndex() );
+			rIndices[3*faceIdx+1] = static_cast<uint32_t>( currFace->getVertBIndex() );
+			rIndices[3*faceIdx+2] = static_cast<uint32_t>( currFace->getVertCIndex() );
+		}
+	} );
+}
+
+//! Packs the vertex indices of the faces having the given flag set e.g. FLAG_SELECTED.
+//! The faces are tested and packed in parallel. The order of the faces is kept.
+void MeshBufferPack::packFaceIndicesWithFlag(
+                const std::vector<Face*>& rFaces,    //!< Faces to test.
+                uint64_t                  rFlagNr,   //!< See Primitive::ePrimitiveFlags.
+                std::vector<uint32_t>&    rIndices   //!< Output: three vertex indices per flagged face.
+) {
+	compactIndices( rFaces.size(), 3, [&]( uint64_t rFaceIdx ) {
+		return( rFaces[rFaceIdx]->getFlag( rFlagNr ) );
+	}, [&]( uint64_t rFaceIdx, uint32_t* rTarget ) {
+		Face* currFace = rFaces[rFaceIdx];
+		rTarget[0] = static_cast<uint32_t>( currFace->getVertAIndex() );
+		rTarget[1] = static_cast<uint32_t>( currFace->getVertBIndex() );
+		rTarget[2] = static_cast<uint32_t>( currFace->getVertCIndex() );
+	}, rIndices );
+}
+
+//! Packs the positions of the vertices having the given flag set e.g. FLAG_SELECTED.
+//! The vertices are tested and packed in parallel. The order of the vertices is kept.
+void MeshBufferPack::packVertexIndicesWithFlag(
+                const std::vector<Vertex*>& rVertices,  //!< Vertices to test.
+                uint64_t                    rFlagNr,    //!< See Primitive::ePrimitiveFlags.
+                std::vector<uint32_t>&      rIndices    //!< Output: positions of the flagged vertices within rVertices.
+) {
+	compactIndices( rVertices.size(), 1, [&]( uint64_t rVertexIdx ) {
+		return( rVertices[rVertexIdx]->getFlag( rFlagNr ) );
+	}, []( uint64_t rVertexIdx, uint32_t* rTarget ) {
+		rTarget[0] = static_cast<uint32_t>( rVertexIdx );
+	}, rIndices );
+}
+
+//! Computes missing face normals in parallel. Otherwise they would be computed on demand, when
+//! vertices without normal estimate theirs from the adjacent faces, which causes concurrent
+//! writes to the faces shared by vertices processed by different threads.
+void MeshBufferPack::prepareFaceNormals( const std::vector<Face*>& rFaces ) {
+	parallelFor( rFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			rFaces[faceIdx]->getAreaNormal(); // computes the normal only, when FLAG_NORMAL_SET is not set.
+		}
+	} );
+}
+
+//! Packs rCount vertices in parallel. Each vertex writes only to its own normal, when it is
+//! estimated on demand, so the vertices need no locks. The face normals are prepared before,
+//! when at least one of the vertices has no normal.
+//!
+//! @returns false in case of an error of at least one vertex. True otherwise.
+bool MeshBufferPack::fetchVertices(
+                const std::vector<Vertex*>& rVertices,       //!< All vertices of the mesh.
+                const std::vector<Face*>&   rFaces,          //!< All faces of the mesh.
+                uint64_t                    rFirst,          //!< Index of the first vertex, when rVertexIndices is nullptr.
+                uint64_t                    rCount,          //!< Number of vertices to pack.
+                const uint64_t*             rVertexIndices,  //!< Optional indices of the vertices to pack. Otherwise [rFirst,rFirst+rCount) is packed.
+                bool                        rFetchTopology   //!< See fetchVertex.
+) {
+	auto vertexIdxAt = [rFirst, rVertexIndices]( uint64_t i ) {
+		return( ( rVertexIndices != nullptr ) ? rVertexIndices[i] : rFirst + i );
+	};
+	std::atomic<bool> normalMissing{ false };
+	parallelFor( rCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			if( !rVertices[vertexIdxAt( i )]->getFlag( Primitive::FLAG_NORMAL_SET ) ) {
+				normalMissing = true;
+				return;
+			}
+		}
+	} );
+	if( normalMissing ) {
+		prepareFaceNormals( rFaces );
+	}
+	std::atomic<bool> noError{ true };
+	parallelFor( rCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		bool noErrorChunk = true;
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			const uint64_t vertexIdx = vertexIdxAt( i );
+			noErrorChunk &= fetchVertex( rVertices[vertexIdx], &mVertexStripes[vertexIdx], rFetchTopology );
+		}
+		if( !noErrorChunk ) {
+			noError = false;
+		}
+	} );
+	return( noError );
+}
@@ -33,8 +33,15 @@
 #include <thread>       // std::thread
 #include <sstream>
 #include <random>
+#include <cmath>        // std::isnan, std::isfinite
+#include <cfloat>       // DBL_MAX, DBL_EPSILON
+#include <limits>       // std::numeric_limits
+#include <atomic>       // std::atomic
+#include <algorithm>    // std::min, std::max
 
 #include <GigaMesh/mesh/gmcommon.h>
+#include <GigaMesh/mesh/primitive.h>
+#include <GigaMesh/mesh/parallelfor.h>
 #include <GigaMesh/logging/Logging.h>
 #include <GigaMesh/getuserandhostname.h>
 
@@ -114,6 +121,171 @@ void MeshInfoData::reset() {
 	}
 }
 
+//! Fast mode: fetch the information, which can be determined from the
+//! primitives as read from file i.e. without establishing the mesh structure.
+//!
+//! Determined are: number of vertices and faces, not-a-number and solo vertices,
+//! vertex flags, finite function values, bounding box, face areas, zero area faces
+//! and volume. Properties requiring the adjacency like borders, manifoldness,
+//! local extrema and connected components are NOT determined and stay reset.
+//!
+//! See Mesh::getMeshInfoData for the complete information.
+//!
+//! @returns false in case of an error. True otherwise.
+bool MeshInfoData::fetchPrimitiveProperties(
+                const std::vector<sVertexProperties>& rVertexProps,
+                const std::vector<sFaceProperties>&   rFaceProps
+) {
+	const uint64_t vertexCount = rVertexProps.size();
+	const uint64_t faceCount   = rFaceProps.size();
+	mCountULong[VERTICES_TOTAL] = vertexCount;
+	mCountULong[FACES_TOTAL]    = faceCount;
+
+	// Per-thread accumulators merged afterwards.
+	struct sPropAccumulator {
+		uint64_t mCount[ULONG_COUNT] = { 0 };
+		double   mBBoxMin[3]    = { +DBL_MAX, +DBL_MAX, +DBL_MAX };
+		double   mBBoxMax[3]    = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+		double   mArea          = 0.0;
+		double   mAreaSmallest  = std::numeric_limits<double>::infinity();
+		double   mAreaLargest   = 0.0;
+		double   mVolumeDXYZ[3] = { 0.0, 0.0, 0.0 };
+	};
+	std::vector<sPropAccumulator> threadAcc( getParallelThreadCount() );
+
+	// Vertices - same handling of not-a-number as Mesh::establishStructure for the bounding box.
+	parallelFor( vertexCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		sPropAccumulator& acc = threadAcc[rThreadIdx];
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			const sVertexProperties& vertProps = rVertexProps[vertIdx];
+			const double coords[3] = { vertProps.mCoordX, vertProps.mCoordY, vertProps.mCoordZ };
+			for( unsigned int i=0; i<3; i++ ) {
+				if( acc.mBBoxMin[i] > coords[i] ) {
+					acc.mBBoxMin[i] = coords[i];
+				}
+				if( acc.mBBoxMax[i] < coords[i] ) {
+					acc.mBBoxMax[i] = coords[i];
+				}
+			}
+			if( std::isnan( coords[0] ) || std::isnan( coords[1] ) || std::isnan( coords[2] ) ) {
+				acc.mCount[VERTICES_NAN]++;
+			}
+			if( std::isfinite( vertProps.mFuncVal ) ) {
+				acc.mCount[VERTICES_FUNCVAL_FINITE]++;
+			}
+			if( vertProps.mFlags & Primitive::FLAG_BELONGS_TO_POLYLINE ) {
+				acc.mCount[VERTICES_POLYLINE]++;
+			}
+			if( vertProps.mFlags & Primitive::FLAG_SYNTHETIC ) {
+				acc.mCount[VERTICES_SYNTHETIC]++;
+			}
+			if( vertProps.mFlags & Primitive::FLAG_MANUAL ) {
+				acc.mCount[VERTICES_MANUAL]++;
+			}
+			if( vertProps.mFlags & Primitive::FLAG_CIRCLE_CENTER ) {
+				acc.mCount[VERTICES_CIRCLE_CENTER]++;
+			}
+			if( vertProps.mFlags & Primitive::FLAG_SELECTED ) {
+				acc.mCount[VERTICES_SELECTED]++;
+			}
+		}
+	} );
+
+	// Faces - area and volume as Face::getAreaNormal and Face::getVolumeDivergence.
+	// Vertices referenced by a face are tagged to count the solo vertices.
+	std::vector<std::atomic<bool>> vertexReferenced( vertexCount ); // value initialized i.e. false
+	std::atomic<uint64_t> faceIndexInvalid{ 0 };
+	parallelFor( faceCount, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		sPropAccumulator& acc = threadAcc[rThreadIdx];
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			const std::vector<uint64_t>& vertIndices = rFaceProps[faceIdx].vertexIndices;
+			if( ( vertIndices.size() != 3 ) || ( vertIndices[0] >= vertexCount ) ||
+			    ( vertIndices[1] >= vertexCount ) || ( vertIndices[2] >= vertexCount ) ) {
+				faceIndexInvalid++;
+				continue;
+			}
+			const sVertexProperties& vertA = rVertexProps[vertIndices[0]];
+			const sVertexProperties& vertB = rVertexProps[vertIndices[1]];
+			const sVertexProperties& vertC = rVertexProps[vertIndices[2]];
+			for( const uint64_t vertIdx : vertIndices ) {
+				vertexReferenced[vertIdx].store( true, std::memory_order_relaxed );
+			}
+			const double vBAx = vertB.mCoordX - vertA.mCoordX;
+			const double vBAy = vertB.mCoordY - vertA.mCoordY;
+			const double vBAz = vertB.mCoordZ - vertA.mCoordZ;
+			const double vCAx = vertC.mCoordX - vertA.mCoordX;
+			const double vCAy = vertC.mCoordY - vertA.mCoordY;
+			const double vCAz = vertC.mCoordZ - vertA.mCoordZ;
+			const double normalX = ( vBAy * vCAz ) - ( vBAz * vCAy );
+			const double normalY = ( vBAz * vCAx ) - ( vBAx * vCAz );
+			const double normalZ = ( vBAx * vCAy ) - ( vBAy * vCAx );
+			const double faceArea = std::sqrt( normalX*normalX + normalY*normalY + normalZ*normalZ ) / 2.0;
+			acc.mArea += faceArea;
+			acc.mAreaSmallest = std::min( acc.mAreaSmallest, faceArea );
+			acc.mAreaLargest  = std::max( acc.mAreaLargest,  faceArea );
+			if( faceArea <= DBL_EPSILON ) {
+				acc.mCount[FACES_ZEROAREA]++;
+			}
+			if( !std::isfinite( faceArea ) || ( faceArea == 0.0 ) ) {
+				continue;
+			}
+			// area * center of gravity * unit normal == center of gravity * normal / 2
+			acc.mVolumeDXYZ[0] += ( vertA.mCoordX + vertB.mCoordX + vertC.mCoordX ) / 3.0 * normalX / 2.0;
+			acc.mVolumeDXYZ[1] += ( vertA.mCoordY + vertB.mCoordY + vertC.mCoordY ) / 3.0 * normalY / 2.0;
+			acc.mVolumeDXYZ[2] += ( vertA.mCoordZ + vertB.mCoordZ + vertC.mCoordZ ) / 3.0 * normalZ / 2.0;
+		}
+	} );
+	if( faceIndexInvalid > 0 ) {
+		LOG::warn() << "[MeshInfoData::" << __FUNCTION__ << "] " << faceIndexInvalid << " faces with invalid vertex references were ignored!\n";
+	}
+
+	// Merge
+	sPropAccumulator totals;
+	for( const sPropAccumulator& acc : threadAcc ) {
+		for( unsigned int i=0; i<ULONG_COUNT; i++ ) {
+			totals.mCount[i] += acc.mCount[i];
+		}
+		for( unsigned int i=0; i<3; i++ ) {
+			totals.mBBoxMin[i] = std::min( totals.mBBoxMin[i], acc.mBBoxMin[i] );
+			totals.mBBoxMax[i] = std::max( totals.mBBoxMax[i], acc.mBBoxMax[i] );
+			totals.mVolumeDXYZ[i] += acc.mVolumeDXYZ[i];
+		}
+		totals.mArea += acc.mArea;
+		totals.mAreaSmallest = std::min( totals.mAreaSmallest, acc.mAreaSmallest );
+		totals.mAreaLargest  = std::max( totals.mAreaLargest,  acc.mAreaLargest );
+	}
+	totals.mCount[VERTICES_SOLO] = 0;
+	for( const auto& isReferenced : vertexReferenced ) {
+		if( !isReferenced.load( std::memory_order_relaxed ) ) {
+			totals.mCount[VERTICES_SOLO]++;
+		}
+	}
+	for( unsigned int i=0; i<ULONG_COUNT; i++ ) {
+		if( ( i == VERTICES_TOTAL ) || ( i == FACES_TOTAL ) ) {
+			continue;
+		}
+		mCountULong[i] = totals.mCount[i];
+	}
+
+	// Same rounding as Mesh::getMeshInfoData
+	mCountDouble[BOUNDINGBOX_MIN_X]  = std::round( totals.mBBoxMin[0]*10000.0 )/10000.0;
+	mCountDouble[BOUNDINGBOX_MIN_Y]  = std::round( totals.mBBoxMin[1]*10000.0 )/10000.0;
+	mCountDouble[BOUNDINGBOX_MIN_Z]  = std::round( totals.mBBoxMin[2]*10000.0 )/10000.0;
+	mCountDouble[BOUNDINGBOX_MAX_X]  = std::round( totals.mBBoxMax[0]*10000.0 )/10000.0;
+	mCountDouble[BOUNDINGBOX_MAX_Y]  = std::round( totals.mBBoxMax[1]*10000.0 )/10000.0;
+	mCountDouble[BOUNDINGBOX_MAX_Z]  = std::round( totals.mBBoxMax[2]*10000.0 )/10000.0;
+	mCountDouble[BOUNDINGBOX_WIDTH]  = std::round( totals.mBBoxMax[0] - totals.mBBoxMin[0] )/10.0; // cm
+	mCountDouble[BOUNDINGBOX_HEIGHT] = std::round( totals.mBBoxMax[1] - totals.mBBoxMin[1] )/10.0; // cm
+	mCountDouble[BOUNDINGBOX_THICK]  = std::round( totals.mBBoxMax[2] - totals.mBBoxMin[2] )/10.0; // cm
+	mCountDouble[FACES_AREA_SMALLEST] = totals.mAreaSmallest;
+	mCountDouble[FACES_AREA_LARGEST]  = totals.mAreaLargest;
+	mCountDouble[TOTAL_AREA]          = std::round( totals.mArea )/100.0; // cm^2
+	mCountDouble[TOTAL_VOLUME_DX]     = totals.mVolumeDXYZ[0];
+	mCountDouble[TOTAL_VOLUME_DY]     = totals.mVolumeDXYZ[1];
+	mCountDouble[TOTAL_VOLUME_DZ]     = totals.mVolumeDXYZ[2];
+	return( true );
+}
+
 unsigned int random_char() {
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -43,6 +43,7 @@
 #include <filesystem>
 #include <chrono>
 
+#include <GigaMesh/mesh/parallelfor.h>
 #include <GigaMesh/mesh/primitive.h>
 #include <GigaMesh/icoSphereTree/IcoSphereTree.h>
 #include "MeshIO/ObjReader.h"
@@ -227,6 +228,12 @@ bool MeshIO::readFile(
 
 	triangulateFaces(rFaceProps, rVertexProps);
 
+	if( mImportWeldTolerance >= 0.0 ) {
+		if( !weldVertexProps( rVertexProps, rFaceProps, mImportWeldTolerance, mImportWeldPolicy ) ) {
+			LOG::warn() << "[MeshIO::" << __FUNCTION__ << "] Welding of the vertices failed!\n";
+		}
+	}
+
 	mModelMetaData = reader->getModelMetaDataRef();
 
 	if(mModelMetaData.hasTextureFiles())
@@ -275,6 +282,94 @@ bool MeshIO::readIsRegularGrid( bool* rIsGrid ) {
 	return( true );
 }
 
+//! Enables welding of the vertices by readFile e.g. for files with duplicated vertices per face like STL exports.
+//! See MeshIO::weldVertexProps.
+void MeshIO::setImportWeldVertices(
+                double                          rTolerance,   //!< Maximum distance of vertices to be welded. Zero for identical coordinates. Negative to disable.
+                VertexWelding::eAttributePolicy rPolicy       //!< Policy for the attributes of the welded vertices.
+) {
+	mImportWeldTolerance = rTolerance;
+	mImportWeldPolicy    = rPolicy;
+}
+
+//! Merges vertices within the given distance, which are typically duplicated per face.
+//! The indices of the faces and polylines are remapped. Faces becoming degenerated i.e.
+//! having two corners welded into one vertex are removed. Feature vectors of the
+//! vertices are merged using the same policy as the other attributes.
+//! See VertexWelding.
+//!
+//! @returns false in case of an error e.g. a negative tolerance. True otherwise.
+bool MeshIO::weldVertexProps(
+                std::vector<sVertexProperties>& rVertexProps,   //!< Vertices to be welded.
+                std::vector<sFaceProperties>&   rFaceProps,     //!< Faces to be remapped.
+                double                          rTolerance,     //!< Maximum distance of vertices to be welded. Zero for identical coordinates.
+                VertexWelding::eAttributePolicy rPolicy,        //!< Policy for the attributes of the welded vertices.
+                uint64_t*                       rMergedNr       //!< Optional output: number of vertices removed by welding.
+) {
+	const uint64_t vertexNr = rVertexProps.size();
+	std::vector<double> vertexCoords( vertexNr * 3 );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			vertexCoords[vertIdx*3]   = rVertexProps[vertIdx].mCoordX;
+			vertexCoords[vertIdx*3+1] = rVertexProps[vertIdx].mCoordY;
+			vertexCoords[vertIdx*3+2] = rVertexProps[vertIdx].mCoordZ;
+		}
+	} );
+	VertexWelding welding;
+	if( !welding.weld( vertexCoords, rTolerance ) ) {
+		LOG::error() << "[MeshIO::" << __FUNCTION__ << "] ERROR: Invalid tolerance " << rTolerance << "!\n";
+		return( false );
+	}
+	if( rMergedNr != nullptr ) {
+		(*rMergedNr) = welding.getMergedNr();
+	}
+	LOG::info() << "[MeshIO::" << __FUNCTION__ << "] Vertices merged: " << welding.getMergedNr() << " of " << vertexNr << "\n";
+	if( welding.getMergedNr() == 0 ) {
+		return( true );
+	}
+
+	std::vector<sVertexProperties> weldedProps;
+	welding.mergeVertexProps( rVertexProps, rPolicy, weldedProps );
+	rVertexProps.swap( weldedProps );
+	if( ( mFeatureVecVerticesLen > 0 ) && ( mFeatureVecVertices.size() == vertexNr * mFeatureVecVerticesLen ) ) {
+		std::vector<double> weldedFeatureVecs;
+		welding.mergeRows( mFeatureVecVertices, mFeatureVecVerticesLen, rPolicy, weldedFeatureVecs );
+		mFeatureVecVertices.swap( weldedFeatureVecs );
+	}
+
+	// Remap and remove degenerated faces.
+	const std::vector<uint64_t>& vertexMap = welding.getVertexMap();
+	parallelFor( rFaceProps.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			for( uint64_t& vertIdx : rFaceProps[faceIdx].vertexIndices ) {
+				if( vertIdx < vertexNr ) {
+					vertIdx = vertexMap[vertIdx];
+				}
+			}
+		}
+	} );
+	const uint64_t facesRemoved = parallelCompact( rFaceProps, []( const sFaceProperties& rFace ) {
+		const std::vector<uint64_t>& indices = rFace.vertexIndices;
+		for( size_t i=0; i<indices.size(); i++ ) {
+			if( indices[i] == indices[( i + 1 ) % indices.size()] ) {
+				return( true );
+			}
+		}
+		return( false );
+	} );
+	if( facesRemoved > 0 ) {
+		LOG::info() << "[MeshIO::" << __FUNCTION__ << "] Degenerated faces removed: " << facesRemoved << "\n";
+	}
+	for( std::vector<int>* polyLine : mPolyLineVertIndices ) {
+		for( int& vertIdx : *polyLine ) {
+			if( ( vertIdx >= 0 ) && ( static_cast<uint64_t>( vertIdx ) < vertexNr ) ) {
+				vertIdx = static_cast<int>( vertexMap[vertIdx] );
+			}
+		}
+	}
+	return( true );
+}
+
 // Texturemap ----------------------------------------------------------------------
 
 //! Imports a texture map (per Vertex) with the format int originalIndex, float red,
@@ -549,6 +644,21 @@ filesystem::path MeshIO::getFullName() const {
 }
 
 bool MeshIO::writeIcoNormalSphereData(const filesystem::path& rFilename, const std::list<sVertexProperties>& rVertexProps, int subdivisions, bool sphereCoordinates)
+{
+	std::vector<double> normalsXYZ;
+	normalsXYZ.reserve(rVertexProps.size() * 3);
+	for(const auto& vertexProp : rVertexProps)
+	{
+		normalsXYZ.push_back(vertexProp.mNormalX);
+		normalsXYZ.push_back(vertexProp.mNormalY);
+		normalsXYZ.push_back(vertexProp.mNormalZ);
+	}
+	return writeIcoNormalSphereData(rFilename, normalsXYZ, subdivisions, sphereCoordinates);
+}
+
+//! Writes the histogram of the given normals (xyz-triplets) binned to the vertices of an icosphere.
+//! Each normal is weighted by its length. Normals with not-a-number are skipped.
+bool MeshIO::writeIcoNormalSphereData(const filesystem::path& rFilename, const std::vector<double>& rNormalsXYZ, int subdivisions, bool sphereCoordinates)
 {
 	fstream filestr;
 	filestr.imbue(std::locale("C"));
@@ -559,15 +669,7 @@ bool MeshIO::writeIcoNormalSphereData(const filesystem::path& rFilename, const s
 	}
 
 	IcoSphereTree icoSphereTree(subdivisions);
-
-	for(const auto& vertexProp : rVertexProps)
-	{
-		Vector3D normal(vertexProp.mNormalX, vertexProp.mNormalY, vertexProp.mNormalZ);
-		auto incSize = normal.normalize3();
-
-		size_t selIndex = icoSphereTree.getNearestVertexIndexAt(normal);
-		icoSphereTree.incData(selIndex, incSize);
-	}
+	icoSphereTree.incDataFromNormals(rNormalsXYZ.data(), rNormalsXYZ.size() / 3);
 
 	std::vector<float> normals = icoSphereTree.getVertices();
 	const std::vector<double>& normalNums = *icoSphereTree.getVertexDataP();
@@ -370,18 +370,33 @@ bool PolyLine::estCurvatureSmooth( double gaussWidth ) {
 }
 
 //! Compute the integral invariants using the radius rIIRadius for all PolyEdge elements.
+//! See compIntInvRadii.
 //! @returns false in case of an error.
 bool PolyLine::compIntInv( double rIIRadius, ePolyIntInvDirection rDirection ) {
-	bool noError = true;
-	for( unsigned int i=0; i<mEdgeList.size(); i++ ) {
-		if( !compIntInv( i, rIIRadius, rDirection ) ) {
-			noError = false;
+	vector<double> intInvs;
+	bool noError = compIntInvRadii( { rIIRadius }, rDirection, &intInvs );
+	for( uint64_t i=0; i<intInvs.size(); i++ ) {
+		if( std::isnan( intInvs[i] ) ) {
+			continue;
 		}
+		mEdgeList[i]->mCurvature = static_cast<float>(intInvs[i]);
+		mEdgeList[i]->setFuncValue( intInvs[i] );
+	}
+	if( !noError ) {
+		cerr << "[PolyLine::" << __FUNCTION__ << "] Warning or errors occured!" << endl;
 	}
-	cerr << "[PolyLine::" << __FUNCTION__ << "] Warning or errors occured!" << endl;
 	return noError;
 }
 
+//! Compute the run-length integral invariants of all PolyEdge elements for several radii in a single pass.
+//! The values are the same as computed by compIntInv( int, double, ePolyIntInvDirection ) apart from
+//! rounding caused by the summation of the run-length. See compIntInvSliding.
+//! @param rValues row-major: one value per PolyEdge and radius.
+//! @returns false in case of an error.
+bool PolyLine::compIntInvRadii( const vector<double>& rRadii, ePolyIntInvDirection rDirection, vector<double>* rValues ) {
+	return compIntInvSliding( rRadii, rDirection, false, rValues );
+}
+
 //! Compute the integral invariants using the radius rIIRadius for all a PolyEdge elements with the given index.
 //! @returns false in case of an error.
 bool PolyLine::compIntInv( int rVertNr, double rIIRadius, ePolyIntInvDirection rDirection ) {
@@ -489,18 +504,32 @@ bool PolyLine::compIntInv( int rVertNr, double rIIRadius, ePolyIntInvDirection r
 }
 
 //! Compute the integral invariants using the radius rIIRadius for all PolyEdge elements.
+//! See compIntInvAngleRadii.
 //! @returns false in case of an error.
 bool PolyLine::compIntInvAngle( double rIIRadius ) {
-	bool noError = true;
-	for( unsigned int i=0; i<mEdgeList.size(); i++ ) {
-		if( !compIntInvAngle( i, rIIRadius ) ) {
-			noError = false;
+	vector<double> intInvs;
+	bool noError = compIntInvAngleRadii( { rIIRadius }, &intInvs );
+	for( uint64_t i=0; i<intInvs.size(); i++ ) {
+		if( std::isnan( intInvs[i] ) ) {
+			continue;
 		}
+		mEdgeList[i]->mCurvature = static_cast<float>(intInvs[i]);
+		mEdgeList[i]->setFuncValue( intInvs[i] );
+	}
+	if( !noError ) {
+		cerr << "[PolyLine::" << __FUNCTION__ << "] Warning or errors occured!" << endl;
 	}
-	cerr << "[PolyLine::" << __FUNCTION__ << "] Warning or errors occured!" << endl;
 	return noError;
 }
 
+//! Compute the angle integral invariants of all PolyEdge elements for several radii in a single pass.
+//! The values are the same as computed by compIntInvAngle( int, double ). See compIntInvSliding.
+//! @param rValues row-major: one value per PolyEdge and radius.
+//! @returns false in case of an error.
+bool PolyLine::compIntInvAngleRadii( const vector<double>& rRadii, vector<double>* rValues ) {
+	return compIntInvSliding( rRadii, POLY_INTEGRAL_INV_BOTH, true, rValues );
+}
+
 //! Compute the integral invariants using the radius rIIRadius for all a PolyEdge elements with the given index.
 //! @returns false in case of an error.
 bool PolyLine::compIntInvAngle( int rVertNr, double rIIRadius ) {
@@ -617,6 +646,152 @@ bool PolyLine::compIntInvAngle( int rVertNr, double rIIRadius ) {
 	return true;
 }
 
+//! Integral invariants of a closed polyline for several radii using sliding windows.
+//!
+//! The per-vertex methods compIntInv( int, double, ePolyIntInvDirection ) and compIntInvAngle( int, double )
+//! walk from each vertex along the line until the sphere is left, which is O(n*k) for n vertices and k
+//! vertices per sphere. Here the positions are copied into a contiguous array and the run-length is
+//! cumulated over two rounds, so the window can pass the start of the closed line. As the distance
+//! to the center is not larger than the run-length, all vertices within a run-length of the radius are
+//! inside the sphere. The bounds of this window only move forward, while the center moves along the
+//! line, i.e. two pointers. Only the vertices beyond have to be tested for leaving the sphere, which
+//! are few for typical profile lines.
+//!
+//! @param rAngle computes the angle between the points on the sphere instead of the run-length.
+//! @param rValues row-major: one value per PolyEdge and radius. Not-a-number, when the sphere contains the whole line.
+//! @returns false in case of an error.
+bool PolyLine::compIntInvSliding(
+                const vector<double>& rRadii,       //!< Radii of the spheres.
+                ePolyIntInvDirection  rDirection,   //!< Direction(s) for the run-length. Ignored for rAngle.
+                bool                  rAngle,       //!< Angle instead of run-length.
+                vector<double>*       rValues       //!< Output: row-major per PolyEdge and radius.
+) {
+	if( rValues == nullptr ) {
+		cerr << "[PolyLine::" << __FUNCTION__ << "] ERROR: NULL pointer given!" << endl;
+		return false;
+	}
+	rValues->clear();
+	if( ( mEdgeList.size() < 3 ) || ( !isClosed() ) ) {
+		cerr << "[PolyLine::" << __FUNCTION__ << "] ERROR: Polyline is not closed!" << endl;
+		return false;
+	}
+	const uint64_t edgeCount  = mEdgeList.size();
+	const uint64_t vertCount  = edgeCount - 1; // Last vertex equals the first vertex.
+	const uint64_t radiiCount = rRadii.size();
+	rValues->assign( edgeCount * radiiCount, _NOT_A_NUMBER_DBL_ );
+
+	vector<double> positions( vertCount * 3 );
+	for( uint64_t i=0; i<vertCount; i++ ) {
+		mEdgeList[i]->mVertPoly->copyXYZTo( &positions[i*3] );
+	}
+	// Same as distanceVV:
+	auto distPos = [&positions]( uint64_t rIdxA, uint64_t rIdxB ) {
+		const double* posA = &positions[rIdxA*3];
+		const double* posB = &positions[rIdxB*3];
+		const double dx = posB[0] - posA[0];
+		const double dy = posB[1] - posA[1];
+		const double dz = posB[2] - posA[2];
+		return( sqrt( dx*dx + dy*dy + dz*dz ) );
+	};
+	// Run-length from the first vertex to the unrolled vertex k within [0,2*vertCount]:
+	vector<double> runLen( 2*vertCount + 1 );
+	runLen[0] = 0.0;
+	for( uint64_t k=1; k<runLen.size(); k++ ) {
+		runLen[k] = runLen[k-1] + distPos( (k-1) % vertCount, k % vertCount );
+	}
+	// Crossing of the sphere between the unrolled vertices rInside and rOutside - see compIntInv( int, double, ePolyIntInvDirection ).
+	// Returns the distance from rInside to the point on the sphere.
+	auto crossSphere = [this,vertCount]( double rRadius, uint64_t rCenter, uint64_t rInside, uint64_t rOutside, Vector3D* rBorderPoint ) {
+		Vector3D sphereCenter = mEdgeList[rCenter]->mVertPoly->getPositionVector();
+		Vector3D currPos      = mEdgeList[rInside % vertCount]->mVertPoly->getPositionVector();
+		Vector3D nextPos      = mEdgeList[rOutside % vertCount]->mVertPoly->getPositionVector();
+		Vector3D interSect1;
+		Vector3D interSect2;
+		eLineSphereCases intersectCase = lineSphereIntersect( rRadius, sphereCenter, currPos, nextPos, &interSect1, &interSect2 );
+		if ( ( intersectCase != LSI_ONE_INTERSECT_P1 ) && ( intersectCase != LSI_ONE_INTERSECT_P2 ) ) {
+			cerr << "[PolyLine::compIntInvSliding] ERROR: Unexpected intersection!" << endl;
+		}
+		(*rBorderPoint) = ( intersectCase == LSI_ONE_INTERSECT_P1 ) ? interSect1 : interSect2;
+		return( abs3( (*rBorderPoint) - currPos ) );
+	};
+
+	const bool forward  = rAngle || ( rDirection != POLY_INTEGRAL_INV_BACKWARD );
+	const bool backward = rAngle || ( rDirection != POLY_INTEGRAL_INV_FORWARD );
+	bool radiusTooLarge = false;
+	for( uint64_t r=0; r<radiiCount; r++ ) {
+		const double radius = rRadii[r];
+		// Vertices are skipped only with a margin for the rounding errors of the cumulated run-length:
+		const double runLenMax = radius - 4.0 * DBL_EPSILON * static_cast<double>( runLen.size() ) * ( runLen.back() + radius );
+		uint64_t insideLast  = 0;         // Forward:  unrolled vertices within ( center, insideLast ] are inside the sphere.
+		uint64_t insideFirst = vertCount; // Backward: unrolled vertices within [ insideFirst, center ) are inside the sphere.
+		while( ( insideFirst > 1 ) && ( runLen[vertCount] - runLen[insideFirst-1] <= runLenMax ) ) {
+			insideFirst--;
+		}
+		for( uint64_t center=0; center<vertCount; center++ ) {
+			double   distIntegral = 0.0;
+			Vector3D borderPointA;
+			Vector3D borderPointB;
+			if( forward ) {
+				// Candidates are the unrolled vertices ( center, center+vertCount ):
+				const uint64_t last = center + vertCount - 1;
+				insideLast = std::max( insideLast, center );
+				while( ( insideLast < last ) && ( runLen[insideLast+1] - runLen[center] <= runLenMax ) ) {
+					insideLast++;
+				}
+				uint64_t outside = insideLast + 1;
+				while( ( outside <= last ) && ( distPos( center, outside % vertCount ) <= radius ) ) {
+					outside++;
+				}
+				if( outside > last ) {
+					// The sphere contains the whole polyline:
+					radiusTooLarge = true;
+					continue;
+				}
+				distIntegral += runLen[outside-1] - runLen[center];
+				distIntegral += crossSphere( radius, center, outside-1, outside, &borderPointA );
+			}
+			if( backward ) {
+				// Candidates are the unrolled vertices ( center, center+vertCount ) walking down from centerUnrolled = center+vertCount:
+				const uint64_t centerUnrolled = center + vertCount;
+				const uint64_t first          = center + 1;
+				insideFirst = std::max( insideFirst, first );
+				while( ( insideFirst < centerUnrolled ) && ( runLen[centerUnrolled] - runLen[insideFirst] > runLenMax ) ) {
+					insideFirst++;
+				}
+				uint64_t outside = insideFirst - 1;
+				while( ( outside >= first ) && ( distPos( center, outside % vertCount ) <= radius ) ) {
+					outside--;
+				}
+				if( outside < first ) {
+					// As compIntInv( int, double, ePolyIntInvDirection ): the backward walk stops after a full round without error.
+					distIntegral += runLen[centerUnrolled] - runLen[first];
+				} else {
+					distIntegral += runLen[centerUnrolled] - runLen[outside+1];
+					distIntegral += crossSphere( radius, center, outside+1, outside, &borderPointB );
+				}
+			}
+			double intInv = distIntegral / radius;
+			if( rAngle ) {
+				Vertex*  vertCenter   = mEdgeList[center]->mVertPoly;
+				Vector3D sphereCenter = vertCenter->getPositionVector();
+				if( abs3( vertCenter->getNormal() ) > 0.0 ) {
+					intInv = -angle( (borderPointA-sphereCenter), (borderPointB-sphereCenter) );
+				} else {
+					intInv = angle( (borderPointA-sphereCenter), (borderPointB-sphereCenter) );
+				}
+			}
+			(*rValues)[center*radiiCount+r] = intInv;
+		}
+		// The last PolyEdge refers to the first vertex:
+		(*rValues)[vertCount*radiiCount+r] = (*rValues)[r];
+	}
+	if( radiusTooLarge ) {
+		cerr << "[PolyLine::" << __FUNCTION__ << "] Warning: Radius for Integral Invariant appears to be to large!" << endl;
+		return false;
+	}
+	return true;
+}
+
 bool PolyLine::getExtrema( set<Vertex*>* someVerts, double gaussWidth, bool absolut ) {
 	//! Returns the polylines extrema.
 	if( !estCurvature( absolut ) ) {
@@ -777,6 +952,10 @@ bool PolyLine::getNeighboursRunLen( int rVertNr, double rDist, vector<int>* rNei
 		rWeights->push_back( (newDistLeft+newDistRight)/2.0 );
 	}
 
+	// Collected in reverse order and prepended at once - inserting each element in front is quadratic:
+	vector<int>    neighVertsLeft;
+	vector<double> distsLeft;
+	vector<double> weightsLeft;
 	iCurr = rVertNr;
 	while( distLeft < rDist ) {
 		iCurr--;
@@ -796,16 +975,19 @@ bool PolyLine::getNeighboursRunLen( int rVertNr, double rDist, vector<int>* rNei
 		vertRight = mEdgeList.at( vertRightIdx )->mVertPoly;
 		newDistRight = ( vertRight->getCenterOfGravity() - mEdgeList.at( iCurrSafe )->mVertPoly->getCenterOfGravity() ).getLength3();
 
-		rDists->insert( rDists->begin(), -distLeft );
+		distsLeft.push_back( -distLeft );
 		if( ( distLeft + newDistLeft ) > rDist ) {
 			newDistLeft = ( rDist - distLeft ) * 2.0;
 			distLeft    = rDist;
 		} else {
 			distLeft += newDistLeft;
 		}
-		rNeighVerts->insert( rNeighVerts->begin(), iCurrSafe );
-		rWeights->insert( rWeights->begin(), (newDistLeft+newDistRight)/2.0 );
+		neighVertsLeft.push_back( iCurrSafe );
+		weightsLeft.push_back( (newDistLeft+newDistRight)/2.0 );
 	}
+	rNeighVerts->insert( rNeighVerts->begin(), neighVertsLeft.rbegin(), neighVertsLeft.rend() );
+	rDists->insert( rDists->begin(), distsLeft.rbegin(), distsLeft.rend() );
+	rWeights->insert( rWeights->begin(), weightsLeft.rbegin(), weightsLeft.rend() );
 #ifdef DEBUG_POLYLINE_GETNEIGHBOURS
 	double sumWeight = 0.0;
 	cout << "Weights:";
@@ -838,10 +1020,11 @@ size_t PolyLine::getSafeIndex(size_t someIdx ) {
 		if( ( someIdx >= 0 ) && ( someIdx < maxIndex ) ) {
 			return someIdx;
 		}
-		// Modulo: a - (n * floor(a/n)) ... because "%" works differently for negative numbers in C/C++
-		//cout << "[PolyLine::getSafeIndex] closed " << someIdx << " % " << maxIndex << " " << someIdx-(maxIndex*floor((double)someIdx/(double)maxIndex)) << endl;
-		return MODULO_INT( someIdx, maxIndex );
-		//return ( someIdx-(maxIndex*floor((double)someIdx/(double)maxIndex)) );
+		// Negative indices are given as int, which wrap around to huge unsigned values. MODULO_INT
+		// computes in float and fails for those, so the signed remainder is shifted into the range:
+		const int64_t signedIdx   = static_cast<int64_t>(someIdx);
+		const int64_t signedCount = static_cast<int64_t>(maxIndex);
+		return ( ( signedIdx % signedCount ) + signedCount ) % signedCount;
 	}
 	//! Open polylines: returns a negative value, when out of range.
 	//cout << "[PolyLine::getSafeIndex] open " << someIdx << endl;
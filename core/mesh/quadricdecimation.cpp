@@ -0,0 +1,502 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/quadricdecimation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <GigaMesh/mesh/parallelfor.h>
+
+//! Weight of the constraint planes along borders relative to the planes of the faces.
+static constexpr double BORDER_WEIGHT = 1000.0;
+
+//! Cross product rC = rA x rB.
+static inline void cross3( const double* rA, const double* rB, double* rC ) {
+	rC[0] = rA[1]*rB[2] - rA[2]*rB[1];
+	rC[1] = rA[2]*rB[0] - rA[0]*rB[2];
+	rC[2] = rA[0]*rB[1] - rA[1]*rB[0];
+}
+
+//! Dot product of two 3D vectors.
+static inline double dot3( const double* rA, const double* rB ) {
+	return( rA[0]*rB[0] + rA[1]*rB[1] + rA[2]*rB[2] );
+}
+
+//! Normal of the triangle with the length of twice its area.
+static inline void triangleNormal( const double* rPosA, const double* rPosB, const double* rPosC, double* rNormal ) {
+	const double edgeAB[3] = { rPosB[0]-rPosA[0], rPosB[1]-rPosA[1], rPosB[2]-rPosA[2] };
+	const double edgeAC[3] = { rPosC[0]-rPosA[0], rPosC[1]-rPosA[1], rPosC[2]-rPosA[2] };
+	cross3( edgeAB, edgeAC, rNormal );
+}
+
+//! Adds the plane with the given unit normal and distance to the origin i.e. n*x + d = 0.
+void QuadricDecimation::sQuadric::addPlane( const double* rNormal, double rDist, double rWeight ) {
+	mA[0] += rWeight * rNormal[0] * rNormal[0];
+	mA[1] += rWeight * rNormal[0] * rNormal[1];
+	mA[2] += rWeight * rNormal[0] * rNormal[2];
+	mA[3] += rWeight * rNormal[1] * rNormal[1];
+	mA[4] += rWeight * rNormal[1] * rNormal[2];
+	mA[5] += rWeight * rNormal[2] * rNormal[2];
+	mA[6] += rWeight * rNormal[0] * rDist;
+	mA[7] += rWeight * rNormal[1] * rDist;
+	mA[8] += rWeight * rNormal[2] * rDist;
+	mA[9] += rWeight * rDist * rDist;
+}
+
+//! Sum of two quadrics.
+void QuadricDecimation::sQuadric::add( const sQuadric& rOther ) {
+	for( unsigned int i=0; i<10; i++ ) {
+		mA[i] += rOther.mA[i];
+	}
+}
+
+//! @returns the weighted sum of the squared distances of the given position to the planes.
+double QuadricDecimation::sQuadric::eval( const double* rPos ) const {
+	const double x = rPos[0];
+	const double y = rPos[1];
+	const double z = rPos[2];
+	return( x*( mA[0]*x + 2.0*( mA[1]*y + mA[2]*z + mA[6] ) ) +
+	        y*( mA[3]*y + 2.0*( mA[4]*z + mA[7] ) ) +
+	        z*( mA[5]*z + 2.0*mA[8] ) + mA[9] );
+}
+
+//! Decimates the given mesh until it has at most rTargetFaceNr faces or there are no more
+//! collapses with costs up to rMaxError. The results are fetched by the getters.
+//!
+//! @returns false for invalid arguments e.g. vertex indices out of range. True otherwise.
+bool QuadricDecimation::decimate(
+                const std::vector<double>&   rVertexCoords,        //!< Vertex coordinates as xyz-triplets.
+                const std::vector<uint64_t>& rFaceVertexIndices,   //!< Three vertex indices per triangle.
+                const std::vector<uint64_t>& rVertexLabels,        //!< Label per vertex or empty to neglect labels.
+                uint64_t                     rTargetFaceNr,        //!< Number of faces to reach.
+                double                       rMaxError             //!< Maximum costs of a collapse i.e. sum of weighted squared distances.
+) {
+	mCoarseFaces.clear();
+	mCoarseToFine.clear();
+	mFineToCoarse.clear();
+	const uint64_t vertexNr = rVertexCoords.size() / 3;
+	if( ( rVertexCoords.size() % 3 != 0 ) || ( rFaceVertexIndices.size() % 3 != 0 ) ||
+	    ( !rVertexLabels.empty() && ( rVertexLabels.size() != vertexNr ) ) ) {
+		return( false );
+	}
+	if( std::any_of( rFaceVertexIndices.begin(), rFaceVertexIndices.end(), [vertexNr]( uint64_t rVertIdx ) {
+	        return( rVertIdx >= vertexNr ); } ) ) {
+		return( false );
+	}
+	mVertexCoords = rVertexCoords.data();
+	mVertexLabels = rVertexLabels.empty() ? nullptr : rVertexLabels.data();
+	mFaces        = rFaceVertexIndices;
+	mFaceRemoved.assign( mFaces.size() / 3, 0 );
+	mMergedInto.resize( vertexNr );
+	std::iota( mMergedInto.begin(), mMergedInto.end(), static_cast<uint64_t>(0) );
+	buildAdjacency();
+
+	std::vector<sScratch> threadScratch( getParallelThreadCount() );
+	mQuadrics.assign( vertexNr, sQuadric() );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			initQuadric( vertIdx, threadScratch[rThreadIdx] );
+		}
+	} );
+
+	uint64_t faceNr = mFaceRemoved.size();
+	std::vector<sCollapse> collapses( vertexNr );
+	std::vector<uint8_t>   collapseValid( vertexNr, 0 );
+	std::vector<uint8_t>   collapseOutdated( vertexNr, 1 );
+	std::vector<sCollapse> collapsesSorted;
+	std::vector<sCollapse> collapsesChosen;
+	std::vector<uint8_t>   faceTouched( mFaceRemoved.size(), 0 );
+	std::vector<uint8_t>   vertexTouched( vertexNr, 0 );
+	while( faceNr > rTargetFaceNr ) {
+		// Cheapest collapse per vertex, which is only estimated again, when the neighbourhood has changed:
+		parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+			for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+				if( collapseOutdated[vertIdx] == 0 ) {
+					continue;
+				}
+				collapseValid[vertIdx] = findCollapse( vertIdx, threadScratch[rThreadIdx], collapses[vertIdx] ) &&
+				                         ( collapses[vertIdx].mCost <= rMaxError );
+				collapseOutdated[vertIdx] = 0;
+			}
+		} );
+		collapsesSorted.clear();
+		for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+			if( collapseValid[vertIdx] != 0 ) {
+				collapsesSorted.push_back( collapses[vertIdx] );
+			}
+		}
+		if( collapsesSorted.empty() ) {
+			break;
+		}
+		std::sort( collapsesSorted.begin(), collapsesSorted.end(), []( const sCollapse& rA, const sCollapse& rB ) {
+			return( ( rA.mCost < rB.mCost ) || ( ( rA.mCost == rB.mCost ) && ( rA.mFrom < rB.mFrom ) ) );
+		} );
+
+		// Choose collapses among the cheaper half, which do not share any face. Their checks
+		// remain valid, when all of them are applied at once.
+		std::fill( faceTouched.begin(), faceTouched.end(), 0 );
+		std::fill( vertexTouched.begin(), vertexTouched.end(), 0 );
+		collapsesChosen.clear();
+		uint64_t facesRemoved = 0;
+		const uint64_t collapsesConsidered = ( collapsesSorted.size() + 1 ) / 2;
+		for( uint64_t i=0; ( i<collapsesConsidered ) && ( faceNr - facesRemoved > rTargetFaceNr ); i++ ) {
+			const sCollapse& currCollapse = collapsesSorted[i];
+			bool touched = false;
+			for( const uint64_t vertIdx : { currCollapse.mFrom, currCollapse.mTo } ) {
+				for( uint64_t j=mAdjacencyOffset[vertIdx]; ( j<mAdjacencyOffset[vertIdx+1] ) && !touched; j++ ) {
+					touched = ( faceTouched[mAdjacentFaces[j]] != 0 );
+				}
+			}
+			if( touched ) {
+				continue;
+			}
+			for( const uint64_t vertIdx : { currCollapse.mFrom, currCollapse.mTo } ) {
+				for( uint64_t j=mAdjacencyOffset[vertIdx]; j<mAdjacencyOffset[vertIdx+1]; j++ ) {
+					const uint64_t* faceVertices = &mFaces[3*mAdjacentFaces[j]];
+					faceTouched[mAdjacentFaces[j]] = 1;
+					vertexTouched[faceVertices[0]] = vertexTouched[faceVertices[1]] = vertexTouched[faceVertices[2]] = 1;
+				}
+			}
+			collapsesChosen.push_back( currCollapse );
+			facesRemoved += currCollapse.mFacesNr;
+		}
+
+		// Apply the collapses, which do not share any face:
+		parallelFor( collapsesChosen.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+			for( uint64_t i=rBegin; i<rEnd; i++ ) {
+				const uint64_t vertFrom = collapsesChosen[i].mFrom;
+				const uint64_t vertTo   = collapsesChosen[i].mTo;
+				mQuadrics[vertTo].add( mQuadrics[vertFrom] );
+				mMergedInto[vertFrom] = vertTo;
+				for( uint64_t j=mAdjacencyOffset[vertFrom]; j<mAdjacencyOffset[vertFrom+1]; j++ ) {
+					const uint64_t faceIdx = mAdjacentFaces[j];
+					uint64_t* faceVertices = &mFaces[3*faceIdx];
+					if( ( faceVertices[0] == vertTo ) || ( faceVertices[1] == vertTo ) || ( faceVertices[2] == vertTo ) ) {
+						mFaceRemoved[faceIdx] = 1;
+						continue;
+					}
+					for( unsigned int k=0; k<3; k++ ) {
+						if( faceVertices[k] == vertFrom ) {
+							faceVertices[k] = vertTo;
+						}
+					}
+				}
+			}
+		}, 256 );
+		faceNr -= facesRemoved;
+		buildAdjacency();
+		// The collapses of the vertices next to the modified 1-rings depend on these 1-rings:
+		parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+			for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+				bool outdated = ( vertexTouched[vertIdx] != 0 );
+				for( uint64_t j=mAdjacencyOffset[vertIdx]; ( j<mAdjacencyOffset[vertIdx+1] ) && !outdated; j++ ) {
+					const uint64_t* faceVertices = &mFaces[3*mAdjacentFaces[j]];
+					outdated = ( vertexTouched[faceVertices[0]] | vertexTouched[faceVertices[1]] | vertexTouched[faceVertices[2]] ) != 0;
+				}
+				collapseOutdated[vertIdx] = outdated ? 1 : 0;
+			}
+		} );
+	}
+
+	// Index of the remaining vertex for each removed vertex:
+	std::vector<uint64_t> coarseIdx( vertexNr );
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		if( mMergedInto[vertIdx] == vertIdx ) {
+			coarseIdx[vertIdx] = mCoarseToFine.size();
+			mCoarseToFine.push_back( vertIdx );
+		}
+	}
+	mFineToCoarse.resize( vertexNr );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			uint64_t remainingIdx = vertIdx;
+			while( mMergedInto[remainingIdx] != remainingIdx ) {
+				remainingIdx = mMergedInto[remainingIdx];
+			}
+			mFineToCoarse[vertIdx] = coarseIdx[remainingIdx];
+		}
+	} );
+	// The faces refer to remaining vertices only:
+	mCoarseFaces.reserve( 3*faceNr );
+	for( uint64_t faceIdx=0; faceIdx<mFaceRemoved.size(); faceIdx++ ) {
+		if( mFaceRemoved[faceIdx] == 0 ) {
+			for( unsigned int k=0; k<3; k++ ) {
+				mCoarseFaces.push_back( coarseIdx[mFaces[3*faceIdx+k]] );
+			}
+		}
+	}
+
+	// Free the memory used during the decimation:
+	mVertexCoords = nullptr;
+	mVertexLabels = nullptr;
+	for( auto* buffer : { &mFaces, &mAdjacencyOffset, &mAdjacentFaces, &mMergedInto } ) {
+		buffer->clear();
+		buffer->shrink_to_fit();
+	}
+	mFaceRemoved.clear();
+	mFaceRemoved.shrink_to_fit();
+	mQuadrics.clear();
+	mQuadrics.shrink_to_fit();
+	return( true );
+}
+
+//! @returns the number of remaining vertices.
+uint64_t QuadricDecimation::getVertexNr() const {
+	return( mCoarseToFine.size() );
+}
+
+//! @returns the number of remaining faces.
+uint64_t QuadricDecimation::getFaceNr() const {
+	return( mCoarseFaces.size() / 3 );
+}
+
+//! @returns three indices of remaining vertices per remaining face.
+const std::vector<uint64_t>& QuadricDecimation::getFaceVertexIndices() const {
+	return( mCoarseFaces );
+}
+
+//! @returns the index of the original vertex for each remaining vertex in increasing order.
+const std::vector<uint64_t>& QuadricDecimation::getCoarseToFine() const {
+	return( mCoarseToFine );
+}
+
+//! @returns the index of the remaining vertex for each original vertex, which is the vertex
+//!          itself or the vertex it was merged into.
+const std::vector<uint64_t>& QuadricDecimation::getFineToCoarse() const {
+	return( mFineToCoarse );
+}
+
+//! Lists the remaining faces adjacent to each vertex by counting followed by a prefix sum.
+void QuadricDecimation::buildAdjacency() {
+	const uint64_t vertexNr = mMergedInto.size();
+	const uint64_t faceNr   = mFaceRemoved.size();
+	mAdjacencyOffset.assign( vertexNr+1, 0 );
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		if( mFaceRemoved[faceIdx] == 0 ) {
+			for( unsigned int k=0; k<3; k++ ) {
+				mAdjacencyOffset[mFaces[3*faceIdx+k]+1]++;
+			}
+		}
+	}
+	std::partial_sum( mAdjacencyOffset.begin(), mAdjacencyOffset.end(), mAdjacencyOffset.begin() );
+	mAdjacentFaces.resize( mAdjacencyOffset[vertexNr] );
+	std::vector<uint64_t> insertPos( mAdjacencyOffset.begin(), mAdjacencyOffset.end()-1 );
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		if( mFaceRemoved[faceIdx] == 0 ) {
+			for( unsigned int k=0; k<3; k++ ) {
+				mAdjacentFaces[insertPos[mFaces[3*faceIdx+k]]++] = faceIdx;
+			}
+		}
+	}
+}
+
+//! Neighbours of a vertex and the number of faces adjacent to the edge to each neighbour.
+//! One face means a border edge, more than two faces a non-manifold edge.
+void QuadricDecimation::collectNeighbours(
+                uint64_t               rVertIdx,      //!< Index of the vertex.
+                std::vector<uint64_t>& rNeighbours,   //!< Output: indices of the neighbours.
+                std::vector<uint64_t>& rFaceCounts    //!< Output: number of faces per edge to the neighbours.
+) const {
+	rNeighbours.clear();
+	rFaceCounts.clear();
+	for( uint64_t j=mAdjacencyOffset[rVertIdx]; j<mAdjacencyOffset[rVertIdx+1]; j++ ) {
+		const uint64_t* faceVertices = &mFaces[3*mAdjacentFaces[j]];
+		for( unsigned int k=0; k<3; k++ ) {
+			const uint64_t neighbourIdx = faceVertices[k];
+			if( neighbourIdx == rVertIdx ) {
+				continue;
+			}
+			const auto itNeighbour = std::find( rNeighbours.begin(), rNeighbours.end(), neighbourIdx );
+			if( itNeighbour == rNeighbours.end() ) {
+				rNeighbours.push_back( neighbourIdx );
+				rFaceCounts.push_back( 1 );
+			} else {
+				rFaceCounts[itNeighbour - rNeighbours.begin()]++;
+			}
+		}
+	}
+}
+
+//! @returns true, when at least one neighbour has a different label. False otherwise and without labels.
+bool QuadricDecimation::isLabelBorder( uint64_t rVertIdx, const std::vector<uint64_t>& rNeighbours ) const {
+	if( mVertexLabels == nullptr ) {
+		return( false );
+	}
+	return( std::any_of( rNeighbours.begin(), rNeighbours.end(), [this, rVertIdx]( uint64_t rNeighbourIdx ) {
+		return( mVertexLabels[rNeighbourIdx] != mVertexLabels[rVertIdx] );
+	} ) );
+}
+
+//! Sum of the planes of the adjacent faces weighted by their area. Planes perpendicular to the faces
+//! are added along border edges and edges between different labels, which keep these in place.
+void QuadricDecimation::initQuadric( uint64_t rVertIdx, sScratch& rScratch ) {
+	sQuadric& quadric = mQuadrics[rVertIdx];
+	const double* vertPos = mVertexCoords + 3*rVertIdx;
+	collectNeighbours( rVertIdx, rScratch.mNeighbours, rScratch.mNeighbourFaces );
+	for( uint64_t j=mAdjacencyOffset[rVertIdx]; j<mAdjacencyOffset[rVertIdx+1]; j++ ) {
+		const uint64_t* faceVertices = &mFaces[3*mAdjacentFaces[j]];
+		double faceNormal[3];
+		triangleNormal( mVertexCoords + 3*faceVertices[0], mVertexCoords + 3*faceVertices[1],
+		                mVertexCoords + 3*faceVertices[2], faceNormal );
+		const double normalLen = std::sqrt( dot3( faceNormal, faceNormal ) );
+		if( !std::isnormal( normalLen ) ) {
+			continue;
+		}
+		for( double& element : faceNormal ) {
+			element /= normalLen;
+		}
+		quadric.addPlane( faceNormal, -dot3( faceNormal, vertPos ), normalLen / 2.0 );
+		// Constraints for the edges of this face starting at this vertex:
+		for( unsigned int k=0; k<3; k++ ) {
+			const uint64_t neighbourIdx = faceVertices[k];
+			if( neighbourIdx == rVertIdx ) {
+				continue;
+			}
+			const uint64_t edgeFaces = rScratch.mNeighbourFaces[std::find( rScratch.mNeighbours.begin(), rScratch.mNeighbours.end(),
+			                                                               neighbourIdx ) - rScratch.mNeighbours.begin()];
+			const bool labelEdge = ( mVertexLabels != nullptr ) && ( mVertexLabels[neighbourIdx] != mVertexLabels[rVertIdx] );
+			if( ( edgeFaces != 1 ) && !labelEdge ) {
+				continue;
+			}
+			const double* neighbourPos = mVertexCoords + 3*neighbourIdx;
+			const double edge[3] = { neighbourPos[0]-vertPos[0], neighbourPos[1]-vertPos[1], neighbourPos[2]-vertPos[2] };
+			double constraintNormal[3];
+			cross3( edge, faceNormal, constraintNormal );
+			const double constraintLen = std::sqrt( dot3( constraintNormal, constraintNormal ) );
+			if( !std::isnormal( constraintLen ) ) {
+				continue;
+			}
+			for( double& element : constraintNormal ) {
+				element /= constraintLen;
+			}
+			quadric.addPlane( constraintNormal, -dot3( constraintNormal, vertPos ), BORDER_WEIGHT * dot3( edge, edge ) );
+		}
+	}
+}
+
+//! Estimates the cheapest collapse of the given vertex into one of its neighbours, which keeps the
+//! mesh manifold, does not flip faces and preserves borders and labels - see class description.
+//!
+//! @returns false, when there is no such collapse. True otherwise.
+bool QuadricDecimation::findCollapse(
+                uint64_t   rVertIdx,    //!< Index of the vertex to remove.
+                sScratch&  rScratch,    //!< Scratch memory of the calling thread.
+                sCollapse& rCollapse    //!< Output: cheapest collapse.
+) const {
+	if( mMergedInto[rVertIdx] != rVertIdx ) {
+		return( false );
+	}
+	collectNeighbours( rVertIdx, rScratch.mNeighbours, rScratch.mNeighbourFaces );
+	if( rScratch.mNeighbours.empty() ) {
+		return( false );
+	}
+	bool isBorder = false;
+	for( const uint64_t edgeFaces : rScratch.mNeighbourFaces ) {
+		if( edgeFaces > 2 ) {
+			return( false ); // non-manifold
+		}
+		isBorder |= ( edgeFaces == 1 );
+	}
+	const bool isLabelBorderVert = isLabelBorder( rVertIdx, rScratch.mNeighbours );
+
+	bool found = false;
+	rCollapse.mCost = std::numeric_limits<double>::infinity();
+	for( uint64_t i=0; i<rScratch.mNeighbours.size(); i++ ) {
+		const uint64_t neighbourIdx = rScratch.mNeighbours[i];
+		const uint64_t edgeFaces    = rScratch.mNeighbourFaces[i];
+		if( ( mVertexLabels != nullptr ) && ( mVertexLabels[neighbourIdx] != mVertexLabels[rVertIdx] ) ) {
+			continue;
+		}
+		if( isBorder && ( edgeFaces != 1 ) ) {
+			continue; // border vertices are only moved along the border.
+		}
+		const double cost = mQuadrics[rVertIdx].eval( mVertexCoords + 3*neighbourIdx ) +
+		                    mQuadrics[neighbourIdx].eval( mVertexCoords + 3*neighbourIdx );
+		if( found && ( cost >= rCollapse.mCost ) ) {
+			continue;
+		}
+		collectNeighbours( neighbourIdx, rScratch.mOtherNeighbours, rScratch.mOtherFaces );
+		if( std::any_of( rScratch.mOtherFaces.begin(), rScratch.mOtherFaces.end(), []( uint64_t rEdgeFaces ) {
+		        return( rEdgeFaces > 2 ); } ) ) {
+			continue;
+		}
+		if( isLabelBorderVert && !isLabelBorder( neighbourIdx, rScratch.mOtherNeighbours ) ) {
+			continue;
+		}
+		// Link condition: the common neighbours have to be the vertices opposite to the edge.
+		uint64_t commonNeighbours = 0;
+		for( const uint64_t otherIdx : rScratch.mOtherNeighbours ) {
+			commonNeighbours += std::count( rScratch.mNeighbours.begin(), rScratch.mNeighbours.end(), otherIdx );
+		}
+		if( commonNeighbours != edgeFaces ) {
+			continue;
+		}
+		if( isFlipped( rVertIdx, neighbourIdx ) ) {
+			continue;
+		}
+		found = true;
+		rCollapse.mCost    = cost;
+		rCollapse.mFrom    = rVertIdx;
+		rCollapse.mTo      = neighbourIdx;
+		rCollapse.mFacesNr = edgeFaces;
+	}
+	return( found );
+}
+
+//! @returns true, when merging rFrom into rTo flips or degenerates a face or creates a face twice. False otherwise.
+bool QuadricDecimation::isFlipped( uint64_t rFrom, uint64_t rTo ) const {
+	for( uint64_t j=mAdjacencyOffset[rFrom]; j<mAdjacencyOffset[rFrom+1]; j++ ) {
+		const uint64_t* faceVertices = &mFaces[3*mAdjacentFaces[j]];
+		if( ( faceVertices[0] == rTo ) || ( faceVertices[1] == rTo ) || ( faceVertices[2] == rTo ) ) {
+			continue; // removed by the collapse.
+		}
+		const double* positions[3];
+		const double* positionsMoved[3];
+		uint64_t otherVertices[2];
+		unsigned int otherNr = 0;
+		for( unsigned int k=0; k<3; k++ ) {
+			positions[k]      = mVertexCoords + 3*faceVertices[k];
+			positionsMoved[k] = ( faceVertices[k] == rFrom ) ? mVertexCoords + 3*rTo : positions[k];
+			if( faceVertices[k] != rFrom ) {
+				otherVertices[otherNr++] = faceVertices[k];
+			}
+		}
+		double normal[3];
+		double normalMoved[3];
+		triangleNormal( positions[0], positions[1], positions[2], normal );
+		triangleNormal( positionsMoved[0], positionsMoved[1], positionsMoved[2], normalMoved );
+		if( !( dot3( normal, normalMoved ) > 0.0 ) ) {
+			return( true );
+		}
+		// The moved face must not exist already:
+		for( uint64_t m=mAdjacencyOffset[rTo]; m<mAdjacencyOffset[rTo+1]; m++ ) {
+			const uint64_t* otherFace = &mFaces[3*mAdjacentFaces[m]];
+			if( ( std::count( otherFace, otherFace+3, otherVertices[0] ) > 0 ) &&
+			    ( std::count( otherFace, otherFace+3, otherVertices[1] ) > 0 ) ) {
+				return( true );
+			}
+		}
+	}
+	return( false );
+}
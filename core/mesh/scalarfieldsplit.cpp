@@ -0,0 +1,329 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/scalarfieldsplit.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include <GigaMesh/mesh/parallelfor.h>
+
+//! Splits the triangles by the given levels. The results are fetched by the getters.
+//!
+//! @returns false for invalid arguments e.g. vertex indices out of range. True otherwise.
+bool ScalarFieldSplit::split(
+                const std::vector<double>&        rVertexValues,        //!< Value of the field per vertex.
+                const std::vector<uint64_t>&      rFaceVertexIndices,   //!< Three vertex indices per triangle.
+                const std::vector<double>&        rLevels,              //!< Values of the level sets in any order.
+                bool                              rDuplicateVertices,   //!< Create separate vertices for both sides of each level.
+                const std::vector<unsigned char>* rFaceMask             //!< Optional: only triangles with non-zero flags are split.
+) {
+	mEdges.clear();
+	mEdgeFirstVertex.clear();
+	mDuplicated.clear();
+	mSplitFaces.clear();
+	mNewVertices.clear();
+	mNewFaces.clear();
+	mVertexNr = rVertexValues.size();
+	const uint64_t faceNr = rFaceVertexIndices.size() / 3;
+	if( ( rFaceVertexIndices.size() % 3 != 0 ) || ( ( rFaceMask != nullptr ) && ( rFaceMask->size() != faceNr ) ) ) {
+		return( false );
+	}
+	const uint64_t vertexNr = mVertexNr;
+	if( std::any_of( rFaceVertexIndices.begin(), rFaceVertexIndices.end(), [vertexNr]( uint64_t rVertIdx ) {
+	        return( rVertIdx >= vertexNr ); } ) ) {
+		return( false );
+	}
+	mLevels.clear();
+	std::copy_if( rLevels.begin(), rLevels.end(), std::back_inserter( mLevels ), []( double rLevel ) { return( std::isfinite( rLevel ) ); } );
+	std::sort( mLevels.begin(), mLevels.end() );
+	mLevels.erase( std::unique( mLevels.begin(), mLevels.end() ), mLevels.end() );
+	mValues    = rVertexValues.data();
+	mFaces     = rFaceVertexIndices.data();
+	mDuplicate = rDuplicateVertices;
+
+	// Classify the triangles:
+	std::vector<unsigned char> faceSplit( faceNr, 0 );
+	parallelFor( faceNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t faceIdx=rBegin; faceIdx<rEnd; faceIdx++ ) {
+			if( ( rFaceMask == nullptr ) || ( (*rFaceMask)[faceIdx] != 0 ) ) {
+				faceSplit[faceIdx] = isSplit( faceIdx ) ? 1 : 0;
+			}
+		}
+	} );
+	for( uint64_t faceIdx=0; faceIdx<faceNr; faceIdx++ ) {
+		if( faceSplit[faceIdx] != 0 ) {
+			mSplitFaces.push_back( faceIdx );
+		}
+	}
+
+	// Crossed edges and vertices on a level - each one once:
+	const unsigned int threadCount = getParallelThreadCount();
+	std::vector<std::vector<std::pair<uint64_t,uint64_t>>> threadEdges( threadCount );
+	std::vector<std::vector<uint64_t>> threadDuplicated( threadCount );
+	parallelFor( mSplitFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			const uint64_t* faceVertices = mFaces + 3*mSplitFaces[i];
+			for( unsigned int k=0; k<3; k++ ) {
+				const uint64_t vertA = faceVertices[k];
+				const uint64_t vertB = faceVertices[(k+1)%3];
+				if( getCrossings( mValues[vertA], mValues[vertB], nullptr ) > 0 ) {
+					threadEdges[rThreadIdx].emplace_back( std::min( vertA, vertB ), std::max( vertA, vertB ) );
+				}
+				if( mDuplicate && std::binary_search( mLevels.begin(), mLevels.end(), mValues[vertA] ) ) {
+					threadDuplicated[rThreadIdx].push_back( vertA );
+				}
+			}
+		}
+	}, 256 );
+	for( unsigned int t=0; t<threadCount; t++ ) {
+		mEdges.insert( mEdges.end(), threadEdges[t].begin(), threadEdges[t].end() );
+		mDuplicated.insert( mDuplicated.end(), threadDuplicated[t].begin(), threadDuplicated[t].end() );
+	}
+	std::sort( mEdges.begin(), mEdges.end() );
+	mEdges.erase( std::unique( mEdges.begin(), mEdges.end() ), mEdges.end() );
+	std::sort( mDuplicated.begin(), mDuplicated.end() );
+	mDuplicated.erase( std::unique( mDuplicated.begin(), mDuplicated.end() ), mDuplicated.end() );
+
+	// New vertices: the crossings of each edge are followed by the duplicates of the vertices on a level.
+	const uint64_t verticesPerCrossing = mDuplicate ? 2 : 1;
+	mEdgeFirstVertex.resize( mEdges.size() );
+	uint64_t newVertexNr = 0;
+	for( uint64_t edgeIdx=0; edgeIdx<mEdges.size(); edgeIdx++ ) {
+		mEdgeFirstVertex[edgeIdx] = mVertexNr + newVertexNr;
+		newVertexNr += verticesPerCrossing * getCrossings( mValues[mEdges[edgeIdx].first], mValues[mEdges[edgeIdx].second], nullptr );
+	}
+	mDuplicatedFirst = mVertexNr + newVertexNr;
+	mNewVertices.resize( newVertexNr + 2*mDuplicated.size() );
+	parallelFor( mEdges.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t edgeIdx=rBegin; edgeIdx<rEnd; edgeIdx++ ) {
+			const uint64_t vertA = mEdges[edgeIdx].first;
+			const uint64_t vertB = mEdges[edgeIdx].second;
+			uint64_t firstLevel = 0;
+			const uint64_t crossingNr = getCrossings( mValues[vertA], mValues[vertB], &firstLevel );
+			sNewVertex* newVertex = &mNewVertices[mEdgeFirstVertex[edgeIdx] - mVertexNr];
+			for( uint64_t i=0; i<crossingNr; i++ ) {
+				const double t = ( mLevels[firstLevel+i] - mValues[vertA] ) / ( mValues[vertB] - mValues[vertA] );
+				if( mDuplicate ) {
+					*(newVertex++) = sNewVertex{ vertA, vertB, t, -1 };
+					*(newVertex++) = sNewVertex{ vertA, vertB, t, +1 };
+				} else {
+					*(newVertex++) = sNewVertex{ vertA, vertB, t, 0 };
+				}
+			}
+		}
+	}, 1024 );
+	for( uint64_t i=0; i<mDuplicated.size(); i++ ) {
+		mNewVertices[newVertexNr + 2*i]   = sNewVertex{ mDuplicated[i], mDuplicated[i], 0.0, -1 };
+		mNewVertices[newVertexNr + 2*i+1] = sNewVertex{ mDuplicated[i], mDuplicated[i], 0.0, +1 };
+	}
+
+	// New triangles: counted first to place the triangles of each split triangle in order.
+	std::vector<uint64_t> newFaceOffset( mSplitFaces.size() + 1, 0 );
+	parallelFor( mSplitFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		std::vector<sBorderPoint> border;
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			collectBorder( mSplitFaces[i], border );
+			newFaceOffset[i+1] = triangulate( mSplitFaces[i], border, nullptr );
+		}
+	}, 256 );
+	for( uint64_t i=0; i<mSplitFaces.size(); i++ ) {
+		newFaceOffset[i+1] += newFaceOffset[i];
+	}
+	mNewFaces.resize( newFaceOffset.back() );
+	parallelFor( mSplitFaces.size(), [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		std::vector<sBorderPoint> border;
+		for( uint64_t i=rBegin; i<rEnd; i++ ) {
+			collectBorder( mSplitFaces[i], border );
+			triangulate( mSplitFaces[i], border, &mNewFaces[newFaceOffset[i]] );
+		}
+	}, 256 );
+
+	mValues = nullptr;
+	mFaces  = nullptr;
+	return( true );
+}
+
+//! @returns the number of input vertices. Vertex indices of new triangles above refer to getNewVertices.
+uint64_t ScalarFieldSplit::getVertexNr() const {
+	return( mVertexNr );
+}
+
+//! @returns the indices of the split triangles in increasing order, which are replaced by getNewFaces.
+const std::vector<uint64_t>& ScalarFieldSplit::getSplitFaces() const {
+	return( mSplitFaces );
+}
+
+//! @returns the new vertices. Their index is the position within this vector plus getVertexNr.
+const std::vector<ScalarFieldSplit::sNewVertex>& ScalarFieldSplit::getNewVertices() const {
+	return( mNewVertices );
+}
+
+//! @returns the new triangles ordered by the index of the split triangle.
+const std::vector<ScalarFieldSplit::sNewFace>& ScalarFieldSplit::getNewFaces() const {
+	return( mNewFaces );
+}
+
+//! @returns the number of levels strictly between the two values.
+uint64_t ScalarFieldSplit::getCrossings(
+                double    rValA,        //!< Value at the start of the edge.
+                double    rValB,        //!< Value at the end of the edge.
+                uint64_t* rFirstLevel   //!< Optional output: index of the lowest crossed level.
+) const {
+	// False for not-a-number:
+	if( !( rValA != rValB ) ) {
+		return( 0 );
+	}
+	const uint64_t levelLow  = std::upper_bound( mLevels.begin(), mLevels.end(), std::min( rValA, rValB ) ) - mLevels.begin();
+	const uint64_t levelHigh = std::lower_bound( mLevels.begin(), mLevels.end(), std::max( rValA, rValB ) ) - mLevels.begin();
+	if( rFirstLevel != nullptr ) {
+		*rFirstLevel = levelLow;
+	}
+	return( levelHigh > levelLow ? levelHigh - levelLow : 0 );
+}
+
+//! @returns true, when an edge of the triangle strictly crosses a level.
+bool ScalarFieldSplit::isSplit( uint64_t rFaceIdx ) const {
+	const uint64_t* faceVertices = mFaces + 3*rFaceIdx;
+	for( unsigned int k=0; k<3; k++ ) {
+		const double value = mValues[faceVertices[k]];
+		if( std::isnan( value ) ) {
+			return( false );
+		}
+	}
+	for( unsigned int k=0; k<3; k++ ) {
+		if( getCrossings( mValues[faceVertices[k]], mValues[faceVertices[(k+1)%3]], nullptr ) > 0 ) {
+			return( true );
+		}
+	}
+	return( false );
+}
+
+//! @returns the index of the first new vertex of the given crossed edge with rVertA < rVertB.
+uint64_t ScalarFieldSplit::findEdge( uint64_t rVertA, uint64_t rVertB ) const {
+	const auto itEdge = std::lower_bound( mEdges.begin(), mEdges.end(), std::make_pair( rVertA, rVertB ) );
+	return( mEdgeFirstVertex[itEdge - mEdges.begin()] );
+}
+
+//! @returns the index of the first new vertex duplicating the given vertex on a level.
+uint64_t ScalarFieldSplit::findDuplicate( uint64_t rVertIdx ) const {
+	const auto itVertex = std::lower_bound( mDuplicated.begin(), mDuplicated.end(), rVertIdx );
+	return( mDuplicatedFirst + 2 * static_cast<uint64_t>( itVertex - mDuplicated.begin() ) );
+}
+
+//! Points along the border of a split triangle in the order of its corners i.e. the corners
+//! and the crossings of the levels in between.
+void ScalarFieldSplit::collectBorder( uint64_t rFaceIdx, std::vector<sBorderPoint>& rBorder ) const {
+	rBorder.clear();
+	const uint64_t* faceVertices = mFaces + 3*rFaceIdx;
+	for( unsigned char corner=0; corner<3; corner++ ) {
+		const unsigned char cornerNext = ( corner + 1 ) % 3;
+		const uint64_t vertIdx = faceVertices[corner];
+		const double   value   = mValues[vertIdx];
+		sBorderPoint cornerPoint{ value, -1, vertIdx, vertIdx, corner, corner, 0.0 };
+		const auto itLevel = std::lower_bound( mLevels.begin(), mLevels.end(), value );
+		if( ( itLevel != mLevels.end() ) && ( *itLevel == value ) ) {
+			cornerPoint.mLevelIdx = itLevel - mLevels.begin();
+			if( mDuplicate ) {
+				cornerPoint.mVertIdx   = findDuplicate( vertIdx );
+				cornerPoint.mVertIdxUp = cornerPoint.mVertIdx + 1;
+			}
+		}
+		rBorder.push_back( cornerPoint );
+
+		const uint64_t vertIdxNext = faceVertices[cornerNext];
+		const double   valueNext   = mValues[vertIdxNext];
+		uint64_t firstLevel = 0;
+		const uint64_t crossingNr = getCrossings( value, valueNext, &firstLevel );
+		if( crossingNr == 0 ) {
+			continue;
+		}
+		const uint64_t firstVertex = findEdge( std::min( vertIdx, vertIdxNext ), std::max( vertIdx, vertIdxNext ) );
+		const uint64_t verticesPerCrossing = mDuplicate ? 2 : 1;
+		for( uint64_t i=0; i<crossingNr; i++ ) {
+			// Levels in the direction of the edge:
+			const uint64_t crossingIdx = ( value < valueNext ) ? i : crossingNr - 1 - i;
+			const double   level       = mLevels[firstLevel+crossingIdx];
+			const uint64_t newVertIdx  = firstVertex + verticesPerCrossing * crossingIdx;
+			rBorder.push_back( sBorderPoint{ level, static_cast<int64_t>( firstLevel+crossingIdx ), newVertIdx,
+			                                 newVertIdx + verticesPerCrossing - 1, corner, cornerNext,
+			                                 ( level - value ) / ( valueNext - value ) } );
+		}
+	}
+}
+
+//! Triangulates the parts of a split triangle between consecutive levels.
+//!
+//! @returns the number of new triangles, which are written to rNewFaces unless it is nullptr.
+uint64_t ScalarFieldSplit::triangulate( uint64_t rFaceIdx, const std::vector<sBorderPoint>& rBorder, sNewFace* rNewFaces ) const {
+	double valueMin = rBorder.front().mValue;
+	double valueMax = rBorder.front().mValue;
+	for( const sBorderPoint& point : rBorder ) {
+		valueMin = std::min( valueMin, point.mValue );
+		valueMax = std::max( valueMax, point.mValue );
+	}
+	// Parts with an area between levels slabFirst-1 and slabFirst up to slabLast-1 and slabLast:
+	const int64_t slabFirst = std::upper_bound( mLevels.begin(), mLevels.end(), valueMin ) - mLevels.begin();
+	const int64_t slabLast  = std::lower_bound( mLevels.begin(), mLevels.end(), valueMax ) - mLevels.begin();
+	uint64_t newFaceNr = 0;
+	std::vector<std::pair<const sBorderPoint*,uint64_t>> polygon;
+	polygon.reserve( rBorder.size() );
+	for( int64_t slabIdx=slabFirst; slabIdx<=slabLast; slabIdx++ ) {
+		polygon.clear();
+		bool onSingleLevel = true;
+		for( const sBorderPoint& point : rBorder ) {
+			if( point.mLevelIdx < 0 ) {
+				if( std::lower_bound( mLevels.begin(), mLevels.end(), point.mValue ) - mLevels.begin() != slabIdx ) {
+					continue;
+				}
+				polygon.emplace_back( &point, point.mVertIdx );
+			} else if( point.mLevelIdx == slabIdx - 1 ) {
+				polygon.emplace_back( &point, point.mVertIdxUp );
+			} else if( point.mLevelIdx == slabIdx ) {
+				polygon.emplace_back( &point, point.mVertIdx );
+			} else {
+				continue;
+			}
+			onSingleLevel &= ( point.mLevelIdx >= 0 ) && ( point.mLevelIdx == polygon.front().first->mLevelIdx );
+		}
+		if( ( polygon.size() < 3 ) || onSingleLevel ) {
+			continue;
+		}
+		// Fan of the convex polygon:
+		for( uint64_t i=1; i+1<polygon.size(); i++ ) {
+			if( rNewFaces != nullptr ) {
+				sNewFace& newFace = rNewFaces[newFaceNr];
+				newFace.mFaceIdx = rFaceIdx;
+				const std::pair<const sBorderPoint*,uint64_t>* corners[3] = { &polygon[0], &polygon[i], &polygon[i+1] };
+				for( unsigned int k=0; k<3; k++ ) {
+					newFace.mVertIdx[k]    = corners[k]->second;
+					newFace.mCornerFrom[k] = corners[k]->first->mCornerFrom;
+					newFace.mCornerTo[k]   = corners[k]->first->mCornerTo;
+					newFace.mCornerT[k]    = corners[k]->first->mT;
+				}
+			}
+			newFaceNr++;
+		}
+	}
+	return( newFaceNr );
+}
@@ -61,6 +61,7 @@
 	mIdxOri( _PRIMITIVE_NOT_INDEXED_ ), \
 	mLabelNr( 0 ),                      \
 	mFeatureVecLen( 0 ),                \
+	mFeatureVecView( false ),           \
 	mFeatureVec( NULL )                 \
 
 using namespace std;
@@ -101,8 +102,8 @@ Vertex::Vertex( const int rSetIdx, const sVertexProperties& rSetProps )
 	TEX_ALPHA = rSetProps.mColorAlp;
 	// Labels
 	mLabelNr  =  rSetProps.mLabelId;
-	// Flags - BEFORE NORMALS!
-	setFlagAll( rSetProps.mFlags );
+	// Flags - BEFORE NORMALS! FLAG_REMOVED is reserved for Mesh::editCommit and must never be taken from a file.
+	setFlagAll( rSetProps.mFlags & ~static_cast<uint64_t>( FLAG_REMOVED ) );
 	// Normals
 	clearFlag( FLAG_NORMAL_SET );
 	setNormal( rSetProps.mNormalX, rSetProps.mNormalY, rSetProps.mNormalZ );
@@ -235,11 +236,7 @@ Vertex::~Vertex() {
 	//!
 	//! This is done just in case we referer to an object still in the memory,
 	//! which is already destroyed.
-	if( mFeatureVec != nullptr ) {
-		delete[] mFeatureVec;
-		mFeatureVecLen = 0;
-		mFeatureVec    = nullptr;
-	}
+	freeFeatureVec();
 }
 
 // Indexing -------------------------------------------------------------------
@@ -593,7 +590,7 @@ bool Vertex::copyVertexPropsTo( sVertexProperties& rVertexProps ) const {
 	if( !getFlagAll( &vertFlag ) ) {
 		return( false );
 	}
-	rVertexProps.mFlags = vertFlag;
+	rVertexProps.mFlags = vertFlag & ~static_cast<uint64_t>( FLAG_REMOVED );
 	return( true );
 }
 
@@ -607,6 +604,16 @@ bool Vertex::estNormalAvgAdjacentFaces() {
 	return( false );
 }
 
+//! Estimate normal with given weights for the adjacent faces - see VertexOfFace.
+//!
+//! @returns false as there is no adjacency.
+bool Vertex::estNormalAvgAdjacentFaces(
+                [[maybe_unused]] eNormalWeighting rWeighting,
+                [[maybe_unused]] uint64_t&        rFacesInvalid
+) {
+	return( false );
+}
+
 //! Set normal vector for this vertex.
 //! Checks if the given vector is valid i.e. a normal number.
 //! In case of an abnormal number the normal will not be altered.
@@ -993,6 +1000,13 @@ bool Vertex::applyTransfrom( Matrix4D* transMat ) {
 	return( true );
 }
 
+//! Same as Vertex::applyTransfrom for an affine transformation, but without
+//! the detour via Vector3D and the full 4x4 matrix.
+void Vertex::applyAffineTransform( const AffineTransform3x4<double>& rTrans ) {
+	rTrans.applyToPoint( mPosition );
+	rTrans.applyToDirection( mNormalXYZ );
+}
+
 bool Vertex::applyMeltingSphere( double rRadius, double rRel ) {
 	//! Applies melting with sqrt(r^2-x^2-y^2).
 	//! Returns false, when the application fails, when
@@ -1565,11 +1579,7 @@ bool Vertex::assignFeatureVec(const double*         rAttachFeatureVec,
 		return false;
 	}
 	// Erase existing vector:
-	if( mFeatureVec != nullptr ) {
-		delete[] mFeatureVec;
-		mFeatureVec = nullptr;
-		mFeatureVecLen = 0;
-	}
+	freeFeatureVec();
 	// Nothing to do - empty vector.
 	if( rSetFeatureVecLen <= 0 ) {
 		return true;
@@ -1592,12 +1602,7 @@ bool Vertex::assignFeatureVec(const std::initializer_list<double> featureVectorV
 
 	// Erase existing vector:
 
-	if(mFeatureVec != nullptr)
-	{
-		delete[] mFeatureVec;
-		mFeatureVec = nullptr;
-		mFeatureVecLen = 0;
-	}
+	freeFeatureVec();
 
 	// Nothing to do - empty vector.
 
@@ -2121,7 +2126,49 @@ void Vertex::resizeFeatureVector(unsigned int size)
 		mFeatureVec[i] = i < oldlen ? oldVec[i] : _NOT_A_NUMBER_DBL_;
 	}
 
-	delete[] oldVec;
+	// A row of the mesh's store is left untouched.
+	if( !mFeatureVecView ) {
+		delete[] oldVec;
+	}
+	mFeatureVecView = false;
+}
+
+//! Uses the given memory e.g. a row of the mesh's FeatureVecStore as feature vector.
+//! The memory is not copied and not freed by the Vertex, so it has to stay valid
+//! until another feature vector is assigned or the Vertex is destroyed.
+//!
+//! @returns false in case of an error. True otherwise.
+bool Vertex::setFeatureVecView(
+                double*      rFeatureVec,     //!< Memory holding rFeatureVecLen elements.
+                unsigned int rFeatureVecLen   //!< Number of elements.
+) {
+	if( ( rFeatureVec == nullptr ) && ( rFeatureVecLen > 0 ) ) {
+		LOG::error() << "[Vertex::" << __FUNCTION__ << "] ERROR: NULL pointer given, while length > 0!\n";
+		return( false );
+	}
+	freeFeatureVec();
+	if( rFeatureVecLen == 0 ) {
+		return( true );
+	}
+	mFeatureVec     = rFeatureVec;
+	mFeatureVecLen  = rFeatureVecLen;
+	mFeatureVecView = true;
+	return( true );
+}
+
+//! @returns true, when the feature vector is a view of the given memory.
+bool Vertex::isFeatureVecViewOf( const double* rFeatureVec ) const {
+	return( mFeatureVecView && ( mFeatureVec == rFeatureVec ) );
+}
+
+//! Removes the feature vector. Memory is only freed, when owned by the Vertex.
+void Vertex::freeFeatureVec() {
+	if( ( mFeatureVec != nullptr ) && !mFeatureVecView ) {
+		delete[] mFeatureVec;
+	}
+	mFeatureVec     = nullptr;
+	mFeatureVecLen  = 0;
+	mFeatureVecView = false;
 }
 
 
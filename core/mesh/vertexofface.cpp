@@ -69,43 +69,75 @@ VertexOfFace::~VertexOfFace() {
 }
 
 //! Estimates the average normal of the adjacent faces and stores them into
-//! the vertice's normal vector.
-//! This function displays an error on the console in case degenerated faces are encountered.
+//! the vertice's normal vector using area and angle as weights.
+//! This function displays a warning on the console in case degenerated faces are encountered.
 //! These are typically faces having an area of zero.
 //!
 //! @returns false in case of an error - e.g. no adjacent faces or an invalid normal. True otherwise.
 bool VertexOfFace::estNormalAvgAdjacentFaces() {
+	uint64_t facesInvalid = 0;
+	bool retVal = estNormalAvgAdjacentFaces( NORMAL_WEIGHT_AREA_ANGLE, facesInvalid );
+	if( facesInvalid > 0 ) {
+		LOG::warn() << "[VertexOfFace::" << __FUNCTION__ << "] ERROR: No valid normal for " << facesInvalid << " adjacent faces of vertex No. " << getIndex() << "!\n";
+		LOG::warn() << "[VertexOfFace::" << __FUNCTION__ << "]        Check for zero-area faces!\n";
+	}
+	return( retVal );
+}
+
+//! Estimates the weighted average normal of the adjacent faces and stores
+//! it into the vertice's normal vector.
+//!
+//! Only the normals of the adjacent faces are read i.e. gathered, which
+//! allows to call this method for different vertices in parallel, when
+//! the face normals are up-to-date. Degenerated faces are neglected and
+//! counted silently, so that the caller can report them once.
+//!
+//! @returns false in case of an error - e.g. no adjacent faces or an invalid normal. True otherwise.
+bool VertexOfFace::estNormalAvgAdjacentFaces(
+                eNormalWeighting rWeighting,     //!< Weights: area and/or angle at this vertex.
+                uint64_t&        rFacesInvalid   //!< Increased by the number of adjacent faces without valid normal.
+) {
 	// We can stop if it is a solo vertex.
 	if( mAdjacentFacesNr == 0 ) {
 		unsetNormal();
 		return( false );
 	}
 	// Compute a weigthed average:
-	Vector3D faceNormal;
+	double normalSum[3] = { 0.0, 0.0, 0.0 };
 	for( int i=0; i<mAdjacentFacesNr; ++i ) {
-		// We use the area of the face as weight by using getNormal( false )
-		Vector3D adjacentFaceNormal = mAdjacentFaces[i]->getNormal( false );
+		Face* adjacentFace = mAdjacentFaces[i];
+		// The length of the face normal is twice its area:
+		double faceNormal[3] = { adjacentFace->getNormalX(), adjacentFace->getNormalY(), adjacentFace->getNormalZ() };
+		const double faceNormalLen = sqrt( faceNormal[0]*faceNormal[0] + faceNormal[1]*faceNormal[1] + faceNormal[2]*faceNormal[2] );
 		// Neglect degenerated faces:
-		if( !isnormal( adjacentFaceNormal.getLength3() ) ) {
-			LOG::warn() << "[VertexOfFace::" << __FUNCTION__ << "] ERROR: No valid normal for face No. " << mAdjacentFaces[i]->getIndex() << "!\n";
-			LOG::warn() << "[VertexOfFace::" << __FUNCTION__ << "]        adjacentFaceNormal: " << adjacentFaceNormal << "\n";
-			LOG::warn() << "[VertexOfFace::" << __FUNCTION__ << "]        Check for zero-area faces!\n";
+		if( !isnormal( faceNormalLen ) ) {
+			rFacesInvalid++;
 			continue;
 		}
-		// We apply a counterweight using the angle of the face for this vertex.
-		double angleAtThisVertex = mAdjacentFaces[i]->getAngleAtVertex( this );
-		faceNormal += adjacentFaceNormal * angleAtThisVertex;
+		double weight = 1.0;
+		switch( rWeighting ) {
+			case NORMAL_WEIGHT_AREA_ANGLE:
+				weight = adjacentFace->getAngleAtVertex( this );
+				break;
+			case NORMAL_WEIGHT_AREA:
+				break;
+			case NORMAL_WEIGHT_ANGLE:
+				weight = adjacentFace->getAngleAtVertex( this ) / faceNormalLen;
+				break;
+		}
+		normalSum[0] += faceNormal[0] * weight;
+		normalSum[1] += faceNormal[1] * weight;
+		normalSum[2] += faceNormal[2] * weight;
 	}
 	// Invalid normal
-	if( !isnormal( faceNormal.getLength3() ) ) {
-		// This error will be shown often for defective meshs - to be treated by calling method:
-		// cerr << "[VertexOfFace::" << __FUNCTION__ << "] ERROR: no valid normal set for Vertex " << this->getIndex() << " !" << endl;
+	const double normalLen = sqrt( normalSum[0]*normalSum[0] + normalSum[1]*normalSum[1] + normalSum[2]*normalSum[2] );
+	if( !isnormal( normalLen ) ) {
+		// This error will be shown often for defective meshs - to be treated by calling method.
 		unsetNormal();
 		return( false );
 	}
 	// Final step: normalize the valid normal vector.
-	faceNormal.normalize3();
-	if( !setNormal( faceNormal.getX(), faceNormal.getY(), faceNormal.getZ() ) ) {
+	if( !setNormal( normalSum[0]/normalLen, normalSum[1]/normalLen, normalSum[2]/normalLen ) ) {
 		LOG::warn() << "[VertexOfFace::" << __FUNCTION__ << "] ERROR: setNormal failed!\n";
 		return( false );
 	}
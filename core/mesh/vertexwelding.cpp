@@ -0,0 +1,383 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <GigaMesh/mesh/vertexwelding.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <GigaMesh/mesh/parallelfor.h>
+
+//! Hash of the integer coordinates of a cell - see splitmix64.
+static inline uint64_t hashCell( const int64_t rX, const int64_t rY, const int64_t rZ ) {
+	uint64_t hash = static_cast<uint64_t>( rX ) * 0x9E3779B97F4A7C15ULL;
+	hash ^= static_cast<uint64_t>( rY ) + 0x632BE59BD9B4E019ULL + ( hash << 6 ) + ( hash >> 2 );
+	hash ^= static_cast<uint64_t>( rZ ) + 0x85157AF5ULL + ( hash << 6 ) + ( hash >> 2 );
+	hash ^= hash >> 30;
+	hash *= 0xBF58476D1CE4E5B9ULL;
+	hash ^= hash >> 27;
+	hash *= 0x94D049BB133111EBULL;
+	hash ^= hash >> 31;
+	return( hash );
+}
+
+//! Integer coordinate of the cell of the given coordinate. Zero for not-a-number.
+static inline int64_t getCellCoord( const double rCoord, const double rCellSize ) {
+	const double cell = std::floor( rCoord / rCellSize );
+	if( !( std::abs( cell ) < 9.0e18 ) ) {
+		return( std::isnan( cell ) ? 0 : ( cell > 0.0 ? INT64_MAX : INT64_MIN ) );
+	}
+	return( static_cast<int64_t>( cell ) );
+}
+
+//! Bit pattern of a coordinate, where -0.0 and 0.0 are equal.
+static inline int64_t getCoordBits( const double rCoord ) {
+	const double coord = ( rCoord == 0.0 ) ? 0.0 : rCoord;
+	int64_t bits = 0;
+	std::memcpy( &bits, &coord, sizeof( bits ) );
+	return( bits );
+}
+
+//! Sorts blocks in parallel, which are merged pairwise in parallel.
+static void sortParallel( std::vector<std::pair<uint64_t,uint64_t>>& rEntries ) {
+	const uint64_t count   = rEntries.size();
+	const uint64_t blockNr = getParallelThreadCount();
+	if( ( blockNr <= 1 ) || ( count < 16384 ) ) {
+		std::sort( rEntries.begin(), rEntries.end() );
+		return;
+	}
+	const uint64_t blockSize = ( count + blockNr - 1 ) / blockNr;
+	auto entryAt = [&rEntries, count]( uint64_t rPos ) {
+		return( rEntries.begin() + static_cast<int64_t>( std::min( rPos, count ) ) );
+	};
+	parallelFor( blockNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t blockIdx=rBegin; blockIdx<rEnd; blockIdx++ ) {
+			std::sort( entryAt( blockIdx*blockSize ), entryAt( ( blockIdx+1 )*blockSize ) );
+		}
+	}, 1 );
+	for( uint64_t width=blockSize; width<count; width*=2 ) {
+		const uint64_t pairNr = ( count + 2*width - 1 ) / ( 2*width );
+		parallelFor( pairNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+			for( uint64_t pairIdx=rBegin; pairIdx<rEnd; pairIdx++ ) {
+				const uint64_t first = pairIdx * 2 * width;
+				std::inplace_merge( entryAt( first ), entryAt( first + width ), entryAt( first + 2*width ) );
+			}
+		}, 1 );
+	}
+}
+
+//! Finds the clusters of vertices within the given distance.
+//!
+//! @returns false in case of an error e.g. a negative tolerance. True otherwise.
+bool VertexWelding::weld(
+                const std::vector<double>& rVertexCoords,   //!< Coordinates x, y and z of all vertices.
+                double                     rTolerance       //!< Maximum distance of vertices to be welded. Zero for identical coordinates.
+) {
+	mVertexMap.clear();
+	mClusterOffsets.assign( 1, 0 );
+	mClusterMembers.clear();
+	if( ( rVertexCoords.size() % 3 != 0 ) || !( rTolerance >= 0.0 ) || std::isinf( rTolerance ) ) {
+		return( false );
+	}
+	const uint64_t vertexNr  = rVertexCoords.size() / 3;
+	const bool     exact     = ( rTolerance == 0.0 );
+	const double   toleranceSqr = rTolerance * rTolerance;
+	const double*  coords    = rVertexCoords.data();
+
+	// Cell of each vertex: the bit patterns of the coordinates, when only identical coordinates are welded.
+	auto getCell = [&]( uint64_t rVertIdx, int64_t* rCell ) {
+		for( unsigned int k=0; k<3; k++ ) {
+			rCell[k] = exact ? getCoordBits( coords[rVertIdx*3+k] ) : getCellCoord( coords[rVertIdx*3+k], rTolerance );
+		}
+	};
+	std::vector<std::pair<uint64_t,uint64_t>> entries( vertexNr );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		int64_t cell[3];
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			getCell( vertIdx, cell );
+			entries[vertIdx] = std::make_pair( hashCell( cell[0], cell[1], cell[2] ), vertIdx );
+		}
+	} );
+	sortParallel( entries );
+
+	// Open addressing table of the occupied cells referring to their range of entries.
+	uint64_t tableSize = 16;
+	while( tableSize < 2 * vertexNr ) {
+		tableSize *= 2;
+	}
+	const uint64_t tableMask = tableSize - 1;
+	std::vector<uint64_t> tableKeys( tableSize, 0 );
+	std::vector<uint64_t> tableFirst( tableSize, 0 );
+	std::vector<uint64_t> tableCount( tableSize, 0 );
+	for( uint64_t entryIdx=0; entryIdx<vertexNr; ) {
+		const uint64_t key = entries[entryIdx].first;
+		uint64_t entryEnd = entryIdx + 1;
+		while( ( entryEnd < vertexNr ) && ( entries[entryEnd].first == key ) ) {
+			entryEnd++;
+		}
+		uint64_t slot = key & tableMask;
+		while( tableCount[slot] > 0 ) {
+			slot = ( slot + 1 ) & tableMask;
+		}
+		tableKeys[slot]  = key;
+		tableFirst[slot] = entryIdx;
+		tableCount[slot] = entryEnd - entryIdx;
+		entryIdx = entryEnd;
+	}
+
+	// Pairs of close vertices linking each vertex to vertices with a lower index.
+	const int neighbourRange = exact ? 0 : 1;
+	std::vector<std::vector<std::pair<uint64_t,uint64_t>>> links( getParallelThreadCount() );
+	parallelFor( vertexNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int rThreadIdx ) {
+		std::vector<std::pair<uint64_t,uint64_t>>& threadLinks = links[rThreadIdx];
+		int64_t cell[3];
+		for( uint64_t vertIdx=rBegin; vertIdx<rEnd; vertIdx++ ) {
+			const double* position = coords + vertIdx*3;
+			getCell( vertIdx, cell );
+			uint64_t closestIdx = vertIdx;
+			for( int dx=-neighbourRange; dx<=neighbourRange; dx++ ) {
+				for( int dy=-neighbourRange; dy<=neighbourRange; dy++ ) {
+					for( int dz=-neighbourRange; dz<=neighbourRange; dz++ ) {
+						const uint64_t key = hashCell( cell[0]+dx, cell[1]+dy, cell[2]+dz );
+						uint64_t slot = key & tableMask;
+						while( ( tableCount[slot] > 0 ) && ( tableKeys[slot] != key ) ) {
+							slot = ( slot + 1 ) & tableMask;
+						}
+						const uint64_t entryEnd = tableFirst[slot] + tableCount[slot];
+						for( uint64_t entryIdx=tableFirst[slot]; entryIdx<entryEnd; entryIdx++ ) {
+							const uint64_t otherIdx = entries[entryIdx].second;
+							if( otherIdx >= vertIdx ) {
+								break; // sorted by index within a cell.
+							}
+							const double* positionOther = coords + otherIdx*3;
+							if( exact ) {
+								// Equality is transitive, so the link to the lowest index is sufficient.
+								if( ( position[0] == positionOther[0] ) && ( position[1] == positionOther[1] ) &&
+								    ( position[2] == positionOther[2] ) ) {
+									closestIdx = std::min( closestIdx, otherIdx );
+								}
+								continue;
+							}
+							const double diffX = position[0] - positionOther[0];
+							const double diffY = position[1] - positionOther[1];
+							const double diffZ = position[2] - positionOther[2];
+							if( diffX*diffX + diffY*diffY + diffZ*diffZ <= toleranceSqr ) {
+								threadLinks.emplace_back( vertIdx, otherIdx );
+							}
+						}
+					}
+				}
+			}
+			if( closestIdx < vertIdx ) {
+				threadLinks.emplace_back( vertIdx, closestIdx );
+			}
+		}
+	} );
+
+	// Union-find, where the root is always the lowest index i.e. parents have lower indices.
+	std::vector<uint64_t> parent( vertexNr );
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		parent[vertIdx] = vertIdx;
+	}
+	auto findRoot = [&parent]( uint64_t rVertIdx ) {
+		while( parent[rVertIdx] != rVertIdx ) {
+			parent[rVertIdx] = parent[parent[rVertIdx]];
+			rVertIdx = parent[rVertIdx];
+		}
+		return( rVertIdx );
+	};
+	for( const auto& threadLinks : links ) {
+		for( const auto& link : threadLinks ) {
+			const uint64_t rootA = findRoot( link.first );
+			const uint64_t rootB = findRoot( link.second );
+			if( rootA != rootB ) {
+				parent[std::max( rootA, rootB )] = std::min( rootA, rootB );
+			}
+		}
+	}
+
+	// Welded vertices in the order of their representatives and their members.
+	mVertexMap.resize( vertexNr );
+	uint64_t weldedNr = 0;
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		if( parent[vertIdx] == vertIdx ) {
+			mVertexMap[vertIdx] = weldedNr++;
+		} else {
+			parent[vertIdx] = parent[parent[vertIdx]]; // the parent is already a root.
+			mVertexMap[vertIdx] = mVertexMap[parent[vertIdx]];
+		}
+	}
+	mClusterOffsets.assign( weldedNr + 1, 0 );
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		mClusterOffsets[mVertexMap[vertIdx]+1]++;
+	}
+	for( uint64_t weldedIdx=0; weldedIdx<weldedNr; weldedIdx++ ) {
+		mClusterOffsets[weldedIdx+1] += mClusterOffsets[weldedIdx];
+	}
+	mClusterMembers.resize( vertexNr );
+	std::vector<uint64_t> fillPos( mClusterOffsets.begin(), mClusterOffsets.end() - 1 );
+	for( uint64_t vertIdx=0; vertIdx<vertexNr; vertIdx++ ) {
+		mClusterMembers[fillPos[mVertexMap[vertIdx]]++] = vertIdx;
+	}
+	return( true );
+}
+
+//! @returns the number of vertices after welding.
+uint64_t VertexWelding::getVertexNr() const {
+	return( mClusterOffsets.size() - 1 );
+}
+
+//! @returns the number of vertices removed by welding.
+uint64_t VertexWelding::getMergedNr() const {
+	return( mVertexMap.size() - getVertexNr() );
+}
+
+//! @returns the index of the welded vertex for each vertex.
+const std::vector<uint64_t>& VertexWelding::getVertexMap() const {
+	return( mVertexMap );
+}
+
+//! @returns the range of the members of each welded vertex within getClusterMembers.
+const std::vector<uint64_t>& VertexWelding::getClusterOffsets() const {
+	return( mClusterOffsets );
+}
+
+//! @returns the vertices of each welded vertex in ascending order i.e. starting with the representative.
+const std::vector<uint64_t>& VertexWelding::getClusterMembers() const {
+	return( mClusterMembers );
+}
+
+//! Properties of the welded vertices according to the given policy. The mean normal is normalized.
+//! Function values being not-a-number are ignored for the mean.
+//!
+//! @returns false, when the number of properties does not match the number of vertices of VertexWelding::weld. True otherwise.
+bool VertexWelding::mergeVertexProps(
+                const std::vector<sVertexProperties>& rVertexProps,   //!< Properties of the vertices given to weld.
+                eAttributePolicy                      rPolicy,        //!< Policy for the attributes.
+                std::vector<sVertexProperties>&       rWeldedProps    //!< Output: properties of the welded vertices.
+) const {
+	if( rVertexProps.size() != mVertexMap.size() ) {
+		return( false );
+	}
+	const uint64_t weldedNr = getVertexNr();
+	rWeldedProps.resize( weldedNr );
+	parallelFor( weldedNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t weldedIdx=rBegin; weldedIdx<rEnd; weldedIdx++ ) {
+			const uint64_t memberFirst = mClusterOffsets[weldedIdx];
+			const uint64_t memberEnd   = mClusterOffsets[weldedIdx+1];
+			sVertexProperties& weldedProps = rWeldedProps[weldedIdx];
+			weldedProps = rVertexProps[mClusterMembers[memberFirst]];
+			if( ( rPolicy == ATTRIBUTES_FIRST ) || ( memberEnd - memberFirst == 1 ) ) {
+				continue;
+			}
+			double   coords[3]  = { 0.0, 0.0, 0.0 };
+			double   normal[3]  = { 0.0, 0.0, 0.0 };
+			uint64_t color[4]   = { 0, 0, 0, 0 };
+			double   funcValSum = 0.0;
+			uint64_t normalNr   = 0;
+			uint64_t funcValNr  = 0;
+			for( uint64_t memberPos=memberFirst; memberPos<memberEnd; memberPos++ ) {
+				const sVertexProperties& props = rVertexProps[mClusterMembers[memberPos]];
+				coords[0] += props.mCoordX;
+				coords[1] += props.mCoordY;
+				coords[2] += props.mCoordZ;
+				if( !std::isnan( props.mNormalX ) && !std::isnan( props.mNormalY ) && !std::isnan( props.mNormalZ ) ) {
+					normal[0] += props.mNormalX;
+					normal[1] += props.mNormalY;
+					normal[2] += props.mNormalZ;
+					normalNr++;
+				}
+				if( !std::isnan( props.mFuncVal ) ) {
+					funcValSum += props.mFuncVal;
+					funcValNr++;
+				}
+				color[0] += props.mColorRed;
+				color[1] += props.mColorGrn;
+				color[2] += props.mColorBle;
+				color[3] += props.mColorAlp;
+			}
+			const uint64_t memberNr = memberEnd - memberFirst;
+			weldedProps.mCoordX = coords[0] / static_cast<double>( memberNr );
+			weldedProps.mCoordY = coords[1] / static_cast<double>( memberNr );
+			weldedProps.mCoordZ = coords[2] / static_cast<double>( memberNr );
+			const double normalLen = std::sqrt( normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2] );
+			if( ( normalNr > 0 ) && ( normalLen > 0.0 ) ) {
+				weldedProps.mNormalX = normal[0] / normalLen;
+				weldedProps.mNormalY = normal[1] / normalLen;
+				weldedProps.mNormalZ = normal[2] / normalLen;
+			}
+			if( funcValNr > 0 ) {
+				weldedProps.mFuncVal = funcValSum / static_cast<double>( funcValNr );
+			}
+			weldedProps.mColorRed = static_cast<unsigned char>( ( color[0] + memberNr/2 ) / memberNr );
+			weldedProps.mColorGrn = static_cast<unsigned char>( ( color[1] + memberNr/2 ) / memberNr );
+			weldedProps.mColorBle = static_cast<unsigned char>( ( color[2] + memberNr/2 ) / memberNr );
+			weldedProps.mColorAlp = static_cast<unsigned char>( ( color[3] + memberNr/2 ) / memberNr );
+		}
+	} );
+	return( true );
+}
+
+//! Rows of a row-major matrix e.g. feature vectors for the welded vertices according to the given policy.
+//! Elements being not-a-number are ignored for the mean.
+//!
+//! @returns false, when the number of rows does not match the number of vertices of VertexWelding::weld. True otherwise.
+bool VertexWelding::mergeRows(
+                const std::vector<double>& rRows,         //!< Row-major matrix with one row per vertex given to weld.
+                uint64_t                   rRowLen,       //!< Number of elements per row.
+                eAttributePolicy           rPolicy,       //!< Policy for the attributes.
+                std::vector<double>&       rWeldedRows    //!< Output: one row per welded vertex.
+) const {
+	if( ( rRowLen == 0 ) || ( rRows.size() != mVertexMap.size() * rRowLen ) ) {
+		return( false );
+	}
+	const uint64_t weldedNr = getVertexNr();
+	rWeldedRows.resize( weldedNr * rRowLen );
+	parallelFor( weldedNr, [&]( uint64_t rBegin, uint64_t rEnd, unsigned int ) {
+		for( uint64_t weldedIdx=rBegin; weldedIdx<rEnd; weldedIdx++ ) {
+			const uint64_t memberFirst = mClusterOffsets[weldedIdx];
+			const uint64_t memberEnd   = mClusterOffsets[weldedIdx+1];
+			double*        weldedRow   = rWeldedRows.data() + weldedIdx*rRowLen;
+			const double*  rowFirst    = rRows.data() + mClusterMembers[memberFirst]*rRowLen;
+			if( ( rPolicy == ATTRIBUTES_FIRST ) || ( memberEnd - memberFirst == 1 ) ) {
+				std::copy( rowFirst, rowFirst + rRowLen, weldedRow );
+				continue;
+			}
+			for( uint64_t i=0; i<rRowLen; i++ ) {
+				double   sum      = 0.0;
+				uint64_t validNr  = 0;
+				for( uint64_t memberPos=memberFirst; memberPos<memberEnd; memberPos++ ) {
+					const double value = rRows[mClusterMembers[memberPos]*rRowLen + i];
+					if( !std::isnan( value ) ) {
+						sum += value;
+						validNr++;
+					}
+				}
+				weldedRow[i] = ( validNr > 0 ) ? sum / static_cast<double>( validNr ) : std::numeric_limits<double>::quiet_NaN();
+			}
+		}
+	} );
+	return( true );
+}
@@ -22,6 +22,9 @@
 
 #include <GigaMesh/mesh/voxelfilter25d.h>
 
+#include <algorithm> // stable_sort
+#include <vector>
+
 using namespace std;
 
 double* generateVoxelFilter2D( double radiusRel,                   //!< Radius relative to xyzDim.
@@ -184,6 +187,144 @@ void applyVoxelFilters2D( double* featureArray, double* rasterArray, voxelFilter
 }
 
 
+bool generateVoxelFilters2DMultiscale( voxelFilter2DElements* sparseFilters, uint multiscaleRadiiSize, uint xyzDim, voxelFilter2DMultiscale* multiscaleFilter ) {
+	//! Merges the sparse filters of generateVoxelFilters2D into one table of columns
+	//! for applyVoxelFilters2D( double*, double*, voxelFilter2DMultiscale* ).
+	//!
+	//! \return false, when the filters are not nested, which does not happen for the
+	//! concentric spheres of generateVoxelFilter2D. True otherwise.
+	multiscaleFilter->nrScales      = multiscaleRadiiSize;
+	multiscaleFilter->nrColumns     = 0;
+	multiscaleFilter->scaleOrder    = nullptr;
+	multiscaleFilter->columnIndices = nullptr;
+	multiscaleFilter->columnOffsets = nullptr;
+	multiscaleFilter->columnHeights = nullptr;
+	if( ( sparseFilters == nullptr ) || ( multiscaleRadiiSize == 0 ) ) {
+		return false;
+	}
+
+	// Order the scales by their number of elements i.e. by their radii.
+	uint* scaleOrder = static_cast<uint*>(calloc( multiscaleRadiiSize, sizeof(uint) ));
+	for( uint i=0; i<multiscaleRadiiSize; i++ ) {
+		scaleOrder[i] = i;
+	}
+	stable_sort( scaleOrder, scaleOrder + multiscaleRadiiSize, [sparseFilters]( uint rScaleA, uint rScaleB ) {
+		return sparseFilters[rScaleA].nrElements > sparseFilters[rScaleB].nrElements;
+	} );
+
+	// Number of scales covering each pixel. Due to the nesting, the covering scales
+	// have to be the first ones of the order.
+	vector<uint> scalesPerPixel( xyzDim*xyzDim, 0 );
+	for( uint rank=0; rank<multiscaleRadiiSize; rank++ ) {
+		const voxelFilter2DElements& sparseFilter = sparseFilters[scaleOrder[rank]];
+		for( int i=0; i<sparseFilter.nrElements; i++ ) {
+			uint& scaleCount = scalesPerPixel[sparseFilter.elementIndices[i]];
+			if( scaleCount != rank ) {
+				cerr << "[generateVoxelFilters2DMultiscale] Filters are not nested!" << endl;
+				free( scaleOrder );
+				return false;
+			}
+			scaleCount++;
+		}
+	}
+
+	// Columns in ascending order of the raster as the sparse filters - so the sums have the same order.
+	vector<uint> columnOfPixel( xyzDim*xyzDim, 0 );
+	uint nrColumns = 0;
+	uint nrHeights = 0;
+	for( uint pixIdx=0; pixIdx<xyzDim*xyzDim; pixIdx++ ) {
+		if( scalesPerPixel[pixIdx] == 0 ) {
+			continue;
+		}
+		columnOfPixel[pixIdx] = nrColumns;
+		nrColumns++;
+		nrHeights += scalesPerPixel[pixIdx];
+	}
+	int*    columnIndices = static_cast<int*>(calloc( nrColumns, sizeof(int) ));
+	uint*   columnOffsets = static_cast<uint*>(calloc( nrColumns+1, sizeof(uint) ));
+	double* columnHeights = static_cast<double*>(calloc( nrHeights, sizeof(double) ));
+	for( uint pixIdx=0; pixIdx<xyzDim*xyzDim; pixIdx++ ) {
+		if( scalesPerPixel[pixIdx] == 0 ) {
+			continue;
+		}
+		const uint columnIdx = columnOfPixel[pixIdx];
+		columnIndices[columnIdx]   = static_cast<int>(pixIdx);
+		columnOffsets[columnIdx+1] = columnOffsets[columnIdx] + scalesPerPixel[pixIdx];
+	}
+	for( uint rank=0; rank<multiscaleRadiiSize; rank++ ) {
+		const voxelFilter2DElements& sparseFilter = sparseFilters[scaleOrder[rank]];
+		for( int i=0; i<sparseFilter.nrElements; i++ ) {
+			const uint columnIdx = columnOfPixel[sparseFilter.elementIndices[i]];
+			columnHeights[columnOffsets[columnIdx]+rank] = sparseFilter.elementValues[i];
+		}
+	}
+
+	multiscaleFilter->nrColumns     = nrColumns;
+	multiscaleFilter->scaleOrder    = scaleOrder;
+	multiscaleFilter->columnIndices = columnIndices;
+	multiscaleFilter->columnOffsets = columnOffsets;
+	multiscaleFilter->columnHeights = columnHeights;
+	return true;
+}
+
+void freeVoxelFilters2DMultiscale( voxelFilter2DMultiscale* multiscaleFilter ) {
+	//! Releases the arrays allocated by generateVoxelFilters2DMultiscale.
+	free( multiscaleFilter->scaleOrder );
+	free( multiscaleFilter->columnIndices );
+	free( multiscaleFilter->columnOffsets );
+	free( multiscaleFilter->columnHeights );
+	multiscaleFilter->nrColumns     = 0;
+	multiscaleFilter->scaleOrder    = nullptr;
+	multiscaleFilter->columnIndices = nullptr;
+	multiscaleFilter->columnOffsets = nullptr;
+	multiscaleFilter->columnHeights = nullptr;
+}
+
+void applyVoxelFilters2D( double* featureArray, double* rasterArray, voxelFilter2DMultiscale* multiscaleFilter ) {
+	//! Estimates the integrals of all scales in a single pass over the columns.
+	//!
+	//! The result is identical to applyVoxelFilters2D using the sparse filters: the
+	//! elements of each scale are summed in the same order. Where the sparse variant
+	//! skips a column without overlap, zero is added.
+	//!
+	//! Remark: featureArray has to be of length multiscaleFilter->nrScales.
+	const uint nrScales = multiscaleFilter->nrScales;
+	// Sums of the intersection and of the filter volume - per thread to avoid allocation per vertex.
+	thread_local vector<double> integralSums;
+	thread_local vector<double> filterSums;
+	integralSums.assign( nrScales, 0.0 );
+	filterSums.assign( nrScales, 0.0 );
+	double* integralSum = integralSums.data();
+	double* filterSum   = filterSums.data();
+
+	const int*    columnIndices = multiscaleFilter->columnIndices;
+	const uint*   columnOffsets = multiscaleFilter->columnOffsets;
+	const double* columnHeights = multiscaleFilter->columnHeights;
+	for( uint c=0; c<multiscaleFilter->nrColumns; c++ ) {
+		const double rasterValue = rasterArray[columnIndices[c]];
+		if( isnan( rasterValue ) ) {
+			// outside the mesh => nothing to add - see applyVoxelFilter2D.
+			continue;
+		}
+		const double* heights     = columnHeights + columnOffsets[c];
+		const uint    scaleCount  = columnOffsets[c+1] - columnOffsets[c];
+		for( uint k=0; k<scaleCount; k++ ) {
+			const double filterElement = heights[k];
+			// we have to shift the raster Values by the half height of the sphere.
+			const double rasterElement = rasterValue + ( filterElement / 2.0 );
+			filterSum[k] += filterElement;
+			// the integral for each pixel (=voxel stack) is the lower value - clamped to zero:
+			const double overlap = ( rasterElement < filterElement ) ? rasterElement : filterElement;
+			integralSum[k] += ( rasterElement > 0.0 ) ? overlap : 0.0;
+		}
+	}
+	for( uint k=0; k<nrScales; k++ ) {
+		double& featureElement = featureArray[multiscaleFilter->scaleOrder[k]];
+		featureElement = integralSum[k] * ( 2.0 / filterSum[k] );
+		featureElement -= 1.0;
+	}
+}
+
 double sumVoxelFilter2D( double* voxelFilter2D, uint xyzDim ) {
 	//! Integrates a filter mask (or an area to be filtered).
 	double filterSum = 0.0;
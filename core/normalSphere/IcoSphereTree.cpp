@@ -21,7 +21,9 @@
 //
 
 #include <GigaMesh/icoSphereTree/IcoSphereTree.h>
+#include <GigaMesh/mesh/parallelfor.h>
 #include <cmath>
+#include <algorithm>
 #include <unordered_map>
 #include <queue>
 #include <limits>
@@ -218,6 +220,51 @@ void IcoSphereTree::subdivide(unsigned int subdivisions)
 
 	mVertexData = std::vector<double>(mVertices.size(), 0);
 
+	buildFlatFaces();
+}
+
+//copies the vertex indices of the face nodes in breadth-first order and the coordinates into contiguous arrays
+void IcoSphereTree::buildFlatFaces()
+{
+	mFlatFaceVertices.clear();
+	mFlatLevelOffsets.clear();
+
+	std::vector<const IcoSphereTreeFaceNode*> currLevelFaces;
+	for(auto& face : mRootFaces)
+	{
+		currLevelFaces.push_back(&face);
+	}
+
+	while(!currLevelFaces.empty())
+	{
+		mFlatLevelOffsets.push_back(mFlatFaceVertices.size() / 3);
+
+		std::vector<const IcoSphereTreeFaceNode*> nextLevelFaces;
+		nextLevelFaces.reserve(currLevelFaces.size() * 4);
+		for(auto face : currLevelFaces)
+		{
+			for(auto vertexIndex : face->vertexIndices)
+			{
+				mFlatFaceVertices.push_back(static_cast<uint32_t>(vertexIndex));
+			}
+			for(auto& child : face->childNodes)
+			{
+				nextLevelFaces.push_back(child.get());
+			}
+		}
+
+		std::swap(currLevelFaces, nextLevelFaces);
+	}
+	//end of the last level
+	mFlatLevelOffsets.push_back(mFlatFaceVertices.size() / 3);
+
+	mFlatVertexCoords.resize(mVertices.size() * 3);
+	for(size_t i = 0; i<mVertices.size(); ++i)
+	{
+		mVertices[i].get3(&mFlatVertexCoords[i * 3]);
+	}
+
+	buildDirectionLookup();
 }
 
 std::vector<unsigned int> IcoSphereTree::getFaceIndices(int subdivisionLevel) const
@@ -416,6 +463,180 @@ bool IcoSphereTree::getNearestVertexFromRay(const Vector3D& rayOrigin, const Vec
 	return true;
 }
 
+//sign of this triple product tells on which side of the plane through the origin, a and b the direction d is
+inline double tripleProduct(const double* d, const double* a, const double* b)
+{
+	return d[0] * (a[1] * b[2] - a[2] * b[1]) + d[1] * (a[2] * b[0] - a[0] * b[2]) + d[2] * (a[0] * b[1] - a[1] * b[0]);
+}
+
+//A line through the origin intersects a triangle of the icosphere, if the direction is within the cone spanned by its vertices.
+//As the midpoints are on the sphere, the cones of the four children tile the cone of their parent exactly. So the
+//ray-triangle tests of getNearestVertexFromRay reduce to the signs of the direction projected onto the planes through
+//the origin and the midpoints. The faces are counter-clockwise seen from the outside, which is kept by subdivideFaces.
+
+//root face containing the direction - the first one on shared edges like getNearestVertexFromRay.
+//in case of numerical issues along the edges, the root face with the smallest violation is used.
+//returns the number of root faces for not-a-number.
+size_t IcoSphereTree::getRootFaceIndex(const double* direction) const
+{
+	size_t faceIdx = mRootFaces.size();
+	double maxMinSide = -std::numeric_limits<double>::max();
+	for(size_t i = 0; i<mRootFaces.size(); ++i)
+	{
+		const double* v0 = &mFlatVertexCoords[mFlatFaceVertices[i * 3] * 3];
+		const double* v1 = &mFlatVertexCoords[mFlatFaceVertices[i * 3 + 1] * 3];
+		const double* v2 = &mFlatVertexCoords[mFlatFaceVertices[i * 3 + 2] * 3];
+		const double minSide = std::min({tripleProduct(direction, v0, v1), tripleProduct(direction, v1, v2), tripleProduct(direction, v2, v0)});
+		if(minSide >= 0.0)
+			return i;
+
+		if(minSide > maxMinSide)
+		{
+			maxMinSide = minSide;
+			faceIdx = i;
+		}
+	}
+	return faceIdx;
+}
+
+//child of the given face of the given level containing the direction - the first one on shared edges.
+size_t IcoSphereTree::getChildFaceIndex(const double* direction, size_t faceIdx, size_t level) const
+{
+	const size_t firstChild = mFlatLevelOffsets[level + 1] + 4 * (faceIdx - mFlatLevelOffsets[level]);
+	//the fourth child is spanned by the midpoints a, b and c - see subdivideFaces
+	const uint32_t* midPoints = &mFlatFaceVertices[(firstChild + 3) * 3];
+	const double* a = &mFlatVertexCoords[midPoints[0] * 3];
+	const double* b = &mFlatVertexCoords[midPoints[1] * 3];
+	const double* c = &mFlatVertexCoords[midPoints[2] * 3];
+	if(tripleProduct(direction, a, c) >= 0.0)
+		return firstChild;
+	if(tripleProduct(direction, b, a) >= 0.0)
+		return firstChild + 1;
+	if(tripleProduct(direction, c, b) >= 0.0)
+		return firstChild + 2;
+	return firstChild + 3;
+}
+
+//cell of the cube map given by the major axis and the other two coordinates projected onto the side of the cube.
+//returns the number of cells for not-a-number and zero length.
+size_t IcoSphereTree::getLookupCellIndex(const double* direction) const
+{
+	const double absXYZ[3] = {std::abs(direction[0]), std::abs(direction[1]), std::abs(direction[2])};
+	const unsigned int axis = (absXYZ[0] >= absXYZ[1]) ? ((absXYZ[0] >= absXYZ[2]) ? 0 : 2) : ((absXYZ[1] >= absXYZ[2]) ? 1 : 2);
+	if(!(absXYZ[axis] > 0.0) || std::isnan(absXYZ[0] + absXYZ[1] + absXYZ[2]))
+		return mLookupFaces.size();
+
+	const unsigned int side = axis * 2 + ((direction[axis] < 0.0) ? 1 : 0);
+	size_t cellIdx = side;
+	for(unsigned int i = 1; i<3; ++i)
+	{
+		const double coord = direction[(axis + i) % 3] / absXYZ[axis];
+		const auto cell = static_cast<unsigned int>((coord + 1.0) * 0.5 * mLookupResolution);
+		cellIdx = cellIdx * mLookupResolution + std::min(cell, mLookupResolution - 1);
+	}
+	return cellIdx;
+}
+
+//the cells of the cube map are convex, so a cell is within a face, when its four corners are.
+void IcoSphereTree::buildDirectionLookup()
+{
+	const size_t levelCount = mFlatLevelOffsets.size() - 1;
+	const size_t cornerRes = mLookupResolution + 1;
+	mLookupFaces.assign(6 * mLookupResolution * mLookupResolution, UINT32_MAX);
+	mLookupLevels.assign(mLookupFaces.size(), 0);
+
+	std::vector<uint32_t> cornerFaces(cornerRes * cornerRes * levelCount);
+	for(unsigned int side = 0; side<6; ++side)
+	{
+		const unsigned int axis = side / 2;
+		//faces containing the corners for each level
+		for(size_t i = 0; i<cornerRes; ++i)
+		{
+			for(size_t j = 0; j<cornerRes; ++j)
+			{
+				double corner[3];
+				corner[axis] = (side % 2 == 0) ? 1.0 : -1.0;
+				corner[(axis + 1) % 3] = 2.0 * static_cast<double>(i) / mLookupResolution - 1.0;
+				corner[(axis + 2) % 3] = 2.0 * static_cast<double>(j) / mLookupResolution - 1.0;
+
+				uint32_t* faces = &cornerFaces[(i * cornerRes + j) * levelCount];
+				faces[0] = static_cast<uint32_t>(getRootFaceIndex(corner));
+				for(size_t level = 0; level + 1<levelCount; ++level)
+				{
+					faces[level + 1] = static_cast<uint32_t>(getChildFaceIndex(corner, faces[level], level));
+				}
+			}
+		}
+		//deepest face shared by the corners of each cell
+		for(size_t i = 0; i<mLookupResolution; ++i)
+		{
+			for(size_t j = 0; j<mLookupResolution; ++j)
+			{
+				const size_t cellIdx = (side * mLookupResolution + i) * mLookupResolution + j;
+				const uint32_t* faces00 = &cornerFaces[(i * cornerRes + j) * levelCount];
+				const uint32_t* faces01 = &cornerFaces[(i * cornerRes + j + 1) * levelCount];
+				const uint32_t* faces10 = &cornerFaces[((i + 1) * cornerRes + j) * levelCount];
+				const uint32_t* faces11 = &cornerFaces[((i + 1) * cornerRes + j + 1) * levelCount];
+				for(size_t level = 0; level<levelCount; ++level)
+				{
+					if(faces00[level] != faces01[level] || faces00[level] != faces10[level] || faces00[level] != faces11[level])
+						break;
+
+					mLookupFaces[cellIdx] = faces00[level];
+					mLookupLevels[cellIdx] = static_cast<uint8_t>(level);
+				}
+			}
+		}
+	}
+}
+
+//The leaf is found by one step per level using the contiguous arrays, instead of the descent through the nodes.
+//The cube map skips the root faces and the coarse levels for most directions.
+size_t IcoSphereTree::getNearestVertexIndexDirect(const Vector3D& direction) const
+{
+	const double d[3] = {direction.getX(), direction.getY(), direction.getZ()};
+
+	const size_t cellIdx = getLookupCellIndex(d);
+	//not-a-number or zero length - same as the failed ray casting
+	if(cellIdx >= mLookupFaces.size())
+		return 0;
+
+	size_t faceIdx = mLookupFaces[cellIdx];
+	size_t level = mLookupLevels[cellIdx];
+	if(faceIdx == UINT32_MAX)
+	{
+		faceIdx = getRootFaceIndex(d);
+		level = 0;
+	}
+
+	for(; level + 2 < mFlatLevelOffsets.size(); ++level)
+	{
+		faceIdx = getChildFaceIndex(d, faceIdx, level);
+	}
+
+	//closest vertex of the leaf to the ray - same arithmetic as getClosestFaceVertexIndexToRay without temporary vectors
+	const double length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+	const double rayDir[3] = {-d[0] / length, -d[1] / length, -d[2] / length};
+	size_t retIndex = 0;
+	double minDistance = std::numeric_limits<double>::max();
+	for(unsigned int corner = 0; corner<3; ++corner)
+	{
+		const uint32_t vertexIndex = mFlatFaceVertices[faceIdx * 3 + corner];
+		const double* v = &mFlatVertexCoords[vertexIndex * 3];
+		const double p[3] = {v[0] - d[0], v[1] - d[1], v[2] - d[2]};
+		const double cross[3] = {p[1] * rayDir[2] - p[2] * rayDir[1],
+		                         p[2] * rayDir[0] - p[0] * rayDir[2],
+		                         p[0] * rayDir[1] - p[1] * rayDir[0]};
+		const double distance = cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+		if(corner == 0 || distance < minDistance)
+		{
+			minDistance = distance;
+			retIndex = vertexIndex;
+		}
+	}
+	return retIndex;
+}
+
 void IcoSphereTree::selectVertex(size_t index)
 {
 	mSelectedVertices.insert(index);
@@ -448,6 +669,58 @@ void IcoSphereTree::incData(size_t index, double value)
 	mMaxData = std::max(mMaxData, mVertexData[index]);	//increment mVertexData, update maxData
 }
 
+void IcoSphereTree::incDataFromNormals(const float* normalsXYZ, size_t count)
+{
+	incDataFromNormalsT(normalsXYZ, count);
+}
+
+void IcoSphereTree::incDataFromNormals(const double* normalsXYZ, size_t count)
+{
+	incDataFromNormalsT(normalsXYZ, count);
+}
+
+//same as incData(getNearestVertexIndexAt(normal), length) for each normal, but in parallel with a histogram per thread.
+//the sums may differ in the last digits from the sequential order.
+template<typename T>
+void IcoSphereTree::incDataFromNormalsT(const T* normalsXYZ, size_t count)
+{
+	const size_t vertexCount = mVertexData.size();
+	std::vector<std::vector<double>> threadData(getParallelThreadCount());
+	parallelFor(count, [&](uint64_t begin, uint64_t end, unsigned int threadIdx)
+	{
+		std::vector<double>& data = threadData[threadIdx];
+		if(data.empty())
+			data.assign(vertexCount, 0.0);
+
+		for(uint64_t i = begin; i<end; ++i)
+		{
+			const T* n = &normalsXYZ[i * 3];
+			if(std::isnan(n[0]) || std::isnan(n[1]) || std::isnan(n[2]))
+				continue;
+
+			Vector3D normal(static_cast<double>(n[0]), static_cast<double>(n[1]), static_cast<double>(n[2]));
+			const auto incSize = normal.normalize3();
+			data[getNearestVertexIndexDirect(normal)] += incSize;
+		}
+	});
+
+	for(const auto& data : threadData)
+	{
+		if(data.empty())
+			continue;
+
+		for(size_t i = 0; i<vertexCount; ++i)
+		{
+			mVertexData[i] += data[i];
+		}
+	}
+
+	for(const auto value : mVertexData)
+	{
+		mMaxData = std::max(mMaxData, value);
+	}
+}
+
 double IcoSphereTree::getMaxData() const
 {
 	return mMaxData;
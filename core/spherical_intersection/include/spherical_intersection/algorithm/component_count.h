@@ -32,6 +32,15 @@ namespace algorithm {
 //! @param graph reference to the Graph whose components will be counted.
 //! @return The number of components.
 std::size_t get_component_count(Graph &graph);
+
+//! @brief Counts the connected components of the underlying undirected graph
+//! of the given graph without changing it.
+//!
+//! Gives the same result as get_component_count, but the graph can be used
+//! for further algorithms afterwards.
+//! @param graph reference to the Graph whose components will be counted.
+//! @return The number of components.
+std::size_t count_components(const Graph &graph);
 } // namespace algorithm
 } // namespace spherical_intersection
 
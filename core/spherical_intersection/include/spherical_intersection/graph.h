@@ -22,9 +22,8 @@
 #ifndef SPHERICAL_INTERSECTION_GRAPH_H
 #define SPHERICAL_INTERSECTION_GRAPH_H
 
-#include <functional>
-#include <memory>
-#include <tuple>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 #include "mesh_spherical.h"
@@ -33,29 +32,31 @@ namespace spherical_intersection {
 //! @brief Directed Multigraph embedded into a sphere that represents that
 //! sphere's intersection with a mesh.
 //!
-//! It is expected, that all references to spheres given during the construction
-//! of nodes and arcs refer to the same sphere and that all parts of meshes
-//! specified during the construction of nodes and arcs belong to the same mesh.
+//! Nodes and arcs are stored in flat containers and refer to each other by
+//! their indices. Erasing a node or an arc only marks it as erased and unlinks
+//! it from the adjacency lists, so indices stay valid until the graph is
+//! cleared. Clearing keeps the allocated memory, which allows to reuse a graph
+//! for many spheres e.g. one graph per thread when processing all vertices of
+//! a mesh.
+//!
+//! It is expected, that all parts of meshes specified during the construction
+//! of nodes and arcs belong to the same mesh.
 class Graph {
       public:
-	class Node;
-	class Arc;
+	//! @brief Index of a node or an arc within the graph.
+	using Index = std::uint32_t;
 
-	using Node_Container = std::list<Node>;
-	using Arc_Container = std::list<Arc>;
+	//! @brief Index marking the absence of a node or an arc.
+	static constexpr Index no_index = std::numeric_limits<Index>::max();
 
 	//! @brief A node.
 	class Node {
 	      public:
-		using Arc_Container =
-		    std::list<std::reference_wrapper<const Arc>>;
-
 		//! @brief Constructs a node from information about the
 		//! intersection of a mesh with a sphere.
 		//!
 		//! Using this constructor constructs nodes not associated with
 		//! a graph.
-		//! @param sphere a reference to the intersecting sphere.
 		//! @param edge a reference to the edge of the mesh containing
 		//! the node.
 		//! @param enters_on_first specification whether the given edge
@@ -67,29 +68,8 @@ class Graph {
 		//! by their distance to the edge's first vertex
 		//! and assigning the positions 0 to m in that order where m is
 		//! the number of nodes on the edge.
-		Node(const math3d::Sphere &sphere, const Mesh::Edge &edge,
-		     const bool enters_on_first, const std::size_t position);
-
-		//! @brief Copy constructor (deleted).
-		//! @param other the other node.
-		Node(const Node &other) = delete;
-
-		//! @brief Move constructor.
-		//! @param other the other node.
-		Node(Node &&other) = default;
-
-		//! @brief Copy assignment operator (deleted).
-		//! @param other the other node.
-		Node &operator=(const Node &other) = delete;
-
-		//! @brief Move assignment operator.
-		//! @param other the other node.
-		Node &operator=(Node &&other) = delete;
-
-		//! @brief Gets the sphere whose intersection with a mesh is
-		//! represented by the graph.
-		//! @return A reference to the sphere.
-		const math3d::Sphere &get_sphere() const;
+		Node(const Mesh::Edge &edge, const bool enters_on_first,
+		     const std::size_t position);
 
 		//! @brief Gets the edge containing the node.
 		//! @return A reference to the edge.
@@ -111,23 +91,30 @@ class Graph {
 		//! @return The position.
 		std::size_t get_position() const;
 
-		//! @brief Gets the graph's arcs whose end node is this node.
-		//! @return A reference to a container containing these arcs.
-		const Arc_Container &get_incoming_arcs() const;
+		//! @brief Gets the first of the graph's arcs whose end node is
+		//! this node. The others follow via Arc::get_next_incoming.
+		//! @return The arc's index or no_index if there is none.
+		Index get_first_incoming_arc() const;
+
+		//! @brief Gets the first of the graph's arcs whose start node
+		//! is this node. The others follow via Arc::get_next_outgoing.
+		//! @return The arc's index or no_index if there is none.
+		Index get_first_outgoing_arc() const;
 
-		//! @brief Gets the graph's arcs whose start node is this node.
-		//! @return A reference to a container containing these arcs.
-		const Arc_Container &get_outgoing_arcs() const;
+		//! @brief Decides whether the node was erased from its graph.
+		//! @return True if and only if the node was erased.
+		bool is_erased() const;
 
 	      private:
-		const math3d::Sphere &sphere;
-		const Mesh::Edge &edge;
-		const bool enters_on_first;
-		const std::size_t position;
+		const Mesh::Edge *edge;
+		std::uint32_t position;
+		bool enters_on_first;
+		bool erased = false;
 
-		Graph::Node_Container::const_iterator in_graph;
-		mutable Arc_Container incoming_arcs;
-		mutable Arc_Container outgoing_arcs;
+		Index first_incoming = no_index;
+		Index last_incoming = no_index;
+		Index first_outgoing = no_index;
+		Index last_outgoing = no_index;
 
 		friend class Graph;
 	};
@@ -140,70 +127,61 @@ class Graph {
 		//!
 		//! Using this constructor constructs arcs not associated with
 		//! a graph.
-		//! @param sphere reference to the intersecting sphere.
 		//! @param triangle reference to the triangle of the mesh
 		//! containing the arc.
-		//! @param start reference to the arc's start node.
-		//! @param end reference to the arc's end node.
-		Arc(const math3d::Sphere &sphere,
-		    const Mesh::Triangle &triangle, const Node &start,
-		    const Node &end);
-
-		//! @brief Copy constructor (deleted).
-		//! @param other the other arc.
-		Arc(const Arc &other) = delete;
-
-		//! @brief Move constructor.
-		//! @param other the other arc.
-		Arc(Arc &&other) = default;
-
-		//! @brief Copy assignment operator (deleted).
-		//! @param other the other arc.
-		Arc &operator=(const Arc &other) = delete;
-
-		//! @brief Move assignment operator.
-		//! @param other the other arc.
-		Arc &operator=(Arc &&other) = delete;
-
-		//! @brief Gets the sphere whose intersection with a mesh is
-		//! represented by the graph.
-		//! @return A reference to the sphere.
-		const math3d::Sphere &get_sphere() const;
+		//! @param start index of the arc's start node.
+		//! @param end index of the arc's end node.
+		Arc(const Mesh::Triangle &triangle, const Index start,
+		    const Index end);
 
 		//! @brief Gets the triangle containing the arc.
 		//! @return A reference to the triangle.
 		const Mesh::Triangle &get_triangle() const;
 
 		//! @brief Gets the arc's start node.
-		//! @return A reference to the arc's start node.
-		const Node &get_start() const;
+		//! @return The index of the arc's start node.
+		Index get_start() const;
 
 		//! @brief Gets the arc's end node.
-		//! @return A reference to the arc's end node.
-		const Node &get_end() const;
+		//! @return The index of the arc's end node.
+		Index get_end() const;
+
+		//! @brief Gets the next arc sharing this arc's end node.
+		//! @return The arc's index or no_index if there is none.
+		Index get_next_incoming() const;
+
+		//! @brief Gets the next arc sharing this arc's start node.
+		//! @return The arc's index or no_index if there is none.
+		Index get_next_outgoing() const;
+
+		//! @brief Decides whether the arc was erased from its graph.
+		//! @return True if and only if the arc was erased.
+		bool is_erased() const;
 
 	      private:
-		const math3d::Sphere &sphere;
-		const Mesh::Triangle &triangle;
+		const Mesh::Triangle *triangle;
+		Index start;
+		Index end;
+		bool erased = false;
 
-		const Node &start;
-		const Node &end;
-		Graph::Arc_Container::const_iterator in_graph;
-		Graph::Node::Arc_Container::const_iterator in_start;
-		Graph::Node::Arc_Container::const_iterator in_end;
+		Index previous_incoming = no_index;
+		Index next_incoming = no_index;
+		Index previous_outgoing = no_index;
+		Index next_outgoing = no_index;
 
 		friend class Graph;
 	};
 
+	using Node_Container = std::vector<Node>;
+	using Arc_Container = std::vector<Arc>;
+
+	//! @brief Constructs an empty graph for a sphere of radius zero.
+	Graph();
+
 	//! @brief Constructs the graph representing the intersection of the
 	//! mesh containing a given vertex and a given sphere.
 	//!
-	//! It is expected that the given vertex is inside the ball enclosed by
-	//! the given sphere. The graph's nodes are the intersections of the
-	//! mesh's edges and its arcs are the intersections of the mesh's
-	//! triangle's with the sphere directed such that a triangles normal
-	//! points from left to right when following an arc in its direction
-	//! with the outward oriented sphere's current surface normal pointing up.
+	//! See assign.
 	//! @param vertex_seed a reference to the given vertex.
 	//! @param sphere a reference to the given sphere.
 	Graph(const Mesh::Vertex &vertex_seed, const math3d::Sphere &sphere);
@@ -224,10 +202,34 @@ class Graph {
 	//! @param other the other graph.
 	Graph &operator=(Graph &&other) = default;
 
+	//! @brief Replaces the graph by the graph representing the
+	//! intersection of the mesh containing a given vertex and a given
+	//! sphere.
+	//!
+	//! It is expected that the given vertex is inside the ball enclosed by
+	//! the given sphere. The graph's nodes are the intersections of the
+	//! mesh's edges and its arcs are the intersections of the mesh's
+	//! triangle's with the sphere directed such that a triangles normal
+	//! points from left to right when following an arc in its direction
+	//! with the outward oriented sphere's current surface normal pointing
+	//! up. The memory of the previous graph is reused.
+	//! @param vertex_seed a reference to the given vertex.
+	//! @param sphere a reference to the given sphere.
+	void assign(const Mesh::Vertex &vertex_seed,
+		    const math3d::Sphere &sphere);
+
+	//! @brief Removes all nodes and arcs while keeping the allocated
+	//! memory. This invalidates all indices.
+	void clear();
+
+	//! @brief Gets the sphere whose intersection with a mesh is
+	//! represented by the graph.
+	//! @return A reference to the sphere.
+	const math3d::Sphere &get_sphere() const;
+
 	//! @brief Constructs a node from information about the
-	//! intersection of a mesh with a sphere and associates it with this
-	//! graph.
-	//! @param sphere reference to the intersecting sphere.
+	//! intersection of a mesh with the graph's sphere and associates it
+	//! with this graph.
 	//! @param edge reference to the edge of the mesh containing
 	//! the node.
 	//! @param enters_on_first specification whether the given edge
@@ -239,45 +241,74 @@ class Graph {
 	//! by their distance to the edge's first vertex
 	//! and assigning the positions 0 to m in that order where m is
 	//! the number of nodes on the edge.
-	Node &emplace_node(const math3d::Sphere &sphere, const Mesh::Edge &edge,
-			   const bool enters_on_first,
+	//! @return The index of the new node.
+	Index emplace_node(const Mesh::Edge &edge, const bool enters_on_first,
 			   const std::size_t position);
 
 	//! @brief Constructs an arc from information about the
-	//! intersection of a mesh with a sphere and associates it with this
-	//! graph.
-	//! @param sphere reference to the intersecting sphere.
+	//! intersection of a mesh with the graph's sphere and associates it
+	//! with this graph.
 	//! @param triangle reference to the triangle of the mesh
 	//! containing the arc.
-	//! @param start reference to the arc's start node.
-	//! @param end reference to the arc's end node.
-	Arc &emplace_arc(const math3d::Sphere &sphere,
-			 const Mesh::Triangle &triangle, const Node &start,
-			 const Node &end);
+	//! @param start index of the arc's start node.
+	//! @param end index of the arc's end node.
+	//! @return The index of the new arc.
+	Index emplace_arc(const Mesh::Triangle &triangle, const Index start,
+			  const Index end);
 
-	//! @brief Removes a given node from the graph.
-	//!
-	//! This invalidates the given node.
-	//! @param a reference to the given node.
-	void erase_node(const Node &node);
+	//! @brief Removes a given node and its arcs from the graph.
+	//! @param node the index of the given node.
+	void erase_node(const Index node);
 
 	//! @brief Removes a given arc from the graph.
-	//!
-	//! This invalidates the given arc.
-	//! @param a reference to the given arc.
-	void erase_arc(const Arc &arc);
+	//! @param arc the index of the given arc.
+	void erase_arc(const Index arc);
+
+	//! @brief Gets a node.
+	//! @param node the node's index.
+	//! @return A reference to the node.
+	const Node &get_node(const Index node) const;
 
-	//! @brief Gets the graph's nodes.
+	//! @brief Gets an arc.
+	//! @param arc the arc's index.
+	//! @return A reference to the arc.
+	const Arc &get_arc(const Index arc) const;
+
+	//! @brief Gets the graph's nodes including the erased ones.
 	//! @return a reference to a container containing the graph's nodes.
 	const Node_Container &get_nodes() const;
 
-	//! @brief Gets the graph's arcs.
+	//! @brief Gets the graph's arcs including the erased ones.
 	//! @return a reference to a container containing the graph's arcs.
 	const Arc_Container &get_arcs() const;
 
+	//! @brief Gets the number of nodes, which were not erased.
+	//! @return The number of nodes.
+	std::size_t get_node_count() const;
+
+	//! @brief Gets the number of arcs, which were not erased.
+	//! @return The number of arcs.
+	std::size_t get_arc_count() const;
+
+	//! @brief Gets the first node in order of construction, which was not
+	//! erased.
+	//! @return The node's index or no_index if there is none.
+	Index get_first_node() const;
+
+	//! @brief Gets the first arc in order of construction, which was not
+	//! erased.
+	//! @return The arc's index or no_index if there is none.
+	Index get_first_arc() const;
+
       private:
+	math3d::Sphere sphere;
 	Node_Container nodes;
 	Arc_Container arcs;
+	std::size_t node_count = 0;
+	std::size_t arc_count = 0;
+	// all nodes and arcs before these indices are erased.
+	Index first_node = 0;
+	Index first_arc = 0;
 };
 } // namespace spherical_intersection
 
@@ -35,9 +35,11 @@ class Arc_Curve {
 	//! Estimations are used when the distance from the arc's start node's
 	//! location to its end node's location is less than the given
 	//! tolerance.
+	//! @param graph the graph containing the arc.
 	//! @param arc the arc.
 	//! @param tolerance the tolerance.
-	Arc_Curve(const Graph::Arc &arc, const double tolerance = 1E-10);
+	Arc_Curve(const Graph &graph, const Graph::Arc &arc,
+		  const double tolerance = 1E-10);
 
 	//! @brief Computes the value c(x/l) where c is the representing curve's
 	//! parametrization by arc length, l its arc length and x a given value.
@@ -80,9 +82,10 @@ class Arc_Curve {
 };
 
 //! @brief Computes a given node's location.
+//! @param graph the graph containing the node.
 //! @param node the node.
 //! @return The location.
-math3d::Vector get_location(const Graph::Node &node);
+math3d::Vector get_location(const Graph &graph, const Graph::Node &node);
 
 } // namespace spherical_intersection
 
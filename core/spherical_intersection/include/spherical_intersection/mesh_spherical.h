@@ -30,6 +30,7 @@
 #include <memory>
 #include <tuple>
 #include <unordered_map> // TODO are all include everywhere needed?
+#include <vector>
 
 #include "math3d/math3d.h" //TODO limit includes in header files everywhere
 
@@ -333,6 +334,20 @@ class Mesh {
 	void add_triangle(const Vertex &vertex_1, const Vertex &vertex_2,
 			  const Vertex &vertex_3);
 
+	//! @brief Adds triangles given by the indices of their vertices.
+	//!
+	//! The result is the same as calling add_triangle for every given
+	//! triangle in the given order, including the order of the edges and
+	//! of the adjacency information. For a mesh without triangles, the
+	//! edges are found by bucketing the triangles' sides by their
+	//! smaller vertex index instead of looking up every side in a hash
+	//! map, which is considerably faster and needs less memory for large
+	//! meshes.
+	//! @param triangle_vertex_indices the indices of the vertices of each
+	//! triangle.
+	void add_triangles(const std::vector<std::array<std::size_t, 3>>
+			       &triangle_vertex_indices);
+
 	// retrieval
 
 	//! @brief Gets the mesh's vertices.
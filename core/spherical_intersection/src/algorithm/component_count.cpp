@@ -20,8 +20,7 @@
 // along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <thread>
-#include <unordered_set>
+#include <cstdint>
 #include <vector>
 
 #include "graph.h"
@@ -33,27 +32,36 @@ std::size_t algorithm::get_component_count(
     Graph &graph) {
 	using namespace spherical_intersection;
 
-	const auto &nodes = graph.get_nodes();
-	auto remove_component = [&graph](const Graph::Node &node) {
-		std::unordered_set<const Graph::Node *> active_node_ptrs{&node};
-		while (!active_node_ptrs.empty()) {
-			const auto &current_node = **active_node_ptrs.begin();
-			active_node_ptrs.erase(active_node_ptrs.begin());
+	// per thread, so the stack is cleared rather than freed between graphs.
+	thread_local std::vector<Graph::Index> active_nodes;
+	auto remove_component = [&graph](const Graph::Index node) {
+		active_nodes.clear();
+		active_nodes.push_back(node);
+		while (!active_nodes.empty()) {
+			const Graph::Index current_node = active_nodes.back();
+			active_nodes.pop_back();
+			const auto &node = graph.get_node(current_node);
+			// a node can be reached more than once before its
+			// removal.
+			if (node.is_erased()) {
+				continue;
+			}
 
-			auto outgoing_arcs = current_node.get_outgoing_arcs();
-			std::vector<const Graph::Node *> successor_ptrs;
-			for (const Graph::Arc &arc : outgoing_arcs) {
-				const auto &end = arc.get_end();
-				if (&end != &current_node) {
-					active_node_ptrs.insert(&end);
+			for (Graph::Index arc = node.get_first_outgoing_arc();
+			     arc != Graph::no_index;
+			     arc = graph.get_arc(arc).get_next_outgoing()) {
+				const auto end = graph.get_arc(arc).get_end();
+				if (end != current_node) {
+					active_nodes.push_back(end);
 				}
 			}
 
-			auto incoming_arcs = current_node.get_incoming_arcs();
-			for (const Graph::Arc &arc : incoming_arcs) {
-				const auto &start = arc.get_start();
-				if (&start != &current_node) {
-					active_node_ptrs.insert(&start);
+			for (Graph::Index arc = node.get_first_incoming_arc();
+			     arc != Graph::no_index;
+			     arc = graph.get_arc(arc).get_next_incoming()) {
+				const auto start = graph.get_arc(arc).get_start();
+				if (start != current_node) {
+					active_nodes.push_back(start);
 				}
 			}
 
@@ -61,9 +69,54 @@ std::size_t algorithm::get_component_count(
 		}
 	};
 	std::size_t component_count = 0;
-	while (!nodes.empty()) {
-		remove_component(*nodes.begin());
+	while (graph.get_node_count() > 0) {
+		remove_component(graph.get_first_node());
 		component_count++;
 	}
 	return component_count;
 }
+
+std::size_t algorithm::count_components(const Graph &graph) {
+	// per thread, so the stack and the stamps are reused between graphs.
+	// A node is visited, when its stamp equals the current stamp.
+	thread_local std::vector<Graph::Index> active_nodes;
+	thread_local std::vector<std::uint64_t> node_stamps;
+	thread_local std::uint64_t stamp = 0;
+	const auto &nodes = graph.get_nodes();
+	if (node_stamps.size() < nodes.size()) {
+		node_stamps.resize(nodes.size(), 0);
+	}
+	stamp++;
+
+	auto visit = [&graph](const Graph::Index node) {
+		if (node_stamps[node] == stamp || graph.get_node(node).is_erased()) {
+			return;
+		}
+		node_stamps[node] = stamp;
+		active_nodes.push_back(node);
+	};
+	std::size_t component_count = 0;
+	for (Graph::Index seed = 0; seed < nodes.size(); seed++) {
+		if (node_stamps[seed] == stamp || nodes[seed].is_erased()) {
+			continue;
+		}
+		component_count++;
+		active_nodes.clear();
+		visit(seed);
+		while (!active_nodes.empty()) {
+			const auto &node = graph.get_node(active_nodes.back());
+			active_nodes.pop_back();
+			for (Graph::Index arc = node.get_first_outgoing_arc();
+			     arc != Graph::no_index;
+			     arc = graph.get_arc(arc).get_next_outgoing()) {
+				visit(graph.get_arc(arc).get_end());
+			}
+			for (Graph::Index arc = node.get_first_incoming_arc();
+			     arc != Graph::no_index;
+			     arc = graph.get_arc(arc).get_next_incoming()) {
+				visit(graph.get_arc(arc).get_start());
+			}
+		}
+	}
+	return component_count;
+}
@@ -30,9 +30,13 @@ std::vector<double> algorithm::get_sphere_intersections(const Graph &graph) {
 	const auto &graphs_nodes = graph.get_nodes();
 	// int numbOfIntersections = 0;
 	std::vector<double> intersections;
+	intersections.reserve(3 * graph.get_node_count());
 
 	for (const auto &node : graphs_nodes) {
-		auto pos = get_location(node);
+		if (node.is_erased()) {
+			continue;
+		}
+		auto pos = get_location(graph, node);
 		intersections.push_back(pos.get(0));
 		intersections.push_back(pos.get(1));
 		intersections.push_back(pos.get(2));
@@ -29,10 +29,13 @@ using namespace spherical_intersection;
 double algorithm::get_sphere_surface_length(const Graph &graph) {
 	double total_length = 0;
 	const auto &arcs = graph.get_arcs();
+	const double radius = graph.get_sphere().get_radius();
 
 	for (const auto &arc : arcs) {
-		total_length +=
-		    Arc_Curve(arc).get_length() / arc.get_sphere().get_radius();
+		if (arc.is_erased()) {
+			continue;
+		}
+		total_length += Arc_Curve(graph, arc).get_length() / radius;
 	}
 
 	return total_length;
@@ -26,6 +26,7 @@
 #include <cmath>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <thread>
 #include <vector>
@@ -56,6 +57,19 @@ double get_turning_angle(const math3d::Vector v_1, const math3d::Vector v_2,
 	}
 }
 
+//! @brief Reusable per thread scratch memory of extract_cycle_contribution.
+struct Cycle_Workspace {
+	std::vector<Graph::Index> arcs_of_cycle;
+	std::vector<Graph::Index> nodes_of_cycle;
+	// track all arc's contributions except the first, since it depends on
+	// the last.
+	std::vector<double> arc_contributions_to_cycle;
+	// marks the nodes of nodes_of_cycle with the current stamp to avoid
+	// searching it. A new stamp unmarks all nodes.
+	std::vector<std::uint64_t> node_stamps;
+	std::uint64_t stamp = 0;
+};
+
 //! @brief Chooses an arbitrary arc of a given graph if that graph has at least
 //! one arc. Otherwise returns std::numeric_limits::quiet_NaN. If an arc is
 //! chosen, choses a cycle containing this arc if such a cycle exists. Otherwise
@@ -74,68 +88,82 @@ double get_turning_angle(const math3d::Vector v_1, const math3d::Vector v_2,
 // A cycle is chosen by starting at a random arc and randomly choosing a next
 // arc starting at the previous arc's end.
 double extract_cycle_contribution(Graph &graph) {
-	using Graph = Graph;
-	using Node = typename Graph::Node;
-	using Arc = typename Graph::Arc;
+	thread_local Cycle_Workspace workspace;
 
 	double accumulation = 0;
-	const auto &arcs = graph.get_arcs();
-	if (arcs.empty()) {
+	const Graph::Index first_arc = graph.get_first_arc();
+	if (first_arc == Graph::no_index) {
 		return std::numeric_limits<double>::quiet_NaN();
 	}
 
-	std::vector<std::reference_wrapper<const Arc>> arcs_of_cycle;
-	std::vector<const Node *> nodes_of_cycle_ptrs;
-	// track all arc's contributions except the first, since it depends on
-	// the last.
-	std::vector<double> arc_contributions_to_cycle;
-	const Arc &current_arc = *arcs.begin();
-	arcs_of_cycle.push_back(current_arc);
-	nodes_of_cycle_ptrs.push_back(&current_arc.get_start());
-	const auto *current_node_ptr = &current_arc.get_end();
-	Arc_Curve current_curve = Arc_Curve(current_arc);
+	auto &arcs_of_cycle = workspace.arcs_of_cycle;
+	auto &nodes_of_cycle = workspace.nodes_of_cycle;
+	auto &arc_contributions_to_cycle = workspace.arc_contributions_to_cycle;
+	auto &node_stamps = workspace.node_stamps;
+	arcs_of_cycle.clear();
+	nodes_of_cycle.clear();
+	arc_contributions_to_cycle.clear();
+	if (node_stamps.size() < graph.get_nodes().size()) {
+		node_stamps.resize(graph.get_nodes().size(), 0);
+	}
+	const std::uint64_t stamp = ++workspace.stamp;
+
+	const math3d::Vector &sphere_center = graph.get_sphere().get_center();
+
+	auto push_node = [&nodes_of_cycle, &node_stamps,
+			  stamp](const Graph::Index node) {
+		nodes_of_cycle.push_back(node);
+		node_stamps[node] = stamp;
+	};
+	auto pop_node = [&nodes_of_cycle, &node_stamps]() {
+		node_stamps[nodes_of_cycle.back()] = 0;
+		nodes_of_cycle.pop_back();
+	};
+
+	const Graph::Arc &current_arc = graph.get_arc(first_arc);
+	arcs_of_cycle.push_back(first_arc);
+	push_node(current_arc.get_start());
+	Graph::Index current_node = current_arc.get_end();
+	Arc_Curve current_curve = Arc_Curve(graph, current_arc);
 
 	// given the next arc performs the following: adds the current arc's
 	// contribution to arc_contributions_to_cycle, updates current_arc,
-	// current_node_ptr, arcs_of_cycle and nodes_of_cycle_ptrs
-	auto go_to_next_arc = [&arcs_of_cycle, &nodes_of_cycle_ptrs,
-			       &arc_contributions_to_cycle, &current_curve,
-			       &current_node_ptr](const Arc &arc) {
+	// current_node, arcs_of_cycle and nodes_of_cycle
+	auto go_to_next_arc = [&graph, &sphere_center, &arcs_of_cycle,
+			       &push_node, &arc_contributions_to_cycle,
+			       &current_curve,
+			       &current_node](const Graph::Index arc_idx) {
+		const Graph::Arc &arc = graph.get_arc(arc_idx);
 		auto end_tangent = current_curve.get_tangent_at(1);
-		arcs_of_cycle.push_back(arc);
-		current_curve = Arc_Curve(arc);
+		arcs_of_cycle.push_back(arc_idx);
+		current_curve = Arc_Curve(graph, arc);
 		auto start_tangent = current_curve.get_tangent_at(0);
 		double angle = get_turning_angle(
 		    end_tangent, start_tangent,
-		    math3d::normalize(current_curve.eval(0) -
-				      arc.get_sphere().get_center()));
+		    math3d::normalize(current_curve.eval(0) - sphere_center));
 		arc_contributions_to_cycle.push_back(
 		    angle + current_curve.get_geodesic_curvature() *
 				current_curve.get_length());
 
-		nodes_of_cycle_ptrs.push_back(current_node_ptr);
-		current_node_ptr = &arc.get_end();
+		push_node(current_node);
+		current_node = arc.get_end();
 	};
 
 	const auto start_curve = current_curve;
-	auto it = std::find(nodes_of_cycle_ptrs.begin(),
-			    nodes_of_cycle_ptrs.end(), current_node_ptr);
-	while (!nodes_of_cycle_ptrs.empty() &&
-	       it == nodes_of_cycle_ptrs.end()) {
-		const auto &current_outgoing_arcs =
-		    current_node_ptr->get_outgoing_arcs();
-		if (!current_outgoing_arcs.empty()) {
-			go_to_next_arc(*current_outgoing_arcs.begin());
-			it = std::find(nodes_of_cycle_ptrs.begin(),
-				       nodes_of_cycle_ptrs.end(),
-				       current_node_ptr);
+	bool is_in_cycle = (node_stamps[current_node] == stamp);
+	while (!nodes_of_cycle.empty() && !is_in_cycle) {
+		const Graph::Index current_outgoing_arc =
+		    graph.get_node(current_node).get_first_outgoing_arc();
+		if (current_outgoing_arc != Graph::no_index) {
+			go_to_next_arc(current_outgoing_arc);
+			is_in_cycle = (node_stamps[current_node] == stamp);
 		} else {
-			const Arc &arc_to_remove = arcs_of_cycle.back();
-			current_node_ptr = &arc_to_remove.get_start();
+			const Graph::Index arc_to_remove = arcs_of_cycle.back();
+			current_node = graph.get_arc(arc_to_remove).get_start();
 			graph.erase_arc(arc_to_remove);
 			arcs_of_cycle.pop_back();
-			nodes_of_cycle_ptrs.pop_back();
-			it = nodes_of_cycle_ptrs.end();
+			pop_node();
+			is_in_cycle = false;
 		}
 	}
 	if (arcs_of_cycle.empty()) {
@@ -144,11 +172,9 @@ double extract_cycle_contribution(Graph &graph) {
 	// calculations to determine the first arc's contribution
 	auto end_tangent = current_curve.get_tangent_at(1);
 	auto start_tangent = start_curve.get_tangent_at(0);
-	const Arc &arc = arcs_of_cycle.back();
-	double angle =
-	    get_turning_angle(end_tangent, start_tangent,
-			      math3d::normalize(current_curve.eval(0) -
-						arc.get_sphere().get_center()));
+	double angle = get_turning_angle(
+	    end_tangent, start_tangent,
+	    math3d::normalize(current_curve.eval(0) - sphere_center));
 
 	// accumulate contributions
 	accumulation += angle + start_curve.get_geodesic_curvature() *
@@ -157,8 +183,8 @@ double extract_cycle_contribution(Graph &graph) {
 	std::accumulate(arc_contributions_to_cycle.begin(), arc_contributions_to_cycle.end(), accumulation);
 
 	// erase the cycle's arcs from graph
-	for (const Arc &circleArc : arcs_of_cycle) {
-		graph.erase_arc(circleArc);
+	for (const Graph::Index circle_arc : arcs_of_cycle) {
+		graph.erase_arc(circle_arc);
 	}
 
 	return 2 * M_PI - accumulation;
@@ -169,10 +195,8 @@ double extract_cycle_contribution(Graph &graph) {
 
 // The implementation makes use of the cycle cut relation in dual planar graphs.
 double algorithm::get_sphere_volume_area(Graph &graph) {
-	const auto &arcs = graph.get_arcs();
-
 	auto accumulation = [&] {
-		while (!arcs.empty()) {
+		while (graph.get_arc_count() > 0) {
 			auto cycle_contribution =
 			    extract_cycle_contribution(graph);
 			if (!std::isnan(cycle_contribution)) {
@@ -182,7 +206,7 @@ double algorithm::get_sphere_volume_area(Graph &graph) {
 		return std::numeric_limits<double>::quiet_NaN();
 	}();
 
-	while (!arcs.empty()) {
+	while (graph.get_arc_count() > 0) {
 		auto cycle_contribution = extract_cycle_contribution(graph);
 		if (!std::isnan(cycle_contribution)) {
 			accumulation += cycle_contribution;
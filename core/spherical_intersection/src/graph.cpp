@@ -20,114 +20,121 @@
 // along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <algorithm>
 #include <cassert>
 #include <cmath>
-#include <sstream>
-#include <unordered_set>
+#include <stdexcept>
+#include <vector>
 
 #include "graph.h"
 #include "mesh_spherical.h"
-#include "utility/hash_combine.h"
+#include "utility/pointer_map.h"
 
 using namespace spherical_intersection;
 
 // Graph::Node
-Graph::Node::Node(const math3d::Sphere &sphere, const Mesh::Edge &edge,
-		  const bool enters_on_first, const std::size_t position)
-    : sphere(sphere), edge(edge), enters_on_first(enters_on_first),
-      position(position) {}
+Graph::Node::Node(const Mesh::Edge &edge, const bool enters_on_first,
+		  const std::size_t position)
+    : edge(&edge), position(static_cast<std::uint32_t>(position)),
+      enters_on_first(enters_on_first) {}
 
-const math3d::Sphere &Graph::Node::get_sphere() const { return this->sphere; }
-
-const Mesh::Edge &Graph::Node::get_edge() const { return this->edge; }
+const Mesh::Edge &Graph::Node::get_edge() const { return *this->edge; }
 
 bool Graph::Node::get_enters_on_first() const { return this->enters_on_first; }
 
 std::size_t Graph::Node::get_position() const { return this->position; }
 
-const Graph::Node::Arc_Container &Graph::Node::get_incoming_arcs() const {
-	return this->incoming_arcs;
+Graph::Index Graph::Node::get_first_incoming_arc() const {
+	return this->first_incoming;
 }
 
-const Graph::Node::Arc_Container &Graph::Node::get_outgoing_arcs() const {
-	return this->outgoing_arcs;
+Graph::Index Graph::Node::get_first_outgoing_arc() const {
+	return this->first_outgoing;
 }
 
-// Graph::Arc
-Graph::Arc::Arc(const math3d::Sphere &sphere, const Mesh::Triangle &triangle,
-		const Node &start, const Node &end)
-    : sphere(sphere), triangle(triangle), start(start), end(end) {}
+bool Graph::Node::is_erased() const { return this->erased; }
 
-const math3d::Sphere &Graph::Arc::get_sphere() const { return this->sphere; }
+// Graph::Arc
+Graph::Arc::Arc(const Mesh::Triangle &triangle, const Index start,
+		const Index end)
+    : triangle(&triangle), start(start), end(end) {}
 
 const Mesh::Triangle &Graph::Arc::get_triangle() const {
-	return this->triangle;
+	return *this->triangle;
+}
+
+Graph::Index Graph::Arc::get_start() const { return this->start; }
+
+Graph::Index Graph::Arc::get_end() const { return this->end; }
+
+Graph::Index Graph::Arc::get_next_incoming() const {
+	return this->next_incoming;
 }
 
-const Graph::Node &Graph::Arc::get_start() const { return this->start; }
+Graph::Index Graph::Arc::get_next_outgoing() const {
+	return this->next_outgoing;
+}
 
-const Graph::Node &Graph::Arc::get_end() const { return this->end; }
+bool Graph::Arc::is_erased() const { return this->erased; }
 
 //! @cond DEV
 
 // Graph
-// helper structures for Graph's constructor
+// helper structures for Graph::assign
 namespace {
 // declarations
 
-//! @brief A utility class to map pairs of vertices to nodes of a graph
-//! representing the elements of the intersection of the edge connecting them
-//! with a sphere.
-class Intersection_Mapper {
-      public:
-	using Key = std::pair<const Mesh::Vertex *, const Mesh::Vertex *>;
-
-	//! @brief Constructs a utility object to map pairs of vertices of a
-	//! mesh to nodes of a given graph that represent the elements of the
-	//! intersection of the mesh's edge connecting the vertices with a
-	//! sphere where the vertices expected to be part of a component mesh of
-	//! the mesh whose intersection with the sphere is represented by the
-	//! graph. All required graph nodes are constructed in the given graph.
-	//! @param graph the representing graph.
-	//! @param vertex_seed a vertex of the component mesh.
-	//! @param sphere the sphere.
-	Intersection_Mapper(Graph &graph, const Mesh::Vertex &vertex_seed,
-			    const math3d::Sphere &sphere);
-
-	//! @brief Applies the map to a given element.
-	//! @param key the given element.
-	//! @return a pointer to the given elements image under the map if the
-	//! map is defined at the given element and nullptr otherwise.
-	const std::vector<std::reference_wrapper<const Graph::Node>> *
-	get(const Key &key) const;
-
-      private:
-	Graph &graph;
-	const math3d::Sphere &sphere;
-	std::unordered_map<
-	    Key, std::vector<std::reference_wrapper<const Graph::Node>>,
-	    std::function<std::size_t(const Key &)>,
-	    std::function<bool(const Key &, const Key &)>>
-	    intersection_map;
-
-	//! @brief Defines the map at vertex pairs given by the given edge while
-	//! the images of these pairs are given by information about the given
-	//! edges intersection with the sphere that was given during the map
-	//! object's construction. This is a conversion of information
-	//! equivalent to a restriction of the map to the corresponding partial
-	//! definition of the map.
-	//! @param edge a reference to the given edge
-	//! @param enters_on_first Expected to be the specification whether the
-	//! given edge enters the intersecting sphere on its first intersection
-	//! with the sphere when directing the edge from its first vertex to its
-	//! second.
-	//! @param intersection_count Expected to be the number of elements in
-	//! the given edge's intersection with the sphere.
-	void create_intersection(const Mesh::Edge &edge, bool enters_on_first,
-				 std::size_t intersection_count);
+//! @brief The nodes of a graph on an edge of a mesh. The nodes have
+//! consecutive indices ordered by their position on the edge.
+struct Edge_Intersection {
+	Graph::Index first_node = Graph::no_index;
+	std::uint32_t node_count = 0;
 };
 
+//! @brief Scratch memory for the construction of graphs. There is one per
+//! thread, which is cleared rather than freed, so that constructing the
+//! graphs for all vertices of a mesh does not allocate once the containers
+//! have grown to the size of the largest neighbourhood.
+struct Construction_Workspace {
+	utility::Pointer_Map<Mesh::Vertex, bool> known_vertices;
+	//! Edges that were visited. Edges intersecting the sphere are mapped to
+	//! their nodes.
+	utility::Pointer_Map<Mesh::Edge, Edge_Intersection> known_edges;
+	std::vector<const Mesh::Vertex *> active_vertices;
+	std::vector<const Mesh::Edge *> active_edges;
+
+	void clear() {
+		this->known_vertices.clear();
+		this->known_edges.clear();
+		this->active_vertices.clear();
+		this->active_edges.clear();
+	}
+};
+
+thread_local Construction_Workspace workspace;
+
+//! @brief Constructs the nodes of a given graph representing the elements of
+//! the intersection of the edges of the component mesh containing a given
+//! vertex with the graph's sphere and maps the intersected edges to these
+//! nodes within the workspace.
+//! @param graph the graph.
+//! @param vertex_seed a vertex of the component mesh.
+void create_intersections(Graph &graph, const Mesh::Vertex &vertex_seed);
+
+//! @brief Constructs the nodes representing the intersection of a given edge
+//! with the graph's sphere and maps the edge to them.
+//! @param graph the graph.
+//! @param intersection the given edge's entry within the workspace.
+//! @param edge a reference to the given edge
+//! @param enters_on_first Expected to be the specification whether the
+//! given edge enters the intersecting sphere on its first intersection
+//! with the sphere when directing the edge from its first vertex to its
+//! second.
+//! @param intersection_count Expected to be the number of elements in
+//! the given edge's intersection with the sphere.
+void create_intersection(Graph &graph, Edge_Intersection &intersection,
+			 const Mesh::Edge &edge, bool enters_on_first,
+			 std::size_t intersection_count);
+
 //! @brief Decides whether a given vector is inside the ball enclosed by a given
 //! sphere.
 //! @param v a reference to the given vector.
@@ -137,48 +144,27 @@ class Intersection_Mapper {
 bool is_in_ball(const math3d::Vector &v, const math3d::Sphere &sphere);
 
 // implementations
-Intersection_Mapper::Intersection_Mapper(Graph &graph,
-					 const Mesh::Vertex &vertex_seed,
-					 const math3d::Sphere &sphere)
-    : graph(graph),
-      sphere(sphere), intersection_map{
-			  1,
-			  [](const Key &node_ptrs) {
-				  std::size_t seed = 0;
-				  utility::hash_combine(seed, node_ptrs.first);
-				  utility::hash_combine(seed, node_ptrs.second);
-				  return seed;
-			  },
-			  [](const Key &node_ptrs_1, const Key &node_ptrs_2) {
-				  return (std::make_pair(node_ptrs_1.first,
-							 node_ptrs_1.second) ==
-					  std::make_pair(node_ptrs_2.first,
-							 node_ptrs_2.second));
-			  }} {
-	std::unordered_set<const Mesh::Vertex *> known_vertex_ptrs = {
-	    &vertex_seed};
-	std::unordered_set<const Mesh::Edge *> known_edge_ptrs;
-	std::vector<std::reference_wrapper<const Mesh::Vertex>>
-	    active_vertices = {vertex_seed};
-	std::vector<std::reference_wrapper<const Mesh::Edge>> active_edges;
-
-	auto notice_vertex = [&known_vertex_ptrs,
+void create_intersections(Graph &graph, const Mesh::Vertex &vertex_seed) {
+	const math3d::Sphere &sphere = graph.get_sphere();
+	auto &known_vertices = workspace.known_vertices;
+	auto &known_edges = workspace.known_edges;
+	auto &active_vertices = workspace.active_vertices;
+	auto &active_edges = workspace.active_edges;
+
+	known_vertices.insert(&vertex_seed, true);
+	active_vertices.push_back(&vertex_seed);
+
+	auto notice_vertex = [&known_vertices,
 			      &active_vertices](const Mesh::Vertex &vertex) {
-		bool vertex_is_new;
-		std::tie(std::ignore, vertex_is_new) =
-		    known_vertex_ptrs.insert(&vertex);
-		if (vertex_is_new) {
-			active_vertices.push_back(vertex);
+		if (known_vertices.insert(&vertex, true).second) {
+			active_vertices.push_back(&vertex);
 		}
 	};
 
-	auto notice_edge = [&known_edge_ptrs,
+	auto notice_edge = [&known_edges,
 			    &active_edges](const Mesh::Edge &edge) {
-		bool edge_is_new;
-		std::tie(std::ignore, edge_is_new) =
-		    known_edge_ptrs.insert(&edge);
-		if (edge_is_new) {
-			active_edges.push_back(edge);
+		if (known_edges.insert(&edge, Edge_Intersection{}).second) {
+			active_edges.push_back(&edge);
 		}
 	};
 
@@ -193,30 +179,28 @@ Intersection_Mapper::Intersection_Mapper(Graph &graph,
 		    }
 	    };
 
-	auto process_adjacency = [&sphere, &known_edge_ptrs,
-	              &notice_vertex,
-				  &notice_containing_triangle_edges, this](
+	auto process_adjacency = [&graph, &sphere, &known_edges,
+				  &notice_vertex,
+				  &notice_containing_triangle_edges](
 				     const Mesh::Vertex::Adjacency &adjacency) {
 		auto &edge = adjacency.get_edge();
-		bool edge_is_new;
-		std::tie(std::ignore, edge_is_new) =
-		    known_edge_ptrs.insert(&edge);
-		if (edge_is_new) {
+		auto inserted = known_edges.insert(&edge, Edge_Intersection{});
+		if (inserted.second) {
 			auto &other_vertex = adjacency.get_other_vertex();
 			if (is_in_ball(other_vertex.get_location(), sphere)) {
 				notice_vertex(other_vertex);
 			} else {
-				this->create_intersection(
-				    edge, &edge.get_vertex(0) == &other_vertex,
-				    1);
+				create_intersection(
+				    graph, *inserted.first, edge,
+				    &edge.get_vertex(0) == &other_vertex, 1);
 				notice_containing_triangle_edges(edge);
 			}
 		}
 	};
 
-	auto process_edge = [&sphere, &notice_vertex,
-			     &notice_containing_triangle_edges,
-			     this](const Mesh::Edge &edge) {
+	auto process_edge = [&graph, &sphere, &known_edges, &notice_vertex,
+			     &notice_containing_triangle_edges](
+				const Mesh::Edge &edge) {
 		auto &vertex_1 = edge.get_vertex(0);
 		auto &vertex_2 = edge.get_vertex(1);
 
@@ -230,7 +214,8 @@ Intersection_Mapper::Intersection_Mapper(Graph &graph,
 			notice_vertex(vertex_2);
 		}
 		if (is_in_ball_1 != is_in_ball_2) {
-			this->create_intersection(edge, !is_in_ball_1, 1);
+			create_intersection(graph, *known_edges.find(&edge),
+					    edge, !is_in_ball_1, 1);
 			notice_containing_triangle_edges(edge);
 		}
 		if (!is_in_ball_1 && !is_in_ball_2) {
@@ -246,15 +231,15 @@ Intersection_Mapper::Intersection_Mapper(Graph &graph,
 			double vector_2_norm2 =
 			    math3d::norm2(vector_2 - sphere.get_center());
 
+			double radius2 =
+			    sphere.get_radius() * sphere.get_radius();
 			if (dot_p < vector_1_norm2 && dot_p < vector_2_norm2 &&
-			    (vector_1_norm2 -
-			     std::pow(sphere.get_radius(), 2)) *
-				    (vector_2_norm2 -
-				     std::pow(sphere.get_radius(), 2)) <
-				std::pow(dot_p -
-					     std::pow(sphere.get_radius(), 2),
-					 2)) {
-				this->create_intersection(edge, true, 2);
+			    (vector_1_norm2 - radius2) *
+				    (vector_2_norm2 - radius2) <
+				(dot_p - radius2) * (dot_p - radius2)) {
+				create_intersection(graph,
+						    *known_edges.find(&edge),
+						    edge, true, 2);
 				notice_containing_triangle_edges(edge);
 			}
 		}
@@ -263,7 +248,7 @@ Intersection_Mapper::Intersection_Mapper(Graph &graph,
 	while (!active_vertices.empty() || !active_edges.empty()) {
 		while (!active_vertices.empty()) {
 			const Mesh::Vertex &current_vertex =
-			    active_vertices.back();
+			    *active_vertices.back();
 			active_vertices.pop_back();
 			for (const auto &adjacency :
 			     current_vertex.get_adjacencies()) {
@@ -271,78 +256,82 @@ Intersection_Mapper::Intersection_Mapper(Graph &graph,
 			}
 		}
 		while (!active_edges.empty()) {
-			const Mesh::Edge &current_edge = active_edges.back();
+			const Mesh::Edge &current_edge = *active_edges.back();
 			active_edges.pop_back();
 			process_edge(current_edge);
 		}
 	}
 }
 
-const std::vector<std::reference_wrapper<const Graph::Node>> *
-Intersection_Mapper::get(const Key &key) const {
-	auto it = this->intersection_map.find(key);
-	if (it == this->intersection_map.end()) {
-		return nullptr;
-	} else {
-		return &(it->second);
-	}
-}
-
-void Intersection_Mapper::create_intersection(const Mesh::Edge &edge,
-					      bool enters_on_first,
-					      std::size_t intersection_count) {
-
-	std::vector<std::reference_wrapper<const Graph::Node>> nodes;
+void create_intersection(Graph &graph, Edge_Intersection &intersection,
+			 const Mesh::Edge &edge, bool enters_on_first,
+			 std::size_t intersection_count) {
+	intersection.first_node = static_cast<Graph::Index>(
+	    graph.get_nodes().size());
+	intersection.node_count =
+	    static_cast<std::uint32_t>(intersection_count);
 	for (std::size_t position = 0; position < intersection_count;
 	     position++) {
-		const Graph::Node &node = this->graph.emplace_node(
-		    sphere, edge, enters_on_first, position);
-		nodes.push_back(node);
+		graph.emplace_node(edge, enters_on_first, position);
 	}
-	std::vector<std::reference_wrapper<const Graph::Node>> nodes_in_reverse;
-	std::reverse_copy(nodes.begin(), nodes.end(),
-			  std::back_inserter(nodes_in_reverse));
-
-	intersection_map[{&edge.get_vertex(0), &edge.get_vertex(1)}] = nodes;
-	intersection_map[{&edge.get_vertex(1), &edge.get_vertex(0)}] =
-	    nodes_in_reverse;
 }
 
 bool is_in_ball(const math3d::Vector &v, const math3d::Sphere &sphere) {
 	return math3d::norm2(v - sphere.get_center()) <
-	       std::pow(sphere.get_radius(), 2);
+	       sphere.get_radius() * sphere.get_radius();
 }
 
 } // namespace
 
 //! @endcond
 
-Graph::Graph(const Mesh::Vertex &vertex_seed, const math3d::Sphere &sphere) {
-	Intersection_Mapper intersection_mapper{*this, vertex_seed, sphere};
-
-	auto get_successor =
-	    [&intersection_mapper](const Mesh::Triangle &triangle,
-				   std::size_t edge_index) {
-		    std::size_t index_offset = 3;
-		    while (index_offset > 0) {
-			    index_offset--;
-			    const auto &vertex_1 = triangle.get_vertex(
-				(edge_index + index_offset) % 3);
-			    const auto &vertex_2 = triangle.get_vertex(
-				(edge_index + index_offset + 1) % 3);
-			    const auto *nodes_ptr =
-				intersection_mapper.get({&vertex_1, &vertex_2});
-
-			    if (nodes_ptr && !nodes_ptr->empty()) {
-				    return nodes_ptr->back();
-			    }
-		    }
-		    throw std::logic_error("Error: Impossible triangle "
-					   "intersection.");
-	    };
+Graph::Graph() : sphere(math3d::Vector{0, 0, 0}, 0) {}
+
+Graph::Graph(const Mesh::Vertex &vertex_seed, const math3d::Sphere &sphere)
+    : sphere(sphere) {
+	this->assign(vertex_seed, sphere);
+}
 
-	for (auto &node : this->nodes) {
+void Graph::assign(const Mesh::Vertex &vertex_seed,
+		   const math3d::Sphere &sphere) {
+	this->clear();
+	this->sphere = sphere;
+	workspace.clear();
+	create_intersections(*this, vertex_seed);
+
+	// the last node on the edge from vertex (edge_index + offset) % 3 to
+	// its successor for the largest offset, where the edge intersects.
+	auto get_successor = [](const Mesh::Triangle &triangle,
+				std::size_t edge_index) {
+		std::size_t index_offset = 3;
+		while (index_offset > 0) {
+			index_offset--;
+			std::size_t triangle_edge_idx =
+			    (edge_index + index_offset) % 3;
+			const auto &edge = triangle.get_edge(triangle_edge_idx);
+			const auto *intersection =
+			    workspace.known_edges.find(&edge);
+
+			if (intersection && intersection->node_count > 0) {
+				if (&edge.get_vertex(0) ==
+				    &triangle.get_vertex(triangle_edge_idx)) {
+					return intersection->first_node +
+					       intersection->node_count - 1;
+				} else {
+					return intersection->first_node;
+				}
+			}
+		}
+		throw std::logic_error("Error: Impossible triangle "
+				       "intersection.");
+	};
+
+	const Index node_count = static_cast<Index>(this->nodes.size());
+	for (Index node_idx = 0; node_idx < node_count; node_idx++) {
+		const Node &node = this->nodes[node_idx];
 		const Mesh::Edge &edge = node.get_edge();
+		const bool enters_on_first = node.enters_on_first;
+		const std::size_t position = node.position;
 		for (const auto &containing_triangle :
 		     edge.get_containing_triangles()) {
 			const Mesh::Triangle &triangle =
@@ -351,62 +340,147 @@ Graph::Graph(const Mesh::Vertex &vertex_seed, const math3d::Sphere &sphere) {
 			    containing_triangle.get_edge_index();
 
 			bool enters_on_node =
-			    ((node.enters_on_first !=
-			      (node.position % 2 == 1)) !=
+			    ((enters_on_first != (position % 2 == 1)) !=
 			     (&triangle.get_vertex(triangle_edge_idx) !=
 			      &edge.get_vertex(0)));
 
 			if (enters_on_node) {
-				const Graph::Node &successor =
+				Index successor =
 				    get_successor(triangle, triangle_edge_idx);
 
-				this->emplace_arc(sphere, triangle, node,
+				this->emplace_arc(triangle, node_idx,
 						  successor);
 			}
 		}
 	}
 }
 
-Graph::Node &Graph::emplace_node(const math3d::Sphere &sphere,
-				 const Mesh::Edge &edge,
+void Graph::clear() {
+	this->nodes.clear();
+	this->arcs.clear();
+	this->node_count = 0;
+	this->arc_count = 0;
+	this->first_node = 0;
+	this->first_arc = 0;
+}
+
+const math3d::Sphere &Graph::get_sphere() const { return this->sphere; }
+
+Graph::Index Graph::emplace_node(const Mesh::Edge &edge,
 				 const bool enters_on_first,
 				 const std::size_t position) {
-	this->nodes.emplace_back(sphere, edge, enters_on_first, position);
-	auto &node = this->nodes.back();
-	node.in_graph = --this->nodes.end();
-	return node;
+	this->nodes.emplace_back(edge, enters_on_first, position);
+	this->node_count++;
+	return static_cast<Index>(this->nodes.size() - 1);
 }
 
-Graph::Arc &Graph::emplace_arc(const math3d::Sphere &sphere,
-			       const Mesh::Triangle &triangle,
-			       const Node &start, const Node &end) {
-	this->arcs.emplace_back(sphere, triangle, start, end);
-	auto &arc = this->arcs.back();
-	start.outgoing_arcs.push_back(arc);
-	end.incoming_arcs.push_back(arc);
-	arc.in_graph = --this->arcs.end();
-	arc.in_start = --start.outgoing_arcs.end();
-	arc.in_end = --end.incoming_arcs.end();
-
-	return arc;
+Graph::Index Graph::emplace_arc(const Mesh::Triangle &triangle,
+				const Index start, const Index end) {
+	const Index arc_idx = static_cast<Index>(this->arcs.size());
+	this->arcs.emplace_back(triangle, start, end);
+	Arc &arc = this->arcs.back();
+
+	Node &start_node = this->nodes[start];
+	arc.previous_outgoing = start_node.last_outgoing;
+	if (start_node.last_outgoing == no_index) {
+		start_node.first_outgoing = arc_idx;
+	} else {
+		this->arcs[start_node.last_outgoing].next_outgoing = arc_idx;
+	}
+	start_node.last_outgoing = arc_idx;
+
+	Node &end_node = this->nodes[end];
+	arc.previous_incoming = end_node.last_incoming;
+	if (end_node.last_incoming == no_index) {
+		end_node.first_incoming = arc_idx;
+	} else {
+		this->arcs[end_node.last_incoming].next_incoming = arc_idx;
+	}
+	end_node.last_incoming = arc_idx;
+
+	this->arc_count++;
+	return arc_idx;
 }
 
-void Graph::erase_node(const Node &node) {
-	while (!node.incoming_arcs.empty()) {
-		this->erase_arc(node.incoming_arcs.front());
+void Graph::erase_node(const Index node) {
+	Node &erased_node = this->nodes[node];
+	assert(!erased_node.erased);
+	while (erased_node.first_incoming != no_index) {
+		this->erase_arc(erased_node.first_incoming);
+	}
+	while (erased_node.first_outgoing != no_index) {
+		this->erase_arc(erased_node.first_outgoing);
+	}
+	erased_node.erased = true;
+	this->node_count--;
+	while (this->first_node < this->nodes.size() &&
+	       this->nodes[this->first_node].erased) {
+		this->first_node++;
+	}
+}
+
+void Graph::erase_arc(const Index arc) {
+	Arc &erased_arc = this->arcs[arc];
+	assert(!erased_arc.erased);
+
+	Node &start_node = this->nodes[erased_arc.start];
+	if (erased_arc.previous_outgoing == no_index) {
+		start_node.first_outgoing = erased_arc.next_outgoing;
+	} else {
+		this->arcs[erased_arc.previous_outgoing].next_outgoing =
+		    erased_arc.next_outgoing;
+	}
+	if (erased_arc.next_outgoing == no_index) {
+		start_node.last_outgoing = erased_arc.previous_outgoing;
+	} else {
+		this->arcs[erased_arc.next_outgoing].previous_outgoing =
+		    erased_arc.previous_outgoing;
+	}
+
+	Node &end_node = this->nodes[erased_arc.end];
+	if (erased_arc.previous_incoming == no_index) {
+		end_node.first_incoming = erased_arc.next_incoming;
+	} else {
+		this->arcs[erased_arc.previous_incoming].next_incoming =
+		    erased_arc.next_incoming;
 	}
-	while (!node.outgoing_arcs.empty()) {
-		this->erase_arc(node.outgoing_arcs.front());
+	if (erased_arc.next_incoming == no_index) {
+		end_node.last_incoming = erased_arc.previous_incoming;
+	} else {
+		this->arcs[erased_arc.next_incoming].previous_incoming =
+		    erased_arc.previous_incoming;
+	}
+
+	erased_arc.erased = true;
+	this->arc_count--;
+	while (this->first_arc < this->arcs.size() &&
+	       this->arcs[this->first_arc].erased) {
+		this->first_arc++;
 	}
-	this->nodes.erase(node.in_graph);
 }
 
-void Graph::erase_arc(const Arc &arc) {
-	arc.start.outgoing_arcs.erase(arc.in_start);
-	arc.end.incoming_arcs.erase(arc.in_end);
-	this->arcs.erase(arc.in_graph);
+const Graph::Node &Graph::get_node(const Index node) const {
+	return this->nodes[node];
+}
+
+const Graph::Arc &Graph::get_arc(const Index arc) const {
+	return this->arcs[arc];
 }
 
 const Graph::Node_Container &Graph::get_nodes() const { return this->nodes; }
 
 const Graph::Arc_Container &Graph::get_arcs() const { return this->arcs; }
+
+std::size_t Graph::get_node_count() const { return this->node_count; }
+
+std::size_t Graph::get_arc_count() const { return this->arc_count; }
+
+Graph::Index Graph::get_first_node() const {
+	return (this->first_node < this->nodes.size()) ? this->first_node
+							: no_index;
+}
+
+Graph::Index Graph::get_first_arc() const {
+	return (this->first_arc < this->arcs.size()) ? this->first_arc
+						      : no_index;
+}
@@ -38,14 +38,16 @@ namespace {
 //! @brief Computes a unit vector describing the direction from the given arc's
 //! start node's location to its end node's location. Estimates direction when
 //! the distance from these locations is less than the given tolerance.
+//! @param graph the graph containing the arc.
 //! @param arc the arc.
 //! @param tolerance the tolerance.
 //! @return The unit vector describing the direction.
-math3d::Vector get_direction(const Graph::Arc &arc, double tolerance) {
-	const auto &start = arc.get_start();
-	const auto &end = arc.get_end();
-	auto start_location = get_location(start);
-	auto end_location = get_location(end);
+math3d::Vector get_direction(const Graph &graph, const Graph::Arc &arc,
+			     double tolerance) {
+	const auto &start = graph.get_node(arc.get_start());
+	const auto &end = graph.get_node(arc.get_end());
+	auto start_location = get_location(graph, start);
+	auto end_location = get_location(graph, end);
 
 	auto try_normalize = [&tolerance](const math3d::Vector &v) {
 		auto norm2 = math3d::norm2(v);
@@ -126,18 +128,21 @@ math3d::Vector get_direction(const Graph::Arc &arc, double tolerance) {
 
 //! @endcond
 
-Arc_Curve::Arc_Curve(const Graph::Arc &arc, const double tolerance) {
+Arc_Curve::Arc_Curve(const Graph &graph, const Graph::Arc &arc,
+		     const double tolerance) {
 	math3d::Vector v_1 = arc.get_triangle().get_vertex(0).get_location();
 	math3d::Vector v_2 = arc.get_triangle().get_vertex(1).get_location();
 	math3d::Vector v_3 = arc.get_triangle().get_vertex(2).get_location();
 	math3d::Vector triangle_normal_vec =
 	    math3d::cross_product(v_2 - v_1, v_3 - v_1);
 
-	math3d::Vector sphere_center = arc.get_sphere().get_center();
-	double sphere_radius = arc.get_sphere().get_radius();
+	math3d::Vector sphere_center = graph.get_sphere().get_center();
+	double sphere_radius = graph.get_sphere().get_radius();
 
-	math3d::Vector start_location = get_location(arc.get_start());
-	math3d::Vector end_location = get_location(arc.get_end());
+	math3d::Vector start_location =
+	    get_location(graph, graph.get_node(arc.get_start()));
+	math3d::Vector end_location =
+	    get_location(graph, graph.get_node(arc.get_end()));
 
 	math3d::Vector triangle_normal = [&] {
 		if (math3d::norm2(triangle_normal_vec) <
@@ -185,7 +190,7 @@ Arc_Curve::Arc_Curve(const Graph::Arc &arc, const double tolerance) {
 		// close start and end locations a good enough
 		// estimate for the line is implicetly used
 		math3d::Vector line_normal_vec = math3d::cross_product(
-		    get_direction(arc, tolerance), triangle_normal);
+		    get_direction(graph, arc, tolerance), triangle_normal);
 		if (math3d::dot_product(start_location - this->center,
 					line_normal_vec) <= 0) {
 			return math3d::get_angle(start_location - this->center,
@@ -238,15 +243,17 @@ double Arc_Curve::get_geodesic_curvature() const {
 
 double Arc_Curve::get_length() const { return this->length; }
 
-math3d::Vector spherical_intersection::get_location(const Graph::Node &node) {
+math3d::Vector spherical_intersection::get_location(const Graph &graph,
+						    const Graph::Node &node) {
 	const auto &vertex_1 = node.get_edge().get_vertex(0);
 	const auto &vertex_2 = node.get_edge().get_vertex(1);
 
-	const auto &sphere = node.get_sphere();
+	const auto &sphere = graph.get_sphere();
 	math3d::Vector u = vertex_1.get_location() - sphere.get_center();
 	math3d::Vector v = vertex_2.get_location() - sphere.get_center();
 
-	std::vector<double> factors;
+	// at most two intersections, hence no need for a dynamic container.
+	double factors[2];
 
 	double a = math3d::norm2(v - u);
 	assert(a != 0);
@@ -259,24 +266,25 @@ math3d::Vector spherical_intersection::get_location(const Graph::Node &node) {
 		d = 0;
 	}
 	if (d == 0) {
-		factors.push_back(-b / (2 * a));
-		factors.push_back(-b / (2 * a));
+		factors[0] = -b / (2 * a);
+		factors[1] = -b / (2 * a);
 	} else {
 		double sqrt_d = std::sqrt(d);
 		if (node.get_enters_on_first()) {
 			if (a > 0) {
-				factors.push_back((-b - sqrt_d) / (2 * a));
-				factors.push_back((-b + sqrt_d) / (2 * a));
+				factors[0] = (-b - sqrt_d) / (2 * a);
+				factors[1] = (-b + sqrt_d) / (2 * a);
 			} else {
-				factors.push_back((-b + sqrt_d) / (2 * a));
-				factors.push_back((-b - sqrt_d) / (2 * a));
+				factors[0] = (-b + sqrt_d) / (2 * a);
+				factors[1] = (-b - sqrt_d) / (2 * a);
 			}
 		} else {
 			if (a > 0) {
-				factors.push_back((-b + sqrt_d) / (2 * a));
+				factors[0] = (-b + sqrt_d) / (2 * a);
 			} else {
-				factors.push_back((-b - sqrt_d) / (2 * a));
+				factors[0] = (-b - sqrt_d) / (2 * a);
 			}
+			factors[1] = factors[0];
 		}
 	}
 
@@ -60,42 +60,38 @@ std::string graph_visualization::to_string(const Graph &graph) {
 		ss << ptr_to_id(static_cast<const void *>(&node));
 		return ss.str();
 	};
-	auto to_succession = [&arc_to_str,
+	auto to_succession = [&graph, &arc_to_str,
 			      &successor_to_str](const Graph::Arc &arc) {
 		std::stringstream ss;
 		std::string arc_as_string = arc_to_str(arc);
 		if (!arc_as_string.empty()) {
 			ss << arc_as_string << " ";
 		}
-		ss << successor_to_str(arc.get_end());
+		ss << successor_to_str(graph.get_node(arc.get_end()));
 		return ss.str();
 	};
-	auto to_adjacency_list = [&node_to_str,
+	auto to_adjacency_list = [&graph, &node_to_str,
 				  &to_succession](const Graph::Node &node) {
 		std::stringstream ss;
 		ss << node_to_str(node) << ":";
-		const typename Graph::Node::Arc_Container &outgoing_arcs =
-		    node.get_outgoing_arcs();
-		auto arc_it = outgoing_arcs.begin();
-		if (arc_it != outgoing_arcs.end()) {
-			ss << " " << to_succession(*arc_it);
-			++arc_it;
-		}
-		for (; arc_it != outgoing_arcs.end(); ++arc_it) {
-			ss << ", " << to_succession(*arc_it);
+		const char *separator = " ";
+		for (Graph::Index arc = node.get_first_outgoing_arc();
+		     arc != Graph::no_index;
+		     arc = graph.get_arc(arc).get_next_outgoing()) {
+			ss << separator << to_succession(graph.get_arc(arc));
+			separator = ", ";
 		}
 		return ss.str();
 	};
 	std::stringstream ss;
 	ss << "directed multigraph " << &graph << " as successor lists:\n";
-	const typename Graph::Node_Container &nodes = graph.get_nodes();
-	auto node_it = nodes.begin();
-	if (node_it != nodes.end()) {
-		ss << to_adjacency_list(*node_it);
-		++node_it;
-	}
-	for (; node_it != nodes.end(); ++node_it) {
-		ss << "\n" << to_adjacency_list(*node_it);
+	const char *separator = "";
+	for (const auto &node : graph.get_nodes()) {
+		if (node.is_erased()) {
+			continue;
+		}
+		ss << separator << to_adjacency_list(node);
+		separator = "\n";
 	}
 	return ss.str();
 }
@@ -121,7 +117,10 @@ graph_visualization::to_raw_mesh(const Graph &graph,
 	    };
 
 	for (const auto &arc : arcs) {
-		Arc_Curve curve(arc);
+		if (arc.is_erased()) {
+			continue;
+		}
+		Arc_Curve curve(graph, arc);
 		auto generate_verts = [&append_vertex_location, &curve](
 					  double pos, double offset_scale) {
 			auto center = curve.eval(pos);
@@ -135,7 +134,7 @@ graph_visualization::to_raw_mesh(const Graph &graph,
 			append_vertex_location(center - v_offset);
 		};
 
-		auto arc_scale = 0.1 * arc.get_sphere().get_radius();
+		auto arc_scale = 0.1 * graph.get_sphere().get_radius();
 		generate_verts(0, arc_scale);
 
 		for (unsigned int i = 1; i <= arc_resolution; i++) {
@@ -24,6 +24,7 @@
 #include <cassert>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <unordered_map>
 
 #include "mesh_spherical.h"
@@ -142,6 +143,156 @@ void Mesh::add_triangle(const Vertex &vertex_1, const Vertex &vertex_2,
 	edge_3.containing_triangles.emplace_back(triangle, 2);
 }
 
+void Mesh::add_triangles(
+    const std::vector<std::array<std::size_t, 3>> &triangle_vertex_indices) {
+	const std::size_t vertex_count = this->vertices.size();
+	for (const auto &indices : triangle_vertex_indices) {
+		for (const auto index : indices) {
+			if (index >= vertex_count) {
+				throw std::out_of_range("Vertex index out of bounds.");
+			}
+		}
+	}
+
+	if (!this->triangles.empty()) {
+		// new sides might be edges that already exist.
+		for (const auto &indices : triangle_vertex_indices) {
+			this->add_triangle(this->vertices[indices[0]],
+					   this->vertices[indices[1]],
+					   this->vertices[indices[2]]);
+		}
+		return;
+	}
+
+	// the side with index i is the side of the triangle i / 3 starting
+	// at its vertex i % 3 like the edges of a triangle in add_triangle.
+	const std::size_t side_count = 3 * triangle_vertex_indices.size();
+	auto get_side_start = [&triangle_vertex_indices](const std::size_t side) {
+		return triangle_vertex_indices[side / 3][side % 3];
+	};
+	auto get_side_end = [&triangle_vertex_indices](const std::size_t side) {
+		return triangle_vertex_indices[side / 3][(side + 1) % 3];
+	};
+
+	// bucket the sides by their smaller vertex index keeping their order.
+	std::vector<std::size_t> bucket_offsets(vertex_count + 1, 0);
+	for (std::size_t side = 0; side < side_count; side++) {
+		bucket_offsets[std::min(get_side_start(side),
+					get_side_end(side)) +
+			       1]++;
+	}
+	for (std::size_t vertex = 0; vertex < vertex_count; vertex++) {
+		bucket_offsets[vertex + 1] += bucket_offsets[vertex];
+	}
+	std::vector<std::size_t> bucket_sides(side_count);
+	{
+		std::vector<std::size_t> fill_positions(
+		    bucket_offsets.begin(), bucket_offsets.end() - 1);
+		for (std::size_t side = 0; side < side_count; side++) {
+			bucket_sides[fill_positions[std::min(
+			    get_side_start(side), get_side_end(side))]++] =
+			    side;
+		}
+	}
+
+	// within a bucket, sides with the same larger vertex index belong to
+	// the same edge, which is represented by the first of these sides.
+	std::vector<std::size_t> side_to_edge(side_count);
+	for (std::size_t vertex = 0; vertex < vertex_count; vertex++) {
+		auto bucket_begin = bucket_sides.begin() + bucket_offsets[vertex];
+		auto bucket_end = bucket_sides.begin() + bucket_offsets[vertex + 1];
+		auto get_other_vertex = [&](const std::size_t side) {
+			return std::max(get_side_start(side), get_side_end(side));
+		};
+		std::sort(bucket_begin, bucket_end,
+			  [&get_other_vertex](const std::size_t side_1,
+					      const std::size_t side_2) {
+				  return std::make_pair(get_other_vertex(side_1),
+							side_1) <
+					 std::make_pair(get_other_vertex(side_2),
+							side_2);
+			  });
+		for (auto it = bucket_begin; it != bucket_end;) {
+			const std::size_t first_side = *it;
+			const std::size_t other_vertex =
+			    get_other_vertex(first_side);
+			for (; it != bucket_end &&
+			       get_other_vertex(*it) == other_vertex;
+			     it++) {
+				side_to_edge[*it] = first_side;
+			}
+		}
+	}
+	bucket_sides = std::vector<std::size_t>();
+	bucket_offsets = std::vector<std::size_t>();
+
+	// number the edges in the order of their first side, which is the
+	// order in which add_triangle creates them. The first side of an edge
+	// precedes all its other sides, so the numbering can be done in place.
+	std::size_t edge_count = 0;
+	for (std::size_t side = 0; side < side_count; side++) {
+		const std::size_t first_side = side_to_edge[side];
+		side_to_edge[side] = (first_side == side)
+					 ? edge_count++
+					 : side_to_edge[first_side];
+	}
+
+	// reserve the adjacency and containing triangle information.
+	std::vector<std::size_t> adjacency_counts(vertex_count, 0);
+	std::vector<unsigned int> containing_triangle_counts(edge_count, 0);
+	for (std::size_t side = 0, next_edge = 0; side < side_count; side++) {
+		if (side_to_edge[side] == next_edge) {
+			adjacency_counts[get_side_start(side)]++;
+			adjacency_counts[get_side_end(side)]++;
+			next_edge++;
+		}
+		containing_triangle_counts[side_to_edge[side]]++;
+	}
+	for (std::size_t vertex = 0; vertex < vertex_count; vertex++) {
+		auto &adjacencies = this->vertices[vertex].adjacencies;
+		adjacencies.reserve(adjacencies.size() +
+				    adjacency_counts[vertex]);
+	}
+
+	// create the edges as add_triangle does.
+	for (std::size_t side = 0; side < side_count; side++) {
+		if (side_to_edge[side] != this->edges.size()) {
+			continue;
+		}
+		const auto &vertex_1 = this->vertices[get_side_start(side)];
+		const auto &vertex_2 = this->vertices[get_side_end(side)];
+		this->edges.emplace_back(vertex_1, vertex_2);
+		auto &edge = this->edges.back();
+		edge.containing_triangles.reserve(
+		    containing_triangle_counts[side_to_edge[side]]);
+		vertex_1.adjacencies.emplace_back(edge, vertex_2);
+		vertex_2.adjacencies.emplace_back(edge, vertex_1);
+	}
+
+	// create the triangles.
+	for (std::size_t triangle_index = 0;
+	     triangle_index < triangle_vertex_indices.size(); triangle_index++) {
+		const auto &indices = triangle_vertex_indices[triangle_index];
+		const std::size_t first_side = 3 * triangle_index;
+		auto &edge_1 = this->edges[side_to_edge[first_side]];
+		auto &edge_2 = this->edges[side_to_edge[first_side + 1]];
+		auto &edge_3 = this->edges[side_to_edge[first_side + 2]];
+
+		this->triangles.emplace_back(
+		    std::array<std::reference_wrapper<const Vertex>, 3>{
+			this->vertices[indices[0]], this->vertices[indices[1]],
+			this->vertices[indices[2]]},
+		    std::array<std::reference_wrapper<const Edge>, 3>{
+			edge_1, edge_2, edge_3});
+
+		const auto &triangle = triangles.back();
+
+		edge_1.containing_triangles.emplace_back(triangle, 0);
+		edge_2.containing_triangles.emplace_back(triangle, 1);
+		edge_3.containing_triangles.emplace_back(triangle, 2);
+	}
+}
+
 const Mesh::Vertex_Container &Mesh::get_vertices() const {
 	return this->vertices;
 }
@@ -151,6 +302,13 @@ const Mesh::Triangle_Container &Mesh::get_triangles() const {
 }
 
 Mesh::Edge &Mesh::to_edge(const Vertex &vertex_1, const Vertex &vertex_2) {
+	if (this->vertex_ptrs_to_edge.size() != this->edges.size()) {
+		// add_triangles creates edges without the hash map.
+		for (auto &edge : this->edges) {
+			this->vertex_ptrs_to_edge.insert(
+			    {{&edge.vertex_1, &edge.vertex_2}, edge});
+		}
+	}
 	auto it = this->vertex_ptrs_to_edge.find({&vertex_1, &vertex_2});
 	if (it == this->vertex_ptrs_to_edge.end()) {
 		this->edges.emplace_back(vertex_1, vertex_2);
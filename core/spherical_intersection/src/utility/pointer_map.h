@@ -0,0 +1,142 @@
+/* * GigaMesh - The GigaMesh Software Framework is a modular software for display,
+ * editing and visualization of 3D-data typically acquired with structured light or
+ * structure from motion.
+ * Copyright (C) 2009-2020 Hubert Mara
+ *
+ * This file is part of GigaMesh.
+ *
+ * GigaMesh is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GigaMesh is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPHERICAL_INTERSECTION_IMPLEMENTATION_UTILITY_POINTER_MAP_H
+#define SPHERICAL_INTERSECTION_IMPLEMENTATION_UTILITY_POINTER_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//! @cond DEV
+
+namespace spherical_intersection {
+namespace utility {
+//! @brief Map from pointers to values using open addressing with linear
+//! probing.
+//!
+//! Intended as reusable scratch memory: clearing is done in constant time by
+//! advancing a generation counter, so the slots are neither freed nor
+//! touched. Value has to be default constructible and copy assignable.
+template <class Key, class Value> class Pointer_Map {
+      public:
+	//! @brief Maps a given key to a given value unless the key is already
+	//! mapped.
+	//! @param key the given key.
+	//! @param value the given value.
+	//! @return A pointer to the value the key is mapped to and true if and
+	//! only if the key was not mapped before. The pointer is valid until
+	//! the next insertion.
+	std::pair<Value *, bool> insert(const Key *key, const Value &value) {
+		if (2 * (this->size + 1) > this->slots.size()) {
+			this->grow();
+		}
+		std::size_t slot_index = this->find_slot(key);
+		Slot &slot = this->slots[slot_index];
+		if (slot.generation == this->generation) {
+			return {&slot.value, false};
+		}
+		slot.key = key;
+		slot.value = value;
+		slot.generation = this->generation;
+		this->size++;
+		return {&slot.value, true};
+	}
+
+	//! @brief Applies the map to a given key.
+	//! @param key the given key.
+	//! @return A pointer to the value the key is mapped to or nullptr if
+	//! the key is not mapped.
+	Value *find(const Key *key) {
+		if (this->size == 0) {
+			return nullptr;
+		}
+		Slot &slot = this->slots[this->find_slot(key)];
+		return (slot.generation == this->generation) ? &slot.value
+							     : nullptr;
+	}
+
+	//! @brief Removes all keys while keeping the allocated memory.
+	void clear() {
+		this->size = 0;
+		this->generation++;
+		if (this->generation == 0) {
+			// wrap around: stale slots could become valid again.
+			for (auto &slot : this->slots) {
+				slot.generation = 0;
+			}
+			this->generation = 1;
+		}
+	}
+
+      private:
+	struct Slot {
+		const Key *key = nullptr;
+		std::uint32_t generation = 0;
+		Value value{};
+	};
+
+	std::vector<Slot> slots;
+	std::size_t size = 0;
+	std::uint32_t generation = 1;
+
+	//! @brief Finds the slot containing a given key or the free slot,
+	//! where it would be inserted. Expects at least one free slot.
+	std::size_t find_slot(const Key *key) const {
+		const std::size_t mask = this->slots.size() - 1;
+		std::uint64_t hash =
+		    static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key)) *
+		    0x9E3779B97F4A7C15ULL;
+		std::size_t slot_index = static_cast<std::size_t>(hash >> 32) & mask;
+		while (this->slots[slot_index].generation == this->generation &&
+		       this->slots[slot_index].key != key) {
+			slot_index = (slot_index + 1) & mask;
+		}
+		return slot_index;
+	}
+
+	//! @brief Doubles the number of slots (a power of two) and reinserts
+	//! the keys of the current generation.
+	void grow() {
+		std::vector<Slot> old_slots(std::max<std::size_t>(
+		    64, 2 * this->slots.size()));
+		old_slots.swap(this->slots);
+		const std::uint32_t old_generation = this->generation;
+		this->generation = 1;
+		for (const auto &old_slot : old_slots) {
+			if (old_slot.generation == old_generation) {
+				Slot &slot =
+				    this->slots[this->find_slot(old_slot.key)];
+				slot.key = old_slot.key;
+				slot.value = old_slot.value;
+				slot.generation = this->generation;
+			}
+		}
+	}
+};
+} // namespace utility
+} // namespace spherical_intersection
+
+//! @endcond
+
+#endif
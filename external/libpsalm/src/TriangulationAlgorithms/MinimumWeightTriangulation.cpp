@@ -5,6 +5,9 @@
 
 #include "MinimumWeightTriangulation.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace psalm
 {
 
@@ -15,6 +18,7 @@ namespace psalm
 
 MinimumWeightTriangulation::MinimumWeightTriangulation()
 {
+	num_vertices = 0;
 	objective_function = minimum_area_and_normal_angle;
 }
 
@@ -23,6 +27,12 @@ MinimumWeightTriangulation::MinimumWeightTriangulation()
 *	requires the input mesh to consist solely of unconnected points. If
 *	this is not the case, the function will abort.
 *
+*	The weights of the sub-polygons are stored in contiguous triangular
+*	tables: once row by row and once column by column, so that both
+*	operands of the inner loop are read sequentially. All sub-polygons
+*	spanning the same number of vertices (a diagonal of the table) are
+*	independent of each other and are computed in parallel.
+*
 *	@param input_mesh Mesh that will be triangulated.
 *
 *	@return true if the mesh could be triangulated, else false. Errors may
@@ -43,48 +53,102 @@ bool MinimumWeightTriangulation::apply_to(mesh& input_mesh)
 		return(false);
 	}
 
-	indices = new size_t*[n];		// store minimum indices (private member)
-	ktuple** weights = new ktuple*[n];	// store weights of triangulation (only required locally)
+	num_vertices = n;
+	size_t num_pairs = n*(n-1)/2;
+	indices.assign(num_pairs, std::numeric_limits<size_t>::max());		// store minimum indices (private member)
+	std::vector<ktuple> weights_by_row(num_pairs);				// store weights of triangulation (only required locally)
+	std::vector<ktuple> weights_by_column(num_pairs);
 
-	for(size_t i = 0; i < n-1; i++)
+	// The default objective function is evaluated using positions and
+	// normalized normals, which are fetched only once per vertex.
+	bool use_normal_angle = (objective_function == static_cast<ktuple (*)(const vertex*, const vertex*, const vertex*)>(minimum_area_and_normal_angle));
+	std::vector<v3ctor> positions(n);
+	std::vector<v3ctor> normals(n);
+	for(size_t i = 0; i < n; i++)
+	{
+		positions[i]	= input_mesh.get_vertex(i)->get_position();
+		normals[i]	= input_mesh.get_vertex(i)->get_normal().normalize();
+	}
+
+	auto weight_of = [&](size_t i, size_t m, size_t k)
+	{
+		if(use_normal_angle)
+		{
+			double cosines[3];
+			double area = normal_angle_cosines(	positions[i], positions[m], positions[k],
+								normals[i], normals[m], normals[k], cosines);
+			return(minimum_area_and_normal_angle(cosines, area));
+		}
+
+		return(objective_function(	input_mesh.get_vertex(i),
+						input_mesh.get_vertex(m),
+						input_mesh.get_vertex(k)));
+	};
+
+	auto set_weight = [&](size_t i, size_t k, const ktuple& weight)
 	{
-		indices[i] = new size_t[n];
-		weights[i] = new ktuple[n];
+		weights_by_row[row_index(i, k)]		= weight;
+		weights_by_column[column_index(i, k)]	= weight;
+	};
 
-		// Initialize weights array correctly
-		if(i < n-1)
-			weights[i][i+1] = ktuple( 0.0, 0.0 );
+	// Initialize weights array correctly
+	for(size_t i = 0; i < n-1; i++)
+	{
+		set_weight(i, i+1, ktuple( 0.0, 0.0 ));
 		if(i < n-2)
-			weights[i][i+2] = objective_function(	input_mesh.get_vertex(i),
-								input_mesh.get_vertex(i+1),
-								input_mesh.get_vertex(i+2));
+			set_weight(i, i+2, weight_of(i, i+1, i+2));
 	}
 
-	size_t j = 2;
-	while(j++ < n-1)	// this is correct -- the loop is supposed to start
-				// with j == 3
+	// Computes the sub-polygons [i, i+j] for all i in [begin, end)
+	auto solve_diagonal = [&](size_t j, size_t begin, size_t end)
 	{
-		for(size_t i = 0; i < n-j; i++)
+		for(size_t i = begin; i < end; i++)
 		{
 			size_t k = i+j;
 
+			// Weights of [i, m] and [m, k] for m = i+1, ..., k-1
+			const ktuple* weights_i = &weights_by_row[row_index(i, i+1)];
+			const ktuple* weights_k = &weights_by_column[column_index(i+1, k)];
+
 			// Find minimum
 			ktuple min_weight = ktuple(std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
 			size_t min_index = std::numeric_limits<size_t>::max();
 			for(size_t m = i+1; m < k; m++)
 			{
-				ktuple cur_weight = objective_function(	input_mesh.get_vertex(i),
-									input_mesh.get_vertex(m),
-									input_mesh.get_vertex(k));
+				const ktuple& weight_im = weights_i[m-i-1];
+				const ktuple& weight_mk = weights_k[m-i-1];
+
+				ktuple cur_weight;
+				if(use_normal_angle)
+				{
+					double cosines[3];
+					double area = normal_angle_cosines(	positions[i], positions[m], positions[k],
+										normals[i], normals[m], normals[k], cosines);
+
+					// The angle of the triangle is a number, when all
+					// cosines are within [-1, 1]. Then the angle of the
+					// result is at least the one of the sub-polygons, so
+					// it can not become the minimum. This avoids the
+					// evaluation of acos() for most of the candidates.
+					if(	std::max(weight_im.first, weight_mk.first) > min_weight.first &&
+						std::fabs(cosines[0]) <= 1.0 &&
+						std::fabs(cosines[1]) <= 1.0 &&
+						std::fabs(cosines[2]) <= 1.0)
+						continue;
+
+					cur_weight = minimum_area_and_normal_angle(cosines, area);
+				}
+				else
+					cur_weight = weight_of(i, m, k);
 
 				// The first component of the tuples can be
 				// added; for the second component, only the
 				// maximum of _all_ tuples is used
 
-				double area	= weights[i][m].second+weights[m][k].second+cur_weight.second;
+				double area	= weight_im.second+weight_mk.second+cur_weight.second;
 				double angle	= std::max(	cur_weight.first,
-								std::max(	weights[i][m].first,
-										weights[m][k].first));
+								std::max(	weight_im.first,
+										weight_mk.first));
 
 				ktuple res = ktuple(angle, area);
 				if(res < min_weight)
@@ -94,23 +158,45 @@ bool MinimumWeightTriangulation::apply_to(mesh& input_mesh)
 				}
 			}
 
-			weights[i][k] = min_weight;
-			indices[i][k] = min_index;
+			set_weight(i, k, min_weight);
+			indices[row_index(i, k)] = min_index;
 		}
-	}
+	};
 
-	// Now weights[0][n-1] contains the weight of the minimal
-	// triangulation. Construct triangulation using the stored indices.
-	bool result = construct_triangulation(input_mesh, 0, n-1);
+	// Small diagonals are not worth starting threads
+	const size_t min_parallel_evaluations = 1 << 14;
+	const size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
 
-	for(size_t i = 0; i < n-1; i++)
+	for(size_t j = 3; j < n; j++)
 	{
-		delete[] weights[i];
-		delete[] indices[i];
+		size_t num_polygons = n-j;
+		size_t num_chunks = std::min(num_threads, num_polygons);
+		if(num_chunks <= 1 || num_polygons*(j-1) < min_parallel_evaluations)
+		{
+			solve_diagonal(j, 0, num_polygons);
+			continue;
+		}
+
+		std::vector<std::thread> threads;
+		threads.reserve(num_chunks-1);
+		for(size_t chunk = 1; chunk < num_chunks; chunk++)
+		{
+			threads.emplace_back(	solve_diagonal, j,
+						chunk*num_polygons/num_chunks,
+						(chunk+1)*num_polygons/num_chunks);
+		}
+
+		solve_diagonal(j, 0, num_polygons/num_chunks);
+		for(auto& thread : threads)
+			thread.join();
 	}
 
-	delete[] weights;
-	delete[] indices;
+	// Now the weight of [0, n-1] is the weight of the minimal
+	// triangulation. Construct triangulation using the stored indices.
+	bool result = construct_triangulation(input_mesh, 0, n-1);
+
+	indices.clear();
+	indices.shrink_to_fit();
 
 	/*
 		Mark _all_ vertices as boundary vertices. Upon subdivision, the
@@ -155,7 +241,7 @@ bool MinimumWeightTriangulation::construct_triangulation(mesh& input_mesh, size_
 	// use minimum index to branch off
 	else
 	{
-		size_t j = indices[i][k];
+		size_t j = indices[row_index(i, k)];
 		if(j != i+1)
 		{
 			if(!construct_triangulation(input_mesh, i, j))
@@ -7,6 +7,7 @@
 #define __MINIMUM_WEIGHT_TRIANGULATION_H__
 
 #include <cmath>
+#include <vector>
 
 #include "TriangulationAlgorithm.h"
 
@@ -31,9 +32,16 @@ class MinimumWeightTriangulation : public TriangulationAlgorithm
 		bool apply_to(mesh& input_mesh);
 
 	protected:
-		size_t** indices;	///< Stores the index that achieves the
-					///< minimum for the minimum-weight
-					///< triangulation.
+		size_t num_vertices;		///< Number of vertices of the polygon
+						///< being triangulated.
+
+		std::vector<size_t> indices;	///< Stores the index that achieves the
+						///< minimum for the minimum-weight
+						///< triangulation for all pairs i < k,
+						///< see row_index().
+
+		size_t row_index(size_t i, size_t k) const;
+		size_t column_index(size_t i, size_t k) const;
 
 		bool construct_triangulation(mesh& input_mesh, size_t i, size_t k);
 
@@ -42,8 +50,40 @@ class MinimumWeightTriangulation : public TriangulationAlgorithm
 		static ktuple minimum_area(const vertex* v1, const vertex* v2, const vertex* v3);
 		static ktuple minimum_area_and_angle(const vertex* v1, const vertex* v2, const vertex* v3);
 		static ktuple minimum_area_and_normal_angle(const vertex* v1, const vertex* v2, const vertex* v3);
+		static double normal_angle_cosines(	const v3ctor& A, const v3ctor& B, const v3ctor& C,
+							const v3ctor& nA, const v3ctor& nB, const v3ctor& nC,
+							double cosines[3]);
+		static ktuple minimum_area_and_normal_angle(const double cosines[3], double area);
 };
 
+/*!
+*	@param i Smaller index of the pair
+*	@param k Larger index of the pair
+*
+*	@return Position of the pair (i, k) within a table storing the upper
+*	triangle row by row, i.e. the entries (i, i+1), ..., (i, n-1) are
+*	contiguous.
+*/
+
+inline size_t MinimumWeightTriangulation::row_index(size_t i, size_t k) const
+{
+	return(i*num_vertices - i*(i+1)/2 + (k-i-1));
+}
+
+/*!
+*	@param i Smaller index of the pair
+*	@param k Larger index of the pair
+*
+*	@return Position of the pair (i, k) within a table storing the upper
+*	triangle column by column, i.e. the entries (0, k), ..., (k-1, k) are
+*	contiguous.
+*/
+
+inline size_t MinimumWeightTriangulation::column_index(size_t i, size_t k) const
+{
+	return(k*(k-1)/2 + i);
+}
+
 /*!
 *	Objective function for the minimum-weight triangulation. Calculates the
 *	area of the triangle.
@@ -186,6 +226,63 @@ inline ktuple MinimumWeightTriangulation::minimum_area_and_normal_angle(const ve
 	return(ktuple(angle, area));
 }
 
+/*!
+*	First part of minimum_area_and_normal_angle() for positions and
+*	normalized vertex normals, which have been fetched beforehand: the
+*	cosines of the angles between the normal of the triangle and the
+*	normals of its vertices. The cross product is computed once for the
+*	normal and the area.
+*
+*	@param A	Position of 1st vertex of triangle
+*	@param B	Position of 2nd vertex of triangle
+*	@param C	Position of 3rd vertex of triangle
+*	@param nA	Normalized normal of 1st vertex of triangle
+*	@param nB	Normalized normal of 2nd vertex of triangle
+*	@param nC	Normalized normal of 3rd vertex of triangle
+*	@param cosines	Cosines of the angles at A, B, C (output)
+*
+*	@returns	Area of triangle[A, B, C] as minimum_area().
+*/
+
+inline double MinimumWeightTriangulation::normal_angle_cosines(	const v3ctor& A, const v3ctor& B, const v3ctor& C,
+									const v3ctor& nA, const v3ctor& nB, const v3ctor& nC,
+									double cosines[3])
+{
+	v3ctor cross = (B-A)|(C-A);
+	double area = cross.length();
+
+	// see v3ctor::normalize()
+	v3ctor normal = (area == 0) ? cross : cross/area;
+
+	cosines[0] = normal*nA;
+	cosines[1] = normal*nB;
+	cosines[2] = normal*nC;
+	return(area);
+}
+
+/*!
+*	Second part of minimum_area_and_normal_angle(). The result is
+*	identical.
+*
+*	@param cosines	Cosines computed by normal_angle_cosines()
+*	@param area	Area computed by normal_angle_cosines()
+*/
+
+inline ktuple MinimumWeightTriangulation::minimum_area_and_normal_angle(const double cosines[3], double area)
+{
+	double angle;
+	angle = std::max(acos(cosines[0]), acos(cosines[1]));
+	angle = std::max(acos(cosines[2]), angle);
+
+	//prevent zero area triangles
+	if(area < std::numeric_limits<double>::epsilon())
+	{
+		area = std::numeric_limits<double>::max();
+	}
+
+	return(ktuple(angle, area));
+}
+
 } // end of namespace "psalm"
 
 #endif
@@ -1104,6 +1104,7 @@ void QGMMainWindow::initMeshSignals() {
 	actionSphereSurfaceLength->setProperty(                       "gmMeshFunctionCall", MeshParams::FUNCVAL_SPHERE_SURFACE_LENGTH                );
 	actionSphereVolumeArea->setProperty(                          "gmMeshFunctionCall", MeshParams::FUNCVAL_SPHERE_VOLUME_AREA                   );
 	actionSphereSurfaceNumberOfComponents->setProperty(           "gmMeshFunctionCall", MeshParams::FUNCVAL_SPHERE_SURFACE_NUMBER_OF_COMPONENTS  );
+	actionSphereDescriptors->setProperty(                         "gmMeshFunctionCall", MeshParams::FUNCVAL_SPHERE_DESCRIPTORS                   );
 	actionAmbientOcclusion->setProperty(                          "gmMeshGLFunctionCall", MeshGLParams::FUNCVAL_AMBIENT_OCCLUSION                );
 	// ... Mesh editing ......................................................................................................................................
 	actionRemoveFacesSelected->setProperty(                       "gmMeshFunctionCall", MeshParams::EDIT_REMOVE_SELMFACES                        );
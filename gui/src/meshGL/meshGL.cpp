@@ -23,6 +23,7 @@
 #include "meshGL.h"
 #include "../meshwidget_params.h"
 
+#include <cstring>
 #include <thread>
 #include <future>
 #include <QTime>
@@ -292,7 +293,7 @@ bool MeshGL::labelsChanged() {
         cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
 		// Polylines, which are often colored like the labels have to be reset too:
 		polyLinesChanged();
-		vboRemoveBuffer( VBUFF_VERTICES_STRIPED,  __FUNCTION__ );
+		vboVerticesStripedChanged( 0, getVertexNr() );
 		// Pass method call to father class:
 		return Mesh::labelsChanged();
 }
@@ -403,11 +404,13 @@ bool MeshGL::applyTransformationToWholeMesh(Matrix4D rTrans, bool rResetNormals,
 }
 
 //! Takes care about OpenGL stuff, when the Mesh is transformed.
-bool MeshGL::applyTransformation( Matrix4D rTrans, set<Vertex*>* rSomeVerts, bool rResetNormals, bool rSaveTransMat ) {
+//! Mesh::applyTransformation and Mesh::applyTransformationToWholeMesh both end here.
+bool MeshGL::applyTransformationToVertices( const Matrix4D& rTrans, const std::vector<Vertex*>& rSomeVerts, const bool rAllVertices,
+                                            const bool rResetNormals, const bool rSaveTransMat ) {
         cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
-        bool retVal = Mesh::applyTransformation( rTrans, rSomeVerts, rResetNormals, rSaveTransMat );
+        bool retVal = Mesh::applyTransformationToVertices( rTrans, rSomeVerts, rAllVertices, rResetNormals, rSaveTransMat );
 		if( !retVal ) {
-                cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: applyTransformation failed!" << endl;
+                cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: applyTransformationToVertices failed!" << endl;
 				return false;
 		}
 		glRemove();
@@ -429,7 +432,7 @@ bool MeshGL::applyMeltingSphere( double rRadius, double rRel ) {
 
 //! Refresh recomputed vertex normals.
 bool MeshGL::normalsVerticesChanged() {
-	vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+	vboVerticesStripedChanged( 0, getVertexNr() );
 	if( mMeshTextured != nullptr ) {
 		delete mMeshTextured;
 		mMeshTextured = nullptr;
@@ -446,7 +449,7 @@ void MeshGL::changedFaceFuncVal() {
 //! Takes care about related VBOs, when the face's function values were changed.
 void MeshGL::changedVertFuncVal() {
 		Mesh::changedVertFuncVal();
-		vboRemoveBuffer( VBUFF_VERTICES_STRIPED,         __FUNCTION__ );
+		vboVerticesStripedChanged( 0, getVertexNr() );
 		vboRemoveBuffer( VBUFF_VERTICES_FLAG_LOCAL_MIN,  __FUNCTION__ );
 		vboRemoveBuffer( VBUFF_VERTICES_FLAG_LOCAL_MAX,  __FUNCTION__ );
         setParamFloatMeshGL( TEXMAP_AUTO_MIN, _NOT_A_NUMBER_DBL_ ); // Nan means not set.
@@ -502,7 +505,7 @@ bool MeshGL::multiplyColorWithFuncVal() {
         cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
 #endif
 		bool retVal = Mesh::multiplyColorWithFuncVal();
-		vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+		vboVerticesStripedChanged( 0, getVertexNr() );
 		setParamIntMeshGL(MeshGLParams::TEXMAP_CHOICE_FACES,
 								MeshGLParams::TEXMAP_VERT_RGB);
 		return retVal;
@@ -513,13 +516,22 @@ bool MeshGL::multiplyColorWithFuncVal( const double rMin, double rMax ) {
         cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
 #endif
 		bool retVal = Mesh::multiplyColorWithFuncVal( rMin, rMax );
-		vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+		vboVerticesStripedChanged( 0, getVertexNr() );
 		return retVal;
 }
 
 bool MeshGL::assignAlphaToSelectedVertices(unsigned char alpha) {
 	bool retVal = Mesh::assignAlphaToSelectedVertices(alpha);
-	vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__);
+	if( mSelectedMVerts.empty() ) {
+		vboVerticesStripedChanged( 0, getVertexNr() );
+		return retVal;
+	}
+	std::vector<uint64_t> vertexIndices;
+	vertexIndices.reserve( mSelectedMVerts.size() );
+	for( Vertex* selectedVertex : mSelectedMVerts ) {
+		vertexIndices.push_back( static_cast<uint64_t>( selectedVertex->getIndex() ) );
+	}
+	vboVerticesStripedChanged( vertexIndices );
 	return retVal;
 }
 
@@ -2473,18 +2485,8 @@ void MeshGL::glPrepare() {
 		//vboPrepareDoubleCone(); // Skip this here, makes startup faster.
 
 		// === FACES (texture per Vertex) ===================================================================
-		vector<GLuint> faceIndices;
-		faceIndices.reserve( getFaceNr()*3 );
-
-		//for( const auto& currFace : mFaces ) {
-		Face* currFace;
-		for( uint64_t faceIdx=0; faceIdx<getFaceNr(); faceIdx++ ) {
-				currFace = getFacePos( faceIdx );
-				faceIndices.push_back( static_cast<GLuint>(currFace->getVertA()->getIndex()) );
-				faceIndices.push_back( static_cast<GLuint>(currFace->getVertB()->getIndex()) );
-				faceIndices.push_back( static_cast<GLuint>(currFace->getVertC()->getIndex()) );
-                //cout << "[MeshGL::prepareVBOs] Face: " << faces[faceCtr*3] << " - " << faces[faceCtr*3+1] << " - " << faces[faceCtr*3+2] << endl;
-		}
+		vector<uint32_t> faceIndices;
+		MeshBufferPack::packFaceIndices( *getPrimitiveListFaces(), faceIndices );
 
 		mVertBufObjs[VBUFF_FACES] = new QOpenGLBuffer( QOpenGLBuffer::IndexBuffer );
 		vboAddBuffer( sizeof(GLuint)*faceIndices.size(), faceIndices.data(), QOpenGLBuffer::StaticDraw, VBUFF_FACES, __FUNCTION__ );
@@ -2561,9 +2563,22 @@ void MeshGL::glPaintFrontalLightPerVertex( const QMatrix4x4 &rTransformMat ,
 }
 
 //! Removes vertices and removes OpenGL VBOs and lists.
+//! Within an open transaction the VBOs are updated by MeshGL::editCommit.
 //! See Mesh::removeVertices for further details.
 bool MeshGL::removeVertices( set<Vertex*>* verticesToRemove ) {
 		bool retVal = Mesh::removeVertices( verticesToRemove );
+		if( isEditActive() ) {
+			return retVal;
+		}
+		glRemove();
+		glPrepare();
+		return retVal;
+}
+
+//! Applies a batch of edits and updates the OpenGL VBOs once.
+//! See Mesh::editCommit for further details.
+bool MeshGL::editCommit() {
+		bool retVal = Mesh::editCommit();
 		glRemove();
 		glPrepare();
 		return retVal;
@@ -3238,26 +3253,11 @@ bool MeshGL::vboPrepareVerticesWithFlag( unsigned int rFlagNr,   //!< See Primit
 		}
 
 		int timeStartSub = clock(); // for performance mesurement
-		vector<int> vertexListTmp;
-		unsigned int vertexCtr = 0;
-		for( auto const& currVertex: (*getPrimitiveListVertices()) ) { // C++11 style
-				if( currVertex->getFlag( rFlagNr ) ) {
-						vertexListTmp.push_back( vertexCtr );
-				}
-				vertexCtr++;
-		}
-		unsigned int vboSize = vertexListTmp.size();
-		GLuint* vertexIndices = new GLuint[vboSize];
-		vertexCtr = 0;
-		vector<int>::iterator itInt;
-		for ( itInt=vertexListTmp.begin(); itInt != vertexListTmp.end(); itInt++ ) {
-				vertexIndices[vertexCtr] = (*itInt);
-				vertexCtr++;
-		}
+		vector<uint32_t> vertexIndices;
+		MeshBufferPack::packVertexIndicesWithFlag( *getPrimitiveListVertices(), rFlagNr, vertexIndices );
+		const uint64_t vboSize = vertexIndices.size();
 
-		// --- Vertex references Double Cones --------------------------------------
-		vboAddBuffer( sizeof(GLuint)*vboSize, vertexIndices, QOpenGLBuffer::StaticDraw, rBufferID, __FUNCTION__ );
-		delete[] vertexIndices;
+		vboAddBuffer( sizeof(GLuint)*vboSize, vertexIndices.data(), QOpenGLBuffer::StaticDraw, rBufferID, __FUNCTION__ );
 
         cout << "[MeshGL::" << __FUNCTION__ << "] Time: " << static_cast<float>( clock() - timeStartSub ) / CLOCKS_PER_SEC << " seconds."  << endl;
         cout << "[MeshGL::" << __FUNCTION__ << "] Elements: " << vboSize << endl;
@@ -3283,26 +3283,11 @@ bool MeshGL::vboPrepareFacesWithFlag( unsigned int rFlagNr,   //!< See Primitive
 		}
 
 		int timeStartSub = clock(); // for performance mesurement
-		vector<int> faceListTmp;
-		for( auto const& currFace: (*getPrimitiveListFaces()) ) { // C++11 style
-				if( currFace->getFlag( rFlagNr ) ) {
-						faceListTmp.push_back( currFace->getVertA()->getIndex() );
-						faceListTmp.push_back( currFace->getVertB()->getIndex() );
-						faceListTmp.push_back( currFace->getVertC()->getIndex() );
-				}
-		}
-		unsigned int vboSize = faceListTmp.size();
-		GLuint* vertexIndices = new GLuint[vboSize];
-		unsigned int faceCtr = 0;
-		vector<int>::iterator itInt;
-		for ( itInt=faceListTmp.begin(); itInt != faceListTmp.end(); itInt++ ) {
-				vertexIndices[faceCtr] = (*itInt);
-				faceCtr++;
-		}
+		vector<uint32_t> vertexIndices;
+		MeshBufferPack::packFaceIndicesWithFlag( *getPrimitiveListFaces(), rFlagNr, vertexIndices );
+		const uint64_t vboSize = vertexIndices.size();
 
-		// --- Vertex references Double Cones --------------------------------------
-		vboAddBuffer( sizeof(GLuint)*vboSize, vertexIndices, QOpenGLBuffer::StaticDraw, rBufferID, __FUNCTION__ );
-		delete[] vertexIndices;
+		vboAddBuffer( sizeof(GLuint)*vboSize, vertexIndices.data(), QOpenGLBuffer::StaticDraw, rBufferID, __FUNCTION__ );
 
         cout << "[MeshGL::" << __FUNCTION__ << "] Time: " << static_cast<float>( clock() - timeStartSub ) / CLOCKS_PER_SEC << " seconds."  << endl;
         cout << "[MeshGL::" << __FUNCTION__ << "] Elements: " << vboSize << endl;
@@ -3372,19 +3357,47 @@ bool MeshGL::vboPreparePolylines() {
 
 //! Prepare Vertices and related data as VBO stripe, i.e. position, color, normal.
 //! See also MeshGL::grVertexStripeElment
+//!
+//! The data is packed by MeshBufferPack in parallel. When the VBO exists, only
+//! the vertices marked by vboVerticesStripedChanged are packed and only the
+//! range enclosing them is uploaded. So several changes between two frames
+//! are packed and uploaded once.
+//!
 //! @returns false in case of an error.
 bool MeshGL::vboPrepareVerticesStriped() {
 #ifdef DEBUG_SHOW_ALL_METHOD_CALLS
         cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
 #endif
+		static_assert( sizeof(grVertexStripeElment) == sizeof(MeshBufferPack::sVertexStripe),
+		               "MeshBufferPack::sVertexStripe has to match the layout of the VBO stripe." );
 		bool noError = true;
 
 		if( mVertBufObjs[VBUFF_VERTICES_STRIPED] == nullptr ) {
 				mVertBufObjs[VBUFF_VERTICES_STRIPED] = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
 		}
 
+		if( ( mVertBufObjs[VBUFF_VERTICES_STRIPED]->isCreated() ) &&
+		    ( !mBufferPack.updateMarkedVertices( *getPrimitiveListVertices(), *getPrimitiveListFaces() ) ) ) {
+				// The number of vertices changed => prepare again.
+				vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+				mVertBufObjs[VBUFF_VERTICES_STRIPED] = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+		}
+
 		if( mVertBufObjs[VBUFF_VERTICES_STRIPED]->isCreated() ) {
-				// Already prepared => nothing to do.
+				// Already prepared => pack the vertices marked by vboVerticesStripedChanged once and upload the changed range only.
+				uint64_t changedBegin;
+				uint64_t changedEnd;
+				if( mBufferPack.getChangedRange( &changedBegin, &changedEnd ) ) {
+						const MeshBufferPack::sVertexStripe* changedData = mBufferPack.getVertexStripes().data() + changedBegin;
+						if( !mVertBufObjs[VBUFF_VERTICES_STRIPED]->bind() ) {
+                                cerr << "[MeshGL::" << __FUNCTION__ << "] ERROR: Could not bind vertex buffer VBUFF_VERTICES_STRIPED to the context!" << endl;
+								return false;
+						}
+						mVertBufObjs[VBUFF_VERTICES_STRIPED]->write( static_cast<int>(sizeof(grVertexStripeElment)*changedBegin), changedData,
+						                                            static_cast<int>(sizeof(grVertexStripeElment)*(changedEnd-changedBegin)) );
+						mVertBufObjs[VBUFF_VERTICES_STRIPED]->release();
+						mBufferPack.clearChangedRange();
+				}
 				return true;
 		}
         cout << "[MeshGL::" << __FUNCTION__ << "] sizeof( grVertexStripeElment ): " << sizeof( grVertexStripeElment ) << " bytes." << endl;
@@ -3392,65 +3405,49 @@ bool MeshGL::vboPrepareVerticesStriped() {
 		// Prepare data for the buffer
 		int timeStart = clock(); // for performance mesurement
 
-		unsigned int vboSize = getVertexNr();
-		vector<grVertexStripeElment> bufferData;
-		bufferData.reserve( vboSize );
-
-		for( unsigned int vertexCtr=0; vertexCtr<vboSize; vertexCtr++ ) {
-				Vertex* currVertex = getVertexPos( vertexCtr );
-				grVertexStripeElment currElement;
-				if( !vboPrepareVerticesStripedFetchVertex( currVertex, &currElement ) ) {
-						noError = false;
-				}
-				bufferData.push_back( currElement );
+		if( !mBufferPack.packVertices( *getPrimitiveListVertices(), *getPrimitiveListFaces() ) ) {
+				noError = false;
 		}
+		const vector<MeshBufferPack::sVertexStripe>& bufferData = mBufferPack.getVertexStripes();
 
-		vboAddBuffer( sizeof(grVertexStripeElment)*bufferData.size(), bufferData.data(), QOpenGLBuffer::StaticDraw, VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+		vboAddBuffer( sizeof(grVertexStripeElment)*bufferData.size(), const_cast<MeshBufferPack::sVertexStripe*>(bufferData.data()),
+		              QOpenGLBuffer::StaticDraw, VBUFF_VERTICES_STRIPED, __FUNCTION__ );
         cout << "[MeshGL::" << __FUNCTION__ << "] Time Vertices: " << static_cast<float>( clock() - timeStart ) / CLOCKS_PER_SEC << " seconds."  << endl;
 
 		return noError;
 }
 
 //! Fetch one vertex into a strided array.
+//! See MeshBufferPack::fetchVertex, which has the same layout.
 bool MeshGL::vboPrepareVerticesStripedFetchVertex( Vertex* rVertex, grVertexStripeElment* rWriteTo ) {
 #ifdef DEBUG_SHOW_ALL_METHOD_CALLS
         cout << "[MeshGL::" << __FUNCTION__ << "]" << endl;
 #endif
-		bool noError = true;
+		MeshBufferPack::sVertexStripe packedVertex;
+		const bool noError = MeshBufferPack::fetchVertex( rVertex, &packedVertex );
+		memcpy( rWriteTo, &packedVertex, sizeof(grVertexStripeElment) );
+		return noError;
+}
 
-		if( !rVertex->copyCoordsTo( rWriteTo->mPosition ) ) {
-				noError = false;
-		}
-		if( !rVertex->copyNormalXYZTo( rWriteTo->mNormal ) ) {
-				noError = false;
-		}
-		if( !rVertex->copyRGBATo( rWriteTo->mColor ) ) {
-				noError = false;
-		}
-		double funcVal;
-		if( !rVertex->getFuncValue( &funcVal ) ) {
-				noError = false;
-		}
-		rWriteTo->mFuncVal = funcVal;  //! \todo change from GLfloat to GLdouble.
-		uint64_t labelID;
-        rVertex->getLabel( labelID ); // No ERROR check, here as getLabels also returns false, when no label is set!
-		rWriteTo->mLabelID = static_cast<GLfloat>(labelID);  // This is INTENTIONAL - to determine faces along the border of a label!
-		// Flags -- these should be UINT, but thanks to fixed normalization this does not work -- see: http://qt-project.org/forums/viewthread/38929
-		rWriteTo->mFlags = 0.0f;
-		if( rVertex->isBorder() ) {
-				rWriteTo->mFlags += 1.0f;
-		}
-		if( rVertex->isNonManifold() ) {
-				rWriteTo->mFlags += 2.0f;
-		}
-		if( rVertex->isDoubleCone() ) {
-				rWriteTo->mFlags += 4.0f;
-		}
-		if( !rVertex->isLabled() ) {
-				rWriteTo->mFlags += 8.0f;
+//! Marks the vertices within [rBegin,rEnd) as changed e.g. after their color or function value was changed.
+//! They are packed and uploaded by vboPrepareVerticesStriped before the next frame without reallocating the VBO.
+//! When the VBO was not prepared, it is removed i.e. prepared again.
+void MeshGL::vboVerticesStripedChanged( uint64_t rBegin, uint64_t rEnd ) {
+		if( ( mVertBufObjs[VBUFF_VERTICES_STRIPED] == nullptr ) || ( !mVertBufObjs[VBUFF_VERTICES_STRIPED]->isCreated() ) ) {
+				vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+				return;
 		}
+		mBufferPack.markVerticesChanged( rBegin, rEnd );
+}
 
-		return noError;
+//! Marks the given vertices as changed e.g. after the color of the selected vertices was changed.
+//! See MeshGL::vboVerticesStripedChanged( uint64_t, uint64_t ).
+void MeshGL::vboVerticesStripedChanged( const std::vector<uint64_t>& rVertexIndices ) {
+		if( ( mVertBufObjs[VBUFF_VERTICES_STRIPED] == nullptr ) || ( !mVertBufObjs[VBUFF_VERTICES_STRIPED]->isCreated() ) ) {
+				vboRemoveBuffer( VBUFF_VERTICES_STRIPED, __FUNCTION__ );
+				return;
+		}
+		mBufferPack.markVerticesChanged( rVertexIndices );
 }
 
 // VBO common --------------------------------------------------------------------------------------------------------------------------------------------------
@@ -23,6 +23,7 @@
 #define MESHGL_H
 
 #include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/meshbufferpack.h>
 #include "meshGL_params.h"
 #include "meshglcolors.h"
 
@@ -82,7 +83,8 @@ class MeshGL : public Mesh, public MeshGLParams {
 		virtual bool       fillPolyLines( uint64_t& rFilled, uint64_t& rFail, uint64_t& rSkipped );
 
                 bool       applyTransformationToWholeMesh( Matrix4D rTrans, bool rResetNormals = true, bool rSaveTransMat = true ) override;
-                bool       applyTransformation( Matrix4D rTrans, std::set<Vertex*>* rSomeVerts, bool rResetNormals = true, bool rSaveTransMat = true ) override;
+                bool       applyTransformationToVertices( const Matrix4D& rTrans, const std::vector<Vertex*>& rSomeVerts, const bool rAllVertices,
+                                                          const bool rResetNormals = true, const bool rSaveTransMat = true ) override;
 				bool       applyMeltingSphere( double rRadius, double rRel ) override;
 
 				bool       normalsVerticesChanged() override;
@@ -141,6 +143,7 @@ class MeshGL : public Mesh, public MeshGLParams {
 
 		// Handling of new primitives:
 				bool       removeVertices( std::set<Vertex*>* verticesToRemove ) override;
+				bool       editCommit() override;
 				bool       insertVerticesCoordTriplets( std::vector<double>* rCoordTriplets ) override;
 				bool       insertVertices( std::vector<Vertex*>* rNewVertices ) override;
 
@@ -177,6 +180,7 @@ protected:
 	};
 	GLuint          mVAO;                      //!< Vertex Array Object - has to be created!
 	QOpenGLBuffer*  mVertBufObjs[VBUFF_COUNT]; //!< Array of Vertex Buffer Objects (within the VAO).
+	MeshBufferPack  mBufferPack;               //!< Packed data of VBUFF_VERTICES_STRIPED including changes not yet packed or uploaded.
 
 	TexturedMesh* mMeshTextured = nullptr;               //!< Class holding the vertex-buffers for a mesh with multiple textures
 #ifdef OPENGL_VBO_SHOW_MEMORY_USAGE
@@ -212,6 +216,8 @@ protected:
 	        bool vboPreparePolylines();
 	        bool vboPrepareVerticesStriped();
 	        bool vboPrepareVerticesStripedFetchVertex( Vertex* rVertex, grVertexStripeElment* rWriteTo );
+	        void vboVerticesStripedChanged( uint64_t rBegin, uint64_t rEnd );
+	        void vboVerticesStripedChanged( const std::vector<uint64_t>& rVertexIndices );
 	        bool vboPrepareDoubleCone();
 	        bool vboPrepareVerticesWithFlag( unsigned int rFlagNr, eVertBufObjs rBufferID );
 	        bool vboPrepareFacesWithFlag(    unsigned int rFlagNr, eVertBufObjs rBufferID );
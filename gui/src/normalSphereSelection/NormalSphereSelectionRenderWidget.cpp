@@ -118,18 +118,7 @@ void NormalSphereSelectionRenderWidget::setRenderNormals(std::vector<float>& nor
 {
 	mNormalUpload = std::move(normals);
 
-	for(size_t i = 0; i<mNormalUpload.size(); i += 3)
-	{
-		if(std::isnan(mNormalUpload[i]) || std::isnan(mNormalUpload[i + 1]) || std::isnan(mNormalUpload[i+2]) )
-			continue;
-
-		Vector3D normal(mNormalUpload[i], mNormalUpload[i+1], mNormalUpload[i+2]);
-
-		auto incSize = normal.normalize3();
-
-		size_t index = mIcoSphereTree.getNearestVertexIndexAt(normal);
-		mIcoSphereTree.incData(index, incSize);
-	}
+	mIcoSphereTree.incDataFromNormals(mNormalUpload.data(), mNormalUpload.size() / 3);
 }
 
 void NormalSphereSelectionRenderWidget::setSelected(double nx, double ny, double nz)
@@ -114,3 +114,58 @@ TEST_CASE("icosphereTree stress test checking", "[.icosphere_stress]")
 		REQUIRE(treeIndex == testIndex);
 	}
 }
+
+TEST_CASE("icosphereTree direct lookup matches the tree", "[icosphere]")
+{
+	const unsigned int subdivision = GENERATE(0U, 1U, 3U, 5U);
+	CAPTURE(subdivision);
+	IcoSphereTree tree(subdivision);
+	const auto treeVertices = generateTreeVertices(tree);
+
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<> dis(-1.0,1.0);
+
+	const size_t randomCount = 20000;
+	std::vector<double> normals;
+	for(size_t i = 0; i<randomCount; ++i)
+	{
+		//not normalized to check the weights
+		normals.insert(normals.end(), {dis(gen), dis(gen), dis(gen)});
+	}
+	//directions along the vertices and the edges of the triangles
+	const auto faceIndices = tree.getFaceIndices();
+	for(size_t i = 0; i<faceIndices.size(); i += 3)
+	{
+		const Vector3D& v0 = treeVertices[faceIndices[i]];
+		const Vector3D& v1 = treeVertices[faceIndices[i + 1]];
+		const Vector3D mid = (v0 * 0.7) + (v1 * 0.3);
+		normals.insert(normals.end(), {v0.getX(), v0.getY(), v0.getZ(), mid.getX(), mid.getY(), mid.getZ()});
+	}
+
+	IcoSphereTree treeSequential(subdivision);
+	for(size_t i = 0; i<normals.size(); i += 3)
+	{
+		Vector3D normal(normals[i], normals[i + 1], normals[i + 2]);
+		const auto incSize = normal.normalize3();
+
+		const auto treeIndex = tree.getNearestVertexIndexAt(normal);
+		const auto directIndex = tree.getNearestVertexIndexDirect(normal);
+		if(directIndex != treeIndex)
+		{
+			//the ray casting may miss the leaf for a few directions exactly along a vertex
+			CHECK(i >= randomCount * 3);
+			CHECK((normal - treeVertices[directIndex]).getLength3Squared() < (normal - treeVertices[treeIndex]).getLength3Squared());
+		}
+		treeSequential.incData(directIndex, incSize);
+	}
+
+	tree.incDataFromNormals(normals.data(), normals.size() / 3);
+	const auto& data = *tree.getVertexDataP();
+	const auto& dataSequential = *treeSequential.getVertexDataP();
+	REQUIRE(data.size() == dataSequential.size());
+	for(size_t i = 0; i<data.size(); ++i)
+	{
+		CHECK(data[i] == Approx(dataSequential[i]));
+	}
+	CHECK(tree.getMaxData() == Approx(treeSequential.getMaxData()));
+}
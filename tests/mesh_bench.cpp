@@ -0,0 +1,769 @@
+//
+// GigaMesh - The GigaMesh Software Framework is a modular software for display,
+// editing and visualization of 3D-data typically acquired with structured light or
+// structure from motion.
+// Copyright (C) 2009-2020 Hubert Mara
+//
+// This file is part of GigaMesh.
+//
+// GigaMesh is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// GigaMesh is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GigaMesh.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+//! Performance suite for the core mesh operations.
+//!
+//! Usage (JSON report incl. throughput and peak RSS):
+//!   gigameshCore_bench --benchmark_out=bench.json --benchmark_out_format=json
+//!
+//! Synthetic meshes are icospheres of a given subdivision level and noisy
+//! regular grids of a given edge length in vertices. The meshes of testdata/
+//! are registered as additional load benchmarks at start-up.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <sys/resource.h> // getrusage
+#endif
+
+#include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/meshbufferpack.h>
+#include <GigaMesh/mesh/voxelfilter25d.h>
+#include <GigaMesh/icoSphereTree/IcoSphereTree.h>
+#include <GigaMesh/logging/Logging.h>
+#include <spherical_intersection/algorithm/sphere_volume_msii.h>
+#include <spherical_intersection/graph.h>
+
+//! Mesh with silenced progress output, so it does not interfere with the report.
+class BenchMesh : public Mesh
+{
+	public:
+		BenchMesh( const std::filesystem::path& rFileName, bool& rSuccess ) : Mesh( rFileName, rSuccess ) {}
+		BenchMesh( std::vector<sVertexProperties>& rVertexProps, std::vector<sFaceProperties>& rFaceProps ) :
+		        Mesh( rVertexProps, rFaceProps ) {}
+		virtual ~BenchMesh() override = default;
+
+		void showProgressStart( const std::string& /*rMsg*/ ) override {}
+		bool showProgress( double /*rVal*/, const std::string& /*rMsg*/ ) override { return true; }
+		void showProgressStop( const std::string& /*rMsg*/ ) override {}
+	protected:
+		void showInformation( const std::string& /*rHead*/, const std::string& /*rMsg*/, const std::string& /*rToClipboard*/ ) override {}
+		void showWarning( const std::string& /*rHead*/, const std::string& /*rMsg*/ ) override {}
+};
+
+//! Generated mesh data kept as properties to construct meshes repeatedly.
+struct sBenchMeshData {
+	std::vector<sVertexProperties> mVertexProps;
+	std::vector<sFaceProperties>   mFaceProps;
+};
+
+//! Icosphere with unit radius and the given number of subdivisions.
+sBenchMeshData generateIcoSphere( const unsigned int rSubdivisions ) {
+	IcoSphereTree tree( rSubdivisions );
+	const std::vector<float>        coords  = tree.getVertices();
+	const std::vector<unsigned int> indices = tree.getFaceIndices();
+
+	sBenchMeshData meshData;
+	meshData.mVertexProps.resize( coords.size() / 3 );
+	for( size_t i=0; i<meshData.mVertexProps.size(); ++i ) {
+		meshData.mVertexProps[i].mCoordX = coords[i*3];
+		meshData.mVertexProps[i].mCoordY = coords[i*3+1];
+		meshData.mVertexProps[i].mCoordZ = coords[i*3+2];
+	}
+	meshData.mFaceProps.resize( indices.size() / 3 );
+	for( size_t i=0; i<meshData.mFaceProps.size(); ++i ) {
+		meshData.mFaceProps[i].vertexIndices = { indices[i*3], indices[i*3+1], indices[i*3+2] };
+	}
+	return meshData;
+}
+
+//! Regular grid of rEdgeVerts x rEdgeVerts vertices with unit spacing and a noisy z-coordinate.
+sBenchMeshData generateNoisyGrid( const unsigned int rEdgeVerts ) {
+	std::mt19937 gen( 4711 ); // fixed seed for reproducible runs
+	std::uniform_real_distribution<> dis( -0.25, 0.25 );
+
+	sBenchMeshData meshData;
+	meshData.mVertexProps.resize( static_cast<size_t>(rEdgeVerts) * rEdgeVerts );
+	for( unsigned int y=0; y<rEdgeVerts; ++y ) {
+		for( unsigned int x=0; x<rEdgeVerts; ++x ) {
+			sVertexProperties& vertProps = meshData.mVertexProps[static_cast<size_t>(y)*rEdgeVerts+x];
+			vertProps.mCoordX = x;
+			vertProps.mCoordY = y;
+			vertProps.mCoordZ = dis( gen );
+		}
+	}
+	meshData.mFaceProps.reserve( 2 * static_cast<size_t>(rEdgeVerts-1) * (rEdgeVerts-1) );
+	for( uint64_t y=0; y+1<rEdgeVerts; ++y ) {
+		for( uint64_t x=0; x+1<rEdgeVerts; ++x ) {
+			const uint64_t idx = y*rEdgeVerts+x;
+			sFaceProperties faceA;
+			faceA.vertexIndices = { idx, idx+1, idx+rEdgeVerts };
+			meshData.mFaceProps.push_back( faceA );
+			sFaceProperties faceB;
+			faceB.vertexIndices = { idx+1, idx+rEdgeVerts+1, idx+rEdgeVerts };
+			meshData.mFaceProps.push_back( faceB );
+		}
+	}
+	return meshData;
+}
+
+//! Fetch generated meshes from a cache as the generation itself is not to be measured.
+const sBenchMeshData& getMeshData( const bool rIsGrid, const unsigned int rSize ) {
+	static std::map<std::pair<bool,unsigned int>,sBenchMeshData> meshCache;
+	auto itMesh = meshCache.find( { rIsGrid, rSize } );
+	if( itMesh == meshCache.end() ) {
+		itMesh = meshCache.emplace( std::make_pair( rIsGrid, rSize ),
+		                            rIsGrid ? generateNoisyGrid( rSize ) : generateIcoSphere( rSize ) ).first;
+	}
+	return itMesh->second;
+}
+
+std::unique_ptr<BenchMesh> createMesh( const bool rIsGrid, const unsigned int rSize ) {
+	sBenchMeshData meshData = getMeshData( rIsGrid, rSize );
+	return std::make_unique<BenchMesh>( meshData.mVertexProps, meshData.mFaceProps );
+}
+
+//! Peak resident set size of the process in MiB.
+double getPeakRSS() {
+#ifndef _MSC_VER
+	rusage usage;
+	if( getrusage( RUSAGE_SELF, &usage ) == 0 ) {
+#ifdef __APPLE__
+		return static_cast<double>( usage.ru_maxrss ) / ( 1024.0 * 1024.0 ); // bytes
+#else
+		return static_cast<double>( usage.ru_maxrss ) / 1024.0;              // kilobytes
+#endif
+	}
+#endif
+	return 0.0;
+}
+
+//! Adds the counters shared by all benchmarks: throughput and peak RSS.
+void setCounters( benchmark::State& rState, const uint64_t rVertexNr ) {
+	rState.counters["vertices"]    = static_cast<double>( rVertexNr );
+	rState.counters["vertices/s"]  = benchmark::Counter( static_cast<double>( rVertexNr ),
+	                                                     benchmark::Counter::kIsIterationInvariantRate );
+	rState.counters["peakRSS_MiB"] = getPeakRSS();
+}
+
+// The first argument selects the mesh type: 0 - icosphere, 1 - noisy grid.
+// The second argument is the subdivision level or the grid edge length, respectively.
+#define BENCH_MESH_ARGS \
+	Args( { 0, 5 } )->Args( { 0, 7 } )->Args( { 1, 256 } )->Args( { 1, 1024 } )->Unit( benchmark::kMillisecond )->UseRealTime()
+
+//==============================================================================
+// IO
+//==============================================================================
+
+//! Write and read a mesh to/from a temporary file of the given extension.
+void benchFileIO( benchmark::State& rState, const std::string& rExtension, const bool rRead ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const std::filesystem::path fileName = std::filesystem::temp_directory_path() /
+	                                       ( "gigamesh_bench" + rExtension );
+	mesh->setFlagExport( MeshIO::EXPORT_BINARY, true );
+	if( rRead ) {
+		mesh->writeFile( fileName );
+	}
+	for( auto _ : rState ) {
+		if( rRead ) {
+			bool readSuccess = false;
+			BenchMesh meshRead( fileName, readSuccess );
+			if( !readSuccess ) {
+				rState.SkipWithError( "Could not read file!" );
+				break;
+			}
+		} else {
+			mesh->writeFile( fileName );
+		}
+	}
+	std::filesystem::remove( fileName );
+	setCounters( rState, mesh->getVertexNr() );
+}
+
+static void BM_LoadPLY( benchmark::State& rState ) { benchFileIO( rState, ".ply", true ); }
+static void BM_SavePLY( benchmark::State& rState ) { benchFileIO( rState, ".ply", false ); }
+static void BM_LoadOBJ( benchmark::State& rState ) { benchFileIO( rState, ".obj", true ); }
+static void BM_SaveOBJ( benchmark::State& rState ) { benchFileIO( rState, ".obj", false ); }
+BENCHMARK( BM_LoadPLY )->BENCH_MESH_ARGS;
+BENCHMARK( BM_SavePLY )->BENCH_MESH_ARGS;
+BENCHMARK( BM_LoadOBJ )->BENCH_MESH_ARGS;
+BENCHMARK( BM_SaveOBJ )->BENCH_MESH_ARGS;
+
+//! Loading the meshes shipped within testdata/
+void benchLoadTestData( benchmark::State& rState, const std::filesystem::path& rFileName ) {
+	uint64_t vertexNr = 0;
+	for( auto _ : rState ) {
+		bool readSuccess = false;
+		BenchMesh mesh( rFileName, readSuccess );
+		if( !readSuccess ) {
+			rState.SkipWithError( "Could not read file!" );
+			break;
+		}
+		vertexNr = mesh.getVertexNr();
+	}
+	setCounters( rState, vertexNr );
+}
+
+//==============================================================================
+// Structure, normals and labeling
+//==============================================================================
+
+static void BM_EstablishStructure( benchmark::State& rState ) {
+	const sBenchMeshData& meshData = getMeshData( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	for( auto _ : rState ) {
+		rState.PauseTiming();
+		std::vector<sVertexProperties> vertexProps( meshData.mVertexProps );
+		std::vector<sFaceProperties>   faceProps( meshData.mFaceProps );
+		rState.ResumeTiming();
+		auto mesh = std::make_unique<BenchMesh>( vertexProps, faceProps );
+		benchmark::DoNotOptimize( mesh->getFaceNr() );
+		rState.PauseTiming(); // Destruction is not part of the measurement.
+		mesh.reset();
+		rState.ResumeTiming();
+	}
+	setCounters( rState, meshData.mVertexProps.size() );
+}
+BENCHMARK( BM_EstablishStructure )->BENCH_MESH_ARGS;
+
+static void BM_NormalsRecompute( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	for( auto _ : rState ) {
+		mesh->resetFaceNormals();
+		mesh->resetVertexNormals();
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_NormalsRecompute )->BENCH_MESH_ARGS;
+
+//! Vertex normals written additionally into a float buffer as used for rendering.
+static void BM_NormalsRecomputeToBuffer( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	std::vector<float> normalsXYZ( 3*mesh->getVertexNr() );
+	for( auto _ : rState ) {
+		mesh->resetFaceNormals();
+		mesh->resetVertexNormals( Vertex::NORMAL_WEIGHT_AREA_ANGLE, normalsXYZ.data() );
+		benchmark::DoNotOptimize( normalsXYZ.data() );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_NormalsRecomputeToBuffer )->BENCH_MESH_ARGS;
+
+//! Interleaved vertex buffer as used for rendering - all vertices.
+static void BM_PackVertexBuffer( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	MeshBufferPack bufferPack;
+	for( auto _ : rState ) {
+		bufferPack.packVertices( *mesh->getPrimitiveListVertices(), *mesh->getPrimitiveListFaces() );
+		benchmark::DoNotOptimize( bufferPack.getVertexStripes().data() );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_PackVertexBuffer )->BENCH_MESH_ARGS;
+
+//! Interleaved vertex buffer - update of 1% of the vertices e.g. after their color was changed.
+static void BM_PackVertexBufferUpdate( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	MeshBufferPack bufferPack;
+	bufferPack.packVertices( *mesh->getPrimitiveListVertices(), *mesh->getPrimitiveListFaces() );
+	std::vector<uint64_t> vertexIndices;
+	for( uint64_t i=0; i<mesh->getVertexNr(); i+=100 ) {
+		vertexIndices.push_back( i );
+	}
+	for( auto _ : rState ) {
+		bufferPack.updateVertices( *mesh->getPrimitiveListVertices(), *mesh->getPrimitiveListFaces(), vertexIndices );
+		bufferPack.clearChangedRange();
+		benchmark::DoNotOptimize( bufferPack.getVertexStripes().data() );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_PackVertexBufferUpdate )->BENCH_MESH_ARGS;
+
+//! Index buffer of the selected faces, which is rebuilt on every change of the selection.
+static void BM_PackSelectedFaceIndices( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	for( uint64_t i=0; i<mesh->getFaceNr(); i+=3 ) {
+		mesh->getFacePos( i )->setFlag( Primitive::FLAG_SELECTED );
+	}
+	std::vector<uint32_t> faceIndices;
+	for( auto _ : rState ) {
+		MeshBufferPack::packFaceIndicesWithFlag( *mesh->getPrimitiveListFaces(), Primitive::FLAG_SELECTED, faceIndices );
+		benchmark::DoNotOptimize( faceIndices.data() );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_PackSelectedFaceIndices )->BENCH_MESH_ARGS;
+
+static void BM_LabelVerticesAll( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	for( auto _ : rState ) {
+		mesh->labelVerticesAll();
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_LabelVerticesAll )->BENCH_MESH_ARGS;
+
+//==============================================================================
+// Descriptors
+//==============================================================================
+
+//! MSII using the radius relative to the bounding box (third argument in percent)
+//! and the raster size (fourth argument).
+static void BM_MSIIQuick( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const double radius = mesh->getBoundingBoxRadius() * static_cast<double>( rState.range( 2 ) ) / 100.0;
+	for( auto _ : rState ) {
+		mesh->computeMSIIQuick( radius, 4, static_cast<unsigned int>( rState.range( 3 ) ) );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_MSIIQuick )->ArgsProduct( { { 0 }, { 5 }, { 2, 5 }, { 64, 128 } } )
+                         ->ArgsProduct( { { 1 }, { 256 }, { 1, 4 }, { 64, 128 } } )
+                         ->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Volume integrals of 16 scales for a random raster using the sparse filters per scale
+//! (arg 0 == 0) or the filters merged for a single pass (arg 0 == 1).
+//! Arguments: { method, raster size }
+static void BM_VoxelFilters2D( benchmark::State& rState ) {
+	const bool singlePass = ( rState.range( 0 ) == 1 );
+	const uint xyzDim = static_cast<uint>( rState.range( 1 ) );
+	std::vector<double> multiscaleRadii( 16 );
+	for( size_t i=0; i<multiscaleRadii.size(); i++ ) {
+		multiscaleRadii[i] = 1.0 - static_cast<double>( i ) / static_cast<double>( multiscaleRadii.size() );
+	}
+	voxelFilter2DElements* sparseFilters;
+	generateVoxelFilters2D( multiscaleRadii.size(), multiscaleRadii.data(), xyzDim, &sparseFilters );
+	voxelFilter2DMultiscale multiscaleFilter;
+	generateVoxelFilters2DMultiscale( sparseFilters, multiscaleRadii.size(), xyzDim, &multiscaleFilter );
+	std::mt19937 gen( 4711 );
+	std::uniform_real_distribution<> dis( -0.5 * xyzDim, 0.5 * xyzDim );
+	std::vector<double> rasterArray( xyzDim * xyzDim );
+	for( auto& rasterValue : rasterArray ) {
+		rasterValue = dis( gen );
+	}
+	std::vector<double> featureVec( multiscaleRadii.size() );
+	for( auto _ : rState ) {
+		if( singlePass ) {
+			applyVoxelFilters2D( featureVec.data(), rasterArray.data(), &multiscaleFilter );
+		} else {
+			applyVoxelFilters2D( featureVec.data(), rasterArray.data(), &sparseFilters, multiscaleRadii.size(), xyzDim );
+		}
+		benchmark::DoNotOptimize( featureVec.data() );
+	}
+	freeVoxelFilters2DMultiscale( &multiscaleFilter );
+	setCounters( rState, 1 );
+}
+BENCHMARK( BM_VoxelFilters2D )->ArgsProduct( { { 0, 1 }, { 128, 256 } } );
+
+//! Geodesic patch with a radius of a tenth of the bounding box around the first vertex.
+static void BM_GeodesicPatch( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const double radius = mesh->getBoundingBoxRadius() / 10.0;
+	Vertex* seedVertex = mesh->getVertexPos( mesh->getVertexNr() / 2 );
+	for( auto _ : rState ) {
+		mesh->estGeodesicPatchFuncVal( seedVertex, radius, false );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_GeodesicPatch )->BENCH_MESH_ARGS;
+
+//! Maximum angle between the face normals and their mean within a sphere around each vertex.
+//! The radius is 3 edge lengths of the grid and about 3 edge lengths of the icosphere.
+static void BM_SphereNeighbourhoodAngle( benchmark::State& rState ) {
+	const bool isGrid = ( rState.range( 0 ) == 1 );
+	auto mesh = createMesh( isGrid, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const double radius = isGrid ? 3.0 : 0.1;
+	for( auto _ : rState ) {
+		mesh->setVertFuncValFaceSphereMeanAngleMax( radius );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_SphereNeighbourhoodAngle )->Args( { 0, 5 } )->Args( { 1, 256 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Spherical intersection graph and its volume integral for all vertices as computed by
+//! gigamesh-featurevectors-sl with a single thread. The radius is 3 edge lengths of the grid
+//! and about 3 edge lengths of the icosphere.
+static void BM_SphereVolumeGraph( benchmark::State& rState ) {
+	const bool isGrid = ( rState.range( 0 ) == 1 );
+	const sBenchMeshData& meshData = getMeshData( isGrid, static_cast<unsigned int>( rState.range( 1 ) ) );
+	spherical_intersection::Mesh mesh;
+	for( const auto& vertProps : meshData.mVertexProps ) {
+		mesh.add_vertex( spherical_intersection::math3d::Vector{ vertProps.mCoordX, vertProps.mCoordY, vertProps.mCoordZ } );
+	}
+	const auto& vertices = mesh.get_vertices();
+	for( const auto& faceProps : meshData.mFaceProps ) {
+		mesh.add_triangle( vertices[faceProps.vertexIndices[0]], vertices[faceProps.vertexIndices[1]],
+		                   vertices[faceProps.vertexIndices[2]] );
+	}
+	const double radius = isGrid ? 3.0 : 0.1;
+	spherical_intersection::Graph graph;
+	for( auto _ : rState ) {
+		for( const auto& vertex : vertices ) {
+			graph.assign( vertex, spherical_intersection::math3d::Sphere{ vertex.get_location(), radius } );
+			benchmark::DoNotOptimize( spherical_intersection::algorithm::get_sphere_volume_area( graph ) );
+		}
+	}
+	setCounters( rState, vertices.size() );
+}
+BENCHMARK( BM_SphereVolumeGraph )->Args( { 0, 5 } )->Args( { 1, 256 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Construction of the spherical_intersection::Mesh as done before computing the sphere descriptors.
+//! The third argument selects add_triangle per face (0) or add_triangles for all faces (1).
+static void BM_SphereMeshBuild( benchmark::State& rState ) {
+	const bool isGrid = ( rState.range( 0 ) == 1 );
+	const sBenchMeshData& meshData = getMeshData( isGrid, static_cast<unsigned int>( rState.range( 1 ) ) );
+	std::vector<std::array<size_t, 3>> faceVertexIndices;
+	faceVertexIndices.reserve( meshData.mFaceProps.size() );
+	for( const auto& faceProps : meshData.mFaceProps ) {
+		faceVertexIndices.push_back( { faceProps.vertexIndices[0], faceProps.vertexIndices[1], faceProps.vertexIndices[2] } );
+	}
+	for( auto _ : rState ) {
+		spherical_intersection::Mesh mesh;
+		for( const auto& vertProps : meshData.mVertexProps ) {
+			mesh.add_vertex( spherical_intersection::math3d::Vector{ vertProps.mCoordX, vertProps.mCoordY, vertProps.mCoordZ } );
+		}
+		if( rState.range( 2 ) == 1 ) {
+			mesh.add_triangles( faceVertexIndices );
+		} else {
+			const auto& vertices = mesh.get_vertices();
+			for( const auto& indices : faceVertexIndices ) {
+				mesh.add_triangle( vertices[indices[0]], vertices[indices[1]], vertices[indices[2]] );
+			}
+		}
+		benchmark::DoNotOptimize( mesh.get_triangles().size() );
+	}
+	setCounters( rState, meshData.mVertexProps.size() );
+}
+BENCHMARK( BM_SphereMeshBuild )->Args( { 0, 7, 0 } )->Args( { 0, 7, 1 } )->Args( { 1, 1024, 0 } )->Args( { 1, 1024, 1 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Surface length, volume area and number of components for three radii. The third argument
+//! selects a pass per descriptor as done by the funcVertSphere* methods (0) or a single pass (1).
+static void BM_SphereDescriptors( benchmark::State& rState ) {
+	const bool isGrid = ( rState.range( 0 ) == 1 );
+	auto mesh = createMesh( isGrid, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const std::vector<double> radii = isGrid ? std::vector<double>{ 1.5, 3.0, 6.0 } : std::vector<double>{ 0.1, 0.2, 0.4 };
+	const unsigned int descriptors[] = { Mesh::SPHERE_DESCRIPTOR_SURFACE_LENGTH, Mesh::SPHERE_DESCRIPTOR_VOLUME_AREA,
+	                                     Mesh::SPHERE_DESCRIPTOR_NUMBER_OF_COMPONENTS };
+	std::vector<double> values;
+	for( auto _ : rState ) {
+		if( rState.range( 2 ) == 1 ) {
+			mesh->computeSphereDescriptors( radii, descriptors[0] | descriptors[1] | descriptors[2], values );
+		} else {
+			for( const unsigned int descriptor : descriptors ) {
+				mesh->computeSphereDescriptors( radii, descriptor, values );
+			}
+		}
+		benchmark::DoNotOptimize( values.data() );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_SphereDescriptors )->Args( { 0, 3, 0 } )->Args( { 0, 3, 1 } )->Args( { 1, 32, 0 } )->Args( { 1, 32, 1 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Ambient occlusion by ray casting against a bounding volume hierarchy of the faces.
+static void BM_AmbientOcclusionRayCast( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	for( auto _ : rState ) {
+		mesh->funcVertAmbientOcclusionRayCast( 64, 0.0 );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_AmbientOcclusionRayCast )->Args( { 0, 5 } )->Args( { 1, 128 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//==============================================================================
+// Cleaning
+//==============================================================================
+
+static void BM_SelfIntersection( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	for( auto _ : rState ) {
+		mesh->selectFaceSelfIntersecting();
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_SelfIntersection )->Args( { 0, 5 } )->Args( { 1, 128 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Removes 0.1% of the faces at random and fills the holes.
+static void BM_HoleFilling( benchmark::State& rState ) {
+	uint64_t vertexNr = 0;
+	for( auto _ : rState ) {
+		rState.PauseTiming();
+		auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+		vertexNr = mesh->getVertexNr();
+		mesh->selectFaceRandom( 0.001 );
+		mesh->removeFacesSelected();
+		rState.ResumeTiming();
+		mesh->convertBordersToPolylines();
+		uint64_t filled  = 0;
+		uint64_t fail    = 0;
+		uint64_t skipped = 0;
+		mesh->fillPolyLines( 3 * 1024, filled, fail, skipped );
+		rState.PauseTiming();
+		mesh.reset();
+		rState.ResumeTiming();
+	}
+	setCounters( rState, vertexNr );
+}
+BENCHMARK( BM_HoleFilling )->Args( { 0, 5 } )->Args( { 1, 256 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Splits the mesh along the given number of parallel planes evenly distributed across the bounding box.
+//! Arguments: { grid, size, planes }
+static void BM_SplitByPlanes( benchmark::State& rState ) {
+	uint64_t vertexNr = 0;
+	for( auto _ : rState ) {
+		rState.PauseTiming();
+		auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+		vertexNr = mesh->getVertexNr();
+		const Vector3D bbMin = mesh->getBoundingBoxA();
+		Vector3D bbSize;
+		mesh->getBoundingBoxSize( bbSize );
+		const int64_t planeNr = rState.range( 2 );
+		std::vector<double> distances( planeNr );
+		for( int64_t i=0; i<planeNr; i++ ) {
+			distances[i] = bbSize.getX() * ( static_cast<double>( i ) + 0.5 ) / static_cast<double>( planeNr );
+		}
+		rState.ResumeTiming();
+		mesh->splitByPlanes( Vector3D( 1.0, 0.0, 0.0, -bbMin.getX() ), distances, false, true );
+		rState.PauseTiming();
+		mesh.reset();
+		rState.ResumeTiming();
+	}
+	setCounters( rState, vertexNr );
+}
+BENCHMARK( BM_SplitByPlanes )->Args( { 0, 5, 1 } )->Args( { 0, 5, 16 } )->Args( { 1, 256, 16 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Triangle soup i.e. three vertices per face as exported to STL.
+sBenchMeshData generateSoup( const sBenchMeshData& rMeshData ) {
+	sBenchMeshData soupData;
+	soupData.mVertexProps.reserve( 3 * rMeshData.mFaceProps.size() );
+	soupData.mFaceProps.resize( rMeshData.mFaceProps.size() );
+	for( size_t i=0; i<rMeshData.mFaceProps.size(); ++i ) {
+		for( size_t j=0; j<3; ++j ) {
+			soupData.mFaceProps[i].vertexIndices.push_back( soupData.mVertexProps.size() );
+			soupData.mVertexProps.push_back( rMeshData.mVertexProps[rMeshData.mFaceProps[i].vertexIndices[j]] );
+		}
+	}
+	return soupData;
+}
+
+//! Welds the vertices of a triangle soup either as properties on import or as mesh operation.
+//! Arguments: { grid, size, mesh }
+static void BM_VertexWelding( benchmark::State& rState ) {
+	const sBenchMeshData soupData = generateSoup( getMeshData( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) ) );
+	const bool useMesh = ( rState.range( 2 ) == 1 );
+	MeshIO meshIO;
+	uint64_t mergedNr = 0;
+	for( auto _ : rState ) {
+		rState.PauseTiming();
+		std::vector<sVertexProperties> vertexProps = soupData.mVertexProps;
+		std::vector<sFaceProperties>   faceProps   = soupData.mFaceProps;
+		std::unique_ptr<BenchMesh> mesh;
+		if( useMesh ) {
+			mesh = std::make_unique<BenchMesh>( vertexProps, faceProps );
+		}
+		rState.ResumeTiming();
+		if( useMesh ) {
+			mesh->weldVertices( 0.0, VertexWelding::ATTRIBUTES_FIRST, mergedNr );
+		} else {
+			meshIO.weldVertexProps( vertexProps, faceProps, 0.0, VertexWelding::ATTRIBUTES_FIRST, &mergedNr );
+		}
+		rState.PauseTiming();
+		mesh.reset();
+		rState.ResumeTiming();
+	}
+	setCounters( rState, soupData.mVertexProps.size() );
+	rState.counters["merged"] = static_cast<double>( mergedNr );
+}
+BENCHMARK( BM_VertexWelding )->Args( { 0, 5, 0 } )->Args( { 0, 5, 1 } )->Args( { 1, 256, 0 } )->Args( { 1, 256, 1 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//==============================================================================
+// Simplification
+//==============================================================================
+
+//! Quadric error decimation to 10% of the faces including the properties of the result.
+static void BM_QuadricDecimation( benchmark::State& rState ) {
+	auto mesh = createMesh( rState.range( 0 ) == 1, static_cast<unsigned int>( rState.range( 1 ) ) );
+	std::vector<sVertexProperties> vertexProps;
+	std::vector<sFaceProperties>   faceProps;
+	std::vector<uint64_t>          fineToCoarse;
+	for( auto _ : rState ) {
+		mesh->decimateQuadricError( mesh->getFaceNr() / 10, std::numeric_limits<double>::infinity(),
+		                            vertexProps, faceProps, fineToCoarse );
+		benchmark::DoNotOptimize( faceProps.data() );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_QuadricDecimation )->Args( { 0, 5 } )->Args( { 0, 7 } )->Args( { 1, 256 } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//==============================================================================
+// Normal sphere histogram as exported by gigamesh-gnsphere.
+//==============================================================================
+
+//! Random unnormalized normals binned by ray casting (arg 0 == 0) or by direct lookup (arg 0 == 1).
+//! Arguments: { method, subdivisions }
+static void BM_NormalSphereBinning( benchmark::State& rState ) {
+	const bool directLookup = ( rState.range( 0 ) == 1 );
+	IcoSphereTree tree( static_cast<unsigned int>( rState.range( 1 ) ) );
+	std::mt19937 gen( 4711 );
+	std::uniform_real_distribution<> dis( -1.0, 1.0 );
+	std::vector<double> normalsXYZ( 3 * 100000 );
+	for( auto& coord : normalsXYZ ) {
+		coord = dis( gen );
+	}
+	for( auto _ : rState ) {
+		if( directLookup ) {
+			tree.incDataFromNormals( normalsXYZ.data(), normalsXYZ.size() / 3 );
+			continue;
+		}
+		for( size_t i=0; i<normalsXYZ.size(); i+=3 ) {
+			Vector3D normal( normalsXYZ[i], normalsXYZ[i+1], normalsXYZ[i+2] );
+			const double incSize = normal.normalize3();
+			tree.incData( tree.getNearestVertexIndexAt( normal ), incSize );
+		}
+	}
+	setCounters( rState, normalsXYZ.size() / 3 );
+}
+BENCHMARK( BM_NormalSphereBinning )->ArgsProduct( { { 0, 1 }, { 3, 6 } } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//==============================================================================
+// Feature vectors
+//==============================================================================
+
+//! Euclidean distances of 32-dimensional feature vectors to a reference vector
+//! with per-vertex allocations (arg 0 == 0) or the contiguous store (arg 0 == 1).
+//! Arguments: { storage, subdivisions of the icosphere }
+static void BM_FeatureVecDistance( benchmark::State& rState ) {
+	const bool contiguous = ( rState.range( 0 ) == 1 );
+	auto mesh = createMesh( false, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const uint64_t featureVecLen = 32;
+	std::mt19937 gen( 4711 );
+	std::uniform_real_distribution<> dis( 0.0, 1.0 );
+	std::vector<double> featureVecs( mesh->getVertexNr() * featureVecLen );
+	for( auto& element : featureVecs ) {
+		element = dis( gen );
+	}
+	std::vector<double> referenceVec( featureVecs.begin(), featureVecs.begin() + featureVecLen );
+	if( contiguous ) {
+		mesh->adoptFeatureVectors( featureVecs, featureVecLen );
+	} else {
+		for( uint64_t i=0; i<mesh->getVertexNr(); i++ ) {
+			mesh->getVertexPos( i )->assignFeatureVec( &featureVecs[i*featureVecLen], featureVecLen );
+		}
+	}
+	for( auto _ : rState ) {
+		double*  funcValues = nullptr;
+		Vertex** vertices   = nullptr;
+		int      vertCount  = 0;
+		mesh->estFeatureDistEucToVertex( referenceVec.data(), &funcValues, &vertices, &vertCount );
+		benchmark::DoNotOptimize( funcValues );
+		delete[] funcValues;
+		delete[] vertices;
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_FeatureVecDistance )->ArgsProduct( { { 0, 1 }, { 5, 7 } } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//! Mahalanobis inspired distances of 16-dimensional feature vectors with cubic weights
+//! with per-vertex allocations (arg 0 == 0) or the contiguous store (arg 0 == 1).
+//! Arguments: { storage, subdivisions of the icosphere }
+static void BM_FeatureVecMahalDist( benchmark::State& rState ) {
+	const bool contiguous = ( rState.range( 0 ) == 1 );
+	auto mesh = createMesh( false, static_cast<unsigned int>( rState.range( 1 ) ) );
+	const uint64_t featureVecLen = 16;
+	std::mt19937 gen( 4711 );
+	std::uniform_real_distribution<> dis( 0.0, 1.0 );
+	std::vector<double> featureVecs( mesh->getVertexNr() * featureVecLen );
+	for( auto& element : featureVecs ) {
+		element = dis( gen );
+	}
+	std::vector<double> referenceVec( featureVecs.begin(), featureVecs.begin() + featureVecLen );
+	if( contiguous ) {
+		mesh->adoptFeatureVectors( featureVecs, featureVecLen );
+	} else {
+		for( uint64_t i=0; i<mesh->getVertexNr(); i++ ) {
+			mesh->getVertexPos( i )->assignFeatureVec( &featureVecs[i*featureVecLen], featureVecLen );
+		}
+	}
+	for( auto _ : rState ) {
+		mesh->funcVertFeatureVecMahalDist( referenceVec, Mesh::FEATURE_VECTOR_PNORM_WEIGTH_CUBIC );
+	}
+	setCounters( rState, mesh->getVertexNr() );
+}
+BENCHMARK( BM_FeatureVecMahalDist )->ArgsProduct( { { 0, 1 }, { 5, 7 } } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//==============================================================================
+// Polylines
+//==============================================================================
+
+//! Run-length integral invariants of a wiggly closed line walking from every vertex (arg 0 == 0)
+//! or by sliding windows (arg 0 == 1). The sphere covers about 1/64 of the line.
+//! Arguments: { method, number of vertices }
+static void BM_PolylineIntInv( benchmark::State& rState ) {
+	const bool slidingWindow = ( rState.range( 0 ) == 1 );
+	const auto vertNr = static_cast<unsigned int>( rState.range( 1 ) );
+	PolyLine polyLine;
+	for( unsigned int i=0; i<=vertNr; i++ ) {
+		const double phi = 2.0 * M_PI * static_cast<double>( i % vertNr ) / vertNr;
+		const double rad = 10.0 + 0.5 * std::sin( 23.0 * phi );
+		polyLine.addBack( Vector3D( rad * std::cos( phi ), rad * std::sin( phi ), 0.0 ), Vector3D( 0.0, 0.0, 1.0 ) );
+	}
+	const double radius = 2.0 * M_PI * 10.0 / 64.0;
+	for( auto _ : rState ) {
+		if( slidingWindow ) {
+			polyLine.compIntInv( radius, PolyLine::POLY_INTEGRAL_INV_BOTH );
+			continue;
+		}
+		for( unsigned int i=0; i<vertNr; i++ ) {
+			polyLine.compIntInv( i, radius, PolyLine::POLY_INTEGRAL_INV_BOTH );
+		}
+	}
+	setCounters( rState, vertNr );
+}
+BENCHMARK( BM_PolylineIntInv )->ArgsProduct( { { 0, 1 }, { 4096, 32768 } } )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//==============================================================================
+
+int main( int argc, char** argv ) {
+	LOG::initLogging();
+	LOG::setLogLevel( LOG::LogLevel::eError );
+
+#ifdef GIGAMESH_TESTDATA_DIR
+	const std::filesystem::path testDataDir( GIGAMESH_TESTDATA_DIR );
+	if( std::filesystem::is_directory( testDataDir ) ) {
+		for( const auto& entry : std::filesystem::directory_iterator( testDataDir ) ) {
+			const std::string extension = entry.path().extension().string();
+			if( extension != ".ply" && extension != ".obj" ) {
+				continue;
+			}
+			benchmark::RegisterBenchmark( ( "BM_LoadTestData/" + entry.path().filename().string() ).c_str(),
+			                              benchLoadTestData, entry.path() )->Unit( benchmark::kMillisecond )->UseRealTime();
+		}
+	}
+#endif
+
+	benchmark::Initialize( &argc, argv );
+	if( benchmark::ReportUnrecognizedArguments( argc, argv ) ) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
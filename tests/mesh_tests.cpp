@@ -21,7 +21,28 @@
 //
 
 #include <catch.hpp>
+#include <GigaMesh/mesh/facebvh.h>
 #include <GigaMesh/mesh/mesh.h>
+#include <GigaMesh/mesh/meshbufferpack.h>
+#include <GigaMesh/mesh/polyline.h>
+#include <GigaMesh/mesh/quadricdecimation.h>
+#include <GigaMesh/mesh/scalarfieldsplit.h>
+#include <GigaMesh/mesh/vertexwelding.h>
+#include <GigaMesh/mesh/voxelfilter25d.h>
+#include <libpsalm/libpsalm.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <spherical_intersection/algorithm/component_count.h>
+#include <spherical_intersection/algorithm/sphere_surface_msii.h>
+#include <spherical_intersection/algorithm/sphere_volume_msii.h>
+#include <spherical_intersection/graph.h>
 
 //Mock wrapper class for Mesh
 // Goals:
@@ -240,3 +261,2107 @@ SCENARIO("Testing translation of selected vertices", "[mesh]")
 		}
 	}
 }
+
+TEST_CASE("Function value statistics", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	// Assign function values including non-finite ones, which have to be ignored.
+	std::vector<double> finiteValues;
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		double funcVal = std::sin(static_cast<double>(i)) * 100.0;
+		if(i % 7 == 0)
+		{
+			funcVal = (i % 2 == 0) ? _NOT_A_NUMBER_DBL_ : _INFINITE_DBL_;
+		}
+		else
+		{
+			finiteValues.push_back(funcVal);
+		}
+		testMesh.getVertexPos(i)->setFuncValue(funcVal);
+	}
+	testMesh.changedVertFuncVal();
+	std::sort(finiteValues.begin(), finiteValues.end());
+	REQUIRE(finiteValues.size() > 2);
+
+	SECTION("Minimum and maximum")
+	{
+		double minVal = 0.0;
+		double maxVal = 0.0;
+		REQUIRE(testMesh.getFuncValuesMinMax(minVal, maxVal));
+		CHECK(minVal == finiteValues.front());
+		CHECK(maxVal == finiteValues.back());
+	}
+
+	SECTION("Quantiles by selection and after sorting match the sorted values")
+	{
+		for(double quantil : {0.01, 0.99, 0.05, 0.95, 0.5, 0.0, 1.0})
+		{
+			double minVal = 0.0;
+			double maxVal = 0.0;
+			REQUIRE(testMesh.getFuncValuesMinMaxQuantil(quantil, 1.0 - quantil, minVal, maxVal));
+			const auto idxLow  = std::lround(quantil * static_cast<double>(finiteValues.size() - 1));
+			const auto idxHigh = std::lround((1.0 - quantil) * static_cast<double>(finiteValues.size() - 1));
+			CHECK(minVal == finiteValues[idxLow]);
+			CHECK(maxVal == finiteValues[idxHigh]);
+		}
+	}
+
+	SECTION("Histogram counts all finite values and is invalidated by changed values")
+	{
+		std::vector<unsigned int> bins(16, 0);
+		double minVal = 0.0;
+		double maxVal = 0.0;
+		REQUIRE(testMesh.getHistogramValues(Mesh::HISTOGRAM_FUNCTION_VALUES_VERTEX, &bins, &minVal, &maxVal));
+		CHECK(std::accumulate(bins.begin(), bins.end(), 0UL) == finiteValues.size());
+
+		testMesh.getVertexPos(1)->setFuncValue(1000.0);
+		testMesh.changedVertFuncVal();
+		REQUIRE(testMesh.getFuncValuesMinMax(minVal, maxVal));
+		CHECK(maxVal == 1000.0);
+	}
+
+	SECTION("Methods of the mesh setting function values invalidate the cache")
+	{
+		double minVal = 0.0;
+		double maxVal = 0.0;
+		REQUIRE(testMesh.getFuncValuesMinMax(minVal, maxVal));
+
+		// Labeling with the iteration step as function value.
+		REQUIRE(testMesh.setParamFlagMesh(MeshParams::LABELING_USE_STEP_AS_FUNCVAL, true));
+		REQUIRE(testMesh.labelVerticesAll());
+		double minExpected = std::numeric_limits<double>::infinity();
+		double maxExpected = -std::numeric_limits<double>::infinity();
+		for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+		{
+			double funcVal = _NOT_A_NUMBER_DBL_;
+			testMesh.getVertexPos(i)->getFuncValue(&funcVal);
+			if(std::isfinite(funcVal))
+			{
+				minExpected = std::min(minExpected, funcVal);
+				maxExpected = std::max(maxExpected, funcVal);
+			}
+		}
+		REQUIRE(maxExpected != finiteValues.back());
+		REQUIRE(testMesh.getFuncValuesMinMax(minVal, maxVal));
+		CHECK(minVal == minExpected);
+		CHECK(maxVal == maxExpected);
+	}
+}
+
+TEST_CASE("Mesh information", "[mesh]")
+{
+	const std::string fileName = GENERATE(as<std::string>{}, "testdata/sphere_ascii.ply", "testdata/flat-vv.obj", "testdata/ngon_concave.ply");
+	CAPTURE(fileName);
+
+	bool success = false;
+	MockMesh testMesh(fileName, success);
+	REQUIRE(success == true);
+
+	MeshInfoData infoFull;
+	REQUIRE(testMesh.getMeshInfoData(infoFull, false, false));
+
+	SECTION("Border configurations of faces match the per-face test")
+	{
+		uint64_t facesThreeBorderVertices = 0;
+		for(uint64_t i=0; i<testMesh.getFaceNr(); ++i)
+		{
+			unsigned int nrVerticesBorder = 0;
+			testMesh.getFacePos(i)->hasBorderVertex(nrVerticesBorder);
+			if(nrVerticesBorder == 3)
+			{
+				facesThreeBorderVertices++;
+			}
+		}
+		CHECK(infoFull.mCountULong[MeshInfoData::FACES_BORDER_THREE_VERTICES] == facesThreeBorderVertices);
+		CHECK(infoFull.mCountULong[MeshInfoData::FACES_MANIFOLD] + infoFull.mCountULong[MeshInfoData::FACES_NONMANIFOLD] == testMesh.getFaceNr());
+	}
+
+	SECTION("Fast mode matches the full mode")
+	{
+		MeshIO meshFile;
+		std::vector<sVertexProperties> vertexProps;
+		std::vector<sFaceProperties> faceProps;
+		REQUIRE(meshFile.readFile(fileName, vertexProps, faceProps));
+
+		MeshInfoData infoFast;
+		REQUIRE(infoFast.fetchPrimitiveProperties(vertexProps, faceProps));
+
+		for(const auto propId : { MeshInfoData::VERTICES_TOTAL, MeshInfoData::FACES_TOTAL,
+		                          MeshInfoData::VERTICES_NAN, MeshInfoData::VERTICES_SOLO,
+		                          MeshInfoData::VERTICES_FUNCVAL_FINITE, MeshInfoData::FACES_ZEROAREA })
+		{
+			CAPTURE(propId);
+			CHECK(infoFast.mCountULong[propId] == infoFull.mCountULong[propId]);
+		}
+		for(unsigned int propId=0; propId<MeshInfoData::DOUBLE_COUNT; ++propId)
+		{
+			CAPTURE(propId);
+			CHECK(infoFast.mCountDouble[propId] == Approx(infoFull.mCountDouble[propId]).margin(1e-9));
+		}
+	}
+}
+
+TEST_CASE("Affine transformation of the whole mesh", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	// Rotation, skew and translation - including a mirroring.
+	const std::vector<double> rotAngle{0.3};
+	Matrix4D transform(Matrix4D::INIT_ROTATE_ABOUT_Z, &rotAngle);
+	transform *= Matrix4D(std::vector<double>{1.0, 0.2, 0.0, 0.0,  0.0, 1.5, 0.0, 0.0,  0.1, 0.0, -0.8, 0.0,  10.0, -5.0, 2.5, 1.0});
+
+	std::vector<Vector3D> positionsExpected;
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		positionsExpected.push_back(testMesh.getVertexPos(i)->getPositionVector() * transform);
+	}
+
+	SECTION("Batched kernel matches Matrix4D::applyTo for float and double")
+	{
+		std::vector<double> coords4;
+		std::vector<float>  coords3;
+		for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+		{
+			Vertex* currVertex = testMesh.getVertexPos(i);
+			coords4.insert(coords4.end(), {currVertex->getX(), currVertex->getY(), currVertex->getZ(), 1.0});
+			coords3.insert(coords3.end(), {static_cast<float>(currVertex->getX()), static_cast<float>(currVertex->getY()), static_cast<float>(currVertex->getZ())});
+		}
+		std::vector<double> coordsKernel(coords4);
+		transform.applyTo(coords4.data(), testMesh.getVertexNr());
+		AffineTransform3x4<double>(transform).applyToPoints(coordsKernel.data(), testMesh.getVertexNr(), 4);
+		AffineTransform3x4<float>(transform).applyToPoints(coords3.data(), testMesh.getVertexNr());
+		for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+		{
+			for(unsigned int k=0; k<3; ++k)
+			{
+				CHECK(coordsKernel[i*4+k] == Approx(coords4[i*4+k]));
+				CHECK(coords3[i*3+k] == Approx(coords4[i*4+k]).margin(1e-3));
+			}
+			CHECK(coordsKernel[i*4+3] == 1.0);
+		}
+	}
+
+	SECTION("Vertices, face normals and bounding box are updated")
+	{
+		REQUIRE(testMesh.applyTransformationToWholeMesh(transform, true, false));
+
+		Vector3D bbMin(+DBL_MAX, +DBL_MAX, +DBL_MAX);
+		Vector3D bbMax(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+		for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+		{
+			Vertex* currVertex = testMesh.getVertexPos(i);
+			CHECK(currVertex->getX() == Approx(positionsExpected[i].getX()));
+			CHECK(currVertex->getY() == Approx(positionsExpected[i].getY()));
+			CHECK(currVertex->getZ() == Approx(positionsExpected[i].getZ()));
+			bbMin.set(std::min(bbMin.getX(), currVertex->getX()), std::min(bbMin.getY(), currVertex->getY()), std::min(bbMin.getZ(), currVertex->getZ()));
+			bbMax.set(std::max(bbMax.getX(), currVertex->getX()), std::max(bbMax.getY(), currVertex->getY()), std::max(bbMax.getZ(), currVertex->getZ()));
+		}
+		CHECK(testMesh.getMinX() == bbMin.getX());
+		CHECK(testMesh.getMinY() == bbMin.getY());
+		CHECK(testMesh.getMinZ() == bbMin.getZ());
+		CHECK(testMesh.getMaxX() == bbMax.getX());
+		CHECK(testMesh.getMaxY() == bbMax.getY());
+		CHECK(testMesh.getMaxZ() == bbMax.getZ());
+
+		// Face normals transformed by the cofactor matrix equal the recomputed ones.
+		for(uint64_t i=0; i<testMesh.getFaceNr(); ++i)
+		{
+			Face* currFace = testMesh.getFacePos(i);
+			Vector3D normalTransformed(currFace->getNormalX(), currFace->getNormalY(), currFace->getNormalZ());
+			currFace->clearFlag(Primitive::FLAG_NORMAL_SET);
+			currFace->getAreaNormal();
+			CHECK(normalTransformed.getX() == Approx(currFace->getNormalX()).margin(1e-9));
+			CHECK(normalTransformed.getY() == Approx(currFace->getNormalY()).margin(1e-9));
+			CHECK(normalTransformed.getZ() == Approx(currFace->getNormalZ()).margin(1e-9));
+		}
+	}
+
+	SECTION("Bounding box of a transformed subset")
+	{
+		// Move the vertex defining the maximum in x inwards, so that the box has to shrink.
+		// Note: Matrix4D( Vector3D ) translates by the negated vector.
+		uint64_t vertIdxMaxX = 0;
+		for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+		{
+			if(testMesh.getVertexPos(i)->getX() > testMesh.getVertexPos(vertIdxMaxX)->getX())
+			{
+				vertIdxMaxX = i;
+			}
+		}
+		std::set<Vertex*> someVertices{ testMesh.getVertexPos(vertIdxMaxX) };
+		REQUIRE(testMesh.applyTransformation(Matrix4D(Vector3D(50.0, 0.0, 0.0)), &someVertices, true, false));
+		const double maxXExpected = testMesh.getMaxX();
+		testMesh.estBoundingBox();
+		CHECK(maxXExpected == testMesh.getMaxX());
+
+		// Move a vertex outwards, which extends the box.
+		someVertices = { testMesh.getVertexPos(0) };
+		REQUIRE(testMesh.applyTransformation(Matrix4D(Vector3D(0.0, 0.0, 1000.0)), &someVertices, true, false));
+		CHECK(testMesh.getMinZ() == testMesh.getVertexPos(0)->getZ());
+		const double minZExpected = testMesh.getMinZ();
+		testMesh.estBoundingBox();
+		CHECK(minZExpected == testMesh.getMinZ());
+	}
+}
+
+TEST_CASE("Vertex normals from adjacent faces", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	const Vertex::eNormalWeighting weighting = GENERATE(Vertex::NORMAL_WEIGHT_AREA_ANGLE, Vertex::NORMAL_WEIGHT_AREA, Vertex::NORMAL_WEIGHT_ANGLE);
+	double meshArea = 0.0;
+	REQUIRE(testMesh.resetFaceNormals(&meshArea));
+	CHECK(meshArea > 0.0);
+
+	// Reference by scattering the weighted face normals to their vertices.
+	std::map<Vertex*, Vector3D> normalsExpected;
+	for(uint64_t i=0; i<testMesh.getFaceNr(); ++i)
+	{
+		Face* currFace = testMesh.getFacePos(i);
+		const Vector3D faceNormal(currFace->getNormalX(), currFace->getNormalY(), currFace->getNormalZ());
+		for(Vertex* currVertex : {currFace->getVertA(), currFace->getVertB(), currFace->getVertC()})
+		{
+			const double angle = currFace->getAngleAtVertex(currVertex);
+			switch(weighting)
+			{
+				case Vertex::NORMAL_WEIGHT_AREA_ANGLE:
+					normalsExpected[currVertex] += faceNormal * angle;
+					break;
+				case Vertex::NORMAL_WEIGHT_AREA:
+					normalsExpected[currVertex] += faceNormal;
+					break;
+				case Vertex::NORMAL_WEIGHT_ANGLE:
+					normalsExpected[currVertex] += faceNormal * ( angle / faceNormal.getLength3() );
+					break;
+			}
+		}
+	}
+
+	std::vector<float> normalsBuffer(3*testMesh.getVertexNr(), -1.0f);
+	REQUIRE(testMesh.resetVertexNormals(weighting, normalsBuffer.data()));
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		Vertex* currVertex = testMesh.getVertexPos(i);
+		Vector3D normalExpected = normalsExpected[currVertex];
+		normalExpected.normalize3();
+		CHECK(currVertex->getNormalX() == Approx(normalExpected.getX()).margin(1e-9));
+		CHECK(currVertex->getNormalY() == Approx(normalExpected.getY()).margin(1e-9));
+		CHECK(currVertex->getNormalZ() == Approx(normalExpected.getZ()).margin(1e-9));
+		CHECK(normalsBuffer[3*i]   == Approx(normalExpected.getX()).margin(1e-6));
+		CHECK(normalsBuffer[3*i+1] == Approx(normalExpected.getY()).margin(1e-6));
+		CHECK(normalsBuffer[3*i+2] == Approx(normalExpected.getZ()).margin(1e-6));
+	}
+}
+
+TEST_CASE("Mesh polishing with incremental iterations", "[mesh]")
+{
+	const std::string fileName = GENERATE(as<std::string>{}, "testdata/flat-vv.obj",
+	                                      "testdata/test_bridging_synthetic_flat.ply", "testdata/0976_REDUX.obj");
+	CAPTURE(fileName);
+
+	bool success = false;
+	MockMesh testMesh(fileName, success);
+	REQUIRE(success == true);
+
+	// The intermediate results and the meta-data are written.
+	const std::filesystem::path fileNameOut = std::filesystem::temp_directory_path() / "gigamesh_polish_test.ply";
+	const std::filesystem::path fileNameLegacy = std::filesystem::temp_directory_path() / "gigamesh_polish_legacy.ply";
+	uint64_t iterationCount = 0;
+	testMesh.completeRestore(fileNameOut, 0.1, true, false, 3000, nullptr, iterationCount);
+	CHECK(iterationCount > 1);
+
+	MeshInfoData infoPolished;
+	REQUIRE(testMesh.getMeshInfoData(infoPolished, false, false));
+	for(const auto propId : { MeshInfoData::VERTICES_NAN, MeshInfoData::VERTICES_SOLO, MeshInfoData::VERTICES_SINGULAR,
+	                          MeshInfoData::VERTICES_ON_INVERTED_EDGE, MeshInfoData::FACES_NONMANIFOLD,
+	                          MeshInfoData::FACES_STICKY, MeshInfoData::FACES_ZEROAREA })
+	{
+		CAPTURE(propId);
+		CHECK(infoPolished.mCountULong[propId] == 0);
+	}
+
+	// Reference: the cleaning checking the whole mesh, which must not find anything missed by
+	// checking the regions only. A comparison with the result of the whole pipeline is not
+	// possible, because the triangulation of the holes depends on the order of the border
+	// vertices in memory i.e. the results vary between runs.
+	const uint64_t vertexNrPolished = testMesh.getVertexNr();
+	const uint64_t faceNrPolished = testMesh.getFaceNr();
+	REQUIRE(testMesh.removeUncleanSmall(fileNameLegacy, 0.1, true));
+	CHECK(testMesh.getVertexNr() == vertexNrPolished);
+	CHECK(testMesh.getFaceNr() == faceNrPolished);
+	testMesh.convertBordersToPolylines();
+	uint64_t holesFilled = 0;
+	uint64_t holesFail = 0;
+	uint64_t holesSkipped = 0;
+	testMesh.fillPolyLines(3000, holesFilled, holesFail, holesSkipped);
+	CHECK(holesFilled == 0);
+
+	for(const std::filesystem::path& fileNameWritten : {fileNameOut, fileNameLegacy})
+	{
+		for(const std::string suffix : {".ply", ".mesh_polish.txt", ".mesh_polish.ttl", ".mesh_polish.xml", ".mesh_polish.json",
+		                                ".mesh_clean.txt", ".mesh_clean.ttl", ".mesh_clean.xml", ".mesh_clean.json"})
+		{
+			std::filesystem::path fileNameSuffix = fileNameWritten;
+			std::filesystem::remove(fileNameSuffix.replace_extension(suffix));
+		}
+	}
+}
+
+TEST_CASE("Batched removal and insertion of primitives", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/0976_REDUX.obj", success);
+	REQUIRE(success == true);
+	MockMesh referenceMesh("testdata/0976_REDUX.obj", success);
+	REQUIRE(success == true);
+	const uint64_t vertexNrPrev = testMesh.getVertexNr();
+	REQUIRE(vertexNrPrev > 100);
+
+	// Every 7th vertex and every 11th face - some of them overlapping.
+	auto getPrimitives = [](const Mesh& rMesh, std::set<Vertex*>& rVerts, std::set<Face*>& rFaces)
+	{
+		for(uint64_t i=0; i<rMesh.getVertexNr(); i+=7)
+		{
+			rVerts.insert(rMesh.getVertexPos(i));
+		}
+		for(uint64_t i=0; i<rMesh.getFaceNr(); i+=11)
+		{
+			rFaces.insert(rMesh.getFacePos(i));
+		}
+	};
+	std::set<Vertex*> vertsReference;
+	std::set<Face*>   facesReference;
+	getPrimitives(referenceMesh, vertsReference, facesReference);
+	std::set<Vertex*> vertsToRemove;
+	std::set<Face*>   facesToRemove;
+	getPrimitives(testMesh, vertsToRemove, facesToRemove);
+	const uint64_t vertsRemovedNr = vertsToRemove.size();
+
+	// Reference: faces first as the vertices' removal would delete some of them.
+	REQUIRE(referenceMesh.removeFaces(&facesReference));
+	REQUIRE(referenceMesh.removeVertices(&vertsReference));
+
+	REQUIRE(testMesh.selectVertInvert());
+	REQUIRE(testMesh.editBegin());
+	CHECK(testMesh.isEditActive());
+	CHECK_FALSE(testMesh.editBegin());
+	REQUIRE(testMesh.editRemoveVertices(vertsToRemove));
+	REQUIRE(testMesh.editRemoveFaces(facesToRemove));
+	// Same removal as deferred call.
+	REQUIRE(testMesh.removeVertices(&vertsToRemove));
+	CHECK(vertsToRemove.empty());
+	CHECK(testMesh.getVertexNr() == vertexNrPrev);
+	Vertex* vertexNew = new Vertex(Vector3D(1.0, 2.0, 3.0));
+	REQUIRE(testMesh.editInsertVertices({vertexNew}));
+	REQUIRE(testMesh.editCommit());
+	CHECK_FALSE(testMesh.isEditActive());
+	CHECK_FALSE(testMesh.editCommit());
+
+	REQUIRE(testMesh.getVertexNr() == referenceMesh.getVertexNr() + 1);
+	REQUIRE(testMesh.getFaceNr() == referenceMesh.getFaceNr());
+	CHECK(testMesh.getVertexNr() == vertexNrPrev - vertsRemovedNr + 1);
+	CHECK(testMesh.getVertexPos(testMesh.getVertexNr()-1) == vertexNew);
+	for(uint64_t i=0; i<referenceMesh.getVertexNr(); i++)
+	{
+		CHECK(testMesh.getVertexPos(i)->getX() == referenceMesh.getVertexPos(i)->getX());
+	}
+	// Order and index of the faces are maintained.
+	for(uint64_t i=0; i<testMesh.getFaceNr(); i++)
+	{
+		const Face* face = testMesh.getFacePos(i);
+		CHECK(face->getIndex() == static_cast<int>(i));
+		CHECK(face->getVertA()->getY() == referenceMesh.getFacePos(i)->getVertA()->getY());
+		CHECK_FALSE(face->getFlag(Primitive::FLAG_REMOVED));
+	}
+	// The selection does not contain removed vertices.
+	std::set<Vertex*> vertsSelected;
+	testMesh.getSelectedVerts(&vertsSelected);
+	CHECK(vertsSelected.size() == vertexNrPrev - vertsRemovedNr);
+}
+
+TEST_CASE("Batched removal with flags loaded from a file", "[mesh]")
+{
+	// Two triangles sharing an edge. All vertices carry FLAG_SYNTHETIC and the bit of FLAG_REMOVED.
+	const uint64_t flagsInFile = Primitive::FLAG_SYNTHETIC | Primitive::FLAG_REMOVED;
+	const std::filesystem::path fileName = std::filesystem::temp_directory_path() / "gigamesh_flags_test.ply";
+	{
+		std::ofstream plyFile(fileName);
+		plyFile << "ply\nformat ascii 1.0\n"
+		        << "element vertex 4\nproperty float x\nproperty float y\nproperty float z\nproperty int flags\n"
+		        << "element face 2\nproperty list uchar int vertex_indices\nend_header\n";
+		plyFile << "0 0 0 " << flagsInFile << "\n1 0 0 " << flagsInFile << "\n"
+		        << "0 1 0 " << flagsInFile << "\n1 1 0 " << flagsInFile << "\n";
+		plyFile << "3 0 1 2\n3 1 3 2\n";
+	}
+	bool success = false;
+	MockMesh testMesh(fileName.string(), success);
+	std::filesystem::remove(fileName);
+	REQUIRE(success == true);
+	REQUIRE(testMesh.getVertexNr() == 4);
+	REQUIRE(testMesh.getFaceNr() == 2);
+	for(uint64_t i=0; i<testMesh.getVertexNr(); i++)
+	{
+		const Vertex* vertex = testMesh.getVertexPos(i);
+		CHECK(vertex->getFlag(Primitive::FLAG_SYNTHETIC));
+		CHECK_FALSE(vertex->getFlag(Primitive::FLAG_REMOVED));
+	}
+
+	// Removing the vertex only used by the second triangle has to remove this triangle, too.
+	std::set<Vertex*> vertsToRemove = { testMesh.getVertexPos(3) };
+	REQUIRE(testMesh.editBegin());
+	REQUIRE(testMesh.editRemoveVertices(vertsToRemove));
+	REQUIRE(testMesh.editCommit());
+	REQUIRE(testMesh.getVertexNr() == 3);
+	REQUIRE(testMesh.getFaceNr() == 1);
+	const Face* face = testMesh.getFacePos(0);
+	CHECK(face->getVertA() == testMesh.getVertexPos(0));
+	CHECK(face->getVertB() == testMesh.getVertexPos(1));
+	CHECK(face->getVertC() == testMesh.getVertexPos(2));
+	for(uint64_t i=0; i<testMesh.getVertexNr(); i++)
+	{
+		std::vector<Face*> facesAdjacent;
+		testMesh.getVertexPos(i)->getFaces(&facesAdjacent);
+		CHECK(facesAdjacent.size() == 1);
+	}
+
+	// The reserved flag is not exported either.
+	sVertexProperties vertexProps;
+	testMesh.getVertexPos(0)->setFlag(Primitive::FLAG_REMOVED);
+	REQUIRE(testMesh.getVertexPos(0)->copyVertexPropsTo(vertexProps));
+	CHECK((vertexProps.mFlags & Primitive::FLAG_REMOVED) == 0);
+	CHECK((vertexProps.mFlags & Primitive::FLAG_SYNTHETIC) != 0);
+	testMesh.getVertexPos(0)->clearFlag(Primitive::FLAG_REMOVED);
+}
+
+//! Reference for libpsalm: the dynamic program of the minimum weight triangulation as implemented before its
+//! optimization i.e. evaluating the objective function for every candidate with the same arithmetic.
+//! @returns the triangles as sorted triples of indices into the polygon.
+std::set<std::array<size_t, 3>> triangulateMinimumWeightReference(const std::vector<double>& rCoords, const std::vector<double>& rNormals)
+{
+	using tWeight = std::pair<double, double>;
+	const size_t n = rCoords.size() / 3;
+	auto normalize = [](std::array<double, 3> vec)
+	{
+		const double len = std::sqrt(vec[0]*vec[0] + vec[1]*vec[1] + vec[2]*vec[2]);
+		if(len == 0)
+		{
+			return vec;
+		}
+		const double lenInv = 1 / len;
+		return std::array<double, 3>{vec[0]*lenInv, vec[1]*lenInv, vec[2]*lenInv};
+	};
+	auto dot = [](const std::array<double, 3>& vecA, const std::array<double, 3>& vecB)
+	{
+		return vecA[0]*vecB[0] + vecA[1]*vecB[1] + vecA[2]*vecB[2];
+	};
+	// minimum_area_and_normal_angle of libpsalm.
+	auto objective = [&](size_t a, size_t b, size_t c)
+	{
+		const double* posA = &rCoords[a*3];
+		const double* posB = &rCoords[b*3];
+		const double* posC = &rCoords[c*3];
+		const std::array<double, 3> edgeBA = {posB[0]-posA[0], posB[1]-posA[1], posB[2]-posA[2]};
+		const std::array<double, 3> edgeCA = {posC[0]-posA[0], posC[1]-posA[1], posC[2]-posA[2]};
+		const std::array<double, 3> cross = {edgeBA[1]*edgeCA[2] - edgeBA[2]*edgeCA[1],
+		                                     edgeBA[2]*edgeCA[0] - edgeBA[0]*edgeCA[2],
+		                                     edgeBA[0]*edgeCA[1] - edgeBA[1]*edgeCA[0]};
+		const std::array<double, 3> normal = normalize(cross);
+		auto normalOf = [&](size_t idx)
+		{
+			return normalize({rNormals[idx*3], rNormals[idx*3+1], rNormals[idx*3+2]});
+		};
+		double angle = std::max(std::acos(dot(normal, normalOf(a))), std::acos(dot(normal, normalOf(b))));
+		angle = std::max(std::acos(dot(normal, normalOf(c))), angle);
+		double area = std::sqrt(dot(cross, cross));
+		if(area < std::numeric_limits<double>::epsilon())
+		{
+			area = std::numeric_limits<double>::max();
+		}
+		return tWeight(angle, area);
+	};
+
+	std::vector<std::vector<tWeight>> weights(n, std::vector<tWeight>(n));
+	std::vector<std::vector<size_t>> indices(n, std::vector<size_t>(n));
+	for(size_t i=0; i+2<n; i++)
+	{
+		weights[i][i+1] = tWeight(0.0, 0.0);
+		weights[i][i+2] = objective(i, i+1, i+2);
+	}
+	weights[n-2][n-1] = tWeight(0.0, 0.0);
+	for(size_t j=3; j<n; j++)
+	{
+		for(size_t i=0; i<n-j; i++)
+		{
+			const size_t k = i+j;
+			tWeight minWeight(std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+			size_t minIndex = std::numeric_limits<size_t>::max();
+			for(size_t m=i+1; m<k; m++)
+			{
+				const tWeight currWeight = objective(i, m, k);
+				const double area = weights[i][m].second + weights[m][k].second + currWeight.second;
+				const double angle = std::max(currWeight.first, std::max(weights[i][m].first, weights[m][k].first));
+				const tWeight candidate(angle, area);
+				if(candidate < minWeight)
+				{
+					minWeight = candidate;
+					minIndex = m;
+				}
+			}
+			weights[i][k] = minWeight;
+			indices[i][k] = minIndex;
+		}
+	}
+
+	std::set<std::array<size_t, 3>> triangles;
+	std::function<void(size_t, size_t)> construct = [&](size_t i, size_t k)
+	{
+		const size_t j = (i+2 == k) ? i+1 : indices[i][k];
+		std::array<size_t, 3> triangle = {i, j, k};
+		std::sort(triangle.begin(), triangle.end());
+		triangles.insert(triangle);
+		if(i+2 == k)
+		{
+			return;
+		}
+		if(j != i+1)
+		{
+			construct(i, j);
+		}
+		if(j != k-1)
+		{
+			construct(j, k);
+		}
+	};
+	construct(0, n-1);
+	return triangles;
+}
+
+TEST_CASE("Filling a large hole", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	// Remove the cap of the sphere, which leaves a single hole with a long border.
+	std::set<Face*> facesToRemove;
+	for(uint64_t i=0; i<testMesh.getFaceNr(); ++i)
+	{
+		Face* face = testMesh.getFacePos(i);
+		if(face->getVertA()->getZ() > 40.0 || face->getVertB()->getZ() > 40.0 || face->getVertC()->getZ() > 40.0)
+		{
+			facesToRemove.insert(face);
+		}
+	}
+	REQUIRE(testMesh.removeFaces(&facesToRemove));
+	const uint64_t faceNrHole = testMesh.getFaceNr();
+
+	REQUIRE(testMesh.convertBordersToPolylines());
+	REQUIRE(testMesh.getPolyLineNr() == 1);
+
+	// The triangulation of libpsalm is the same as by the reference implementation.
+	auto checkTriangulation = [](const std::vector<double>& rCoords, const std::vector<double>& rNormals)
+	{
+		const int vertexNr = static_cast<int>(rCoords.size() / 3);
+		std::vector<long> vertexIDs(vertexNr);
+		std::iota(vertexIDs.begin(), vertexIDs.end(), 1);
+		std::vector<double> coords = rCoords;
+		std::vector<double> normals = rNormals;
+		size_t  newVertexNr = 0;
+		double* newCoords   = nullptr;
+		int     newFaceNr   = 0;
+		long*   newFaceIDs  = nullptr;
+		REQUIRE(fill_hole(vertexNr, vertexIDs.data(), coords.data(), nullptr, normals.data(),
+		                  &newVertexNr, &newCoords, &newFaceNr, &newFaceIDs, false));
+		CHECK(newVertexNr == 0);
+		CHECK(newFaceNr == vertexNr - 2);
+		// Existing vertices are returned with negative IDs.
+		std::set<std::array<size_t, 3>> triangles;
+		for(int i=0; i<newFaceNr; ++i)
+		{
+			std::array<size_t, 3> triangle = {static_cast<size_t>(-newFaceIDs[i * 3] - 1),
+			                                  static_cast<size_t>(-newFaceIDs[i * 3 + 1] - 1),
+			                                  static_cast<size_t>(-newFaceIDs[i * 3 + 2] - 1)};
+			std::sort(triangle.begin(), triangle.end());
+			triangles.insert(triangle);
+		}
+		delete[] newCoords;
+		delete[] newFaceIDs;
+		CHECK(triangles == triangulateMinimumWeightReference(rCoords, rNormals));
+	};
+
+	// Border of the hole without normals as used by Mesh::fillPolyLines and with the normals of the vertices.
+	// The polyline is closed by repeating its first vertex.
+	PolyLine* border = testMesh.getPolyLinePos(0);
+	const int borderNr = border->length() - 1;
+	REQUIRE(borderNr > 3);
+	std::vector<double> coords(borderNr * 3);
+	std::vector<double> normals(borderNr * 3);
+	for(int i=0; i<borderNr; ++i)
+	{
+		Vertex* vertex = border->getVertexRef(i);
+		vertex->copyXYZTo(&coords[i * 3]);
+		const Vector3D normal = vertex->getNormal(true);
+		normals[i * 3]     = normal.getX();
+		normals[i * 3 + 1] = normal.getY();
+		normals[i * 3 + 2] = normal.getZ();
+	}
+	checkTriangulation(coords, std::vector<double>(borderNr * 3, 0.0));
+	checkTriangulation(coords, normals);
+
+	// Noisy circle with noisy normals, which is large enough for the parallel evaluation of the diagonals.
+	const unsigned int circleNr = 300;
+	std::mt19937 gen(4711);
+	std::uniform_real_distribution<> dis(-0.1, 0.1);
+	std::vector<double> circleCoords(circleNr * 3);
+	std::vector<double> circleNormals(circleNr * 3);
+	for(unsigned int i=0; i<circleNr; ++i)
+	{
+		const double phi = 2.0 * M_PI * i / circleNr;
+		circleCoords[i * 3]      = std::cos(phi) + dis(gen);
+		circleCoords[i * 3 + 1]  = std::sin(phi) + dis(gen);
+		circleCoords[i * 3 + 2]  = dis(gen);
+		circleNormals[i * 3]     = dis(gen);
+		circleNormals[i * 3 + 1] = dis(gen);
+		circleNormals[i * 3 + 2] = 1.0;
+	}
+	checkTriangulation(circleCoords, circleNormals);
+
+	uint64_t filled  = 0;
+	uint64_t fail    = 0;
+	uint64_t skipped = 0;
+	CHECK(testMesh.fillPolyLines(0, filled, fail, skipped));
+	CHECK(filled == 1);
+	CHECK(fail == 0);
+	CHECK(skipped == 0);
+	CHECK(testMesh.getFaceNr() > faceNrHole);
+
+	// No border remains.
+	uint64_t borderVertices = 0;
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		if(testMesh.getVertexPos(i)->isBorder())
+		{
+			++borderVertices;
+		}
+	}
+	CHECK(borderVertices == 0);
+}
+
+TEST_CASE("Isolines of multiple iso-values in a single pass", "[mesh]")
+{
+	// Planar grid of 20 x 10 units with the linear function value x + y/2, so that the isolines are
+	// straight lines clipped by the border of the grid.
+	const unsigned int gridX = 20;
+	const unsigned int gridY = 10;
+	const std::filesystem::path fileName = std::filesystem::temp_directory_path() / "gigamesh_isolines_test.obj";
+	{
+		std::ofstream objFile(fileName);
+		for(unsigned int y=0; y<=gridY; ++y)
+		{
+			for(unsigned int x=0; x<=gridX; ++x)
+			{
+				objFile << "v " << x << " " << y << " 0\n";
+			}
+		}
+		for(unsigned int y=0; y<gridY; ++y)
+		{
+			for(unsigned int x=0; x<gridX; ++x)
+			{
+				const unsigned int idx = y * (gridX + 1) + x + 1; // OBJ starts with one.
+				objFile << "f " << idx << " " << idx + 1 << " " << idx + gridX + 2 << "\n";
+				objFile << "f " << idx << " " << idx + gridX + 2 << " " << idx + gridX + 1 << "\n";
+			}
+		}
+	}
+	bool success = false;
+	MockMesh testMesh(fileName.string(), success);
+	std::filesystem::remove(fileName);
+	REQUIRE(success == true);
+	REQUIRE(testMesh.getFaceNr() == 2 * gridX * gridY);
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		Vertex* vert = testMesh.getVertexPos(i);
+		vert->setFuncValue(vert->getX() + 0.5 * vert->getY());
+	}
+	testMesh.changedVertFuncVal();
+
+	// Length of the line x + y/2 = c within the grid.
+	auto getExpectedLength = [](double rIsoValue)
+	{
+		if(rIsoValue < 5.0)
+		{
+			return rIsoValue * std::sqrt(5.0);
+		}
+		if(rIsoValue > 20.0)
+		{
+			return (25.0 - rIsoValue) * std::sqrt(5.0);
+		}
+		return std::sqrt(125.0);
+	};
+
+	// Unordered iso-values including a duplicate and values outside the range. None of them matches
+	// the function value of a vertex, which are multiples of 1/2.
+	const std::vector<double> isoValues{12.1, 3.3, -1.0, 21.7, 12.1, 30.0, 17.9};
+	std::vector<double> isoValuesExpected;
+	for(const double isoValue : isoValues)
+	{
+		if(isoValue > 0.0 && isoValue < 25.0)
+		{
+			isoValuesExpected.push_back(isoValue);
+		}
+	}
+	std::sort(isoValuesExpected.begin(), isoValuesExpected.end());
+
+	REQUIRE(testMesh.isolinesToPolylines(isoValues));
+	REQUIRE(testMesh.getPolyLineNr() == isoValuesExpected.size());
+	std::vector<double> isoValuesFound;
+	for(unsigned int i=0; i<testMesh.getPolyLineNr(); ++i)
+	{
+		std::vector<double> coords;
+		REQUIRE(testMesh.getPolyLinePos(i)->getVertexCoords(&coords));
+		REQUIRE(coords.size() >= 6);
+		const double isoValue = coords[0] + 0.5 * coords[1];
+		CAPTURE(isoValue);
+		isoValuesFound.push_back(isoValue);
+		double length = 0.0;
+		for(size_t j=0; j<coords.size(); j+=3)
+		{
+			CHECK(coords[j] + 0.5 * coords[j + 1] == Approx(isoValue));
+			CHECK(coords[j + 2] == 0.0);
+			if(j > 0)
+			{
+				length += std::sqrt(std::pow(coords[j] - coords[j - 3], 2.0) + std::pow(coords[j + 1] - coords[j - 2], 2.0));
+			}
+		}
+		CHECK(length == Approx(getExpectedLength(isoValue)));
+	}
+	std::sort(isoValuesFound.begin(), isoValuesFound.end());
+	REQUIRE(isoValuesFound.size() == isoValuesExpected.size());
+	for(size_t i=0; i<isoValuesFound.size(); ++i)
+	{
+		CHECK(isoValuesFound[i] == Approx(isoValuesExpected[i]));
+	}
+
+	// Non-finite iso-values are skipped and reported.
+	CHECK_FALSE(testMesh.isolinesToPolylines({_NOT_A_NUMBER_DBL_, 3.3}));
+	CHECK(testMesh.getPolyLineNr() == isoValuesExpected.size() + 1);
+}
+
+TEST_CASE("Sliding window integral invariants of polylines", "[mesh]")
+{
+	// Closed line with wiggles, so that the distance to the center is not monotonic along the line.
+	PolyLine polyLine;
+	const unsigned int vertNr = 360;
+	for(unsigned int i=0; i<=vertNr; ++i)
+	{
+		const double phi = 2.0 * M_PI * static_cast<double>(i % vertNr) / vertNr;
+		const double rad = 10.0 + 1.5 * std::sin(11.0 * phi) + 0.3 * std::cos(37.0 * phi);
+		polyLine.addBack(Vector3D(rad * std::cos(phi), rad * std::sin(phi), 0.2 * std::sin(5.0 * phi)), Vector3D(0.0, 0.0, 1.0));
+	}
+	REQUIRE(polyLine.isClosed());
+
+	const std::vector<double> radii{0.5, 1.0, 2.5, 6.0};
+	const auto direction = GENERATE(PolyLine::POLY_INTEGRAL_INV_BOTH, PolyLine::POLY_INTEGRAL_INV_FORWARD, PolyLine::POLY_INTEGRAL_INV_BACKWARD);
+	std::vector<double> runLenValues;
+	std::vector<double> angleValues;
+	REQUIRE(polyLine.compIntInvRadii(radii, direction, &runLenValues));
+	REQUIRE(polyLine.compIntInvAngleRadii(radii, &angleValues));
+	REQUIRE(runLenValues.size() == (vertNr + 1) * radii.size());
+	REQUIRE(angleValues.size() == (vertNr + 1) * radii.size());
+
+	// Compare with the walk along the line from every single vertex.
+	for(size_t r=0; r<radii.size(); ++r)
+	{
+		std::vector<double> expected;
+		for(unsigned int i=0; i<vertNr; ++i)
+		{
+			REQUIRE(polyLine.compIntInv(i, radii[r], direction));
+		}
+		polyLine.getEdgeFuncVals(&expected);
+		unsigned int mismatches = 0;
+		for(unsigned int i=0; i<vertNr; ++i)
+		{
+			if(runLenValues[i * radii.size() + r] != Approx(expected[i]).epsilon(1e-10))
+			{
+				++mismatches;
+			}
+		}
+		CHECK(mismatches == 0);
+		CHECK(runLenValues[vertNr * radii.size() + r] == runLenValues[r]);
+
+		for(unsigned int i=0; i<vertNr; ++i)
+		{
+			REQUIRE(polyLine.compIntInvAngle(i, radii[r]));
+		}
+		expected.clear();
+		polyLine.getEdgeFuncVals(&expected);
+		mismatches = 0;
+		for(unsigned int i=0; i<vertNr; ++i)
+		{
+			if(angleValues[i * radii.size() + r] != expected[i])
+			{
+				++mismatches;
+			}
+		}
+		CHECK(mismatches == 0);
+	}
+
+	// Single radius sets the function values.
+	std::vector<double> funcVals;
+	REQUIRE(polyLine.compIntInv(radii[1], direction));
+	polyLine.getEdgeFuncVals(&funcVals);
+	for(unsigned int i=0; i<=vertNr; ++i)
+	{
+		CHECK(funcVals[i] == runLenValues[i * radii.size() + 1]);
+	}
+
+	// A sphere containing the whole line is an error.
+	CHECK_FALSE(polyLine.compIntInvRadii({100.0}, PolyLine::POLY_INTEGRAL_INV_BOTH, &runLenValues));
+	CHECK(std::isnan(runLenValues.front()));
+
+	// All polylines of a mesh in parallel.
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success);
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		Vertex* vert = testMesh.getVertexPos(i);
+		vert->setFuncValue(vert->getZ());
+	}
+	testMesh.changedVertFuncVal();
+	REQUIRE(testMesh.isolinesToPolylines({-0.5, 0.0, 0.5}));
+	std::vector<std::vector<double>> meshValues;
+	REQUIRE(testMesh.compPolylinesIntInvRunLenRadii(radii, direction, &meshValues));
+	REQUIRE(meshValues.size() == testMesh.getPolyLineNr());
+	unsigned int closedNr = 0;
+	for(unsigned int i=0; i<testMesh.getPolyLineNr(); ++i)
+	{
+		PolyLine* currPoly = testMesh.getPolyLinePos(i);
+		if(!currPoly->isClosed())
+		{
+			CHECK(meshValues[i].empty());
+			continue;
+		}
+		++closedNr;
+		REQUIRE(currPoly->compIntInvRadii(radii, direction, &runLenValues));
+		CHECK(meshValues[i] == runLenValues);
+	}
+	CHECK(closedNr > 0);
+}
+
+TEST_CASE("Ambient occlusion by ray casting", "[mesh]")
+{
+	// Every n-th vertex is removed beforehand, so that the indices of the vertices are outdated.
+	using tInput = std::tuple<std::string, uint64_t>;
+	const tInput input = GENERATE(tInput{"testdata/sphere_ascii.ply", 0},
+	                              tInput{"testdata/0976_REDUX.obj", 0},
+	                              tInput{"testdata/0976_REDUX.obj", 13});
+	const std::string fileName = std::get<0>(input);
+	const uint64_t removeStep = std::get<1>(input);
+	CAPTURE(fileName, removeStep);
+	bool success = false;
+	MockMesh testMesh(fileName, success);
+	REQUIRE(success);
+	if(removeStep > 0)
+	{
+		std::set<Vertex*> vertsToRemove;
+		for(uint64_t i=0; i<testMesh.getVertexNr(); i+=removeStep)
+		{
+			vertsToRemove.insert(testMesh.getVertexPos(i));
+		}
+		REQUIRE(testMesh.removeVertices(&vertsToRemove));
+	}
+
+	// The faces refer to the position of their vertices independent of Vertex::getIndex.
+	std::vector<double>   vertexCoords(testMesh.getVertexNr() * 3);
+	std::vector<uint64_t> faceVertexIndices;
+	std::map<const Vertex*, uint64_t> vertexPositions;
+	for(uint64_t i=0; i<testMesh.getVertexNr(); ++i)
+	{
+		testMesh.getVertexPos(i)->copyXYZTo(&vertexCoords[i * 3]);
+		vertexPositions[testMesh.getVertexPos(i)] = i;
+	}
+	for(uint64_t i=0; i<testMesh.getFaceNr(); ++i)
+	{
+		Face* face = testMesh.getFacePos(i);
+		faceVertexIndices.insert(faceVertexIndices.end(), {vertexPositions.at(face->getVertA()),
+		                                                   vertexPositions.at(face->getVertB()),
+		                                                   vertexPositions.at(face->getVertC())});
+	}
+	FaceBVH faceBVH;
+	FaceBVH faceList; // Single leaf i.e. every ray is tested against all faces.
+	REQUIRE(faceBVH.build(vertexCoords, faceVertexIndices));
+	REQUIRE(faceList.build(vertexCoords, faceVertexIndices, static_cast<unsigned int>(testMesh.getFaceNr())));
+	CHECK(faceBVH.getFaceNr() == testMesh.getFaceNr());
+	CHECK(faceBVH.getNodeNr() > 1);
+	CHECK(faceList.getNodeNr() == 1);
+	CHECK_FALSE(FaceBVH().build(vertexCoords, {0, 1, testMesh.getVertexNr()}));
+
+	// Spherical Fibonacci lattice as documented for Mesh::funcVertAmbientOcclusionRayCast.
+	const unsigned int directionNr = 64;
+	std::vector<double> directions(directionNr * 3);
+	for(unsigned int i=0; i<directionNr; ++i)
+	{
+		const double phi   = 2.0 * M_PI * (i / (0.5 * (std::sqrt(5.0) + 1.0)));
+		const double theta = std::acos(1.0 - ((2.0 * i + 1.0) / directionNr));
+		directions[i * 3]     = std::cos(phi) * std::sin(theta);
+		directions[i * 3 + 1] = std::sin(phi) * std::sin(theta);
+		directions[i * 3 + 2] = -std::cos(theta);
+	}
+	const double radius = testMesh.getBoundingBoxRadius();
+	const double tMin   = 1e-9 * radius;
+
+	// Packets and single rays through the hierarchy are the same as the tests against all faces,
+	// which also provide the reference ambient occlusion.
+	const uint64_t vertStep = 61;
+	std::vector<double> expectedAO;
+	unsigned int mismatches = 0;
+	uint64_t occludedNr = 0;
+	for(uint64_t vertIdx=0; vertIdx<testMesh.getVertexNr(); vertIdx+=vertStep)
+	{
+		const double* origin = &vertexCoords[vertIdx * 3];
+		const Vector3D normal = testMesh.getVertexPos(vertIdx)->getNormal(true);
+		double brightness = 0.0;
+		for(unsigned int i=0; i<directionNr; i+=FaceBVH::PACKET_SIZE)
+		{
+			const uint32_t packet = faceBVH.isOccludedPacket(origin, &directions[i * 3], FaceBVH::PACKET_SIZE, tMin, DBL_MAX, vertIdx);
+			for(unsigned int ray=0; ray<FaceBVH::PACKET_SIZE; ++ray)
+			{
+				const double* dir = &directions[(i + ray) * 3];
+				const bool occluded = faceList.isOccluded(origin, dir, tMin, DBL_MAX, vertIdx);
+				if(occluded != (((packet >> ray) & 1) != 0) ||
+				   occluded != faceBVH.isOccluded(origin, dir, tMin, DBL_MAX, vertIdx))
+				{
+					++mismatches;
+				}
+				occludedNr += occluded ? 1 : 0;
+				const double cosine = normal.getX() * dir[0] + normal.getY() * dir[1] + normal.getZ() * dir[2];
+				if(cosine > 0.0 && !occluded)
+				{
+					brightness += cosine;
+				}
+			}
+		}
+		expectedAO.push_back(brightness);
+	}
+	CHECK(mismatches == 0);
+	CHECK(occludedNr > 0);
+
+	REQUIRE(testMesh.funcVertAmbientOcclusionRayCast(directionNr, 0.0));
+	mismatches = 0;
+	double sumAO = 0.0;
+	for(uint64_t vertIdx=0; vertIdx<testMesh.getVertexNr(); ++vertIdx)
+	{
+		double funcVal = 0.0;
+		testMesh.getVertexPos(vertIdx)->getFuncValue(&funcVal);
+		CHECK(funcVal >= 0.0);
+		sumAO += funcVal;
+		if(vertIdx % vertStep == 0 && funcVal != expectedAO[vertIdx / vertStep])
+		{
+			++mismatches;
+		}
+	}
+	CHECK(mismatches == 0);
+	if(fileName == "testdata/sphere_ascii.ply")
+	{
+		// Convex i.e. only rays grazing the surface are occluded: the cosine integrated over the hemisphere is 1/4 of the sphere.
+		CHECK(sumAO / testMesh.getVertexNr() == Approx(directionNr / 4.0).epsilon(0.05));
+	}
+	else
+	{
+		CHECK(sumAO / testMesh.getVertexNr() < directionNr / 4.0);
+	}
+
+	CHECK_FALSE(testMesh.funcVertAmbientOcclusionRayCast(0, 0.0));
+}
+
+TEST_CASE("Packing of render buffers", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/0976_REDUX.obj", success);
+	REQUIRE(success);
+	const std::vector<Vertex*>& vertices = *testMesh.getPrimitiveListVertices();
+	const std::vector<Face*>&   faces    = *testMesh.getPrimitiveListFaces();
+	for(uint64_t i=0; i<vertices.size(); ++i)
+	{
+		vertices[i]->setIndex(static_cast<int>(i));
+	}
+
+	// Interleaved vertices against serial packing.
+	MeshBufferPack bufferPack;
+	CHECK_FALSE(bufferPack.updateVertices(vertices, faces, 0, vertices.size()));
+	REQUIRE(bufferPack.packVertices(vertices, faces));
+	REQUIRE(bufferPack.getVertexStripes().size() == vertices.size());
+	auto checkStripes = [&]()
+	{
+		for(uint64_t i=0; i<vertices.size(); ++i)
+		{
+			MeshBufferPack::sVertexStripe expected;
+			REQUIRE(MeshBufferPack::fetchVertex(vertices[i], &expected));
+			REQUIRE(std::memcmp(&expected, &bufferPack.getVertexStripes()[i], sizeof(expected)) == 0);
+		}
+	};
+	checkStripes();
+	uint64_t changedBegin = 0;
+	uint64_t changedEnd   = 0;
+	CHECK_FALSE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+
+	// Partial updates extend the changed range.
+	const std::vector<uint64_t> changedVertices{vertices.size() - 2, 17, 123};
+	for(const uint64_t vertexIdx : changedVertices)
+	{
+		vertices[vertexIdx]->setRGB(1, 2, 3);
+	}
+	REQUIRE(bufferPack.updateVertices(vertices, faces, changedVertices));
+	REQUIRE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+	CHECK(changedBegin == 17);
+	CHECK(changedEnd == vertices.size() - 1);
+	checkStripes();
+	bufferPack.clearChangedRange();
+	for(uint64_t i=40; i<60; ++i)
+	{
+		vertices[i]->setFuncValue(static_cast<double>(i));
+	}
+	REQUIRE(bufferPack.updateVertices(vertices, faces, 40, 60));
+	REQUIRE(bufferPack.updateVertices(vertices, faces, 30, 50));
+	REQUIRE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+	CHECK(changedBegin == 30);
+	CHECK(changedEnd == 60);
+	CHECK(bufferPack.getVertexStripes()[45].mFuncVal == 45.0f);
+	checkStripes();
+
+	// Marked vertices are packed once by updateMarkedVertices.
+	bufferPack.clearChangedRange();
+	for(uint64_t i=200; i<210; ++i)
+	{
+		vertices[i]->setFuncValue(-static_cast<double>(i));
+	}
+	vertices[5]->setRGB(4, 5, 6);
+	bufferPack.markVerticesChanged(200, 205);
+	bufferPack.markVerticesChanged(205, 210);
+	bufferPack.markVerticesChanged(std::vector<uint64_t>{5, 207, 5});
+	CHECK_FALSE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+	CHECK(bufferPack.getVertexStripes()[200].mFuncVal != -200.0f);
+	REQUIRE(bufferPack.updateMarkedVertices(vertices, faces));
+	REQUIRE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+	CHECK(changedBegin == 5);
+	CHECK(changedEnd == 210);
+	CHECK(bufferPack.getVertexStripes()[200].mFuncVal == -200.0f);
+	checkStripes();
+	bufferPack.clearChangedRange();
+	REQUIRE(bufferPack.updateMarkedVertices(vertices, faces));
+	CHECK_FALSE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+	bufferPack.markVerticesChanged(std::vector<uint64_t>{vertices.size()});
+	CHECK_FALSE(bufferPack.updateMarkedVertices(vertices, faces));
+
+	CHECK_FALSE(bufferPack.updateVertices(vertices, faces, std::vector<uint64_t>{vertices.size()}));
+	const std::vector<Vertex*> fewerVertices(vertices.begin(), vertices.end() - 1);
+	CHECK_FALSE(bufferPack.updateVertices(fewerVertices, faces, 0, 1));
+	REQUIRE(bufferPack.packVertices(vertices, faces));
+	CHECK_FALSE(bufferPack.getChangedRange(&changedBegin, &changedEnd));
+
+	// Index buffers against serial packing.
+	std::vector<uint32_t> faceIndices;
+	std::vector<uint32_t> expectedFaceIndices;
+	std::vector<uint32_t> selectedFaceIndices;
+	std::vector<uint32_t> expectedSelectedFaceIndices;
+	for(uint64_t i=0; i<faces.size(); ++i)
+	{
+		const std::initializer_list<uint32_t> vertexIndices{faces[i]->getVertAIndex(), faces[i]->getVertBIndex(), faces[i]->getVertCIndex()};
+		expectedFaceIndices.insert(expectedFaceIndices.end(), vertexIndices);
+		if(i % 7 == 3)
+		{
+			faces[i]->setFlag(Primitive::FLAG_SELECTED);
+			expectedSelectedFaceIndices.insert(expectedSelectedFaceIndices.end(), vertexIndices);
+		}
+	}
+	std::vector<uint32_t> selectedVertexIndices;
+	std::vector<uint32_t> expectedSelectedVertexIndices;
+	for(uint64_t i=0; i<vertices.size(); i+=5)
+	{
+		vertices[i]->setFlag(Primitive::FLAG_SELECTED);
+		expectedSelectedVertexIndices.push_back(static_cast<uint32_t>(i));
+	}
+	MeshBufferPack::packFaceIndices(faces, faceIndices);
+	MeshBufferPack::packFaceIndicesWithFlag(faces, Primitive::FLAG_SELECTED, selectedFaceIndices);
+	MeshBufferPack::packVertexIndicesWithFlag(vertices, Primitive::FLAG_SELECTED, selectedVertexIndices);
+	CHECK(faceIndices == expectedFaceIndices);
+	CHECK(selectedFaceIndices == expectedSelectedFaceIndices);
+	CHECK(selectedVertexIndices == expectedSelectedVertexIndices);
+	MeshBufferPack::packFaceIndicesWithFlag(faces, Primitive::FLAG_SYNTHETIC, selectedFaceIndices);
+	CHECK(selectedFaceIndices.empty());
+}
+
+TEST_CASE("Quadric error decimation", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/0976_REDUX.obj", success);
+	REQUIRE(success);
+	const uint64_t vertexNr = testMesh.getVertexNr();
+	const uint64_t faceNr   = testMesh.getFaceNr();
+	std::vector<double>   vertexCoords(vertexNr * 3);
+	std::vector<uint64_t> faceVertexIndices(faceNr * 3);
+	for(uint64_t i=0; i<vertexNr; ++i)
+	{
+		testMesh.getVertexPos(i)->copyXYZTo(&vertexCoords[i*3]);
+	}
+	for(uint64_t i=0; i<faceNr; ++i)
+	{
+		faceVertexIndices[i*3]   = testMesh.getFacePos(i)->getVertAIndex();
+		faceVertexIndices[i*3+1] = testMesh.getFacePos(i)->getVertBIndex();
+		faceVertexIndices[i*3+2] = testMesh.getFacePos(i)->getVertCIndex();
+	}
+	// Two labels split at the mean x-coordinate.
+	double meanX = 0.0;
+	for(uint64_t i=0; i<vertexNr; ++i)
+	{
+		meanX += vertexCoords[i*3] / vertexNr;
+	}
+	std::vector<uint64_t> vertexLabels(vertexNr);
+	for(uint64_t i=0; i<vertexNr; ++i)
+	{
+		vertexLabels[i] = vertexCoords[i*3] < meanX ? 1 : 2;
+	}
+	// Number of faces per edge.
+	auto countEdgeFaces = [](const std::vector<uint64_t>& rFaces)
+	{
+		std::map<std::pair<uint64_t,uint64_t>, unsigned int> edgeFaces;
+		for(uint64_t i=0; i<rFaces.size(); i+=3)
+		{
+			for(unsigned int k=0; k<3; ++k)
+			{
+				const uint64_t vertA = rFaces[i+k];
+				const uint64_t vertB = rFaces[i+(k+1)%3];
+				edgeFaces[std::make_pair(std::min(vertA, vertB), std::max(vertA, vertB))]++;
+			}
+		}
+		return edgeFaces;
+	};
+	const auto fineEdges = countEdgeFaces(faceVertexIndices);
+
+	QuadricDecimation decimation;
+	std::vector<uint64_t> badFaces(faceVertexIndices);
+	badFaces[5] = vertexNr;
+	CHECK_FALSE(decimation.decimate(vertexCoords, badFaces, vertexLabels, faceNr / 4));
+
+	const uint64_t targetFaceNr = faceNr / 4;
+	REQUIRE(decimation.decimate(vertexCoords, faceVertexIndices, vertexLabels, targetFaceNr));
+	CHECK(decimation.getFaceNr() <= targetFaceNr);
+	CHECK(decimation.getFaceNr() > targetFaceNr / 2);
+	const std::vector<uint64_t>& coarseFaces  = decimation.getFaceVertexIndices();
+	const std::vector<uint64_t>& coarseToFine = decimation.getCoarseToFine();
+	const std::vector<uint64_t>& fineToCoarse = decimation.getFineToCoarse();
+	REQUIRE(coarseToFine.size() == decimation.getVertexNr());
+	REQUIRE(fineToCoarse.size() == vertexNr);
+	for(uint64_t i=0; i<coarseToFine.size(); ++i)
+	{
+		REQUIRE(fineToCoarse[coarseToFine[i]] == i);
+	}
+	// Vertices are only merged within their label, so each label is kept.
+	for(uint64_t i=0; i<vertexNr; ++i)
+	{
+		REQUIRE(fineToCoarse[i] < coarseToFine.size());
+		REQUIRE(vertexLabels[coarseToFine[fineToCoarse[i]]] == vertexLabels[i]);
+	}
+	// Remaining faces are valid and do not introduce non-manifold edges.
+	const auto coarseEdges = countEdgeFaces(coarseFaces);
+	unsigned int fineNonManifold = 0;
+	for(const auto& edge : fineEdges)
+	{
+		fineNonManifold += edge.second > 2 ? 1 : 0;
+	}
+	unsigned int coarseNonManifold = 0;
+	for(const auto& edge : coarseEdges)
+	{
+		coarseNonManifold += edge.second > 2 ? 1 : 0;
+	}
+	CHECK(coarseNonManifold <= fineNonManifold);
+	for(uint64_t i=0; i<coarseFaces.size(); i+=3)
+	{
+		REQUIRE(coarseFaces[i] != coarseFaces[i+1]);
+		REQUIRE(coarseFaces[i] != coarseFaces[i+2]);
+		REQUIRE(coarseFaces[i+1] != coarseFaces[i+2]);
+	}
+	// Border vertices stay on the border.
+	std::vector<bool> coarseBorder(coarseToFine.size(), false);
+	for(const auto& edge : coarseEdges)
+	{
+		if(edge.second == 1)
+		{
+			coarseBorder[edge.first.first] = coarseBorder[edge.first.second] = true;
+		}
+	}
+	for(const auto& edge : fineEdges)
+	{
+		if(edge.second == 1)
+		{
+			REQUIRE(coarseBorder[fineToCoarse[edge.first.first]]);
+			REQUIRE(coarseBorder[fineToCoarse[edge.first.second]]);
+		}
+	}
+
+	// A maximum error of zero merges only vertices within planes.
+	QuadricDecimation decimationExact;
+	REQUIRE(decimationExact.decimate(vertexCoords, faceVertexIndices, {}, 0, 0.0));
+	CHECK(decimationExact.getFaceNr() > decimation.getFaceNr());
+
+	// Mesh interface and transfer of function values.
+	std::vector<sVertexProperties> vertexProps;
+	std::vector<sFaceProperties>   faceProps;
+	std::vector<uint64_t>          meshFineToCoarse;
+	REQUIRE(testMesh.decimateQuadricError(targetFaceNr, std::numeric_limits<double>::infinity(),
+	                                      vertexProps, faceProps, meshFineToCoarse));
+	CHECK(testMesh.getFaceNr() == faceNr);
+	CHECK(faceProps.size() <= targetFaceNr);
+	REQUIRE(meshFineToCoarse.size() == vertexNr);
+	Mesh coarseMesh(vertexProps, faceProps);
+	REQUIRE(coarseMesh.getVertexNr() == vertexProps.size());
+	for(uint64_t i=0; i<coarseMesh.getVertexNr(); ++i)
+	{
+		coarseMesh.getVertexPos(i)->setFuncValue(static_cast<double>(i));
+	}
+	CHECK_FALSE(testMesh.setVertFuncValFromCoarse(coarseMesh, std::vector<uint64_t>(vertexNr - 1, 0)));
+	REQUIRE(testMesh.setVertFuncValFromCoarse(coarseMesh, meshFineToCoarse));
+	for(uint64_t i=0; i<vertexNr; ++i)
+	{
+		double funcVal = 0.0;
+		testMesh.getVertexPos(i)->getFuncValue(&funcVal);
+		REQUIRE(funcVal == static_cast<double>(meshFineToCoarse[i]));
+	}
+}
+
+TEST_CASE("Split by several levels in a single pass", "[mesh]")
+{
+	// Single triangle with values 0, 1 and 2 cut at 0.5 and 1.5 into three parts with five triangles.
+	ScalarFieldSplit fieldSplit;
+	const std::vector<double>   triangleValues{0.0, 1.0, 2.0};
+	const std::vector<uint64_t> triangleFace{0, 1, 2};
+	CHECK_FALSE(fieldSplit.split(triangleValues, {0, 1, 3}, {0.5}, false));
+	REQUIRE(fieldSplit.split(triangleValues, triangleFace, {1.5, 0.5, 0.5}, false));
+	CHECK(fieldSplit.getSplitFaces() == std::vector<uint64_t>{0});
+	CHECK(fieldSplit.getNewVertices().size() == 4);
+	CHECK(fieldSplit.getNewFaces().size() == 5);
+	// The vertex on the level is duplicated in addition to the crossings.
+	REQUIRE(fieldSplit.split(triangleValues, triangleFace, {1.0}, true));
+	CHECK(fieldSplit.getNewVertices().size() == 4);
+	CHECK(fieldSplit.getNewFaces().size() == 2);
+	const std::vector<unsigned char> faceMask{0};
+	REQUIRE(fieldSplit.split(triangleValues, triangleFace, {1.0}, false, &faceMask));
+	CHECK(fieldSplit.getSplitFaces().empty());
+
+	// Total area and number of border edges, which also checks the connections of the faces.
+	// Optionally the number of border edges after splitting by the given planes.
+	auto getAreaAndBorder = [](Mesh& rMesh, double& rArea, uint64_t& rBorderEdges,
+	                           const Vector3D* rPlaneHNF=nullptr, const std::vector<double>& rDistances={})
+	{
+		rArea = 0.0;
+		rBorderEdges = 0;
+		for(uint64_t i=0; i<rMesh.getFaceNr(); ++i)
+		{
+			Face* face = rMesh.getFacePos(i);
+			rArea += face->getAreaNormal();
+			Vertex* vertices[4] = {face->getVertA(), face->getVertB(), face->getVertC(), face->getVertA()};
+			for(const Face::eEdgeNames edge : {Face::EDGE_AB, Face::EDGE_BC, Face::EDGE_CA})
+			{
+				if(face->getNeighbourFace(edge) != nullptr)
+				{
+					continue;
+				}
+				rBorderEdges++;
+				if(rPlaneHNF == nullptr)
+				{
+					continue;
+				}
+				const double distA = vertices[edge-1]->estDistanceToPlane(*rPlaneHNF);
+				const double distB = vertices[edge]->estDistanceToPlane(*rPlaneHNF);
+				for(const double distance : rDistances)
+				{
+					rBorderEdges += (std::min(distA, distB) < distance && std::max(distA, distB) > distance) ? 1 : 0;
+				}
+			}
+		}
+	};
+	bool success = false;
+	MockMesh meshReference("testdata/cuneus_ideal_w_normals_midpoint_subdiv.obj", success);
+	REQUIRE(success);
+	MockMesh meshSplit("testdata/cuneus_ideal_w_normals_midpoint_subdiv.obj", success);
+	REQUIRE(success);
+	double areaBefore = 0.0;
+	uint64_t borderBefore = 0;
+	getAreaAndBorder(meshSplit, areaBefore, borderBefore);
+	const uint64_t vertexNrBefore = meshSplit.getVertexNr();
+	const uint64_t faceNrBefore   = meshSplit.getFaceNr();
+
+	// A single plane compared to the generic method.
+	const Vector3D center = meshSplit.getBoundingBoxCenter();
+	Vector3D planeHNF(1.0, 0.0, 0.0, -center.getX() - 0.0123);
+	uint64_t borderExpected = 0;
+	getAreaAndBorder(meshSplit, areaBefore, borderExpected, &planeHNF, {0.0});
+	Plane cutPlane(&planeHNF);
+	REQUIRE(meshReference.splitMesh(
+	        [&planeHNF](Face* rFace) { return rFace->intersectsPlane(&planeHNF); },
+	        [&planeHNF](VertexOfFace* rVertex) { return rVertex->estDistanceToPlane(planeHNF); },
+	        [&cutPlane](VertexOfFace* rVertX, VertexOfFace* rVertY, Vector3D& rIntersection)
+	        {
+	            cutPlane.getIntersectionFacePlaneLinePos(rVertX->getPositionVector(), rVertY->getPositionVector(), rIntersection);
+	        }, false, true));
+	REQUIRE(meshSplit.splitByPlane(planeHNF, false, true));
+	CHECK(meshSplit.getVertexNr() == meshReference.getVertexNr());
+	CHECK(meshSplit.getFaceNr() == meshReference.getFaceNr());
+	CHECK(meshSplit.getVertexNr() > vertexNrBefore);
+	CHECK(meshSplit.getFaceNr() > faceNrBefore);
+	double area = 0.0;
+	uint64_t border = 0;
+	getAreaAndBorder(meshSplit, area, border);
+	CHECK(area == Approx(areaBefore).epsilon(1e-9));
+	CHECK(border == borderExpected);
+	CHECK(border > borderBefore);
+
+	// Parallel planes cutting into slabs: no face crosses a plane afterwards.
+	Vector3D bbSize;
+	REQUIRE(meshSplit.getBoundingBoxSize(bbSize));
+	std::vector<double> distances;
+	for(int i=-3; i<=3; ++i)
+	{
+		distances.push_back(0.1 * i * bbSize.getX() + 0.0017);
+	}
+	const uint64_t vertexNrPrevious = meshSplit.getVertexNr();
+	getAreaAndBorder(meshSplit, area, borderExpected, &planeHNF, distances);
+	REQUIRE(meshSplit.splitByPlanes(planeHNF, distances, false, true));
+	CHECK(meshSplit.getVertexNr() > vertexNrPrevious);
+	getAreaAndBorder(meshSplit, area, border);
+	CHECK(area == Approx(areaBefore).epsilon(1e-9));
+	CHECK(border == borderExpected);
+	const double tolerance = 1e-9 * bbSize.getX();
+	for(uint64_t i=0; i<meshSplit.getFaceNr(); ++i)
+	{
+		Face* face = meshSplit.getFacePos(i);
+		const double distA = face->getVertA()->estDistanceToPlane(planeHNF);
+		const double distB = face->getVertB()->estDistanceToPlane(planeHNF);
+		const double distC = face->getVertC()->estDistanceToPlane(planeHNF);
+		const double distMin = std::min({distA, distB, distC});
+		const double distMax = std::max({distA, distB, distC});
+		for(const double distance : distances)
+		{
+			REQUIRE_FALSE((distMin < distance - tolerance && distMax > distance + tolerance));
+		}
+	}
+
+	// Iso lines with duplicated vertices: the new vertices are on the iso lines.
+	for(uint64_t i=0; i<meshSplit.getVertexNr(); ++i)
+	{
+		Vertex* vertex = meshSplit.getVertexPos(i);
+		vertex->setFuncValue(vertex->getY());
+	}
+	const uint64_t vertexNrIso = meshSplit.getVertexNr();
+	const std::vector<double> isoVals{center.getY() + 0.0031, center.getY() + 0.2 * bbSize.getY() + 0.0031};
+	REQUIRE(meshSplit.splitByIsoLines(isoVals, true, true));
+	REQUIRE(meshSplit.getVertexNr() > vertexNrIso);
+	CHECK((meshSplit.getVertexNr() - vertexNrIso) % 2 == 0);
+	for(uint64_t i=vertexNrIso; i<meshSplit.getVertexNr(); ++i)
+	{
+		double funcVal = 0.0;
+		meshSplit.getVertexPos(i)->getFuncValue(&funcVal);
+		REQUIRE((funcVal == Approx(isoVals[0]) || funcVal == Approx(isoVals[1])));
+	}
+	getAreaAndBorder(meshSplit, area, border);
+	CHECK(area == Approx(areaBefore).epsilon(1e-6));
+	CHECK(border > borderBefore);
+}
+
+TEST_CASE("Vertex welding", "[mesh]")
+{
+	SECTION("Engine")
+	{
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		const std::vector<double> coords = {
+			0.0, 0.0, 0.0,
+			1.0, 0.0, 0.0,
+			-0.0, 0.0, 0.0,
+			1.0005, 0.0, 0.0,
+			1.001, 0.0, 0.0,
+			nan, 0.0, 0.0,
+			nan, 0.0, 0.0,
+			5.0, 5.0, 5.0
+		};
+		VertexWelding welding;
+		CHECK_FALSE(welding.weld(coords, -1.0));
+		CHECK_FALSE(welding.weld(std::vector<double>(4, 0.0), 0.0));
+
+		REQUIRE(welding.weld(coords, 0.0));
+		CHECK(welding.getMergedNr() == 1);
+		CHECK(welding.getVertexMap() == std::vector<uint64_t>({0, 1, 0, 2, 3, 4, 5, 6}));
+
+		// Chain of vertices within the tolerance.
+		REQUIRE(welding.weld(coords, 0.0006));
+		CHECK(welding.getMergedNr() == 3);
+		CHECK(welding.getVertexNr() == 5);
+		CHECK(welding.getVertexMap() == std::vector<uint64_t>({0, 1, 0, 1, 1, 2, 3, 4}));
+		CHECK(welding.getClusterOffsets() == std::vector<uint64_t>({0, 2, 5, 6, 7, 8}));
+		CHECK(welding.getClusterMembers() == std::vector<uint64_t>({0, 2, 1, 3, 4, 5, 6, 7}));
+
+		std::vector<sVertexProperties> vertexProps(coords.size() / 3);
+		for(size_t i=0; i<vertexProps.size(); ++i)
+		{
+			vertexProps[i].mCoordX   = coords[i*3];
+			vertexProps[i].mCoordY   = coords[i*3+1];
+			vertexProps[i].mCoordZ   = coords[i*3+2];
+			vertexProps[i].mColorRed = static_cast<unsigned char>(10 * i);
+			vertexProps[i].mFuncVal  = (i == 3) ? nan : static_cast<double>(i);
+			vertexProps[i].mLabelId  = i;
+		}
+		std::vector<sVertexProperties> weldedProps;
+		REQUIRE(welding.mergeVertexProps(vertexProps, VertexWelding::ATTRIBUTES_FIRST, weldedProps));
+		REQUIRE(weldedProps.size() == 5);
+		CHECK(weldedProps[1].mCoordX == 1.0);
+		CHECK(weldedProps[1].mColorRed == 10);
+		REQUIRE(welding.mergeVertexProps(vertexProps, VertexWelding::ATTRIBUTES_MEAN, weldedProps));
+		CHECK(weldedProps[1].mCoordX == Approx(1.0005));
+		CHECK(weldedProps[1].mColorRed == 27);
+		CHECK(weldedProps[1].mFuncVal == 2.5);
+		CHECK(weldedProps[1].mLabelId == 1);
+		CHECK(std::isnan(weldedProps[2].mCoordX));
+		CHECK_FALSE(welding.mergeVertexProps(std::vector<sVertexProperties>(3), VertexWelding::ATTRIBUTES_MEAN, weldedProps));
+
+		std::vector<double> rows(coords.size() / 3 * 2);
+		for(size_t i=0; i<rows.size(); ++i)
+		{
+			rows[i] = static_cast<double>(i);
+		}
+		std::vector<double> weldedRows;
+		REQUIRE(welding.mergeRows(rows, 2, VertexWelding::ATTRIBUTES_MEAN, weldedRows));
+		REQUIRE(weldedRows.size() == 10);
+		CHECK(weldedRows[0] == 2.0);
+		CHECK(weldedRows[3] == Approx(19.0 / 3.0));
+	}
+
+	// Mesh with separate vertices per face as exported e.g. as STL.
+	bool success = false;
+	MockMesh testMesh("testdata/cuneus_ideal_w_normals_midpoint_subdiv.obj", success);
+	REQUIRE(success == true);
+	const uint64_t vertexNr = testMesh.getVertexNr();
+	const uint64_t faceNr   = testMesh.getFaceNr();
+	for(uint64_t i=0; i<vertexNr; ++i)
+	{
+		testMesh.getVertexPos(i)->setIndex(i);
+		testMesh.getVertexPos(i)->setFuncValue(static_cast<double>(i));
+	}
+	std::mt19937 gen(4711);
+	std::uniform_real_distribution<> dis(-1e-6, 1e-6);
+	std::vector<sVertexProperties> soupVertexProps(faceNr * 3);
+	std::vector<sFaceProperties>   soupFaceProps(faceNr);
+	for(uint64_t faceIdx=0; faceIdx<faceNr; ++faceIdx)
+	{
+		Face* face = testMesh.getFacePos(faceIdx);
+		Vertex* vertices[3] = {face->getVertA(), face->getVertB(), face->getVertC()};
+		for(unsigned int k=0; k<3; ++k)
+		{
+			vertices[k]->copyVertexPropsTo(soupVertexProps[faceIdx*3+k]);
+			soupFaceProps[faceIdx].vertexIndices.push_back(faceIdx*3+k);
+		}
+	}
+	auto countBorderEdges = [](Mesh& rMesh)
+	{
+		uint64_t borderEdges = 0;
+		for(uint64_t i=0; i<rMesh.getFaceNr(); ++i)
+		{
+			for(const Face::eEdgeNames edge : {Face::EDGE_AB, Face::EDGE_BC, Face::EDGE_CA})
+			{
+				borderEdges += rMesh.getFacePos(i)->getNeighbourFace(edge) == nullptr ? 1 : 0;
+			}
+		}
+		return borderEdges;
+	};
+	const uint64_t borderEdges = countBorderEdges(testMesh);
+
+	SECTION("Properties")
+	{
+		MeshIO meshIO;
+		uint64_t mergedNr = 0;
+		CHECK_FALSE(meshIO.weldVertexProps(soupVertexProps, soupFaceProps, -1.0, VertexWelding::ATTRIBUTES_FIRST));
+		REQUIRE(meshIO.weldVertexProps(soupVertexProps, soupFaceProps, 0.0, VertexWelding::ATTRIBUTES_FIRST, &mergedNr));
+		CHECK(mergedNr == faceNr * 3 - vertexNr);
+		CHECK(soupVertexProps.size() == vertexNr);
+		CHECK(soupFaceProps.size() == faceNr);
+		Mesh weldedMesh(soupVertexProps, soupFaceProps);
+		CHECK(countBorderEdges(weldedMesh) == borderEdges);
+	}
+
+	SECTION("Import")
+	{
+		const std::filesystem::path fileName = std::filesystem::temp_directory_path() / "gigamesh_welding_test.ply";
+		{
+			Mesh soupMesh(soupVertexProps, soupFaceProps);
+			CHECK(countBorderEdges(soupMesh) == faceNr * 3);
+			REQUIRE(soupMesh.writeFile(fileName));
+		}
+		MeshIO meshIO;
+		std::vector<sVertexProperties> vertexProps;
+		std::vector<sFaceProperties>   faceProps;
+		REQUIRE(meshIO.readFile(fileName, vertexProps, faceProps));
+		CHECK(vertexProps.size() == faceNr * 3);
+		meshIO.setImportWeldVertices(0.0);
+		REQUIRE(meshIO.readFile(fileName, vertexProps, faceProps));
+		CHECK(vertexProps.size() == vertexNr);
+		CHECK(faceProps.size() == faceNr);
+		std::filesystem::remove(fileName);
+	}
+
+	SECTION("Mesh with tolerance and mean attributes")
+	{
+		for(auto& vertexProps : soupVertexProps)
+		{
+			vertexProps.mCoordX += dis(gen);
+			vertexProps.mCoordY += dis(gen);
+			vertexProps.mCoordZ += dis(gen);
+		}
+		Mesh soupMesh(soupVertexProps, soupFaceProps);
+		uint64_t mergedNr = 0;
+		REQUIRE(soupMesh.weldVertices(1e-4, VertexWelding::ATTRIBUTES_MEAN, mergedNr));
+		CHECK(mergedNr == faceNr * 3 - vertexNr);
+		CHECK(soupMesh.getVertexNr() == vertexNr);
+		CHECK(soupMesh.getFaceNr() == faceNr);
+		CHECK(countBorderEdges(soupMesh) == borderEdges);
+		// The mean of the function values refers to the original vertex.
+		for(uint64_t i=0; i<soupMesh.getVertexNr(); ++i)
+		{
+			Vertex* vertex = soupMesh.getVertexPos(i);
+			double funcValue = 0.0;
+			vertex->getFuncValue(&funcValue);
+			REQUIRE(funcValue == std::round(funcValue));
+			const Vertex* vertexOri = testMesh.getVertexPos(static_cast<uint64_t>(funcValue));
+			CHECK(abs3(vertex->getPositionVector() - vertexOri->getPositionVector()) < 2e-6);
+		}
+		// Welding again does not change anything.
+		REQUIRE(soupMesh.weldVertices(1e-4, VertexWelding::ATTRIBUTES_FIRST, mergedNr));
+		CHECK(mergedNr == 0);
+	}
+}
+
+TEST_CASE("Mahalanobis distance of feature vectors", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	const uint64_t vertexNr = testMesh.getVertexNr();
+	const uint64_t featureVecLen = 16;
+	std::vector<double> featureVecs(vertexNr * featureVecLen);
+	for(uint64_t i=0; i<featureVecs.size(); ++i)
+	{
+		featureVecs[i] = std::sin(static_cast<double>(i) * 0.37) * 0.5 + 0.5;
+	}
+	const std::vector<double> featureVecsCopy = featureVecs;
+	REQUIRE(testMesh.adoptFeatureVectors(featureVecs, featureVecLen));
+	const std::vector<double> referenceVec(featureVecsCopy.begin() + 9*featureVecLen, featureVecsCopy.begin() + 10*featureVecLen);
+
+	// Reference: row vector d times the lower triangular weight matrix W followed by the product with d.
+	auto getExpected = [&](const double* rFeatureVec)
+	{
+		std::vector<double> weighted(featureVecLen, 0.0);
+		std::vector<double> diff(featureVecLen);
+		for(uint64_t k=0; k<featureVecLen; ++k)
+		{
+			diff[k] = rFeatureVec[k] - referenceVec[k];
+		}
+		for(uint64_t k=0; k<featureVecLen; ++k)
+		{
+			for(uint64_t j=0; j<featureVecLen; ++j)
+			{
+				const double ny = static_cast<double>(k + 1);
+				const double nx = static_cast<double>(j + 1);
+				const double weight = (j <= k) ? (3.0*pow(nx, 2.0) - 3.0*nx + 1.0) / pow(ny, 3.0) : 0.0;
+				weighted[j] += diff[k] * weight;
+			}
+		}
+		double quadForm = 0.0;
+		for(uint64_t j=0; j<featureVecLen; ++j)
+		{
+			quadForm += weighted[j] * diff[j];
+		}
+		return std::sqrt(quadForm);
+	};
+
+	SECTION("Contiguous store")
+	{
+		REQUIRE(testMesh.funcVertFeatureVecMahalDist(referenceVec, Mesh::FEATURE_VECTOR_PNORM_WEIGTH_CUBIC));
+		for(uint64_t i=0; i<vertexNr; ++i)
+		{
+			double funcValue = 0.0;
+			testMesh.getVertexPos(i)->getFuncValue(&funcValue);
+			REQUIRE(funcValue == Approx(getExpected(&featureVecsCopy[i*featureVecLen])).epsilon(1e-12));
+		}
+		double funcValue = 1.0;
+		testMesh.getVertexPos(9)->getFuncValue(&funcValue);
+		CHECK(funcValue == 0.0);
+	}
+
+	SECTION("Vertices with their own feature vector")
+	{
+		testMesh.getVertexPos(3)->resizeFeatureVector(featureVecLen + 1);
+		REQUIRE(testMesh.funcVertFeatureVecMahalDist(referenceVec, Mesh::FEATURE_VECTOR_PNORM_WEIGTH_CUBIC));
+		for(uint64_t i=0; i<vertexNr; ++i)
+		{
+			double funcValue = 0.0;
+			testMesh.getVertexPos(i)->getFuncValue(&funcValue);
+			if(i == 3)
+			{
+				CHECK(std::isnan(funcValue));
+				continue;
+			}
+			REQUIRE(funcValue == Approx(getExpected(&featureVecsCopy[i*featureVecLen])).epsilon(1e-12));
+		}
+	}
+
+	SECTION("Invalid arguments")
+	{
+		CHECK_FALSE(testMesh.funcVertFeatureVecMahalDist(std::vector<double>(), Mesh::FEATURE_VECTOR_PNORM_WEIGTH_LINEAR));
+		FeatureVecStore store;
+		std::vector<double> values(featureVecsCopy);
+		REQUIRE(store.adopt(values, featureVecLen));
+		std::vector<double> distances;
+		CHECK_FALSE(store.computeWeightedDistances(referenceVec.data(), std::vector<double>(featureVecLen), distances));
+		REQUIRE(store.computeWeightedDistances(referenceVec.data(), std::vector<double>(featureVecLen * featureVecLen, 0.0), distances));
+		REQUIRE(distances.size() == vertexNr);
+		CHECK(distances.front() == 0.0);
+	}
+}
+
+TEST_CASE("Contiguous feature vectors", "[mesh]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	const uint64_t vertexNr = testMesh.getVertexNr();
+	const uint64_t featureVecLen = 11;
+	std::vector<double> featureVecs(vertexNr * featureVecLen);
+	for(uint64_t i=0; i<featureVecs.size(); ++i)
+	{
+		featureVecs[i] = std::sin(static_cast<double>(i)) + 1.5;
+	}
+	const std::vector<double> featureVecsCopy = featureVecs;
+
+	std::vector<double> tooShort(featureVecLen);
+	CHECK_FALSE(testMesh.adoptFeatureVectors(tooShort, featureVecLen));
+
+	REQUIRE(testMesh.adoptFeatureVectors(featureVecs, featureVecLen));
+	CHECK(featureVecs.empty());
+	for(uint64_t i=0; i<vertexNr; i+=31)
+	{
+		Vertex* vert = testMesh.getVertexPos(i);
+		REQUIRE(vert->getFeatureVectorLen() == featureVecLen);
+		for(unsigned int j=0; j<featureVecLen; ++j)
+		{
+			double elementValue = 0.0;
+			vert->getFeatureElement(j, &elementValue);
+			CHECK(elementValue == featureVecsCopy[i*featureVecLen+j]);
+		}
+	}
+	testMesh.changedVertFeatureVectors();
+
+	std::vector<double> referenceVec(featureVecsCopy.begin() + 5*featureVecLen, featureVecsCopy.begin() + 6*featureVecLen);
+	auto checkDistances = [&testMesh, &referenceVec]()
+	{
+		double*  funcValues = nullptr;
+		Vertex** vertices   = nullptr;
+		int      vertCount  = 0;
+		REQUIRE(testMesh.estFeatureDistManToVertex(referenceVec.data(), &funcValues, &vertices, &vertCount));
+		REQUIRE(static_cast<uint64_t>(vertCount) == testMesh.getVertexNr());
+		for(int i=0; i<vertCount; ++i)
+		{
+			REQUIRE(vertices[i] == testMesh.getVertexPos(i));
+			CHECK(funcValues[i] == Approx(vertices[i]->getFeatureDistManTo(referenceVec.data())));
+		}
+		delete[] funcValues;
+		delete[] vertices;
+		REQUIRE(testMesh.estFeatureDistEucToVertex(referenceVec.data(), &funcValues, &vertices, &vertCount));
+		for(int i=0; i<vertCount; ++i)
+		{
+			CHECK(funcValues[i] == Approx(vertices[i]->getFeatureDistEucTo(referenceVec.data())));
+		}
+		delete[] funcValues;
+		delete[] vertices;
+		REQUIRE(testMesh.estFeatureTanimotoDistTo(referenceVec.data(), &funcValues, &vertices, &vertCount));
+		for(int i=0; i<vertCount; ++i)
+		{
+			CHECK(funcValues[i] == Approx(vertices[i]->getFeatureVecTanimotoDist(referenceVec.data())));
+		}
+		delete[] funcValues;
+		delete[] vertices;
+	};
+
+	SECTION("Distances using the contiguous store")
+	{
+		checkDistances();
+	}
+
+	SECTION("Vertices with their own feature vector")
+	{
+		// Detaches a single vertex from the store, which is then no longer used for the distances.
+		REQUIRE(testMesh.getVertexPos(3)->assignFeatureVec(referenceVec.data(), featureVecLen));
+		testMesh.getVertexPos(7)->resizeFeatureVector(featureVecLen + 2);
+		double elementValue = 0.0;
+		testMesh.getVertexPos(7)->getFeatureElement(1, &elementValue);
+		CHECK(elementValue == featureVecsCopy[7*featureVecLen+1]);
+		testMesh.getVertexPos(7)->resizeFeatureVector(featureVecLen);
+		checkDistances();
+	}
+
+	SECTION("Removal")
+	{
+		for(uint64_t i=0; i<vertexNr; ++i)
+		{
+			REQUIRE(testMesh.getVertexPos(i)->assignFeatureVec(nullptr, 0));
+		}
+		CHECK(testMesh.getFeatureVecLenMax(Primitive::IS_VERTEX) == 0);
+	}
+}
+
+TEST_CASE("Statistics of sphere neighbourhoods", "[mesh]")
+{
+	const std::string fileName = GENERATE(as<std::string>{}, "testdata/sphere_ascii.ply", "testdata/0976_REDUX.obj");
+	bool success = false;
+	MockMesh testMesh(fileName, success);
+	REQUIRE(success == true);
+
+	// Representable as float as used by fetchSphereBitArray.
+	const double radius = static_cast<float>(2.0 * testMesh.getBoundingBoxRadius() / 16.0);
+	const std::vector<Mesh::eSphereNeighbourhoodStat> stats = {Mesh::SPHERE_STAT_FACE_ANGLE_MAX, Mesh::SPHERE_STAT_FACE_MEAN_ANGLE_MAX,
+	                                                           Mesh::SPHERE_STAT_FACE_MEAN_ANGLE_MEAN, Mesh::SPHERE_STAT_FACE_AREA,
+	                                                           Mesh::SPHERE_STAT_FACE_COUNT, Mesh::SPHERE_STAT_VERTEX_COUNT};
+	std::vector<double> values;
+	CHECK_FALSE(testMesh.estSphereNeighbourhoodStats(radius, {}, values));
+	CHECK_FALSE(testMesh.estSphereNeighbourhoodStats(-1.0, stats, values));
+	REQUIRE(testMesh.estSphereNeighbourhoodStats(radius, stats, values));
+	const uint64_t vertexNr = testMesh.getVertexNr();
+	REQUIRE(values.size() == vertexNr * stats.size());
+
+	// Reference: faces fetched per vertex with the shared bit arrays.
+	uint64_t* vertBitArrayVisited = nullptr;
+	const int vertNrLongs = testMesh.getBitArrayVerts(&vertBitArrayVisited);
+	uint64_t* faceBitArrayVisited = nullptr;
+	const int faceNrLongs = testMesh.getBitArrayFaces(&faceBitArrayVisited);
+	uint64_t mismatches = 0;
+	for(uint64_t i=0; i<vertexNr; i++)
+	{
+		Vertex* vertex = testMesh.getVertexPos(i);
+		std::vector<Face*> facesInSphere;
+		REQUIRE(testMesh.fetchSphereBitArray(vertex, &facesInSphere, static_cast<float>(radius), vertNrLongs, vertBitArrayVisited,
+		                                     faceNrLongs, faceBitArrayVisited));
+		const Vector3D vertNormal = vertex->getNormal();
+		Vector3D meanNormal(0.0, 0.0, 0.0, 0.0);
+		double area = 0.0;
+		for(Face* face : facesInSphere)
+		{
+			meanNormal += face->getNormal();
+			area += face->getAreaNormal();
+		}
+		double angleMax = -DBL_MAX;
+		double meanAngleMax = -DBL_MAX;
+		double meanAngleSum = 0.0;
+		for(Face* face : facesInSphere)
+		{
+			angleMax = std::max(angleMax, angle(face->getNormal(), vertNormal));
+			meanAngleMax = std::max(meanAngleMax, angle(face->getNormal(), meanNormal));
+			meanAngleSum += angle(face->getNormal(), meanNormal);
+		}
+		const double* row = values.data() + i*stats.size();
+		// Same up to rounding of the vector lengths.
+		mismatches += (row[0] != Approx(angleMax));
+		mismatches += (row[1] != Approx(meanAngleMax));
+		mismatches += (row[2] != Approx(meanAngleSum / facesInSphere.size()));
+		mismatches += (row[3] != Approx(area));
+		mismatches += (row[4] != facesInSphere.size());
+		mismatches += (row[5] < 1.0);
+	}
+	delete[] vertBitArrayVisited;
+	delete[] faceBitArrayVisited;
+	CHECK(mismatches == 0);
+
+	// The function values are the according statistics.
+	mismatches = 0;
+	REQUIRE(testMesh.setVertFuncValFaceSphereMeanAngleMax(radius));
+	for(uint64_t i=0; i<vertexNr; i++)
+	{
+		double funcVal = 0.0;
+		testMesh.getVertexPos(i)->getFuncValue(&funcVal);
+		mismatches += (funcVal != values[i*stats.size()+1]);
+	}
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE("Sphere descriptors in a single pass", "[spherical_intersection]")
+{
+	bool success = false;
+	MockMesh testMesh("testdata/sphere_ascii.ply", success);
+	REQUIRE(success == true);
+
+	const std::vector<double> radii = {40.0, 15.0, 100.0};
+	const unsigned int allDescriptors = Mesh::SPHERE_DESCRIPTOR_SURFACE_LENGTH | Mesh::SPHERE_DESCRIPTOR_VOLUME_AREA |
+	                                    Mesh::SPHERE_DESCRIPTOR_NUMBER_OF_COMPONENTS;
+	std::vector<double> values;
+	CHECK_FALSE(testMesh.computeSphereDescriptors({}, allDescriptors, values));
+	CHECK_FALSE(testMesh.computeSphereDescriptors({1.0, 0.0}, allDescriptors, values));
+	CHECK_FALSE(testMesh.computeSphereDescriptors(radii, 0, values));
+	REQUIRE(testMesh.computeSphereDescriptors(radii, allDescriptors, values));
+	const uint64_t vertexNr = testMesh.getVertexNr();
+	REQUIRE(values.size() == vertexNr * radii.size() * 3);
+
+	// Reference: a fresh graph per descriptor as built by the single descriptor functions.
+	spherical_intersection::Mesh sphericalMesh;
+	for(uint64_t i=0; i<vertexNr; i++)
+	{
+		const Vertex* vertex = testMesh.getVertexPos(i);
+		sphericalMesh.add_vertex(spherical_intersection::math3d::Vector{vertex->getX(), vertex->getY(), vertex->getZ()});
+	}
+	std::vector<std::array<size_t, 3>> faceIndices;
+	for(uint64_t i=0; i<testMesh.getFaceNr(); i++)
+	{
+		Face* face = testMesh.getFacePos(i);
+		faceIndices.push_back({face->getVertAIndex(), face->getVertBIndex(), face->getVertCIndex()});
+	}
+	sphericalMesh.add_triangles(faceIndices);
+	auto sameValue = [](double valueA, double valueB)
+	{
+		return (valueA == valueB) || (std::isnan(valueA) && std::isnan(valueB));
+	};
+	uint64_t mismatches = 0;
+	uint64_t volumeAreasValid = 0;
+	for(uint64_t i=0; i<vertexNr; i++)
+	{
+		const auto& vertex = sphericalMesh.get_vertices()[i];
+		for(size_t r=0; r<radii.size(); r++)
+		{
+			const spherical_intersection::math3d::Sphere sphere{vertex.get_location(), radii[r]};
+			spherical_intersection::Graph graphLength{vertex, sphere};
+			spherical_intersection::Graph graphArea{vertex, sphere};
+			spherical_intersection::Graph graphComponents{vertex, sphere};
+			const double* row = values.data() + (i*radii.size() + r)*3;
+			const double volumeArea = spherical_intersection::algorithm::get_sphere_volume_area(graphArea);
+			mismatches += !sameValue(row[0], spherical_intersection::algorithm::get_sphere_surface_length(graphLength));
+			mismatches += !sameValue(row[1], volumeArea);
+			mismatches += !sameValue(row[2], spherical_intersection::algorithm::get_component_count(graphComponents));
+			volumeAreasValid += !std::isnan(volumeArea);
+		}
+	}
+	CHECK(mismatches == 0);
+	CHECK(volumeAreasValid > 0);
+
+	// A subset of the descriptors gives the according columns.
+	std::vector<double> componentValues;
+	REQUIRE(testMesh.computeSphereDescriptors(radii, Mesh::SPHERE_DESCRIPTOR_NUMBER_OF_COMPONENTS, componentValues));
+	REQUIRE(componentValues.size() == vertexNr * radii.size());
+	for(uint64_t i=0; i<componentValues.size(); i++)
+	{
+		mismatches += !sameValue(componentValues[i], values[i*3+2]);
+	}
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE("Bulk construction of spherical intersection meshes", "[spherical_intersection]")
+{
+	// Wavy grid of 9 x 9 vertices with alternating diagonals, so that the edges are not created in vertex order.
+	const size_t edgeVerts = 9;
+	std::vector<std::array<size_t, 3>> triangleIndices;
+	for(size_t y=0; y+1<edgeVerts; y++)
+	{
+		for(size_t x=0; x+1<edgeVerts; x++)
+		{
+			const size_t idx = y*edgeVerts+x;
+			if((x+y)%2 == 0)
+			{
+				triangleIndices.push_back({idx, idx+1, idx+edgeVerts});
+				triangleIndices.push_back({idx+edgeVerts+1, idx+edgeVerts, idx+1});
+			}
+			else
+			{
+				triangleIndices.push_back({idx+edgeVerts, idx, idx+edgeVerts+1});
+				triangleIndices.push_back({idx+1, idx+edgeVerts+1, idx});
+			}
+		}
+	}
+	// Non-manifold edge shared by three triangles.
+	triangleIndices.push_back({edgeVerts*edgeVerts, 1, 0});
+
+	spherical_intersection::Mesh incrementalMesh;
+	spherical_intersection::Mesh bulkMesh;
+	for(size_t i=0; i<=edgeVerts*edgeVerts; i++)
+	{
+		const double x = static_cast<double>(i%edgeVerts);
+		const double y = static_cast<double>(i/edgeVerts);
+		const spherical_intersection::math3d::Vector location{x, y, 0.25*std::sin(x+2.0*y)};
+		incrementalMesh.add_vertex(location);
+		bulkMesh.add_vertex(location);
+	}
+	const auto& incrementalVertices = incrementalMesh.get_vertices();
+	for(const auto& indices : triangleIndices)
+	{
+		incrementalMesh.add_triangle(incrementalVertices[indices[0]], incrementalVertices[indices[1]], incrementalVertices[indices[2]]);
+	}
+	bulkMesh.add_triangles(triangleIndices);
+	CHECK_THROWS_AS(bulkMesh.add_triangles({{0, 1, edgeVerts*edgeVerts+1}}), std::out_of_range);
+
+	// Adding to a mesh with triangles has to reuse the existing edges.
+	incrementalMesh.add_triangle(incrementalVertices[1], incrementalVertices[0], incrementalVertices[edgeVerts]);
+	bulkMesh.add_triangles({{1, 0, edgeVerts}});
+
+	// Same structure including the order of the adjacencies and containing triangles.
+	auto describeEdge = [](const spherical_intersection::Mesh::Edge& edge)
+	{
+		std::vector<size_t> description = {edge.get_vertex(0).get_index(), edge.get_vertex(1).get_index()};
+		for(const auto& containing : edge.get_containing_triangles())
+		{
+			for(unsigned int i=0; i<3; i++)
+			{
+				description.push_back(containing.get_triangle().get_vertex(i).get_index());
+			}
+			description.push_back(containing.get_edge_index());
+		}
+		return description;
+	};
+	REQUIRE(bulkMesh.get_triangles().size() == incrementalMesh.get_triangles().size());
+	for(size_t i=0; i<incrementalMesh.get_triangles().size(); i++)
+	{
+		for(unsigned int j=0; j<3; j++)
+		{
+			CHECK(describeEdge(bulkMesh.get_triangles()[i].get_edge(j)) == describeEdge(incrementalMesh.get_triangles()[i].get_edge(j)));
+		}
+	}
+	for(size_t i=0; i<incrementalVertices.size(); i++)
+	{
+		const auto& incrementalAdjacencies = incrementalVertices[i].get_adjacencies();
+		const auto& bulkAdjacencies = bulkMesh.get_vertices()[i].get_adjacencies();
+		REQUIRE(bulkAdjacencies.size() == incrementalAdjacencies.size());
+		for(size_t j=0; j<incrementalAdjacencies.size(); j++)
+		{
+			CHECK(bulkAdjacencies[j].get_other_vertex().get_index() == incrementalAdjacencies[j].get_other_vertex().get_index());
+			CHECK(describeEdge(bulkAdjacencies[j].get_edge()) == describeEdge(incrementalAdjacencies[j].get_edge()));
+		}
+	}
+
+	// Same descriptors.
+	spherical_intersection::Graph graph;
+	for(size_t i=0; i<incrementalVertices.size(); i++)
+	{
+		const spherical_intersection::math3d::Sphere sphere{incrementalVertices[i].get_location(), 1.7};
+		graph.assign(incrementalVertices[i], sphere);
+		const double surfaceLength = spherical_intersection::algorithm::get_sphere_surface_length(graph);
+		graph.assign(bulkMesh.get_vertices()[i], sphere);
+		CHECK(spherical_intersection::algorithm::get_sphere_surface_length(graph) == surfaceLength);
+	}
+}
+
+TEST_CASE("Reused spherical intersection graphs", "[spherical_intersection]")
+{
+	// Planar grid of 21 x 21 vertices with unit spacing.
+	const size_t edgeVerts = 21;
+	spherical_intersection::Mesh mesh;
+	for(size_t y=0; y<edgeVerts; y++)
+	{
+		for(size_t x=0; x<edgeVerts; x++)
+		{
+			mesh.add_vertex(spherical_intersection::math3d::Vector{static_cast<double>(x), static_cast<double>(y), 0.0});
+		}
+	}
+	const auto& vertices = mesh.get_vertices();
+	for(size_t y=0; y+1<edgeVerts; y++)
+	{
+		for(size_t x=0; x+1<edgeVerts; x++)
+		{
+			const size_t idx = y*edgeVerts+x;
+			mesh.add_triangle(vertices[idx], vertices[idx+1], vertices[idx+edgeVerts]);
+			mesh.add_triangle(vertices[idx+1], vertices[idx+edgeVerts+1], vertices[idx+edgeVerts]);
+		}
+	}
+
+	const size_t centerIdx = (edgeVerts/2)*edgeVerts + edgeVerts/2;
+	const std::vector<size_t> vertexIndices = { centerIdx, centerIdx+1, 5*edgeVerts+6, centerIdx-edgeVerts+2 };
+	const std::vector<double> radii = { 3.7, 1.3, 2.45 };
+
+	// A single graph reused for all spheres has to give the same results as fresh graphs.
+	spherical_intersection::Graph reusedGraph;
+	for(const double radius : radii)
+	{
+		for(const size_t vertexIdx : vertexIndices)
+		{
+			const auto& vertex = vertices[vertexIdx];
+			const spherical_intersection::math3d::Sphere sphere{vertex.get_location(), radius};
+
+			spherical_intersection::Graph freshGraph{vertex, sphere};
+			const size_t nodeCount = freshGraph.get_node_count();
+			const double surfaceLength = spherical_intersection::algorithm::get_sphere_surface_length(freshGraph);
+			const double volumeArea = spherical_intersection::algorithm::get_sphere_volume_area(freshGraph);
+			CHECK(freshGraph.get_arc_count() == 0);
+			CHECK(freshGraph.get_first_arc() == spherical_intersection::Graph::no_index);
+
+			reusedGraph.assign(vertex, sphere);
+			CHECK(reusedGraph.get_node_count() == nodeCount);
+			CHECK(reusedGraph.get_arc_count() == nodeCount); // a single cycle
+			CHECK(spherical_intersection::algorithm::get_sphere_surface_length(reusedGraph) == surfaceLength);
+			CHECK(spherical_intersection::algorithm::get_sphere_volume_area(reusedGraph) == volumeArea);
+			reusedGraph.assign(vertex, sphere);
+			CHECK(spherical_intersection::algorithm::get_component_count(reusedGraph) == 1);
+			CHECK(reusedGraph.get_node_count() == 0);
+
+			// Flat surface: great circle and half of the sphere.
+			CHECK(surfaceLength == Approx(2.0*M_PI));
+			CHECK(volumeArea == Approx(2.0*M_PI));
+		}
+	}
+}
+
+TEST_CASE("Multi-scale voxel filter in a single pass", "[mesh]")
+{
+	// Radii in arbitrary order and a raster with holes i.e. not-a-number.
+	double radii[] = {0.5, 1.0, 0.125, 0.75, 0.25};
+	const uint scaleCount = sizeof(radii) / sizeof(radii[0]);
+	const uint xyzDim = 64;
+	voxelFilter2DElements* sparseFilters = nullptr;
+	double** voxelFilters2D = generateVoxelFilters2D(scaleCount, radii, xyzDim, &sparseFilters);
+	voxelFilter2DMultiscale multiscaleFilter;
+	REQUIRE(generateVoxelFilters2DMultiscale(sparseFilters, scaleCount, xyzDim, &multiscaleFilter));
+	CHECK(multiscaleFilter.nrColumns == static_cast<uint>(sparseFilters[1].nrElements));
+
+	std::vector<double> rasterArray(xyzDim * xyzDim);
+	for(uint i=0; i<rasterArray.size(); ++i)
+	{
+		const double x = static_cast<double>(i % xyzDim) - xyzDim / 2.0;
+		const double y = static_cast<double>(i / xyzDim) - xyzDim / 2.0;
+		rasterArray[i] = 0.2 * x * x - 0.3 * y + 5.0 * std::sin(0.5 * x * y) - 10.0;
+		if((i % 17 == 0) || (x > 25.0))
+		{
+			rasterArray[i] = _NOT_A_NUMBER_DBL_;
+		}
+	}
+
+	std::vector<double> featuresSparse(scaleCount, 0.0);
+	std::vector<double> featuresMultiscale(scaleCount, 0.0);
+	applyVoxelFilters2D(featuresSparse.data(), rasterArray.data(), &sparseFilters, scaleCount, xyzDim);
+	applyVoxelFilters2D(featuresMultiscale.data(), rasterArray.data(), &multiscaleFilter);
+	for(uint i=0; i<scaleCount; ++i)
+	{
+		// The same sums in the same order.
+		CHECK(featuresMultiscale[i] == featuresSparse[i]);
+		CHECK(featuresMultiscale[i] >= -1.0);
+		CHECK(featuresMultiscale[i] <= 1.0);
+	}
+
+	freeVoxelFilters2DMultiscale(&multiscaleFilter);
+	for(uint i=0; i<scaleCount; ++i)
+	{
+		free(voxelFilters2D[i]);
+		free(sparseFilters[i].elementIndices);
+		free(sparseFilters[i].elementValues);
+	}
+	free(voxelFilters2D);
+	free(sparseFilters);
+}